@@ -106,7 +106,7 @@ private:
 public:
     static Ptr create(const char* name, Args&&... args)
     {
-        const auto types = AbstractFactory::getRegistry();
+        const auto& types = AbstractFactory::getRegistry();
         auto p = types.find(name);
         if (p == types.end())
         {
@@ -136,7 +136,7 @@ namespace dap
     std::unique_ptr<BaseType> createProduct(const std::string& productName, Args&&... args)
     {
         using Factory = AbstractFactory<BaseType, Args&&...>;
-        return Factory::create(productName, std::forward<Args>(args)...);
+        return Factory::create(productName.c_str(), std::forward<Args>(args)...);
     }
 
     // dump Product names and its constructor arguments registered in the factory
@@ -2,6 +2,7 @@
 #define DAP_BASE_CONSTANTS_H
 
 #include <cmath>
+#include <cstddef>
 
 #define UNUSED_ARG(arg) (void)(arg);
 
@@ -12,6 +13,8 @@ namespace dap
     constexpr float HALF_PI     = float(M_PI) / 2.0f;
     constexpr float INV_HALF_PI = 1.0f / HALF_PI;
 
+    constexpr size_t CACHE_LINE_SIZE = 64;
+
 }
 
 #endif // DAP_BASE_CONSTANTS_H
@@ -2,6 +2,10 @@
 
 #ifdef __APPLE__
 #include <dispatch/dispatch.h>
+#elif __linux__
+#include <cerrno>
+#include <ctime>
+#include <semaphore.h>
 #endif
 
 using dap::Semaphore;
@@ -38,8 +42,54 @@ public:
             dispatch_semaphore_signal(m_sem);
     }
 };
+#elif __linux__
+class Semaphore::Impl
+{
+    sem_t m_sem;
+
+public:
+    explicit Impl(int initialValue)
+    {
+        sem_init(&m_sem, 0, static_cast<unsigned int>(initialValue));
+    }
+    Impl(const Impl&) =delete;
+    Impl(Impl&&) =delete;
+    ~Impl()
+    {
+        sem_destroy(&m_sem);
+    }
+    Impl& operator=(const Impl&) =delete;
+    Impl& operator=(Impl&&) =delete;
+    int64_t wait()
+    {
+        int result = 0;
+        while ((result = sem_wait(&m_sem)) != 0 && errno == EINTR)
+        {
+        }
+        return result;
+    }
+    // returns non-zero if the timeout elapsed, as dispatch_semaphore_wait does
+    int64_t wait(int64_t ns)
+    {
+        timespec deadline{};
+        clock_gettime(CLOCK_REALTIME, &deadline);
+        ns += deadline.tv_nsec;
+        deadline.tv_sec += static_cast<time_t>(ns / 1000000000);
+        deadline.tv_nsec = static_cast<long>(ns % 1000000000);
+        int result = 0;
+        while ((result = sem_timedwait(&m_sem, &deadline)) != 0 && errno == EINTR)
+        {
+        }
+        return result;
+    }
+    void signal(uint32_t count)
+    {
+        while ((count--) != 0)
+            sem_post(&m_sem);
+    }
+};
 #else
-#error "Semaphore not defined for other platforms than OSX"
+#error "Semaphore not defined for other platforms than OSX and Linux"
 #endif
 
 Semaphore::Semaphore(int initialValue)
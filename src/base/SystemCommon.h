@@ -1,13 +1,17 @@
 #ifndef DAP_BASE_SYSTEM_COMMON_H
 #define DAP_BASE_SYSTEM_COMMON_H
 
+#include <cstdint>
 #include <iostream>
 #include <memory>
 #include <sstream>
 #include <stdexcept>
 #include <thread>
 #include <type_traits> // std::is_same
+#if defined(__x86_64__) || defined(__i386__)
+#include <emmintrin.h> // _mm_pause
 #include <xmmintrin.h>
+#endif
 
 //#define thread_local __thread; // osx currently does not support c++11 thread_local keyword
 
@@ -20,7 +24,7 @@
 #include <sys/signal.h>
 
 // flush-to-zero denormals
-#ifndef _MM_DENORMALS_ZERO_MASK
+#if (defined(__x86_64__) || defined(__i386__)) && !defined(_MM_DENORMALS_ZERO_MASK)
 #define _MM_DENORMALS_ZERO_MASK 0x0040
 #define _MM_DENORMALS_ZERO_ON 0x0040
 #define _MM_DENORMALS_ZERO_OFF 0x0000
@@ -119,6 +123,27 @@ namespace dap
     {
         return std::thread::hardware_concurrency();
     }
+    // hint that the calling thread is spin waiting, other architectures than x86 yield instead
+    inline void spinPause()
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        _mm_pause();
+#else
+        std::this_thread::yield();
+#endif
+    }
+    // denormal floats are flushed to zero on the calling thread, on x86 and arm64
+    inline void flushDenormalsToZero()
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        _MM_SET_FLUSH_ZERO_MODE(_MM_FLUSH_ZERO_ON);
+        _MM_SET_DENORMALS_ZERO_MODE(_MM_DENORMALS_ZERO_ON);
+#elif defined(__aarch64__)
+        uint64_t fpcr = 0;
+        asm volatile("mrs %0, fpcr" : "=r"(fpcr));
+        asm volatile("msr fpcr, %0" : : "r"(fpcr | (uint64_t(1) << 24u))); // FZ
+#endif
+    }
 
     static inline void setRealtimePriority(std::thread* thread)
     {
@@ -146,6 +171,29 @@ namespace dap
 #endif
     }
 
+    // pins thread (or the calling thread if null) to the given core. On OSX cores cannot be
+    // pinned, the core is used as an affinity tag so threads with different tags are spread
+    static inline void setThreadAffinity(std::thread* thread, size_t core)
+    {
+#if __APPLE__
+        pthread_t inThread = thread ? thread->native_handle() : pthread_self(); // NOLINT
+        thread_affinity_policy_data_t policy = {static_cast<integer_t>(core + 1)};
+        thread_policy_set(pthread_mach_thread_np(inThread),
+                          THREAD_AFFINITY_POLICY,
+                          (thread_policy_t)&policy, // NOLINT
+                          THREAD_AFFINITY_POLICY_COUNT);
+#elif __linux__
+        pthread_t inThread = thread ? thread->native_handle() : pthread_self();
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        CPU_SET(core % CPU_SETSIZE, &cpus);
+        pthread_setaffinity_np(inThread, sizeof(cpu_set_t), &cpus);
+#else
+        (void)thread;
+        (void)core;
+#endif
+    }
+
 } // namespace dap
 
 #endif // DAP_BASE_SYSTEM_COMMON_H
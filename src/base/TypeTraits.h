@@ -11,6 +11,7 @@
 #include <tuple>
 #include <type_traits>
 #include <typeindex>
+#include <utility>
 #include <vector>
 
 #define DAP_REQUIRES_T(...) typename std::enable_if<(__VA_ARGS__), int>::type
@@ -110,6 +111,27 @@ namespace dap
     {
         return true;
     }
+    // packed SIMD types (e.g. fastmath::Pack) specialize lane_traits to be accepted where an
+    // arithmetic type is expected, each lane behaving as an independent scalar
+    template <typename T>
+    struct lane_traits
+    {
+        using scalar_type              = T;
+        static constexpr size_t size   = 1;
+        static constexpr bool is_packed = false;
+    };
+    template <typename T>
+    using lane_scalar_t = typename lane_traits<std::decay_t<T>>::scalar_type;
+    template <typename T>
+    constexpr bool isPacked()
+    {
+        return lane_traits<std::decay_t<T>>::is_packed;
+    }
+    template <typename T>
+    constexpr bool isArithmeticOrPacked()
+    {
+        return isArithmetic<T>() || isPacked<T>();
+    }
     template <typename, typename>
     constexpr bool isArithmeticOrComplex()
     {
@@ -125,6 +147,11 @@ namespace dap
     {
         return true;
     }
+    template <typename T, DAP_REQUIRES(isPacked<T>())>
+    constexpr bool isArithmeticOrComplex()
+    {
+        return isArithmetic<lane_scalar_t<T>>();
+    }
     template <class T = void>
     constexpr bool isStringConvertible()
     {
@@ -209,13 +236,16 @@ namespace dap
             }
         };
 
-        template <std::size_t N, std::size_t... Is>
-        struct make_sequence : make_sequence<N - 1, N - 1, Is...>
+        template <std::size_t... Is>
+        constexpr sequence<Is...> to_sequence(std::index_sequence<Is...> /*unused*/)
         {
-        };
+            return {};
+        }
 
-        template <std::size_t... Is>
-        struct make_sequence<0, Is...> : sequence<Is...>
+        // 0, ..., N - 1, generated by std::make_index_sequence without one template instantiation
+        // per index, so that arrays of thousands of values can be generated at compile time
+        template <std::size_t N>
+        struct make_sequence : decltype(to_sequence(std::make_index_sequence<N>{}))
         {
         };
 
@@ -1,9 +1,13 @@
 #ifndef DAP_CRTP_NODES_NODE_H
 #define DAP_CRTP_NODES_NODE_H
 
+#include "crtp/nodes/Profiling.h"
 #include "fastmath/Var.h"
+#include <algorithm>
+#include <array>
 #include <cassert>
 #include <memory>
+#include <ratio>
 #include <tuple>
 
 #define NODE_INPUT_NAMES(...) decltype(dap::crtp::make_input_names(__VA_ARGS__))
@@ -19,12 +23,28 @@ namespace dap
         class ValueNode;
         template <typename TInput>
         using ConstantNode = const dap::crtp::ValueNode<TInput>;
+        template <typename Ratio, typename T = float>
+        class StaticValueNode;
+        // compile time constant Num / Den, e.g. x * constant<1, 2>
+        template <intmax_t Num, intmax_t Den = 1>
+        using constant = StaticValueNode<std::ratio<Num, Den>>;
         template <typename Processor, typename Inputs, typename InputNames>
         class ProcessorNode;
         template <typename TInputs, typename... TInputNamesTuples>
         class SplitNode;
         template <typename TInputs, typename Op>
         class JoinNode;
+        enum class ControlInterpolation
+        {
+            None,
+            Linear
+        };
+        template <typename TInput, size_t Divisor, ControlInterpolation Interpolation>
+        class ControlRateNode;
+        template <typename TInput, typename TBody>
+        class SharedNode;
+        template <typename TInput>
+        class SharedInput;
 
         template <typename Processor, typename Inputs, typename... InputNames>
         auto make_processor_node(Processor&&, Inputs&&, InputNames&&...); // TODO: remove
@@ -59,6 +79,18 @@ namespace dap
             {
                 return std::is_base_of<crtp::Node, T>::value;
             }
+
+            // processors declaring `static constexpr bool audio_rate_only = true` must be
+            // evaluated on every sample
+            template <typename Processor, typename = void>
+            struct IsAudioRateProcessor : std::false_type
+            {
+            };
+            template <typename Processor>
+            struct IsAudioRateProcessor<Processor, std::void_t<decltype(Processor::audio_rate_only)>>
+            : std::integral_constant<bool, Processor::audio_rate_only>
+            {
+            };
         } // namespace traits
 
         // retrieves stored value depending on the type
@@ -97,6 +129,111 @@ namespace dap
 
         template <size_t N, typename TInputs>
         using inputs_element_t = tuple_element_t<N, typename TInputs::type>;
+
+        // maximum number of frames evaluated at once when processing blocks
+        using max_block_size_t = std::integral_constant<size_t, 64>;
+
+        namespace detail
+        {
+            template <typename T>
+            using block_t = std::array<std::decay_t<T>, max_block_size_t::value>;
+
+            // evaluates a node input into a block, plain values are passed through
+            template <typename T, DAP_REQUIRES(!traits::IsCrtpNode<T>::value)>
+            inline auto pullBlock(T& value, size_t)
+            {
+                return dispatch(value);
+            }
+            template <typename T, DAP_REQUIRES(traits::IsCrtpNode<T>::value)>
+            inline auto pullBlock(T& node, size_t frames)
+            {
+                block_t<decltype(node())> block;
+                node.processBlock(block.data(), frames);
+                return block;
+            }
+            // a node held through a pointer is rendered once per input pointing at it: by block
+            // each such input pulls its own block, i.e. consecutive blocks, while per sample the
+            // reads interleave. A stateful node read twice, e.g. MultiplyNode<Osc*, Osc*>, thus
+            // renders differently by block than per sample, SharedNode reads it once instead
+            template <typename T, DAP_REQUIRES(traits::IsCrtpNode<T>::value)>
+            inline auto pullBlock(T* node, size_t frames)
+            {
+                return pullBlock(node->self(), frames);
+            }
+
+            // n-th sample of a pulled block
+            template <typename T, size_t N>
+            inline T sampleAt(const std::array<T, N>& block, size_t n)
+            {
+                return block[n];
+            }
+            template <typename T>
+            inline T sampleAt(const T& value, size_t)
+            {
+                return value;
+            }
+
+            // argument given to block overloads of processors: pointer to blocks, plain values
+            template <typename T, size_t N>
+            inline const T* blockArg(const std::array<T, N>& block)
+            {
+                return block.data();
+            }
+            template <typename T>
+            inline const T& blockArg(const T& value)
+            {
+                return value;
+            }
+
+            // true if Processor implements process(Out* out, size_t frames, inputs...)
+            template <typename Processor, typename Out, typename Blocks, typename = void>
+            struct HasBlockProcess : std::false_type
+            {
+            };
+            template <typename Processor, typename Out, typename... Blocks>
+            struct HasBlockProcess<
+                Processor,
+                Out,
+                std::tuple<Blocks...>,
+                std::void_t<decltype(std::declval<Processor&>().process(
+                    std::declval<Out*>(), size_t{}, blockArg(std::declval<const Blocks&>())...))>>
+            : std::true_type
+            {
+            };
+
+            // true if Processor implements reset(), processors holding state should
+            template <typename Processor, typename = void>
+            struct HasReset : std::false_type
+            {
+            };
+            template <typename Processor>
+            struct HasReset<Processor, std::void_t<decltype(std::declval<Processor&>().reset())>>
+            : std::true_type
+            {
+            };
+
+            // calls the processor block overload process(out, frames, inputs...) if available,
+            // or the scalar one for each frame otherwise
+            template <typename Processor, typename T, typename Blocks, size_t... Is>
+            inline void processBlocks(Processor& processor,
+                                      T* out,
+                                      size_t frames,
+                                      const Blocks& blocks,
+                                      const std::index_sequence<Is...>&)
+            {
+                if constexpr (HasBlockProcess<Processor, T, Blocks>::value)
+                {
+                    processor.process(out, frames, blockArg(std::get<Is>(blocks))...);
+                }
+                else
+                {
+                    for (size_t n = 0; n < frames; ++n)
+                    {
+                        out[n] = processor(sampleAt(std::get<Is>(blocks), n)...);
+                    }
+                }
+            }
+        }
     }
 }
 
@@ -184,6 +321,30 @@ public:
     {
         return self()();
     }
+    // renders frames samples into out, evaluating the graph in blocks of max_block_size_t
+    template <typename T>
+    void process(T* out, size_t frames)
+    {
+        for (size_t offset = 0; offset < frames; offset += max_block_size_t::value)
+        {
+            self().processBlock(out + offset, std::min(frames - offset, max_block_size_t::value));
+        }
+    }
+    // evaluates up to max_block_size_t frames, nodes with a block implementation hide this one
+    template <typename T>
+    void processBlock(T* out, size_t frames)
+    {
+        assert(frames <= max_block_size_t::value);
+        for (size_t n = 0; n < frames; ++n)
+        {
+            out[n] = self()();
+        }
+    }
+    // brings the node's own state back to its initial value, inputs and parameters are left
+    // untouched. Use resetState(node) to reset a whole graph
+    void resetState()
+    {
+    }
     // conversion operator (i.e. int(), float(), etc)
     template <typename T>
     operator T()
@@ -200,12 +361,12 @@ class dap::crtp::ValueNode : public NodeExpression<ValueNode<TInput>, Node::Inpu
 
 public:
     ValueNode() = default;
-    template <typename T, DAP_REQUIRES(isArithmetic<T>())>
+    template <typename T, DAP_REQUIRES(isArithmeticOrPacked<T>())>
     ValueNode(const T& t)
     {
         base_type::template input<0>() = t;
     }
-    template <typename T, DAP_REQUIRES(isArithmetic<T>())>
+    template <typename T, DAP_REQUIRES(isArithmeticOrPacked<T>())>
     ValueNode(T&& t)
     {
         base_type::template input<0>() = TInput(std::forward<T>(t));
@@ -231,13 +392,13 @@ public:
     {
     }
     ~ValueNode() = default;
-    template <typename T, DAP_REQUIRES(isArithmetic<T>())>
+    template <typename T, DAP_REQUIRES(isArithmeticOrPacked<T>())>
     ValueNode& operator=(const T& x)
     {
         base_type::template input<0>() = x;
         return *this;
     }
-    template <typename T, DAP_REQUIRES(isArithmetic<T>())>
+    template <typename T, DAP_REQUIRES(isArithmeticOrPacked<T>())>
     ValueNode& operator=(T&& x)
     {
         base_type::template input<0>() = TInput(std::forward<T>(x));
@@ -271,20 +432,72 @@ public:
     {
         return base_type::template input<0>();
     }
+    template <typename T>
+    void processBlock(T* out, size_t frames)
+    {
+        std::fill(out, out + frames, base_type::template input<0>());
+    }
+};
+
+// constant known at compile time, expressions using it are simplified when built, e.g.
+// x * constant<1>() is x, see private/SimplifyNodeOpsImpl.hpp
+template <typename Ratio, typename T>
+class dap::crtp::StaticValueNode
+: public NodeExpression<StaticValueNode<Ratio, T>, Node::Inputs<>>
+{
+public:
+    using ratio = Ratio;
+    static constexpr T value() noexcept
+    {
+        return T(Ratio::num) / T(Ratio::den);
+    }
+    static constexpr auto inputNames()
+    {
+        return std::tuple<>{};
+    }
+    constexpr auto operator()() const
+    {
+        return value();
+    }
+    template <typename U>
+    void processBlock(U* out, size_t frames)
+    {
+        std::fill(out, out + frames, value());
+    }
 };
 
 template <typename Processor, typename Inputs, typename InputNames>
 class dap::crtp::ProcessorNode
-: public NodeExpression<ProcessorNode<Processor, Inputs, InputNames>, Inputs>
+: public NodeExpression<ProcessorNode<Processor, Inputs, InputNames>, Inputs>,
+  public node_profiler_t<Processor>
 {
     static_assert(isTuple(InputNames{}), "InputNames must be a tuple");
-    using base_type = NodeExpression<ProcessorNode<Processor, Inputs, InputNames>, Inputs>;
+    using base_type     = NodeExpression<ProcessorNode<Processor, Inputs, InputNames>, Inputs>;
+    using profiler_type = node_profiler_t<Processor>;
     Processor m_processor;
 
     template <size_t... Is>
     inline auto callProcessor(const std::index_sequence<Is...>&)
     {
-        return m_processor(dispatch(std::get<Is>(base_type::m_inputs))...);
+        if constexpr (profiler_type::profiled)
+        {
+            // inputs are evaluated first so they are not accounted to this node
+            auto args = std::make_tuple(dispatch(std::get<Is>(base_type::m_inputs))...);
+            const typename profiler_type::Scope scope(*this, 1);
+            return m_processor(std::get<Is>(args)...);
+        }
+        else
+        {
+            return m_processor(dispatch(std::get<Is>(base_type::m_inputs))...);
+        }
+    }
+    template <typename T, size_t... Is>
+    inline void processBlock(T* out, size_t frames, const std::index_sequence<Is...>& indices)
+    {
+        const auto blocks =
+            std::make_tuple(detail::pullBlock(std::get<Is>(base_type::m_inputs), frames)...);
+        const typename profiler_type::Scope scope(*this, frames);
+        detail::processBlocks(m_processor, out, frames, blocks, indices);
     }
 
 public:
@@ -303,11 +516,36 @@ public:
     {
         return InputNames{};
     }
+    // the processor itself, e.g. to configure it at graph construction
+    Processor& processor()
+    {
+        return m_processor;
+    }
+    const Processor& processor() const
+    {
+        return m_processor;
+    }
+    void resetState()
+    {
+        if constexpr (detail::HasReset<Processor>::value)
+        {
+            m_processor.reset();
+        }
+    }
     auto operator()()
     {
         static constexpr auto indices = std::make_index_sequence<base_type::inputCount()>{};
         return callProcessor(indices);
     }
+    // pulls a block from every input node, then calls the processor block overload
+    // process(out, frames, inputs...) if available, or the scalar one for each frame otherwise
+    template <typename T>
+    void processBlock(T* out, size_t frames)
+    {
+        assert(frames <= max_block_size_t::value);
+        static constexpr auto indices = std::make_index_sequence<base_type::inputCount()>{};
+        processBlock(out, frames, indices);
+    }
 };
 
 namespace dap
@@ -400,6 +638,18 @@ public:
         constexpr static auto indices = std::make_index_sequence<branchCount>{};
         return split(dispatch(base_type::template input<0>()), indices);
     }
+    // the source is pulled as a block, branches are fed sample by sample
+    template <typename T>
+    void processBlock(T* out, size_t frames)
+    {
+        assert(frames <= max_block_size_t::value);
+        constexpr static auto indices = std::make_index_sequence<branchCount>{};
+        const auto source = detail::pullBlock(base_type::template input<0>(), frames);
+        for (size_t n = 0; n < frames; ++n)
+        {
+            out[n] = split(detail::sampleAt(source, n), indices);
+        }
+    }
 };
 
 // joins SplitNodes and applies Op to each branch
@@ -424,6 +674,16 @@ class dap::crtp::JoinNode : public NodeExpression<JoinNode<TInputs, Op>, TInputs
     {
         return join(dispatch(std::get<Is>(base_type::m_inputs))...);
     }
+    template <typename T, size_t... Is>
+    inline void joinBlock(T* out, size_t frames, const std::index_sequence<Is...>&)
+    {
+        auto blocks =
+            std::make_tuple(detail::pullBlock(std::get<Is>(base_type::m_inputs), frames)...);
+        for (size_t n = 0; n < frames; ++n)
+        {
+            out[n] = join(detail::sampleAt(std::get<Is>(blocks), n)...);
+        }
+    }
     static constexpr auto indices()
     {
         return std::make_index_sequence<base_type::inputCount()>{};
@@ -439,6 +699,424 @@ public:
         static constexpr auto is = indices();
         return join(is);
     }
+    template <typename T>
+    void processBlock(T* out, size_t frames)
+    {
+        assert(frames <= max_block_size_t::value);
+        static constexpr auto is = indices();
+        joinBlock(out, frames, is);
+    }
+};
+
+namespace dap
+{
+    namespace crtp
+    {
+        namespace traits
+        {
+            // true if a node, or any node feeding it, is an audio rate only processor
+            template <typename T>
+            struct IsAudioRate : std::false_type
+            {
+            };
+            template <typename T>
+            struct IsAudioRate<T*> : IsAudioRate<T>
+            {
+            };
+            template <typename Processor, typename... Is, typename InputNames>
+            struct IsAudioRate<ProcessorNode<Processor, Node::Inputs<Is...>, InputNames>>
+            : std::integral_constant<bool,
+                                     IsAudioRateProcessor<Processor>::value ||
+                                         any(false, IsAudioRate<Is>::value...)>
+            {
+            };
+            template <typename... Is, typename... TInputNamesTuples>
+            struct IsAudioRate<SplitNode<Node::Inputs<Is...>, TInputNamesTuples...>>
+            : std::integral_constant<bool, any(false, IsAudioRate<Is>::value...)>
+            {
+            };
+            template <typename... Is, typename Op>
+            struct IsAudioRate<JoinNode<Node::Inputs<Is...>, Op>>
+            : std::integral_constant<bool, any(false, IsAudioRate<Is>::value...)>
+            {
+            };
+            template <typename TInput, typename TBody>
+            struct IsAudioRate<SharedNode<TInput, TBody>>
+            : std::integral_constant<bool, IsAudioRate<TInput>::value || IsAudioRate<TBody>::value>
+            {
+            };
+            template <typename TInput>
+            struct IsAudioRate<SharedInput<TInput>> : IsAudioRate<TInput>
+            {
+            };
+        }
+    }
+}
+
+// evaluates its input once every Divisor samples and holds or linearly interpolates the result
+// in between, so the input subtree runs at samplerate / Divisor. Input lookups by name are
+// forwarded to the input node, so wrapping a node does not change its parameter paths.
+template <typename TInput, size_t Divisor, dap::crtp::ControlInterpolation Interpolation>
+class dap::crtp::ControlRateNode
+: public NodeExpression<ControlRateNode<TInput, Divisor, Interpolation>, Node::Inputs<TInput>>
+{
+    static_assert(Divisor > 0, "Divisor must be greater than zero");
+    static_assert(!traits::IsAudioRate<TInput>::value,
+                  "an audio rate only processor cannot be evaluated at control rate");
+    using base_type =
+        NodeExpression<ControlRateNode<TInput, Divisor, Interpolation>, Node::Inputs<TInput>>;
+    using value_type = std::decay_t<decltype(dispatch(std::declval<TInput&>()))>;
+
+    value_type m_value{0};
+    value_type m_step{0};
+    size_t m_counter{0};
+
+    inline void update(const value_type target)
+    {
+        if constexpr (Interpolation == ControlInterpolation::Linear)
+        {
+            // reaches target after Divisor samples
+            m_step = (target - m_value) / value_type(Divisor);
+        }
+        else
+        {
+            m_value = target;
+        }
+    }
+    // renders frames samples, input() giving the value of the input at each update
+    template <typename T, typename Fn>
+    void render(T* out, size_t frames, Fn&& input)
+    {
+        size_t n = 0;
+        while (n < frames)
+        {
+            if (m_counter == 0)
+            {
+                update(input());
+            }
+            const size_t run = std::min(frames - n, Divisor - m_counter);
+            if constexpr (Interpolation == ControlInterpolation::Linear)
+            {
+                // a local, as out may alias the members as far as the compiler knows
+                value_type value = m_value;
+                for (size_t i = 0; i < run; ++i)
+                {
+                    value += m_step;
+                    out[n + i] = value;
+                }
+                m_value = value;
+            }
+            else
+            {
+                std::fill(out + n, out + n + run, m_value);
+            }
+            n += run;
+            m_counter = (m_counter + run) % Divisor;
+        }
+    }
+
+public:
+    using base_type::input;
+
+    static constexpr size_t divisor()
+    {
+        return Divisor;
+    }
+    static constexpr auto inputNames()
+    {
+        return make_input_names("source"_s);
+    }
+    template <char... Chars>
+    constexpr auto& input(constexpr_string<Chars...> name)
+    {
+        return base_type::template input<0>().input(name);
+    }
+    void resetState()
+    {
+        m_value   = value_type(0);
+        m_step    = value_type(0);
+        m_counter = 0;
+    }
+    auto operator()()
+    {
+        if (m_counter == 0)
+        {
+            update(dispatch(base_type::template input<0>()));
+        }
+        if (++m_counter == Divisor)
+        {
+            m_counter = 0;
+        }
+        if constexpr (Interpolation == ControlInterpolation::Linear)
+        {
+            m_value += m_step;
+        }
+        return m_value;
+    }
+    // number of times the input is evaluated over the next frames samples
+    size_t ticks(size_t frames) const
+    {
+        const size_t first = (Divisor - m_counter) % Divisor;
+        return first < frames ? (frames - first - 1) / Divisor + 1 : 0;
+    }
+    template <typename T>
+    void processBlock(T* out, size_t frames)
+    {
+        render(out, frames, [this]() { return dispatch(base_type::template input<0>()); });
+    }
+    // renders as processBlock, the input values being read from ticks(frames) values rendered
+    // beforehand, e.g. by a StaticSchedule
+    template <typename T, typename V>
+    void processBlock(T* out, size_t frames, const V* ticks)
+    {
+        render(out, frames, [&ticks]() { return value_type(*ticks++); });
+    }
+};
+
+namespace dap
+{
+    namespace crtp
+    {
+        namespace detail
+        {
+            // output of the source of a SharedNode, read by its SharedInputs
+            template <typename TInput>
+            struct SharedCache
+            {
+                using value_type = std::decay_t<decltype(dispatch(std::declval<TInput&>()))>;
+
+                value_type value{0};
+                block_t<value_type> block{};
+            };
+
+            // true if the node renders each of its inputs by block when rendered by block
+            template <typename T>
+            struct RendersInputsByBlock : std::false_type
+            {
+            };
+            template <typename Processor, typename Inputs, typename InputNames>
+            struct RendersInputsByBlock<ProcessorNode<Processor, Inputs, InputNames>>
+            : std::true_type
+            {
+            };
+            template <typename TInputs, typename Op>
+            struct RendersInputsByBlock<JoinNode<TInputs, Op>> : std::true_type
+            {
+            };
+            template <typename TInput, typename TBody>
+            struct RendersInputsByBlock<SharedNode<TInput, TBody>>
+            : std::integral_constant<bool, SharedNode<TInput, TBody>::byBlock()>
+            {
+            };
+
+            template <typename T>
+            struct IsSplitNode : std::false_type
+            {
+            };
+            template <typename TInputs, typename... TInputNamesTuples>
+            struct IsSplitNode<SplitNode<TInputs, TInputNamesTuples...>> : std::true_type
+            {
+            };
+
+            template <typename TInput, typename T>
+            struct IsSharedNodeOf : std::false_type
+            {
+            };
+            template <typename TInput, typename TBody>
+            struct IsSharedNodeOf<TInput, SharedNode<TInput, TBody>> : std::true_type
+            {
+            };
+
+            // number of SharedInput<TInput> held by T, those of a nested SharedNode of the same
+            // source excluded as they read it
+            template <typename TInput, typename T>
+            constexpr size_t sharedReaders();
+            template <typename TInput, typename... Is>
+            constexpr size_t sharedReadersOf(const std::tuple<Is...>*)
+            {
+                return (size_t(0) + ... + sharedReaders<TInput, Is>());
+            }
+            template <typename TInput, typename T>
+            constexpr size_t sharedReaders()
+            {
+                using node_t = std::remove_cv_t<T>;
+                if constexpr (std::is_same<node_t, SharedInput<TInput>>::value)
+                {
+                    return 1;
+                }
+                else if constexpr (!traits::IsCrtpNode<node_t>::value ||
+                                   IsSharedNodeOf<TInput, node_t>::value)
+                {
+                    return 0;
+                }
+                else
+                {
+                    using inputs_t = typename node_t::input_type;
+                    return sharedReadersOf<TInput>(static_cast<const inputs_t*>(nullptr));
+                }
+            }
+
+            // true if every SharedInput<TInput> held by T is rendered by block when T is, i.e.
+            // none is below a node evaluating its inputs per sample, as a ControlRateNode or
+            // the branches of a SplitNode
+            template <typename TInput, typename T>
+            constexpr bool sharedReadByBlock();
+            template <typename TInput, typename... Is>
+            constexpr bool sharedReadByBlockOf(const std::tuple<Is...>*)
+            {
+                return (true && ... && sharedReadByBlock<TInput, Is>());
+            }
+            template <typename TInput, typename T>
+            constexpr bool sharedReadByBlock()
+            {
+                using node_t = std::remove_cv_t<T>;
+                if constexpr (sharedReaders<TInput, node_t>() == 0 ||
+                              std::is_same<node_t, SharedInput<TInput>>::value)
+                {
+                    return true;
+                }
+                else if constexpr (RendersInputsByBlock<node_t>::value)
+                {
+                    using inputs_t = typename node_t::input_type;
+                    return sharedReadByBlockOf<TInput>(static_cast<const inputs_t*>(nullptr));
+                }
+                else if constexpr (IsSplitNode<node_t>::value)
+                {
+                    // the source is pulled by block, branches are fed sample by sample
+                    using source_t = tuple_element_t<0, typename node_t::input_type>;
+                    return sharedReaders<TInput, source_t>() == sharedReaders<TInput, node_t>() &&
+                           sharedReadByBlock<TInput, source_t>();
+                }
+                else
+                {
+                    return false;
+                }
+            }
+        }
+    }
+}
+
+// evaluates its source, then its body, whose SharedInput<TInput> nodes all read the output of the
+// source, which is thus evaluated once for any number of consumers. The readers are found in the
+// type of the body, nested SharedNodes of the same source type reading their own. The source is
+// rendered by block when the body is, unless a reader is evaluated per sample within a block (e.g.
+// below a ControlRateNode), the whole node being then evaluated sample by sample. Copies bind the
+// readers of their body to themselves, and visitors see the source once, as input "source".
+template <typename TInput, typename TBody>
+class dap::crtp::SharedNode
+: public NodeExpression<SharedNode<TInput, TBody>, Node::Inputs<TInput, TBody>>
+{
+    static_assert(traits::IsCrtpNode<TInput>::value, "only nodes can be shared");
+    static_assert(detail::sharedReaders<TInput, TBody>() > 0, "the body must read the source");
+    using base_type = NodeExpression<SharedNode<TInput, TBody>, Node::Inputs<TInput, TBody>>;
+
+    detail::SharedCache<TInput> m_cache;
+
+    template <typename T>
+    void bind(T& node)
+    {
+        using node_t = std::remove_cv_t<T>;
+        if constexpr (std::is_same<node_t, SharedInput<TInput>>::value)
+        {
+            node.m_cache = &m_cache;
+        }
+        else if constexpr (detail::sharedReaders<TInput, node_t>() > 0)
+        {
+            for_each(node.inputs(), [this](auto& input) { bind(input); });
+        }
+    }
+    void bind()
+    {
+        bind(base_type::template input<1>());
+    }
+
+public:
+    SharedNode()
+    {
+        bind();
+    }
+    SharedNode(const SharedNode& other)
+    : base_type(other)
+    {
+        bind();
+    }
+    SharedNode(SharedNode&& other) noexcept
+    : base_type(std::move(other))
+    {
+        bind();
+    }
+    ~SharedNode() = default;
+    SharedNode& operator=(const SharedNode& other)
+    {
+        base_type::operator=(other);
+        bind();
+        return *this;
+    }
+    SharedNode& operator=(SharedNode&& other) noexcept
+    {
+        base_type::operator=(std::move(other));
+        bind();
+        return *this;
+    }
+
+    static constexpr size_t readers()
+    {
+        return detail::sharedReaders<TInput, TBody>();
+    }
+    static constexpr bool byBlock()
+    {
+        return detail::sharedReadByBlock<TInput, TBody>();
+    }
+    static constexpr auto inputNames()
+    {
+        return make_input_names("source"_s, "body"_s);
+    }
+    auto operator()()
+    {
+        m_cache.value = dispatch(base_type::template input<0>());
+        return dispatch(base_type::template input<1>());
+    }
+    template <typename T>
+    void processBlock(T* out, size_t frames)
+    {
+        assert(frames <= max_block_size_t::value);
+        if constexpr (byBlock())
+        {
+            base_type::template input<0>().processBlock(m_cache.block.data(), frames);
+            base_type::template input<1>().processBlock(out, frames);
+        }
+        else
+        {
+            base_type::processBlock(out, frames);
+        }
+    }
+};
+
+// reads the source of the SharedNode holding it in its body, it has no inputs
+template <typename TInput>
+class dap::crtp::SharedInput : public NodeExpression<SharedInput<TInput>, Node::Inputs<>>
+{
+    template <typename, typename>
+    friend class SharedNode;
+
+    const detail::SharedCache<TInput>* m_cache{nullptr};
+
+public:
+    static constexpr auto inputNames()
+    {
+        return std::tuple<>{};
+    }
+    auto operator()()
+    {
+        assert(m_cache != nullptr && "SharedInput outside of a SharedNode");
+        return m_cache->value;
+    }
+    template <typename T>
+    void processBlock(T* out, size_t frames)
+    {
+        assert(m_cache != nullptr && "SharedInput outside of a SharedNode");
+        std::copy(m_cache->block.begin(), m_cache->block.begin() + frames, out);
+    }
 };
 
 template <typename Processor, typename Inputs, typename... InputNames>
@@ -449,5 +1127,6 @@ auto dap::crtp::make_processor_node(Processor&&, Inputs&&, InputNames&&...)
 
 #include "private/BinaryNodeOpsImpl.hpp"
 #include "private/UnaryNodeOpsImpl.hpp"
+#include "private/SimplifyNodeOpsImpl.hpp"
 
 #endif // DAP_CRTP_NODE_NODE_H
@@ -0,0 +1,153 @@
+#ifndef DAP_CRTP_NODES_OPTIMIZER_H
+#define DAP_CRTP_NODES_OPTIMIZER_H
+
+#include "crtp/nodes/Node.h"
+#include "crtp/nodes/Parallel.h"
+#include <ostream>
+
+namespace dap
+{
+    namespace crtp
+    {
+        // returns a copy of node whose arithmetic subexpressions are rebuilt with the rewriting
+        // rules of private/SimplifyNodeOpsImpl.hpp. Inputs, parameters and processors, with their
+        // configuration and state, are copied, control rate nodes restart their interpolation.
+        template <typename T>
+        auto optimize(const T& node);
+
+        template <typename T>
+        using optimize_t = decltype(optimize(std::declval<const T&>()));
+
+        // number of nodes owned by a graph, including the root
+        template <typename T>
+        constexpr size_t nodeCount();
+
+        template <typename Graph>
+        struct OptimizationReport;
+
+        namespace detail
+        {
+            template <typename T>
+            struct IsArithmeticNode : std::false_type
+            {
+            };
+            template <typename Fn, typename L, typename R, typename InputNames>
+            struct IsArithmeticNode<ProcessorNode<Fn, Node::Inputs<L, R>, InputNames>>
+            : std::integral_constant<bool,
+                                     std::is_same<Fn, Add>::value ||
+                                         std::is_same<Fn, Subtract>::value ||
+                                         std::is_same<Fn, Multiply>::value ||
+                                         std::is_same<Fn, Divide>::value>
+            {
+                using fn = Fn;
+            };
+
+            template <typename T>
+            struct IsRebuildable : std::false_type
+            {
+            };
+            template <typename Processor, typename... Is, typename InputNames>
+            struct IsRebuildable<ProcessorNode<Processor, Node::Inputs<Is...>, InputNames>>
+            : std::true_type
+            {
+                using type = ProcessorNode<Processor, Node::Inputs<optimize_t<Is>...>, InputNames>;
+            };
+            template <typename Processor, typename... Is, typename InputNames>
+            struct IsRebuildable<ParallelNode<Processor, Node::Inputs<Is...>, InputNames>>
+            : std::true_type
+            {
+                using type = ParallelNode<Processor, Node::Inputs<optimize_t<Is>...>, InputNames>;
+            };
+            template <typename TInput, size_t Divisor, ControlInterpolation Interpolation>
+            struct IsRebuildable<ControlRateNode<TInput, Divisor, Interpolation>> : std::true_type
+            {
+                using type = ControlRateNode<optimize_t<TInput>, Divisor, Interpolation>;
+            };
+
+            template <typename T, typename = void>
+            struct HasProcessor : std::false_type
+            {
+            };
+            template <typename T>
+            struct HasProcessor<T, std::void_t<decltype(std::declval<const T&>().processor())>>
+            : std::true_type
+            {
+            };
+
+            template <typename T, size_t... Is>
+            auto rebuild(const T& node, const std::index_sequence<Is...>&)
+            {
+                typename IsRebuildable<T>::type optimized;
+                std::forward_as_tuple(optimized.template input<Is>()...) =
+                    std::forward_as_tuple(optimize(node.template input<Is>())...);
+                if constexpr (HasProcessor<T>::value)
+                {
+                    optimized.processor() = node.processor();
+                }
+                if constexpr (traits::IsParallelNode<T>::value)
+                {
+                    optimized.setWorkerPool(node.workerPool());
+                }
+                return optimized;
+            }
+
+            template <typename T, size_t... Is>
+            constexpr size_t inputNodeCount(const std::index_sequence<Is...>&)
+            {
+                return (size_t(0) + ... +
+                        nodeCount<
+                            std::remove_const_t<tuple_element_t<Is, typename T::input_type>>>());
+            }
+        }
+    }
+}
+
+template <typename T>
+auto dap::crtp::optimize(const T& node)
+{
+    if constexpr (detail::IsArithmeticNode<T>::value)
+    {
+        using fn_t = typename detail::IsArithmeticNode<T>::fn;
+        return detail::Simplify<fn_t>::apply(optimize(node.template input<0>()),
+                                             optimize(node.template input<1>()));
+    }
+    else if constexpr (detail::IsRebuildable<T>::value)
+    {
+        return detail::rebuild(node, std::make_index_sequence<T::inputCount()>{});
+    }
+    else
+    {
+        return node;
+    }
+}
+
+template <typename T>
+constexpr size_t dap::crtp::nodeCount()
+{
+    if constexpr (traits::IsCrtpNode<T>::value)
+    {
+        return 1 + detail::inputNodeCount<T>(
+                       std::make_index_sequence<std::tuple_size<typename T::input_type>::value>{});
+    }
+    else
+    {
+        return 0;
+    }
+}
+
+// number of nodes optimize would eliminate from Graph
+template <typename Graph>
+struct dap::crtp::OptimizationReport
+{
+    static constexpr size_t nodes          = nodeCount<Graph>();
+    static constexpr size_t optimizedNodes = nodeCount<optimize_t<Graph>>();
+    static constexpr size_t eliminated     = nodes - optimizedNodes;
+
+    friend std::ostream& operator<<(std::ostream& out, const OptimizationReport&)
+    {
+        return out << "nodes: " << nodes << ", after optimization: " << optimizedNodes
+                   << ", eliminated: " << eliminated;
+    }
+};
+
+#endif // DAP_CRTP_NODES_OPTIMIZER_H
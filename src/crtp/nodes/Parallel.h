@@ -0,0 +1,185 @@
+#ifndef DAP_CRTP_NODES_PARALLEL_H
+#define DAP_CRTP_NODES_PARALLEL_H
+
+#include "crtp/nodes/Node.h"
+#include "threadsafe/WorkerPool.h"
+
+namespace dap
+{
+    namespace crtp
+    {
+        template <typename Processor, typename Inputs, typename InputNames>
+        class ParallelNode;
+
+        namespace detail
+        {
+            template <typename TNode>
+            struct MakeParallel;
+            template <typename Processor, typename Inputs, typename InputNames>
+            struct MakeParallel<ProcessorNode<Processor, Inputs, InputNames>>
+            {
+                using type = ParallelNode<Processor, Inputs, InputNames>;
+            };
+        }
+
+        // turns a processor node into one evaluating its inputs concurrently, e.g.
+        // parallel_join<decltype(processor<Mixer>::with_inputs<...>::prefixed_by("bus_"_s))>
+        template <typename TProcessorNode>
+        using parallel_join = typename detail::MakeParallel<TProcessorNode>::type;
+
+        namespace detail
+        {
+            template <typename Processor, typename Inputs, typename InputNames>
+            struct RendersInputsByBlock<ParallelNode<Processor, Inputs, InputNames>>
+            : std::true_type
+            {
+            };
+        }
+
+        namespace traits
+        {
+            template <typename T>
+            struct IsParallelNode : std::false_type
+            {
+            };
+            template <typename Processor, typename Inputs, typename InputNames>
+            struct IsParallelNode<ParallelNode<Processor, Inputs, InputNames>> : std::true_type
+            {
+            };
+            template <typename Processor, typename... Is, typename InputNames>
+            struct IsAudioRate<ParallelNode<Processor, Node::Inputs<Is...>, InputNames>>
+            : IsAudioRate<ProcessorNode<Processor, Node::Inputs<Is...>, InputNames>>
+            {
+            };
+        }
+    }
+}
+
+// ProcessorNode whose input blocks are rendered concurrently on a WorkerPool, the processor is
+// called once all of them are done. Inputs must be independent, i.e. not share any node. Without
+// a pool, or when evaluated per sample, inputs are evaluated serially as in ProcessorNode.
+template <typename Processor, typename Inputs, typename InputNames>
+class dap::crtp::ParallelNode
+: public NodeExpression<ParallelNode<Processor, Inputs, InputNames>, Inputs>,
+  public node_profiler_t<Processor>
+{
+    static_assert(isTuple(InputNames{}), "InputNames must be a tuple");
+    using base_type     = NodeExpression<ParallelNode<Processor, Inputs, InputNames>, Inputs>;
+    using profiler_type = node_profiler_t<Processor>;
+    using pool_t        = threadsafe::WorkerPool;
+
+    static constexpr auto indices()
+    {
+        return std::make_index_sequence<base_type::inputCount()>{};
+    }
+    template <size_t... Is>
+    static auto makeBlocks(const std::index_sequence<Is...>&)
+        -> std::tuple<std::decay_t<decltype(detail::pullBlock(
+            std::declval<typename Inputs::template type_of<Is>&>(), size_t{}))>...>;
+    using blocks_t = decltype(makeBlocks(indices()));
+
+    Processor m_processor;
+    blocks_t m_blocks;
+    pool_t* m_pool{nullptr};
+    size_t m_frames{0};
+
+    template <size_t I>
+    static void pullInput(void* context)
+    {
+        auto& node = *static_cast<ParallelNode*>(context);
+        std::get<I>(node.m_blocks) =
+            detail::pullBlock(std::get<I>(node.m_inputs), node.m_frames);
+    }
+    template <size_t... Is>
+    inline auto callProcessor(const std::index_sequence<Is...>&)
+    {
+        if constexpr (profiler_type::profiled)
+        {
+            auto args = std::make_tuple(dispatch(std::get<Is>(base_type::m_inputs))...);
+            const typename profiler_type::Scope scope(*this, 1);
+            return m_processor(std::get<Is>(args)...);
+        }
+        else
+        {
+            return m_processor(dispatch(std::get<Is>(base_type::m_inputs))...);
+        }
+    }
+    template <typename T, size_t... Is>
+    inline void processBlock(T* out, size_t frames, const std::index_sequence<Is...>& is)
+    {
+        const std::array<pool_t::Task, sizeof...(Is)> tasks{{{&pullInput<Is>, this}...}};
+        m_frames = frames;
+        if (m_pool != nullptr)
+        {
+            m_pool->run(tasks.data(), tasks.size());
+        }
+        else
+        {
+            for (const auto& task : tasks)
+            {
+                task.function(task.context);
+            }
+        }
+        const typename profiler_type::Scope scope(*this, frames);
+        detail::processBlocks(m_processor, out, frames, m_blocks, is);
+    }
+
+public:
+    ParallelNode() = default;
+    template <typename... Ts>
+    ParallelNode(const Ts&... inputs)
+    {
+        base_type::m_inputs = std::forward_as_tuple(inputs...);
+    }
+    template <typename... Ts>
+    ParallelNode(Ts&&... inputs)
+    {
+        base_type::m_inputs = std::forward_as_tuple(inputs...);
+    }
+    static constexpr auto inputNames()
+    {
+        return InputNames{};
+    }
+    // the pool is not owned and must outlive the node, nullptr evaluates inputs serially. A
+    // ParallelNode nested in the inputs of another one renders on a worker of the outer pool, it
+    // must not share that pool since WorkerPool::run is called from a single thread, see
+    // crtp::setWorkerPool
+    void setWorkerPool(pool_t* pool)
+    {
+        m_pool = pool;
+    }
+    pool_t* workerPool() const
+    {
+        return m_pool;
+    }
+    // the processor itself, e.g. to configure it at graph construction
+    Processor& processor()
+    {
+        return m_processor;
+    }
+    const Processor& processor() const
+    {
+        return m_processor;
+    }
+    void resetState()
+    {
+        if constexpr (detail::HasReset<Processor>::value)
+        {
+            m_processor.reset();
+        }
+    }
+    auto operator()()
+    {
+        static constexpr auto is = indices();
+        return callProcessor(is);
+    }
+    template <typename T>
+    void processBlock(T* out, size_t frames)
+    {
+        assert(frames <= max_block_size_t::value);
+        static constexpr auto is = indices();
+        processBlock(out, frames, is);
+    }
+};
+
+#endif // DAP_CRTP_NODES_PARALLEL_H
@@ -32,6 +32,13 @@ namespace dap
                 }
             };
         };
+
+        // input tag evaluating TInput every Divisor samples, e.g.
+        // processor<P>::with_inputs<control_rate<control_t, 16>, ...>
+        template <typename TInput,
+                  size_t Divisor,
+                  ControlInterpolation Interpolation = ControlInterpolation::None>
+        using control_rate = ControlRateNode<TInput, Divisor, Interpolation>;
     }
 }
 
@@ -0,0 +1,224 @@
+#ifndef DAP_CRTP_NODES_PROFILING_H
+#define DAP_CRTP_NODES_PROFILING_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h> // __rdtsc
+#endif
+
+// defining DAP_PROFILE_NODES profiles every processor node, see traits::IsProfiled
+#ifdef DAP_PROFILE_NODES
+#define DAP_PROFILE_NODES_ENABLED true
+#else
+#define DAP_PROFILE_NODES_ENABLED false
+#endif
+
+namespace dap
+{
+    namespace crtp
+    {
+        class ProfileTable;
+
+        template <bool Enabled>
+        class NodeProfiler;
+
+        namespace traits
+        {
+            // nodes of processors for which this is true record their cost into the
+            // ProfileTable, specialize it to profile some processors only
+            template <typename Processor>
+            struct IsProfiled : std::integral_constant<bool, DAP_PROFILE_NODES_ENABLED>
+            {
+            };
+        }
+
+        // instrumentation policy of the nodes rendering Processor, empty when not profiled
+        template <typename Processor>
+        using node_profiler_t = NodeProfiler<traits::IsProfiled<Processor>::value>;
+    }
+}
+
+// Preallocated table holding the cost of every profiled node. Each node claims an entry which is
+// only written by the thread rendering the node, so updates are relaxed loads and stores which
+// any thread may read at any time. Nodes give their entry back when destroyed, creating a node
+// while capacity profiled nodes are alive throws.
+class dap::crtp::ProfileTable final
+{
+public:
+    static constexpr size_t capacity = 1024;
+
+    struct Figures
+    {
+        uint64_t cycles; // time stamp counter ticks, or nanoseconds where there is no counter
+        uint64_t calls;  // calls to the processor, i.e. blocks or single frames
+        uint64_t frames;
+    };
+
+private:
+    struct Entry
+    {
+        std::atomic<uint64_t> cycles{0};
+        std::atomic<uint64_t> calls{0};
+        std::atomic<uint64_t> frames{0};
+    };
+
+    std::array<Entry, capacity> m_entries;
+    std::array<std::atomic<bool>, capacity> m_claimed{};
+    std::atomic<size_t> m_size{0};
+
+    static void add(std::atomic<uint64_t>& counter, uint64_t value)
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    }
+    static void zero(Entry& e)
+    {
+        e.cycles.store(0, std::memory_order_relaxed);
+        e.calls.store(0, std::memory_order_relaxed);
+        e.frames.store(0, std::memory_order_relaxed);
+    }
+
+public:
+    static ProfileTable& instance()
+    {
+        static ProfileTable table;
+        return table;
+    }
+    static uint64_t now()
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#else
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                         std::chrono::steady_clock::now().time_since_epoch())
+                                         .count());
+#endif
+    }
+
+    // claims a zeroed entry, throws std::length_error if every entry is claimed
+    size_t acquire()
+    {
+        for (size_t entry = 0; entry < capacity; ++entry)
+        {
+            bool claimed = false;
+            if (!m_claimed[entry].load(std::memory_order_relaxed) &&
+                m_claimed[entry].compare_exchange_strong(claimed, true, std::memory_order_acquire))
+            {
+                m_size.fetch_add(1, std::memory_order_relaxed);
+                return entry;
+            }
+        }
+        throw std::length_error("ProfileTable is full, too many profiled nodes are alive");
+    }
+    // gives an entry back, zeroed for the next node claiming it
+    void release(size_t entry)
+    {
+        zero(m_entries[entry]);
+        m_size.fetch_sub(1, std::memory_order_relaxed);
+        m_claimed[entry].store(false, std::memory_order_release);
+    }
+    // the entries claimed
+    size_t size() const
+    {
+        return m_size.load(std::memory_order_relaxed);
+    }
+    void record(size_t entry, uint64_t cycles, size_t frames)
+    {
+        auto& e = m_entries[entry];
+        add(e.cycles, cycles);
+        add(e.calls, 1);
+        add(e.frames, frames);
+    }
+    Figures figures(size_t entry) const
+    {
+        const auto& e = m_entries[entry];
+        return {e.cycles.load(std::memory_order_relaxed),
+                e.calls.load(std::memory_order_relaxed),
+                e.frames.load(std::memory_order_relaxed)};
+    }
+    // zeroes every entry, must not be called while profiled nodes are rendered
+    void clear()
+    {
+        for (auto& e : m_entries)
+        {
+            zero(e);
+        }
+    }
+};
+
+template <>
+class dap::crtp::NodeProfiler<false>
+{
+public:
+    static constexpr bool profiled = false;
+
+    struct Scope
+    {
+        constexpr Scope(const NodeProfiler&, size_t)
+        {
+        }
+    };
+};
+
+// owns an entry of the ProfileTable, copies of a node claim their own
+template <>
+class dap::crtp::NodeProfiler<true>
+{
+    size_t m_entry{ProfileTable::instance().acquire()};
+
+public:
+    static constexpr bool profiled = true;
+
+    // records the cycles spent from its construction to its destruction
+    class Scope
+    {
+        const size_t m_entry;
+        const size_t m_frames;
+        const uint64_t m_start;
+
+    public:
+        Scope(const NodeProfiler& profiler, size_t frames)
+        : m_entry(profiler.m_entry)
+        , m_frames(frames)
+        , m_start(ProfileTable::now())
+        {
+        }
+        Scope(const Scope&) = delete;
+        Scope(Scope&&)      = delete;
+        ~Scope()
+        {
+            ProfileTable::instance().record(m_entry, ProfileTable::now() - m_start, m_frames);
+        }
+        Scope& operator=(const Scope&) = delete;
+        Scope& operator=(Scope&&) = delete;
+    };
+
+    NodeProfiler() = default;
+    NodeProfiler(const NodeProfiler&)
+    {
+    }
+    NodeProfiler& operator=(const NodeProfiler&)
+    {
+        return *this;
+    }
+    ~NodeProfiler()
+    {
+        ProfileTable::instance().release(m_entry);
+    }
+
+    size_t profileEntry() const
+    {
+        return m_entry;
+    }
+    ProfileTable::Figures profile() const
+    {
+        return ProfileTable::instance().figures(m_entry);
+    }
+};
+
+#endif // DAP_CRTP_NODES_PROFILING_H
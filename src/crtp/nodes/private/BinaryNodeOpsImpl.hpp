@@ -23,12 +23,18 @@
     {                                                                                \
         return opnode<D1*, D2*>{n1->self(), n2->self()};                             \
     }                                                                                \
-    template <typename T, typename D, typename I, DAP_REQUIRES(isArithmetic<T>())>   \
+    template <typename T,                                                            \
+              typename D,                                                            \
+              typename I,                                                            \
+              DAP_REQUIRES(isArithmeticOrPacked<T>())>                               \
     inline constexpr auto operator op(T const& t, NodeExpression<D, I> n) noexcept   \
     {                                                                                \
         return opnode<T, D>{t, n.self()};                                            \
     }                                                                                \
-    template <typename D, typename I, typename T, DAP_REQUIRES(isArithmetic<T>())>   \
+    template <typename D,                                                            \
+              typename I,                                                            \
+              typename T,                                                            \
+              DAP_REQUIRES(isArithmeticOrPacked<T>())>                               \
     inline constexpr auto operator op(NodeExpression<D, I> n, T const& t) noexcept   \
     {                                                                                \
         return opnode<D, T>{n.self(), t};                                            \
@@ -57,12 +63,12 @@
     {                                                                                           \
         return opnode<D1*, D2*>{n1->self(), n2->self()};                                        \
     }                                                                                           \
-    template <typename T, typename D, typename I, DAP_REQUIRES(isArithmetic<T>())>              \
+    template <typename T, typename D, typename I, DAP_REQUIRES(isArithmeticOrPacked<T>())>      \
     inline constexpr auto func(T const& t, NodeExpression<D, I> n) noexcept                     \
     {                                                                                           \
         return opnode<T, D>{t, n.self()};                                                       \
     }                                                                                           \
-    template <typename D, typename I, typename T, DAP_REQUIRES(isArithmetic<T>())>              \
+    template <typename D, typename I, typename T, DAP_REQUIRES(isArithmeticOrPacked<T>())>      \
     inline constexpr auto func(NodeExpression<D, I> n, T const& t) noexcept                     \
     {                                                                                           \
         return opnode<D, T>{n.self(), t};                                                       \
@@ -132,13 +138,15 @@ namespace dap
         template <typename T, typename U>
         inline auto power_impl(T t, U u) noexcept
         {
-            return std::pow(t, u);
+            using std::pow;
+            return pow(t, u);
         }
 
         template <typename T, typename U>
         inline auto hypot_impl(T t, U u) noexcept
         {
-            return std::hypot(t, u);
+            using std::hypot;
+            return hypot(t, u);
         }
         template <typename T, typename U>
         inline auto equal_impl(T t, U u) noexcept
@@ -178,13 +186,15 @@ namespace dap
         template <typename T>
         inline auto max_impl(T x, T y) noexcept
         {
-            return std::max<T>(x, y);
+            using std::max;
+            return max(x, y);
         }
 
         template <typename T>
         inline auto min_impl(T x, T y) noexcept
         {
-            return std::min<T>(x, y);
+            using std::min;
+            return min(x, y);
         }
 
         // create Nodes and overloaded functions
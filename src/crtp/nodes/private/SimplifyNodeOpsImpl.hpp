@@ -0,0 +1,243 @@
+// rewriting rules applied when + - * / node expressions are built with compile time constants:
+// - constant subtrees are folded, e.g. constant<1>() + constant<2>() is constant<3>
+// - identities are eliminated, e.g. x * constant<1>() and x + constant<0>() are x
+// - consecutive gains are merged, e.g. (x * constant<2>()) * constant<3>() is x * constant<6>
+// - common gains are hoisted out of sums, e.g. x * c + y * c is (x + y) * c
+// Division by a constant becomes a multiplication by its inverse so it can be merged too, dividing
+// by constant<0>() does not compile.
+// Plain values and ValueNodes are only known at runtime and are never rewritten.
+// As with -ffast-math, x * constant<0>() and constant<0>() / x are constant<0>: the result is 0
+// even if x is inf or NaN, and x is dropped from the graph so a stateful x stops advancing.
+
+namespace dap
+{
+    namespace crtp
+    {
+        namespace detail
+        {
+            template <typename T>
+            struct IsStaticValue : std::false_type
+            {
+            };
+            template <typename Ratio, typename T>
+            struct IsStaticValue<StaticValueNode<Ratio, T>> : std::true_type
+            {
+            };
+
+            template <typename T, typename Ratio>
+            constexpr bool isStaticValue()
+            {
+                if constexpr (IsStaticValue<T>::value)
+                {
+                    return std::ratio_equal<typename T::ratio, Ratio>::value;
+                }
+                else
+                {
+                    return false;
+                }
+            }
+
+            // x * constant
+            template <typename T>
+            struct IsGain : std::false_type
+            {
+            };
+            template <typename TInput, typename Ratio, typename T, typename InputNames>
+            struct IsGain<ProcessorNode<Multiply,
+                                        Node::Inputs<TInput, StaticValueNode<Ratio, T>>,
+                                        InputNames>> : std::true_type
+            {
+                using ratio = Ratio;
+            };
+
+            template <typename L, typename R>
+            constexpr bool haveSameGain()
+            {
+                if constexpr (IsGain<L>::value && IsGain<R>::value)
+                {
+                    return std::ratio_equal<typename IsGain<L>::ratio,
+                                            typename IsGain<R>::ratio>::value;
+                }
+                else
+                {
+                    return false;
+                }
+            }
+
+            template <typename Fn, typename L, typename R>
+            struct IsSimplifiable
+            : std::integral_constant<bool,
+                                     traits::IsCrtpNode<L>::value &&
+                                         traits::IsCrtpNode<R>::value &&
+                                         (IsStaticValue<L>::value || IsStaticValue<R>::value ||
+                                          (!std::is_same<Fn, Multiply>::value &&
+                                           !std::is_same<Fn, Divide>::value &&
+                                           haveSameGain<L, R>()))>
+            {
+            };
+
+            template <template <class, class> class RatioOp, typename L, typename R>
+            constexpr auto fold(const L&, const R&)
+            {
+                using value_type = std::common_type_t<decltype(L::value()), decltype(R::value())>;
+                return StaticValueNode<RatioOp<typename L::ratio, typename R::ratio>, value_type>{};
+            }
+
+            template <typename Fn>
+            struct Simplify;
+
+            template <>
+            struct Simplify<Multiply>
+            {
+                template <typename L, typename R>
+                static auto apply(const L& l, const R& r)
+                {
+                    if constexpr (IsStaticValue<L>::value && IsStaticValue<R>::value)
+                    {
+                        return fold<std::ratio_multiply>(l, r);
+                    }
+                    else if constexpr (IsStaticValue<L>::value)
+                    {
+                        // constants go right
+                        return apply(r, l);
+                    }
+                    else if constexpr (isStaticValue<R, std::ratio<1>>())
+                    {
+                        return l;
+                    }
+                    else if constexpr (isStaticValue<R, std::ratio<0>>())
+                    {
+                        return r;
+                    }
+                    else if constexpr (IsGain<L>::value && IsStaticValue<R>::value)
+                    {
+                        return apply(l.template input<0>(),
+                                     fold<std::ratio_multiply>(l.template input<1>(), r));
+                    }
+                    else
+                    {
+                        return MultiplyNode<L, R>{l, r};
+                    }
+                }
+            };
+
+            template <>
+            struct Simplify<Divide>
+            {
+                template <typename L, typename R>
+                static auto apply(const L& l, const R& r)
+                {
+                    constexpr bool zeroDivisor = isStaticValue<R, std::ratio<0>>();
+                    static_assert(!zeroDivisor, "division by constant<0>()");
+                    if constexpr (zeroDivisor)
+                    {
+                        // only the assertion above is reported
+                        return DivideNode<L, R>{l, r};
+                    }
+                    else if constexpr (IsStaticValue<L>::value && IsStaticValue<R>::value)
+                    {
+                        return fold<std::ratio_divide>(l, r);
+                    }
+                    else if constexpr (isStaticValue<L, std::ratio<0>>())
+                    {
+                        return l;
+                    }
+                    else if constexpr (IsStaticValue<R>::value)
+                    {
+                        return Simplify<Multiply>::apply(
+                            l, fold<std::ratio_divide>(constant<1>{}, r));
+                    }
+                    else
+                    {
+                        return DivideNode<L, R>{l, r};
+                    }
+                }
+            };
+
+            template <>
+            struct Simplify<Add>
+            {
+                template <typename L, typename R>
+                static auto apply(const L& l, const R& r)
+                {
+                    if constexpr (IsStaticValue<L>::value && IsStaticValue<R>::value)
+                    {
+                        return fold<std::ratio_add>(l, r);
+                    }
+                    else if constexpr (IsStaticValue<L>::value)
+                    {
+                        return apply(r, l);
+                    }
+                    else if constexpr (isStaticValue<R, std::ratio<0>>())
+                    {
+                        return l;
+                    }
+                    else if constexpr (haveSameGain<L, R>())
+                    {
+                        return Simplify<Multiply>::apply(
+                            apply(l.template input<0>(), r.template input<0>()),
+                            l.template input<1>());
+                    }
+                    else
+                    {
+                        return AddNode<L, R>{l, r};
+                    }
+                }
+            };
+
+            template <>
+            struct Simplify<Subtract>
+            {
+                template <typename L, typename R>
+                static auto apply(const L& l, const R& r)
+                {
+                    if constexpr (IsStaticValue<L>::value && IsStaticValue<R>::value)
+                    {
+                        return fold<std::ratio_subtract>(l, r);
+                    }
+                    else if constexpr (isStaticValue<R, std::ratio<0>>())
+                    {
+                        return l;
+                    }
+                    else if constexpr (haveSameGain<L, R>())
+                    {
+                        return Simplify<Multiply>::apply(
+                            apply(l.template input<0>(), r.template input<0>()),
+                            l.template input<1>());
+                    }
+                    else
+                    {
+                        return SubtractNode<L, R>{l, r};
+                    }
+                }
+            };
+        }
+
+        // these are exact matches, so they are preferred to the generic operators taking
+        // NodeExpression base classes
+        template <typename L, typename R, DAP_REQUIRES(detail::IsSimplifiable<Add, L, R>::value)>
+        inline auto operator+(const L& l, const R& r)
+        {
+            return detail::Simplify<Add>::apply(l, r);
+        }
+        template <typename L,
+                  typename R,
+                  DAP_REQUIRES(detail::IsSimplifiable<Subtract, L, R>::value)>
+        inline auto operator-(const L& l, const R& r)
+        {
+            return detail::Simplify<Subtract>::apply(l, r);
+        }
+        template <typename L,
+                  typename R,
+                  DAP_REQUIRES(detail::IsSimplifiable<Multiply, L, R>::value)>
+        inline auto operator*(const L& l, const R& r)
+        {
+            return detail::Simplify<Multiply>::apply(l, r);
+        }
+        template <typename L, typename R, DAP_REQUIRES(detail::IsSimplifiable<Divide, L, R>::value)>
+        inline auto operator/(const L& l, const R& r)
+        {
+            return detail::Simplify<Divide>::apply(l, r);
+        }
+    } // namespace crtp
+} // namespace dap
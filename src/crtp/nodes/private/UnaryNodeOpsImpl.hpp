@@ -4,7 +4,8 @@
         template <typename T>                                          \
         auto operator()(T t) const noexcept                            \
         {                                                              \
-            return std::func(t);                                       \
+            using std::func;                                           \
+            return func(t);                                            \
         }                                                              \
     };                                                                 \
     template <typename TInput>                                         \
@@ -25,7 +26,7 @@
     {                                                                  \
         return name_struct##Node<E>{e.self()};                         \
     }                                                                  \
-    template <typename T, DAP_REQUIRES(isArithmetic<T>())>             \
+    template <typename T, DAP_REQUIRES(isArithmeticOrPacked<T>())>     \
     inline constexpr auto func(T t) noexcept                           \
     {                                                                  \
         return name_struct##Node<T>{t};                                \
@@ -72,7 +73,7 @@ namespace dap
         {
             return SqrNode<E>{e.self()};
         }
-        template <typename T, DAP_REQUIRES(isArithmetic<T>())>
+        template <typename T, DAP_REQUIRES(isArithmeticOrPacked<T>())>
         inline constexpr auto sqr(T t) noexcept
         {
             return SqrNode<T>{t};
@@ -0,0 +1,79 @@
+#include "crtp/nodes/Processor.h"
+#include "dsp/NoiseGenerator.h"
+#include "dsp/Smoother.h"
+#include "dsp/UniformDistribution.h"
+#include <gtest/gtest.h>
+#include <vector>
+
+using namespace testing;
+using namespace dap;
+using namespace dap::crtp;
+
+namespace
+{
+    class Counter
+    {
+        float m_count{0};
+
+    public:
+        auto operator()(float step)
+        {
+            m_count += step;
+            return m_count;
+        }
+    };
+    using counter_t = decltype(processor<Counter>::with_inputs<float>::named("step"_s));
+    using noise_gen_t = dsp::NoiseGenerator<dsp::UniformDistribution>;
+    using noise_t     = decltype(
+        processor<noise_gen_t>::with_inputs<float, noise_gen_t::Color>::named("gain"_s, "color"_s));
+
+    static_assert(!traits::IsAudioRate<counter_t>::value, "counter can run at control rate");
+    static_assert(traits::IsAudioRate<noise_t>::value, "noise is audio rate only");
+    static_assert(traits::IsAudioRate<decltype(counter_t{} + noise_t{})>::value,
+                  "audio rate propagates through the graph");
+}
+
+TEST(ControlRateTest, hold)
+{
+    control_rate<counter_t, 4> control;
+    control.input("step"_s) = 1.0f;
+
+    const std::vector<float> expected{1, 1, 1, 1, 2, 2, 2, 2, 3, 3};
+    for (auto x : expected)
+    {
+        ASSERT_FLOAT_EQ(x, control());
+    }
+}
+TEST(ControlRateTest, linear)
+{
+    control_rate<counter_t, 4, ControlInterpolation::Linear> control;
+    control.input("step"_s) = 1.0f;
+
+    const std::vector<float> expected{0.25f, 0.5f, 0.75f, 1.0f, 1.25f, 1.5f, 1.75f, 2.0f};
+    for (auto x : expected)
+    {
+        ASSERT_FLOAT_EQ(x, control());
+    }
+}
+TEST(ControlRateTest, block_matches_per_sample)
+{
+    using control_t = control_rate<counter_t, 24, ControlInterpolation::Linear>;
+    using sum_t     = decltype(control_t{} + ValueNode<float>{});
+    sum_t scalar;
+    sum_t block;
+    scalar.input("x"_s).input("step"_s) = 0.5f;
+    block.input("x"_s).input("step"_s)  = 0.5f;
+
+    const size_t frames = 200;
+    std::vector<float> expected(frames);
+    std::vector<float> actual(frames);
+    for (auto& x : expected)
+    {
+        x = scalar();
+    }
+    block.process(actual.data(), frames);
+    for (size_t i = 0; i < frames; ++i)
+    {
+        ASSERT_FLOAT_EQ(expected[i], actual[i]);
+    }
+}
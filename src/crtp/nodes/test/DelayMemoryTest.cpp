@@ -0,0 +1,86 @@
+#include "crtp/nodes/Node.h"
+#include "crtp/utility/DelayMemory.h"
+#include "dsp/CombFilter.h"
+#include <gtest/gtest.h>
+#include <sstream>
+#include <vector>
+
+using namespace testing;
+using namespace dap;
+using namespace dap::crtp;
+
+namespace
+{
+    template <size_t N>
+    using comb_t = ProcessorNode<dsp::FeedbackCombFilter<float, N>,
+                                 Node::Inputs<float, float, float>,
+                                 NODE_INPUT_NAMES("signal"_s, "delay"_s, "feedback"_s)>;
+    // a dynamic comb filter fed by another one
+    using graph_t = ProcessorNode<dsp::FeedbackCombFilter<float, dsp::dynamic_delay>,
+                                  Node::Inputs<comb_t<dsp::dynamic_delay>, float, float>,
+                                  NODE_INPUT_NAMES("signal"_s, "delay"_s, "feedback"_s)>;
+
+    template <typename T>
+    void init(T& comb, float delay)
+    {
+        comb.input("delay"_s)    = delay;
+        comb.input("feedback"_s) = 0.5f;
+    }
+}
+
+TEST(DelayMemoryTest, attach_and_report)
+{
+    graph_t graph;
+    init(graph, 300.0f);
+    init(graph.input("signal"_s), 20.0f);
+    graph.input("signal"_s).input("signal"_s) = 1.0f;
+    graph.processor().setMaxDelay(1000);
+    graph.input("signal"_s).processor().setMaxDelay(100);
+    // the graph itself stays small
+    ASSERT_LT(sizeof(graph), 256u);
+
+    dsp::DelayMemory memory;
+    attachDelayMemory(memory, graph);
+    const auto figures = delayMemory(graph);
+    ASSERT_EQ(2u, figures.lines);
+    ASSERT_EQ(0u, figures.inlineBytes);
+    ASSERT_EQ(4160u + 576u, figures.arenaBytes); // 1027 and 131 samples on cache lines
+    ASSERT_EQ(figures.arenaBytes, memory.capacity());
+    ASSERT_EQ(figures.arenaBytes, memory.used());
+
+    // renders as the same graph with inline lines
+    using inline_graph_t = ProcessorNode<dsp::FeedbackCombFilter<float, 1024>,
+                                         Node::Inputs<comb_t<128>, float, float>,
+                                         NODE_INPUT_NAMES("signal"_s, "delay"_s, "feedback"_s)>;
+    inline_graph_t reference;
+    init(reference, 300.0f);
+    init(reference.input("signal"_s), 20.0f);
+    reference.input("signal"_s).input("signal"_s) = 1.0f;
+    ASSERT_EQ(1152 * sizeof(float) + 6 * sizeof(float), delayMemory(reference).inlineBytes);
+
+    std::vector<float> out(1000);
+    graph.process(out.data(), out.size());
+    for (size_t n = 0; n < out.size(); ++n)
+    {
+        ASSERT_FLOAT_EQ(reference(), out[n]) << n;
+    }
+
+    std::ostringstream report;
+    printDelayMemory(report, graph);
+    ASSERT_NE(std::string::npos, report.str().find("(signal, delay, feedback): 4108 bytes"));
+    ASSERT_NE(std::string::npos, report.str().find("2 processors: 0 bytes inline, 4736 bytes"));
+}
+TEST(DelayMemoryTest, max_delay_of_a_subtree)
+{
+    graph_t graph;
+    graph.processor().setMaxDelay(1000);
+    setMaxDelay(graph.input("signal"_s), 100);
+    // the outer line keeps its 1027 samples, the inner one gets 131
+    ASSERT_EQ(1027 * sizeof(float), graph.processor().memorySize());
+    ASSERT_EQ(131 * sizeof(float), graph.input("signal"_s).processor().memorySize());
+
+    dsp::DelayMemory memory;
+    attachDelayMemory(memory, graph);
+    ASSERT_TRUE(graph.processor().attached());
+    ASSERT_TRUE(graph.input("signal"_s).processor().attached());
+}
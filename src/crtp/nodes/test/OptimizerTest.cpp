@@ -0,0 +1,112 @@
+#include "crtp/nodes/Node.h"
+#include "crtp/nodes/Optimizer.h"
+#include "dsp/Oscillator.h"
+#include <gtest/gtest.h>
+#include <limits>
+
+using namespace testing;
+using namespace dap;
+using namespace dap::crtp;
+
+namespace
+{
+    using x_t   = ValueNode<float>;
+    using osc_t = ProcessorNode<
+        dsp::Oscillator<float>,
+        Node::Inputs<float, x_t, float, float, dsp::OscillatorFunctions::Shape>,
+        NODE_INPUT_NAMES("gain"_s, "frequency"_s, "phase"_s, "samplerate"_s, "shape"_s)>;
+}
+
+TEST(OptimizerTest, folds_constants)
+{
+    auto c = constant<1>{} + constant<1, 2>{} * constant<3>{};
+    static_assert(std::is_same<decltype(c), StaticValueNode<std::ratio<5, 2>>>::value, "");
+    ASSERT_EQ(2.5f, c());
+    ASSERT_EQ(0.5f, (constant<1>{} / constant<2>{})());
+    ASSERT_EQ(-1.0f, (constant<1>{} - constant<2>{})());
+}
+
+TEST(OptimizerTest, eliminates_identities)
+{
+    x_t x(3.0f);
+    static_assert(std::is_same<decltype(x * constant<1>{}), x_t>::value, "");
+    static_assert(std::is_same<decltype(constant<1>{} * x), x_t>::value, "");
+    static_assert(std::is_same<decltype(x + constant<0>{}), x_t>::value, "");
+    static_assert(std::is_same<decltype(constant<0>{} + x), x_t>::value, "");
+    static_assert(std::is_same<decltype(x - constant<0>{}), x_t>::value, "");
+    static_assert(std::is_same<decltype(x / constant<1>{}), x_t>::value, "");
+    static_assert(std::is_same<decltype(x * constant<0>{}), constant<0>>::value, "");
+    ASSERT_EQ(3.0f, (x * constant<1>{})());
+    ASSERT_EQ(0.0f, (x * constant<0>{})());
+
+    // fast-math rules, x is dropped whatever its value
+    static_assert(std::is_same<decltype(constant<0>{} / x), constant<0>>::value, "");
+    x = std::numeric_limits<float>::infinity();
+    ASSERT_EQ(0.0f, (x * constant<0>{})());
+    ASSERT_EQ(0.0f, (constant<0>{} / x)());
+
+    // runtime values are never rewritten
+    static_assert(nodeCount<decltype(x * 1.0f)>() == 2, "");
+}
+
+TEST(OptimizerTest, merges_gains)
+{
+    x_t x(3.0f);
+    auto y = (x * constant<2>{}) * constant<3>{};
+    static_assert(std::is_same<decltype(y), decltype(x * constant<6>{})>::value, "");
+    ASSERT_EQ(18.0f, y());
+
+    auto z = constant<4>{} * (x / constant<2>{});
+    static_assert(std::is_same<decltype(z), decltype(x * constant<2>{})>::value, "");
+    ASSERT_EQ(6.0f, z());
+
+    // gains cancelling each other out
+    static_assert(std::is_same<decltype((x * constant<2>{}) / constant<2>{}), x_t>::value, "");
+}
+
+TEST(OptimizerTest, hoists_gains_out_of_sums)
+{
+    x_t x(3.0f);
+    x_t y(5.0f);
+    auto sum = x * constant<1, 4>{} + y * constant<1, 4>{};
+    static_assert(std::is_same<decltype(sum), decltype((x + y) * constant<1, 4>{})>::value, "");
+    ASSERT_EQ(2.0f, sum());
+    auto difference = x * constant<1, 4>{} - y * constant<1, 4>{};
+    ASSERT_EQ(-0.5f, difference());
+
+    // different gains are kept
+    auto kept = x * constant<1, 4>{} + y * constant<1, 2>{};
+    static_assert(nodeCount<decltype(kept)>() == 7, "");
+    ASSERT_EQ(3.25f, kept());
+}
+
+TEST(OptimizerTest, optimizes_spelled_out_graphs)
+{
+    // types written out by hand are not built through the operators
+    using gain_t  = MultiplyNode<osc_t, constant<1>>;
+    using graph_t = AddNode<MultiplyNode<gain_t, constant<2>>, constant<0>>;
+
+    using report_t = OptimizationReport<graph_t>;
+    static_assert(report_t::nodes == 8, "");
+    static_assert(report_t::optimizedNodes == 4, "");
+    static_assert(report_t::eliminated == 4, "");
+    static_assert(std::is_same<optimize_t<graph_t>, MultiplyNode<osc_t, constant<2>>>::value, "");
+
+    graph_t graph;
+    auto& osc = graph.input<0>().input<0>().input<0>();
+    osc.input("gain"_s)            = 0.5f;
+    osc.input("frequency"_s)       = 440.0f;
+    osc.input("phase"_s)           = 0.0f;
+    osc.input("samplerate"_s)      = 44100.0f;
+    osc.input("shape"_s)           = dsp::OscillatorFunctions::Shape::Sine;
+    // the processors carry over their state, the oscillator going on from its phase
+    for (int n = 0; n < 37; ++n)
+    {
+        graph();
+    }
+    auto optimized = optimize(graph);
+    for (int n = 0; n < 100; ++n)
+    {
+        ASSERT_FLOAT_EQ(graph(), optimized());
+    }
+}
@@ -0,0 +1,92 @@
+#include "crtp/nodes/Node.h"
+#include "dsp/LadderFilter.h"
+#include "dsp/Oscillator.h"
+#include "dsp/Smoother.h"
+#include "fastmath/Pack.h"
+#include <gtest/gtest.h>
+#include <vector>
+
+using namespace testing;
+using namespace dap;
+using namespace dap::crtp;
+using fastmath::float4;
+
+namespace
+{
+    using shape_t = dsp::OscillatorFunctions::Shape;
+
+    template <typename T>
+    using control_t = ProcessorNode<dsp::FixedSmoother<T, 64>,
+                                    Node::Inputs<T>,
+                                    NODE_INPUT_NAMES("value"_s)>;
+    template <typename T>
+    using osc_t = ProcessorNode<dsp::Oscillator<T>,
+                                Node::Inputs<control_t<T>, T, T, T, shape_t>,
+                                NODE_INPUT_NAMES(
+                                    "gain"_s, "frequency"_s, "phase"_s, "samplerate"_s, "shape"_s)>;
+    template <typename T>
+    using filter_t = ProcessorNode<dsp::LadderFilter<T>,
+                                   Node::Inputs<decltype(osc_t<T>{} * T{}), T, T, T>,
+                                   NODE_INPUT_NAMES(
+                                       "signal"_s, "frequency"_s, "resonance"_s, "samplerate"_s)>;
+
+    template <typename T>
+    void init(filter_t<T>& filter, T frequency, T cutoff, shape_t shape)
+    {
+        auto& osc                                 = filter.input("signal"_s).input("x"_s);
+        filter.input("signal"_s).input("y"_s)     = T(0.5f);
+        filter.input("frequency"_s)               = cutoff;
+        filter.input("resonance"_s)               = T(1.5f);
+        filter.input("samplerate"_s)              = T(44100.0f);
+        osc.input("gain"_s).input("value"_s)      = T(1.0f);
+        osc.input("frequency"_s)                  = frequency;
+        osc.input("phase"_s)                      = T(0.0f);
+        osc.input("samplerate"_s)                 = T(44100.0f);
+        osc.input("shape"_s)                      = shape;
+    }
+}
+
+TEST(PackedNodeTest, lanes_match_scalar_graphs)
+{
+    const float frequencies[] = {110.0f, 220.0f, 330.0f, 440.0f};
+    const float cutoffs[]     = {500.0f, 1000.0f, 2000.0f, 4000.0f};
+
+    for (auto shape : {shape_t::Sine, shape_t::Square, shape_t::Saw, shape_t::Triangle})
+    {
+        filter_t<float4> packed;
+        init(packed, float4::load(frequencies), float4::load(cutoffs), shape);
+        std::vector<filter_t<float>> voices(float4::size());
+        for (size_t i = 0; i < voices.size(); ++i)
+        {
+            init(voices[i], frequencies[i], cutoffs[i], shape);
+        }
+
+        for (size_t n = 0; n < 1000; ++n)
+        {
+            const float4 y = packed();
+            for (size_t i = 0; i < voices.size(); ++i)
+            {
+                ASSERT_NEAR(voices[i](), y[i], 1e-3f) << shape << " lane " << i << " sample " << n;
+            }
+        }
+    }
+}
+TEST(PackedNodeTest, block_processing)
+{
+    const float frequencies[] = {110.0f, 220.0f, 330.0f, 440.0f};
+    filter_t<float4> scalar;
+    filter_t<float4> block;
+    init(scalar, float4::load(frequencies), float4(1000.0f), shape_t::Saw);
+    init(block, float4::load(frequencies), float4(1000.0f), shape_t::Saw);
+
+    std::vector<float4> out(200);
+    block.process(out.data(), out.size());
+    for (const auto& y : out)
+    {
+        const float4 expected = scalar();
+        for (size_t i = 0; i < float4::size(); ++i)
+        {
+            ASSERT_FLOAT_EQ(expected[i], y[i]);
+        }
+    }
+}
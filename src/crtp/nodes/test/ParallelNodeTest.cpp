@@ -0,0 +1,98 @@
+#include "crtp/nodes/Parallel.h"
+#include "crtp/nodes/Processor.h"
+#include "crtp/utility/WorkerPoolSetter.h"
+#include "dsp/Mixer.h"
+#include "dsp/Oscillator.h"
+#include <gtest/gtest.h>
+#include <vector>
+
+using namespace testing;
+using namespace dap;
+using namespace dap::crtp;
+
+namespace
+{
+    using shape_t = dsp::OscillatorFunctions::Shape;
+    using osc_t   = decltype(
+        processor<dsp::Oscillator<float>>::with_inputs<float, float, float, float, shape_t>::named(
+            "gain"_s, "frequency"_s, "phase"_s, "samplerate"_s, "shape"_s));
+    using bus_t =
+        decltype(processor<dsp::Mixer::Bus>::with_inputs<float, osc_t>::named("gain"_s, "signal"_s));
+    using mixer_t = decltype(
+        processor<dsp::Mixer>::with_inputs<bus_t, bus_t, bus_t>::prefixed_by("bus_"_s));
+    using parallel_mixer_t = parallel_join<mixer_t>;
+
+    template <typename Mixer>
+    void init(Mixer& mixer)
+    {
+        auto setup = [](auto& bus, float frequency, shape_t shape) {
+            auto& osc = bus.input("signal"_s);
+            bus.input("gain"_s)        = 0.5f;
+            osc.input("gain"_s)        = 1.0f;
+            osc.input("frequency"_s)   = frequency;
+            osc.input("phase"_s)       = 0.0f;
+            osc.input("samplerate"_s)  = 44100.0f;
+            osc.input("shape"_s)       = shape;
+        };
+        setup(mixer.template input<0>(), 110.0f, shape_t::Sine);
+        setup(mixer.template input<1>(), 220.0f, shape_t::Saw);
+        setup(mixer.template input<2>(), 330.0f, shape_t::Triangle);
+    }
+    template <typename Mixer>
+    std::vector<float> render(Mixer& mixer, size_t frames)
+    {
+        std::vector<float> out(frames);
+        for (size_t offset = 0; offset < frames; offset += 512)
+        {
+            mixer.process(out.data() + offset, std::min(frames - offset, size_t(512)));
+        }
+        return out;
+    }
+}
+
+TEST(ParallelNodeTest, matches_serial_join)
+{
+    mixer_t serial;
+    parallel_mixer_t parallel;
+    init(serial);
+    init(parallel);
+    threadsafe::WorkerPool pool(2, false);
+    parallel.setWorkerPool(&pool);
+
+    const size_t frames = 4100; // not a multiple of max_block_size_t
+    const auto expected = render(serial, frames);
+    const auto actual   = render(parallel, frames);
+    for (size_t n = 0; n < frames; ++n)
+    {
+        ASSERT_FLOAT_EQ(expected[n], actual[n]);
+    }
+}
+TEST(ParallelNodeTest, evaluates_serially_without_pool)
+{
+    mixer_t serial;
+    parallel_mixer_t parallel;
+    init(serial);
+    init(parallel);
+
+    for (size_t n = 0; n < 100; ++n)
+    {
+        ASSERT_FLOAT_EQ(serial(), parallel());
+    }
+    const auto expected = render(serial, 1000);
+    const auto actual   = render(parallel, 1000);
+    ASSERT_EQ(expected, actual);
+}
+TEST(ParallelNodeTest, pool_set_on_every_parallel_node)
+{
+    using graph_t = AddNode<parallel_mixer_t, parallel_mixer_t>;
+    static_assert(parallelDepth<graph_t>() == 1, "");
+    static_assert(parallelDepth<parallel_join<graph_t>>() == 2, "");
+
+    graph_t graph;
+    threadsafe::WorkerPool pool(1, false);
+    setWorkerPool(graph, &pool);
+    ASSERT_EQ(&pool, graph.input("x"_s).workerPool());
+    ASSERT_EQ(&pool, graph.input("y"_s).workerPool());
+    setWorkerPool(graph, nullptr);
+    ASSERT_EQ(nullptr, graph.input("x"_s).workerPool());
+}
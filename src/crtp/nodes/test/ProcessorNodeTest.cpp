@@ -1,5 +1,8 @@
 #include "crtp/nodes/Node.h"
+#include "dsp/Oscillator.h"
+#include "dsp/Smoother.h"
 #include <gtest/gtest.h>
+#include <vector>
 
 using namespace testing;
 using namespace dap;
@@ -14,6 +17,17 @@ public:
     }
 };
 
+class Counter
+{
+    float m_count{0};
+
+public:
+    auto operator()()
+    {
+        return m_count += 1.0f;
+    }
+};
+
 template <typename T>
 class TProdProcessor
 {
@@ -43,3 +57,66 @@ TEST(ProcessorNodeTest, templated_processor)
     prod.input("rhs"_s) = 3.0f;
     ASSERT_EQ(6.0f, prod);
 }
+TEST(ProcessorNodeTest, block_processing_matches_per_sample)
+{
+    using control_t = ProcessorNode<dsp::FixedSmoother<float, 64>,
+                                    Node::Inputs<float>,
+                                    NODE_INPUT_NAMES("value"_s)>;
+    using osc_t     = ProcessorNode<dsp::Oscillator<float>,
+                                Node::Inputs<control_t,
+                                             decltype(control_t{} + ValueNode<float>{}),
+                                             float,
+                                             float,
+                                             dsp::OscillatorFunctions::Shape>,
+                                NODE_INPUT_NAMES(
+                                    "gain"_s, "frequency"_s, "phase"_s, "samplerate"_s, "shape"_s)>;
+
+    auto init = [](osc_t& osc) {
+        osc.input("gain"_s).input("value"_s)                   = 0.5f;
+        osc.input("frequency"_s).input("x"_s).input("value"_s) = 440.0f;
+        osc.input("frequency"_s).input("y"_s)                  = 20.0f;
+        osc.input("phase"_s)                                   = 0.0f;
+        osc.input("samplerate"_s)                              = 44100.0f;
+        osc.input("shape"_s)                                   = dsp::OscillatorFunctions::Shape::Sine;
+    };
+    osc_t scalarOsc;
+    osc_t blockOsc;
+    init(scalarOsc);
+    init(blockOsc);
+
+    const size_t frames = 1000; // not a multiple of max_block_size_t
+    std::vector<float> expected(frames);
+    std::vector<float> actual(frames);
+    for (auto& x : expected)
+    {
+        x = scalarOsc();
+    }
+    blockOsc.process(actual.data(), frames);
+    for (size_t i = 0; i < frames; ++i)
+    {
+        ASSERT_FLOAT_EQ(expected[i], actual[i]);
+    }
+}
+TEST(ProcessorNodeTest, pointer_inputs_are_pulled_per_input)
+{
+    using counter_t = ProcessorNode<Counter, Node::Inputs<>, std::tuple<>>;
+    using square_t  = MultiplyNode<counter_t*, counter_t*>;
+
+    // per sample the two reads interleave
+    counter_t scalarCounter;
+    square_t scalarSquare(&scalarCounter, &scalarCounter);
+    for (size_t i = 0; i < 10; ++i)
+    {
+        ASSERT_FLOAT_EQ(float((2 * i + 1) * (2 * i + 2)), scalarSquare());
+    }
+
+    // by block each input pulls a block of its own, not block equivalent
+    counter_t blockCounter;
+    square_t blockSquare(&blockCounter, &blockCounter);
+    std::vector<float> out(max_block_size_t::value);
+    blockSquare.process(out.data(), out.size());
+    for (size_t i = 0; i < out.size(); ++i)
+    {
+        ASSERT_FLOAT_EQ(float((i + 1) * (i + 1 + max_block_size_t::value)), out[i]);
+    }
+}
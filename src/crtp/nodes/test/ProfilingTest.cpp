@@ -0,0 +1,127 @@
+#include "crtp/nodes/Node.h"
+#include "crtp/utility/ProfileReporter.h"
+#include "crtp/utility/StaticSchedule.h"
+#include "dsp/Oscillator.h"
+#include <gtest/gtest.h>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+using namespace testing;
+using namespace dap;
+using namespace dap::crtp;
+
+namespace
+{
+    struct Gain
+    {
+        inline auto operator()(float gain, float x)
+        {
+            return gain * x;
+        }
+    };
+}
+
+template <>
+struct dap::crtp::traits::IsProfiled<Gain> : std::true_type
+{
+};
+
+namespace
+{
+    using osc_t  = ProcessorNode<dsp::Oscillator<float>,
+                                Node::Inputs<float, float, float, float, dsp::OscillatorFunctions::Shape>,
+                                NODE_INPUT_NAMES(
+                                    "gain"_s, "frequency"_s, "phase"_s, "samplerate"_s, "shape"_s)>;
+    using gain_t = ProcessorNode<Gain, Node::Inputs<float, osc_t>, NODE_INPUT_NAMES("gain"_s, "signal"_s)>;
+
+    void init(gain_t& node)
+    {
+        auto& osc                  = node.input("signal"_s);
+        osc.input("gain"_s)        = 1.0f;
+        osc.input("frequency"_s)   = 440.0f;
+        osc.input("phase"_s)       = 0.0f;
+        osc.input("samplerate"_s)  = 44100.0f;
+        osc.input("shape"_s)       = dsp::OscillatorFunctions::Shape::Sine;
+        node.input("gain"_s)       = 0.5f;
+    }
+}
+
+TEST(ProfilingTest, compiled_out_when_disabled)
+{
+    static_assert(!node_profiler_t<dsp::Oscillator<float>>::profiled, "");
+    static_assert(std::is_empty<node_profiler_t<dsp::Oscillator<float>>>::value, "");
+    static_assert(node_profiler_t<Gain>::profiled, "");
+}
+
+TEST(ProfilingTest, records_blocks_and_frames)
+{
+    gain_t node;
+    init(node);
+    ASSERT_LT(node.profileEntry(), ProfileTable::capacity);
+    ASSERT_EQ(0u, node.profile().calls);
+
+    std::vector<float> out(1000);
+    node.process(out.data(), out.size());
+    auto figures = node.profile();
+    ASSERT_EQ(16u, figures.calls); // blocks of 64 frames
+    ASSERT_EQ(1000u, figures.frames);
+    ASSERT_GT(figures.cycles, 0u);
+
+    node();
+    figures = node.profile();
+    ASSERT_EQ(17u, figures.calls);
+    ASSERT_EQ(1001u, figures.frames);
+
+    // a copy is another node
+    const gain_t& source = node;
+    gain_t copy          = source;
+    ASSERT_NE(node.profileEntry(), copy.profileEntry());
+    ASSERT_EQ(0u, copy.profile().calls);
+}
+
+TEST(ProfilingTest, entries_given_back)
+{
+    auto& table       = ProfileTable::instance();
+    const size_t size = table.size();
+    for (size_t i = 0; i < 2 * ProfileTable::capacity; ++i)
+    {
+        gain_t node;
+        node();
+        ASSERT_EQ(1u, node.profile().calls);
+    }
+    ASSERT_EQ(size, table.size());
+
+    // a full table throws
+    std::vector<gain_t> nodes(ProfileTable::capacity - size);
+    ASSERT_EQ(ProfileTable::capacity, table.size());
+    ASSERT_THROW(gain_t{}, std::length_error);
+    nodes.clear();
+    ASSERT_EQ(size, table.size());
+}
+
+TEST(ProfilingTest, records_scheduled_nodes)
+{
+    gain_t node;
+    init(node);
+    StaticSchedule<gain_t> schedule(node);
+    std::vector<float> out(128);
+    schedule.process(out.data(), out.size());
+    ASSERT_EQ(2u, node.profile().calls);
+    ASSERT_EQ(128u, node.profile().frames);
+}
+
+TEST(ProfilingTest, reports_profiled_nodes)
+{
+    gain_t node;
+    init(node);
+    std::vector<float> out(64);
+    node.process(out.data(), out.size());
+
+    std::ostringstream report;
+    printProfile(report, node);
+    const auto text = report.str();
+    // the oscillator is not profiled
+    ASSERT_EQ(1, std::count(text.begin(), text.end(), '\n'));
+    ASSERT_NE(std::string::npos, text.find("Gain (gain, signal): calls 1, frames 64, cycles "));
+}
@@ -0,0 +1,121 @@
+#include "crtp/nodes/Processor.h"
+#include "crtp/utility/NodeVisitor.h"
+#include "crtp/utility/StateReset.h"
+#include <gtest/gtest.h>
+#include <vector>
+
+using namespace testing;
+using namespace dap;
+using namespace dap::crtp;
+
+namespace
+{
+    class Counter
+    {
+        float m_count{0};
+
+    public:
+        auto operator()(float step)
+        {
+            m_count += step;
+            return m_count;
+        }
+        void reset()
+        {
+            m_count = 0;
+        }
+    };
+    using counter_t = decltype(processor<Counter>::with_inputs<float>::named("step"_s));
+    using input_t   = SharedInput<counter_t>;
+    using graph_t   = SharedNode<counter_t, decltype(input_t{} + input_t{} * input_t{})>;
+
+    // a reader evaluated every 4 samples, the other one every sample
+    using control_t = control_rate<input_t, 4>;
+    using mixed_t   = SharedNode<counter_t, decltype(input_t{} + control_t{})>;
+
+    graph_t makeGraph()
+    {
+        graph_t graph;
+        graph.input("source"_s).input("step"_s) = 1.0f;
+        return graph;
+    }
+
+    // counts the visits of the nodes of type T
+    template <typename T>
+    struct Count
+    {
+        size_t& count;
+
+        void visit(T&)
+        {
+            ++count;
+        }
+        template <typename U>
+        void visit(U&)
+        {
+        }
+    };
+}
+
+TEST(SharedNodeTest, evaluated_once_per_sample)
+{
+    static_assert(graph_t::readers() == 3, "");
+    static_assert(graph_t::byBlock(), "");
+    auto graph = makeGraph();
+    for (int i = 1; i < 10; ++i)
+    {
+        const float x = float(i);
+        ASSERT_FLOAT_EQ(x + x * x, graph());
+    }
+}
+TEST(SharedNodeTest, evaluated_once_per_block)
+{
+    auto graph = makeGraph();
+    const size_t frames = 150;
+    std::vector<float> output(frames);
+    graph.process(output.data(), frames);
+    for (size_t i = 0; i < frames; ++i)
+    {
+        const float x = float(i + 1);
+        ASSERT_FLOAT_EQ(x + x * x, output[i]);
+    }
+}
+TEST(SharedNodeTest, readers_at_control_rate)
+{
+    // the control rate reader makes the node render sample by sample
+    static_assert(mixed_t::readers() == 2, "");
+    static_assert(!mixed_t::byBlock(), "");
+    mixed_t graph;
+    graph.input("source"_s).input("step"_s) = 1.0f;
+    const size_t frames = 150;
+    std::vector<float> output(frames);
+    graph.process(output.data(), frames);
+    for (size_t i = 0; i < frames; ++i)
+    {
+        ASSERT_FLOAT_EQ(float(i + 1 + i - i % 4 + 1), output[i]) << i;
+    }
+}
+TEST(SharedNodeTest, copies_read_their_own_source)
+{
+    auto graph = makeGraph();
+    graph();
+    auto copy = graph;
+    copy.input("source"_s).input("step"_s) = 2.0f;
+    // 1 + 1 * 1, then 2 + 2 * 2
+    ASSERT_FLOAT_EQ(6.0f, graph());
+    // 3 + 3 * 3
+    ASSERT_FLOAT_EQ(12.0f, copy());
+}
+TEST(SharedNodeTest, source_visited_once)
+{
+    auto graph = makeGraph();
+    size_t count = 0;
+    NodeVisitor<Count<counter_t>> visit(Count<counter_t>{count});
+    visit(graph);
+    ASSERT_EQ(1u, count);
+
+    graph();
+    graph();
+    resetState(graph);
+    ASSERT_FLOAT_EQ(2.0f, graph());
+}
@@ -0,0 +1,236 @@
+#include "crtp/nodes/Node.h"
+#include "crtp/nodes/Processor.h"
+#include "crtp/utility/DelayMemory.h"
+#include "crtp/utility/StaticSchedule.h"
+#include "dsp/CombFilter.h"
+#include "dsp/LadderFilter.h"
+#include "dsp/Mixer.h"
+#include "dsp/Oscillator.h"
+#include "dsp/Smoother.h"
+#include <gtest/gtest.h>
+#include <vector>
+
+using namespace testing;
+using namespace dap;
+using namespace dap::crtp;
+
+namespace
+{
+    using shape_t   = dsp::OscillatorFunctions::Shape;
+    using control_t = ControlRateNode<ProcessorNode<dsp::FixedSmoother<float, 16>,
+                                                    Node::Inputs<float>,
+                                                    NODE_INPUT_NAMES("value"_s)>,
+                                      8,
+                                      ControlInterpolation::Linear>;
+    template <typename Freq>
+    using osc_t = ProcessorNode<dsp::Oscillator<float>,
+                                Node::Inputs<control_t, Freq, float, float, shape_t>,
+                                NODE_INPUT_NAMES(
+                                    "gain"_s, "frequency"_s, "phase"_s, "samplerate"_s, "shape"_s)>;
+    using lfo_t = osc_t<ValueNode<float>>;
+    using fm_t  = osc_t<decltype(lfo_t{} + 0.0f)>;
+    using bus_t = ProcessorNode<dsp::Mixer::Bus,
+                                Node::Inputs<float, fm_t>,
+                                NODE_INPUT_NAMES("gain"_s, "signal"_s)>;
+    using mixer_t =
+        decltype(processor<dsp::Mixer>::with_inputs<bus_t, bus_t>::prefixed_by("bus_"_s));
+    using graph_t = ProcessorNode<dsp::LadderFilter<float>,
+                                  Node::Inputs<mixer_t, float, float, float>,
+                                  NODE_INPUT_NAMES(
+                                      "signal"_s, "frequency"_s, "resonance"_s, "samplerate"_s)>;
+
+    template <typename Osc>
+    void initOsc(Osc& osc)
+    {
+        osc.input("gain"_s).input("value"_s) = 1.0f;
+        osc.input("phase"_s)                 = 0.0f;
+        osc.input("samplerate"_s)            = 44100.0f;
+        osc.input("shape"_s)                 = shape_t::Sine;
+    }
+    void init(fm_t& osc, float frequency, float depth)
+    {
+        auto& lfo = osc.input("frequency"_s).input("x"_s);
+        initOsc(osc);
+        initOsc(lfo);
+        osc.input("frequency"_s).input("y"_s) = frequency;
+        lfo.input("gain"_s).input("value"_s)  = depth;
+        lfo.input("frequency"_s)              = 3.0f;
+    }
+    void init(graph_t& graph)
+    {
+        auto& mixer = graph.input("signal"_s);
+        mixer.input<0>().input("gain"_s) = 0.5f;
+        mixer.input<1>().input("gain"_s) = 0.7f;
+        init(mixer.input<0>().input("signal"_s), 440.0f, 100.0f);
+        init(mixer.input<1>().input("signal"_s), 220.0f, 20.0f);
+        graph.input("frequency"_s)  = 2000.0f;
+        graph.input("resonance"_s)  = 1.5f;
+        graph.input("samplerate"_s) = 44100.0f;
+    }
+}
+
+TEST(StaticScheduleTest, layout)
+{
+    using schedule_t = StaticSchedule<graph_t>;
+    // filter, mixer, and two buses each with an fm oscillator, an adder and an lfo, both
+    // oscillators having a smoothed gain at control rate
+    ASSERT_EQ(18u, schedule_t::stepCount());
+    // filter, mixer, bus, oscillator, adder, smoother
+    ASSERT_EQ(6u, schedule_t::stateGroupCount());
+    // the smoother of the deepest lfo renders into buffer 10: filter (0), second bus (1 + 1 + 1),
+    // its oscillator (3 + 1 + 1), its adder (5 + 1 + 1), the lfo (7 + 1 + 0), its gain (8 + 1 + 0)
+    // and the smoother (9 + 1)
+    ASSERT_EQ(11u, schedule_t::bufferCount());
+
+    // a control rate node is flattened with its source, unless it is a value
+    ASSERT_EQ(2u, StaticSchedule<control_t>::stepCount());
+    using control_value_t = ControlRateNode<ValueNode<float>, 8, ControlInterpolation::Linear>;
+    ASSERT_EQ(0u, StaticSchedule<control_value_t>::stepCount());
+}
+
+TEST(StaticScheduleTest, matches_graph)
+{
+    graph_t graph;
+    graph_t scheduled;
+    init(graph);
+    init(scheduled);
+    StaticSchedule<graph_t> schedule(scheduled);
+
+    std::vector<float> expected(1000);
+    std::vector<float> out(expected.size());
+    for (auto frames : {size_t{1000}, size_t{37}, size_t{64}, size_t{500}})
+    {
+        graph.process(expected.data(), frames);
+        schedule.process(out.data(), frames);
+        for (size_t n = 0; n < frames; ++n)
+        {
+            ASSERT_FLOAT_EQ(expected[n], out[n]);
+        }
+    }
+
+    // parameters are still read from the graph
+    scheduled.input("frequency"_s) = 500.0f;
+    graph.input("frequency"_s)     = 500.0f;
+    graph.process(expected.data(), expected.size());
+    schedule.process(out.data(), out.size());
+    for (size_t n = 0; n < out.size(); ++n)
+    {
+        ASSERT_FLOAT_EQ(expected[n], out[n]);
+    }
+}
+
+TEST(StaticScheduleTest, takes_the_processors_of_the_graph)
+{
+    // a comb filter whose line is sized and attached on the graph, fed by an oscillator
+    using comb_t = ProcessorNode<dsp::FeedbackCombFilter<float, dsp::dynamic_delay>,
+                                 Node::Inputs<lfo_t, float, float>,
+                                 NODE_INPUT_NAMES("signal"_s, "delay"_s, "feedback"_s)>;
+    using reference_t = ProcessorNode<dsp::FeedbackCombFilter<float, 512>,
+                                      Node::Inputs<lfo_t, float, float>,
+                                      NODE_INPUT_NAMES("signal"_s, "delay"_s, "feedback"_s)>;
+    const auto init = [](auto& comb) {
+        initOsc(comb.input("signal"_s));
+        comb.input("signal"_s).input("frequency"_s) = 440.0f;
+        comb.input("delay"_s)                       = 300.0f;
+        comb.input("feedback"_s)                    = 0.5f;
+    };
+    comb_t graph;
+    reference_t reference;
+    init(graph);
+    init(reference);
+    graph.processor().setMaxDelay(300);
+    dsp::DelayMemory memory;
+    attachDelayMemory(memory, graph);
+
+    std::vector<float> expected(400);
+    std::vector<float> out(expected.size());
+    const auto render = [&](auto& renderer, size_t frames) {
+        reference.process(expected.data(), frames);
+        renderer.process(out.data(), frames);
+        for (size_t n = 0; n < frames; ++n)
+        {
+            ASSERT_FLOAT_EQ(expected[n], out[n]) << n;
+        }
+    };
+    {
+        StaticSchedule<comb_t> schedule(graph);
+        // 4 steps: the comb filter, the oscillator, its gain and the smoother of the gain
+        ASSERT_EQ(4u, schedule.stepCount());
+        ASSERT_TRUE(schedule.processorOf(graph).attached());
+        ASSERT_FALSE(graph.processor().attached());
+        for (size_t block = 0; block < 3; ++block)
+        {
+            render(schedule, 37 + block * 61);
+        }
+    }
+    // the graph goes on with the state left by the schedule
+    ASSERT_TRUE(graph.processor().attached());
+    for (size_t block = 3; block < 6; ++block)
+    {
+        render(graph, 37 + block * 61);
+    }
+}
+
+TEST(StaticScheduleTest, control_rate_subtrees)
+{
+    // a gain updated every 3 samples, and a frequency every 5 samples reading a control rate node
+    // itself: the inner smoother runs once every 15 samples
+    using smoother_t = ProcessorNode<dsp::FixedSmoother<float, 16>,
+                                     Node::Inputs<float>,
+                                     NODE_INPUT_NAMES("value"_s)>;
+    using gain_t  = ControlRateNode<smoother_t, 3, ControlInterpolation::Linear>;
+    using inner_t = ControlRateNode<smoother_t, 3, ControlInterpolation::None>;
+    using frequency_t =
+        ControlRateNode<decltype(inner_t{} + 100.0f), 5, ControlInterpolation::None>;
+    using osc_t = ProcessorNode<dsp::Oscillator<float>,
+                                Node::Inputs<gain_t, frequency_t, float, float, shape_t>,
+                                NODE_INPUT_NAMES(
+                                    "gain"_s, "frequency"_s, "phase"_s, "samplerate"_s, "shape"_s)>;
+    // oscillator, gain and its smoother, frequency, adder, inner control and its smoother
+    ASSERT_EQ(7u, StaticSchedule<osc_t>::stepCount());
+
+    const auto init = [](osc_t& osc) {
+        osc.input("gain"_s).input("value"_s)                   = 1.0f;
+        osc.input("frequency"_s).input("x"_s).input("value"_s) = 340.0f;
+        osc.input("phase"_s)                                   = 0.0f;
+        osc.input("samplerate"_s)                              = 44100.0f;
+        osc.input("shape"_s)                                   = shape_t::Saw;
+    };
+    osc_t graph;
+    osc_t scheduled;
+    init(graph);
+    init(scheduled);
+    StaticSchedule<osc_t> schedule(scheduled);
+
+    std::vector<float> expected(1000);
+    std::vector<float> out(expected.size());
+    for (auto frames : {size_t{1}, size_t{2}, size_t{13}, size_t{1000}, size_t{64}, size_t{7}})
+    {
+        for (size_t n = 0; n < frames; ++n)
+        {
+            expected[n] = graph();
+        }
+        schedule.process(out.data(), frames);
+        for (size_t n = 0; n < frames; ++n)
+        {
+            ASSERT_FLOAT_EQ(expected[n], out[n]) << frames << " " << n;
+        }
+    }
+}
+
+TEST(StaticScheduleTest, reset)
+{
+    graph_t graph;
+    init(graph);
+    StaticSchedule<graph_t> schedule(graph);
+
+    std::vector<float> expected(300);
+    std::vector<float> out(expected.size());
+    schedule.process(expected.data(), expected.size());
+    schedule.reset();
+    schedule.process(out.data(), out.size());
+    for (size_t n = 0; n < out.size(); ++n)
+    {
+        ASSERT_EQ(expected[n], out[n]);
+    }
+}
@@ -0,0 +1,134 @@
+#include "crtp/nodes/Node.h"
+#include "crtp/utility/VoicePool.h"
+#include "dsp/Oscillator.h"
+#include "dsp/Smoother.h"
+#include <gtest/gtest.h>
+#include <vector>
+
+using namespace testing;
+using namespace dap;
+using namespace dap::crtp;
+
+namespace
+{
+    using shape_t = dsp::OscillatorFunctions::Shape;
+
+    using gain_t = ProcessorNode<dsp::FixedSmoother<float, 64>,
+                                 Node::Inputs<float>,
+                                 NODE_INPUT_NAMES("value"_s)>;
+    using osc_t  = ProcessorNode<dsp::Oscillator<float>,
+                                Node::Inputs<gain_t, float, float, float, shape_t>,
+                                NODE_INPUT_NAMES(
+                                    "gain"_s, "frequency"_s, "phase"_s, "samplerate"_s, "shape"_s)>;
+
+    void init(osc_t& osc, float gain, float frequency)
+    {
+        osc.input("gain"_s).input("value"_s) = gain;
+        osc.input("frequency"_s)             = frequency;
+        osc.input("phase"_s)                 = 0.0f;
+        osc.input("samplerate"_s)            = 44100.0f;
+        osc.input("shape"_s)                 = shape_t::Sine;
+    }
+}
+
+TEST(VoicePoolTest, sums_active_voices)
+{
+    VoicePool<ValueNode<float>, 4> pool;
+    std::vector<float> out(100, 1.0f);
+
+    pool.process(out.data(), out.size());
+    for (auto x : out)
+    {
+        ASSERT_EQ(0.0f, x);
+    }
+
+    pool.noteOn(60) = 0.25f;
+    pool.noteOn(64) = 0.5f;
+    ASSERT_EQ(2u, pool.activeCount());
+    pool.process(out.data(), out.size());
+    for (auto x : out)
+    {
+        ASSERT_EQ(0.75f, x);
+    }
+}
+
+TEST(VoicePoolTest, released_voices_are_freed_once_silent)
+{
+    VoicePool<osc_t, 2> pool;
+    std::vector<float> out(4096);
+
+    init(pool.noteOn(60), 0.5f, 440.0f);
+    pool.process(out.data(), out.size());
+    ASSERT_EQ(1u, pool.activeCount());
+
+    ASSERT_EQ(nullptr, pool.noteOff(61));
+    auto* voice = pool.noteOff(60);
+    ASSERT_NE(nullptr, voice);
+    // still fading out
+    voice->input("gain"_s).input("value"_s) = 0.0f;
+    pool.process(out.data(), 64);
+    ASSERT_EQ(1u, pool.activeCount());
+    pool.process(out.data(), out.size());
+    ASSERT_EQ(0u, pool.activeCount());
+}
+
+TEST(VoicePoolTest, steals_oldest)
+{
+    VoicePool<ValueNode<float>, 2> pool(VoiceStealing::Oldest);
+    std::vector<float> out(64);
+
+    pool.noteOn(60) = 0.5f;
+    pool.noteOn(62) = 0.1f;
+    pool.process(out.data(), out.size());
+    pool.noteOn(64) = 0.2f;
+    ASSERT_EQ(2u, pool.activeCount());
+    ASSERT_EQ(nullptr, pool.noteOff(60));
+    ASSERT_NE(nullptr, pool.noteOff(62));
+    ASSERT_NE(nullptr, pool.noteOff(64));
+}
+
+TEST(VoicePoolTest, steals_quietest)
+{
+    VoicePool<ValueNode<float>, 2> pool(VoiceStealing::Quietest);
+    std::vector<float> out(64);
+
+    pool.noteOn(60) = 0.5f;
+    pool.noteOn(62) = 0.1f;
+    pool.process(out.data(), out.size());
+    pool.noteOn(64) = 0.2f;
+    ASSERT_EQ(nullptr, pool.noteOff(62));
+    ASSERT_NE(nullptr, pool.noteOff(60));
+}
+
+TEST(VoicePoolTest, steals_released_voices_first)
+{
+    VoicePool<ValueNode<float>, 2> pool(VoiceStealing::Oldest);
+    std::vector<float> out(64);
+
+    pool.noteOn(60) = 0.5f;
+    pool.noteOn(62) = 0.5f;
+    pool.noteOff(62);
+    pool.process(out.data(), out.size());
+    pool.noteOn(64) = 0.5f;
+    ASSERT_NE(nullptr, pool.noteOff(60));
+}
+
+TEST(VoicePoolTest, stolen_voices_restart_from_initial_state)
+{
+    VoicePool<osc_t, 1> pool;
+    std::vector<float> out(1000);
+    std::vector<float> expected(out.size());
+
+    osc_t fresh;
+    init(fresh, 0.5f, 330.0f);
+    fresh.process(expected.data(), expected.size());
+
+    init(pool.noteOn(60), 0.5f, 440.0f);
+    pool.process(out.data(), 123);
+    init(pool.noteOn(62), 0.5f, 330.0f);
+    pool.process(out.data(), out.size());
+    for (size_t n = 0; n < out.size(); ++n)
+    {
+        ASSERT_EQ(expected[n], out[n]);
+    }
+}
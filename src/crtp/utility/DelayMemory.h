@@ -0,0 +1,181 @@
+#ifndef CRTP_UTILITY_DELAY_MEMORY_H
+#define CRTP_UTILITY_DELAY_MEMORY_H
+
+#include "InputNamesPrinter.h"
+#include "NodeVisitor.h"
+#include "base/Streamable.h"
+#include "crtp/nodes/Parallel.h"
+#include "dsp/DelayMemory.h"
+#include <ostream>
+
+namespace dap
+{
+    namespace crtp
+    {
+        template <typename Fn>
+        class DelayMemoryVisitor;
+
+        struct DelayMemoryFigures
+        {
+            size_t lines{0};       // processors holding delay lines
+            size_t inlineBytes{0}; // samples held by the processors themselves
+            size_t arenaBytes{0};  // samples of the dynamic lines, see DelayMemory::footprint
+        };
+
+        // the delay memory of the processors of graph
+        template <typename Graph>
+        DelayMemoryFigures delayMemory(Graph& graph);
+
+        // sets the maximum delay, in samples, of the dynamic delay lines of node and its inputs,
+        // e.g. of a flanger of the graph. The graph must then be attached to its memory again.
+        template <typename Node>
+        void setMaxDelay(Node& node, size_t delay);
+
+        // sizes memory to the dynamic delay lines of graph, their maximum delay being set, and
+        // attaches them to it. Lines attached to memory before must be attached again.
+        template <typename Graph>
+        void attachDelayMemory(dsp::DelayMemory& memory, Graph& graph);
+
+        // prints the delay memory of every processor of graph holding delay lines, then the total
+        template <typename Graph>
+        void printDelayMemory(std::ostream& out, Graph& graph);
+
+        namespace detail
+        {
+            // true if Processor holds delay lines, see DelayLine::memorySize
+            template <typename Processor, typename = void>
+            struct HasDelayMemory : std::false_type
+            {
+            };
+            template <typename Processor>
+            struct HasDelayMemory<
+                Processor,
+                std::void_t<decltype(std::declval<const Processor&>().memorySize())>>
+            : std::true_type
+            {
+            };
+
+            // true if the delay lines of Processor take their samples from a DelayMemory
+            template <typename Processor, typename = void>
+            struct HasDynamicDelay : std::false_type
+            {
+            };
+            template <typename Processor>
+            struct HasDynamicDelay<Processor,
+                                   std::void_t<decltype(std::declval<Processor&>().attach(
+                                       std::declval<dsp::DelayMemory&>()))>>
+            : std::true_type
+            {
+            };
+        }
+    }
+}
+
+// calls fn(node, processor) for every processor node whose processor holds delay lines
+template <typename Fn>
+class dap::crtp::DelayMemoryVisitor
+{
+    Fn m_fn;
+
+public:
+    explicit DelayMemoryVisitor(Fn fn)
+    : m_fn(fn)
+    {
+    }
+    template <typename Processor,
+              typename Inputs,
+              typename InputNames,
+              DAP_REQUIRES(detail::HasDelayMemory<Processor>::value)>
+    void visit(ProcessorNode<Processor, Inputs, InputNames>& node)
+    {
+        m_fn(node, node.processor());
+    }
+    template <typename Processor,
+              typename Inputs,
+              typename InputNames,
+              DAP_REQUIRES(detail::HasDelayMemory<Processor>::value)>
+    void visit(ParallelNode<Processor, Inputs, InputNames>& node)
+    {
+        m_fn(node, node.processor());
+    }
+    template <typename... Ts>
+    void visit(Ts&...)
+    {
+        // no delay lines
+    }
+};
+
+namespace dap
+{
+    namespace crtp
+    {
+        namespace detail
+        {
+            template <typename Graph, typename Fn>
+            void visitDelayMemory(Graph& graph, Fn fn)
+            {
+                NodeVisitor<DelayMemoryVisitor<Fn>> visit(DelayMemoryVisitor<Fn>{fn});
+                visit(graph);
+            }
+        }
+    }
+}
+
+template <typename Graph>
+dap::crtp::DelayMemoryFigures dap::crtp::delayMemory(Graph& graph)
+{
+    DelayMemoryFigures figures;
+    detail::visitDelayMemory(graph, [&figures](auto&, auto& processor) {
+        using processor_t = std::decay_t<decltype(processor)>;
+        ++figures.lines;
+        if constexpr (detail::HasDynamicDelay<processor_t>::value)
+        {
+            figures.arenaBytes += dsp::DelayMemory::footprint(processor.memorySize());
+        }
+        else
+        {
+            figures.inlineBytes += processor.memorySize();
+        }
+    });
+    return figures;
+}
+
+template <typename Node>
+void dap::crtp::setMaxDelay(Node& node, size_t delay)
+{
+    detail::visitDelayMemory(node, [delay](auto&, auto& processor) {
+        if constexpr (detail::HasDynamicDelay<std::decay_t<decltype(processor)>>::value)
+        {
+            processor.setMaxDelay(delay);
+        }
+    });
+}
+
+template <typename Graph>
+void dap::crtp::attachDelayMemory(dsp::DelayMemory& memory, Graph& graph)
+{
+    memory.resize(delayMemory(graph).arenaBytes);
+    detail::visitDelayMemory(graph, [&memory](auto&, auto& processor) {
+        if constexpr (detail::HasDynamicDelay<std::decay_t<decltype(processor)>>::value)
+        {
+            processor.attach(memory);
+        }
+    });
+}
+
+template <typename Graph>
+void dap::crtp::printDelayMemory(std::ostream& out, Graph& graph)
+{
+    detail::visitDelayMemory(graph, [&out](auto& node, auto& processor) {
+        using processor_t = std::decay_t<decltype(processor)>;
+        out << demangle<processor_t>() << " (" << InputNamesPrinter::join(node.inputNames())
+            << "): " << processor.memorySize() << " bytes "
+            << (detail::HasDynamicDelay<processor_t>::value ? "in the arena" : "inline")
+            << std::endl;
+    });
+    const auto figures = delayMemory(graph);
+    out << "delay memory of " << figures.lines << " processors: " << figures.inlineBytes
+        << " bytes inline, " << figures.arenaBytes << " bytes in the arena" << std::endl;
+}
+
+#endif // CRTP_UTILITY_DELAY_MEMORY_H
@@ -3,6 +3,7 @@
 
 #include "NodeVisitor.h"
 #include <iostream>
+#include <string>
 
 namespace dap
 {
@@ -31,6 +32,16 @@ class dap::crtp::InputNamesPrinter
     }
 
 public:
+    // comma separated names, e.g. of node.inputNames()
+    template <typename... Ts>
+    static std::string join(const std::tuple<Ts...>& names)
+    {
+        std::string joined;
+        for_each(names, [&joined](auto name) {
+            joined += (joined.empty() ? "" : ", ") + to_string(name);
+        });
+        return joined;
+    }
     template <typename... Ts>
     void visit(ProcessorNode<Ts...>& node)
     {
@@ -0,0 +1,77 @@
+#ifndef CRTP_UTILITY_PROFILE_REPORTER_H
+#define CRTP_UTILITY_PROFILE_REPORTER_H
+
+#include "InputNamesPrinter.h"
+#include "NodeVisitor.h"
+#include "base/Streamable.h"
+#include "crtp/nodes/Parallel.h"
+#include <ostream>
+
+namespace dap
+{
+    namespace crtp
+    {
+        class ProfileReporter;
+
+        // prints the cost of every profiled node of graph, see traits::IsProfiled
+        template <typename Graph>
+        void printProfile(std::ostream& out, Graph& graph);
+    }
+}
+
+// prints one line per profiled processor node, naming it by its processor and input names, with
+// the figures it recorded in the ProfileTable
+class dap::crtp::ProfileReporter
+{
+    std::ostream& m_out;
+
+    template <typename Processor, typename TNode>
+    void report(const TNode& node)
+    {
+        const auto figures = node.profile();
+        m_out << demangle<Processor>() << " (" << InputNamesPrinter::join(node.inputNames())
+              << "): calls " << figures.calls << ", frames " << figures.frames << ", cycles "
+              << figures.cycles;
+        if (figures.frames > 0)
+        {
+            m_out << ", cycles per frame " << figures.cycles / figures.frames;
+        }
+        m_out << std::endl;
+    }
+
+public:
+    explicit ProfileReporter(std::ostream& out)
+    : m_out(out)
+    {
+    }
+    template <typename Processor,
+              typename Inputs,
+              typename InputNames,
+              DAP_REQUIRES(traits::IsProfiled<Processor>::value)>
+    void visit(ProcessorNode<Processor, Inputs, InputNames>& node)
+    {
+        report<Processor>(node);
+    }
+    template <typename Processor,
+              typename Inputs,
+              typename InputNames,
+              DAP_REQUIRES(traits::IsProfiled<Processor>::value)>
+    void visit(ParallelNode<Processor, Inputs, InputNames>& node)
+    {
+        report<Processor>(node);
+    }
+    template <typename... Ts>
+    void visit(Ts&...)
+    {
+        // not profiled
+    }
+};
+
+template <typename Graph>
+void dap::crtp::printProfile(std::ostream& out, Graph& graph)
+{
+    auto visit = make_node_visitor<ProfileReporter>(out);
+    visit(graph);
+}
+
+#endif // CRTP_UTILITY_PROFILE_REPORTER_H
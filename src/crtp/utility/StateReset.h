@@ -0,0 +1,41 @@
+#ifndef CRTP_UTILITY_STATE_RESET_H
+#define CRTP_UTILITY_STATE_RESET_H
+
+#include "NodeVisitor.h"
+
+namespace dap
+{
+    namespace crtp
+    {
+        class StateReset;
+
+        // resets the state of node and all of its inputs, as if the graph had just been
+        // constructed while keeping its parameters
+        template <typename T>
+        void resetState(T& node);
+    }
+}
+
+// brings every visited node back to its initial state, see NodeExpression::resetState
+class dap::crtp::StateReset
+{
+public:
+    template <typename T, DAP_REQUIRES(traits::IsCrtpNode<T>::value)>
+    void visit(T& node)
+    {
+        node.resetState();
+    }
+    template <typename T, DAP_REQUIRES(!traits::IsCrtpNode<T>::value)>
+    void visit(T&)
+    {
+        // values have no state
+    }
+};
+
+template <typename T>
+void dap::crtp::resetState(T& node)
+{
+    NodeVisitor<StateReset>()(node);
+}
+
+#endif // CRTP_UTILITY_STATE_RESET_H
@@ -0,0 +1,560 @@
+#ifndef CRTP_UTILITY_STATIC_SCHEDULE_H
+#define CRTP_UTILITY_STATIC_SCHEDULE_H
+
+#include "StateReset.h"
+#include "crtp/nodes/Parallel.h"
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <tuple>
+
+namespace dap
+{
+    namespace crtp
+    {
+        template <typename Graph>
+        class StaticSchedule;
+
+        namespace detail
+        {
+            namespace schedule
+            {
+                // how a scheduled processor receives one of its inputs
+                enum class InputKind
+                {
+                    Value,    // read once per block from the graph
+                    Pulled,   // rendered by the input node itself, its state stays in the graph
+                    Scheduled // rendered by an earlier step of the schedule into a buffer
+                };
+
+                // processor nodes, whose processor the schedule takes over
+                template <typename T>
+                struct Schedulable : std::false_type
+                {
+                };
+                template <typename Processor, typename... Is, typename InputNames>
+                struct Schedulable<ProcessorNode<Processor, Node::Inputs<Is...>, InputNames>>
+                : std::true_type
+                {
+                    using processor = Processor;
+                    using inputs    = std::tuple<Is...>;
+                };
+                template <typename Processor, typename... Is, typename InputNames>
+                struct Schedulable<ParallelNode<Processor, Node::Inputs<Is...>, InputNames>>
+                : Schedulable<ProcessorNode<Processor, Node::Inputs<Is...>, InputNames>>
+                {
+                };
+
+                template <typename T>
+                struct IsValueNode : std::false_type
+                {
+                };
+                template <typename T>
+                struct IsValueNode<ValueNode<T>> : std::true_type
+                {
+                };
+                template <typename Ratio, typename T>
+                struct IsValueNode<StaticValueNode<Ratio, T>> : std::true_type
+                {
+                };
+
+                template <typename T>
+                struct IsControlRate : std::false_type
+                {
+                };
+                template <typename TInput, size_t Divisor, ControlInterpolation Interpolation>
+                struct IsControlRate<ControlRateNode<TInput, Divisor, Interpolation>>
+                : std::true_type
+                {
+                    using source = TInput;
+                };
+
+                // outputs are buffered as Sample, e.g. a double mixer output is buffered as float
+                template <typename Sample, typename T>
+                constexpr bool isBuffered()
+                {
+                    using result_t = std::decay_t<decltype(std::declval<T&>()())>;
+                    return std::is_same<result_t, Sample>::value ||
+                           (std::is_floating_point<result_t>::value &&
+                            std::is_floating_point<Sample>::value);
+                }
+
+                template <typename Sample, typename T>
+                constexpr InputKind inputKind()
+                {
+                    using node_t = std::remove_const_t<T>;
+                    if constexpr (!traits::IsCrtpNode<std::remove_pointer_t<node_t>>::value ||
+                                  IsValueNode<node_t>::value)
+                    {
+                        return InputKind::Value;
+                    }
+                    else if constexpr (Schedulable<node_t>::value)
+                    {
+                        return isBuffered<Sample, node_t>() ? InputKind::Scheduled
+                                                            : InputKind::Pulled;
+                    }
+                    else if constexpr (IsControlRate<node_t>::value)
+                    {
+                        // flattened when its source is, which then renders one value per update
+                        using source_t = typename IsControlRate<node_t>::source;
+                        return isBuffered<Sample, node_t>() &&
+                                       inputKind<Sample, source_t>() == InputKind::Scheduled
+                                   ? InputKind::Scheduled
+                                   : InputKind::Pulled;
+                    }
+                    else
+                    {
+                        return InputKind::Pulled;
+                    }
+                }
+
+                // one processor invocation: the node found at Path renders into buffer Slot,
+                // and its scheduled inputs are read from buffers Slot + 1 + input index. Domain
+                // holds the paths of the control rate nodes the node is below, outermost first,
+                // the step renders as many frames as the innermost one updates
+                template <typename Processor,
+                          typename Path,
+                          size_t Slot,
+                          typename Kinds,
+                          typename Domain>
+                struct Step
+                {
+                    using processor = Processor;
+                    using path      = Path;
+                    using domain    = Domain;
+                    static constexpr size_t slot()
+                    {
+                        return Slot;
+                    }
+                    static constexpr auto inputs()
+                    {
+                        return std::make_index_sequence<Kinds::size()>{};
+                    }
+                };
+
+                // the control rate node found at Path renders into buffer Slot, the values of
+                // its source at each update being read from buffer Slot + 1
+                template <typename Path, size_t Slot, typename Domain>
+                struct ControlStep
+                {
+                    using processor = void;
+                    using path      = Path;
+                    using domain    = Domain;
+                    static constexpr size_t slot()
+                    {
+                        return Slot;
+                    }
+                };
+
+                template <typename Path, size_t I>
+                struct Append;
+                template <size_t... Is, size_t I>
+                struct Append<std::index_sequence<Is...>, I>
+                {
+                    using type = std::index_sequence<Is..., I>;
+                };
+
+                // post order list of the steps rendering TNode, i.e. inputs come first
+                template <typename Sample,
+                          typename TNode,
+                          typename Path,
+                          size_t Slot,
+                          typename Domain,
+                          bool = IsControlRate<TNode>::value>
+                struct Flatten
+                {
+                    using inputs = typename Schedulable<TNode>::inputs;
+                    template <size_t I>
+                    using input_t = tuple_element_t<I, inputs>;
+
+                    template <size_t I>
+                    static auto inputSteps()
+                    {
+                        if constexpr (inputKind<Sample, input_t<I>>() == InputKind::Scheduled)
+                        {
+                            return typename Flatten<Sample,
+                                                    std::remove_const_t<input_t<I>>,
+                                                    typename Append<Path, I>::type,
+                                                    Slot + 1 + I,
+                                                    Domain>::type{};
+                        }
+                        else
+                        {
+                            return std::tuple<>{};
+                        }
+                    }
+                    template <size_t... Is>
+                    static auto steps(const std::index_sequence<Is...>&)
+                    {
+                        using kinds_t =
+                            std::integer_sequence<InputKind, inputKind<Sample, input_t<Is>>()...>;
+                        using step_t = Step<typename Schedulable<TNode>::processor,
+                                            Path,
+                                            Slot,
+                                            kinds_t,
+                                            Domain>;
+                        return std::tuple_cat(inputSteps<Is>()..., std::tuple<step_t>{});
+                    }
+                    using type =
+                        decltype(steps(std::make_index_sequence<std::tuple_size<inputs>::value>{}));
+                };
+                template <typename Sample,
+                          typename TNode,
+                          typename Path,
+                          size_t Slot,
+                          typename... Ds>
+                struct Flatten<Sample, TNode, Path, Slot, std::tuple<Ds...>, true>
+                {
+                    using source_t = std::remove_const_t<typename IsControlRate<TNode>::source>;
+                    using type     = decltype(std::tuple_cat(
+                        typename Flatten<Sample,
+                                         source_t,
+                                         typename Append<Path, 0>::type,
+                                         Slot + 1,
+                                         std::tuple<Ds..., Path>>::type{},
+                        std::tuple<ControlStep<Path, Slot, std::tuple<Ds...>>>{}));
+                };
+
+                template <typename Sample,
+                          typename Graph,
+                          bool = inputKind<Sample, Graph>() == InputKind::Scheduled>
+                struct FlattenGraph
+                {
+                    using type = std::tuple<>;
+                };
+                template <typename Sample, typename Graph>
+                struct FlattenGraph<Sample, Graph, true>
+                {
+                    using type = typename Flatten<Sample,
+                                                  Graph,
+                                                  std::index_sequence<>,
+                                                  0,
+                                                  std::tuple<>>::type;
+                };
+
+                // types of Ts other than void, each listed once
+                template <typename Unique, typename Ts>
+                struct UniqueImpl;
+                template <typename... Us>
+                struct UniqueImpl<std::tuple<Us...>, std::tuple<>>
+                {
+                    using type = std::tuple<Us...>;
+                };
+                template <typename... Us, typename T, typename... Ts>
+                struct UniqueImpl<std::tuple<Us...>, std::tuple<T, Ts...>>
+                : UniqueImpl<std::conditional_t<std::disjunction<std::is_void<T>,
+                                                                 std::is_same<T, Us>...>::value,
+                                                std::tuple<Us...>,
+                                                std::tuple<Us..., T>>,
+                             std::tuple<Ts...>>
+                {
+                };
+                template <typename Ts>
+                using unique_t = typename UniqueImpl<std::tuple<>, Ts>::type;
+
+                // occurrences of T among the first end types of Ts
+                template <typename T, typename... Ts>
+                constexpr size_t countOf(size_t end)
+                {
+                    constexpr bool same[] = {false, std::is_same<T, Ts>::value...};
+                    size_t count          = 0;
+                    for (size_t i = 0; i < end; ++i)
+                    {
+                        count += same[i + 1] ? 1 : 0;
+                    }
+                    return count;
+                }
+
+                template <typename Steps>
+                struct Layout;
+                template <typename... Steps>
+                struct Layout<std::tuple<Steps...>>
+                {
+                    using processors_t = std::tuple<typename Steps::processor...>;
+                    using groups_t     = unique_t<processors_t>;
+
+                    // processors of the same type are stored in the same array
+                    template <typename Groups>
+                    struct States;
+                    template <typename... Ps>
+                    struct States<std::tuple<Ps...>>
+                    {
+                        using type = std::tuple<
+                            std::array<Ps, countOf<Ps, typename Steps::processor...>(
+                                               sizeof...(Steps))>...>;
+                    };
+                    using states_t = typename States<groups_t>::type;
+
+                    template <size_t K>
+                    static constexpr size_t group()
+                    {
+                        return Index<tuple_element_t<K, processors_t>, groups_t>::value;
+                    }
+                    template <size_t K>
+                    static constexpr size_t indexInGroup()
+                    {
+                        return countOf<tuple_element_t<K, processors_t>,
+                                       typename Steps::processor...>(K);
+                    }
+                    static constexpr size_t bufferCount()
+                    {
+                        return std::max({size_t(0), (Steps::slot() + 1)...});
+                    }
+                };
+            }
+        }
+    }
+}
+
+// Flattens a graph at compile time into a linear list of processor invocations, inputs first,
+// which process() runs as straight-line code, block by block. Intermediate blocks live in a few
+// buffers assigned at compile time and reused along the evaluation order. The schedule takes the
+// processors of the graph over, moving them into one contiguous array per processor type, and
+// moves them back when destroyed.
+//
+// Processor nodes are scheduled, including ParallelNode whose inputs then run serially, and so
+// are control rate nodes over them: their subtree renders one sample per update of the control
+// rate node, which then interpolates the values rendered. Other nodes (e.g. shared ones) render
+// their own subtree as usual, and the graph keeps holding every parameter. The graph must outlive
+// the schedule, and must not be rendered directly while the schedule holds its processors.
+template <typename Graph>
+class dap::crtp::StaticSchedule final
+{
+    using InputKind = detail::schedule::InputKind;
+    using sample_t  = std::decay_t<decltype(std::declval<Graph&>()())>;
+    using steps_t   = typename detail::schedule::FlattenGraph<sample_t, Graph>::type;
+    using layout_t  = detail::schedule::Layout<steps_t>;
+    using states_t  = typename layout_t::states_t;
+    using buffers_t = std::array<detail::block_t<sample_t>, layout_t::bufferCount()>;
+
+    template <size_t K>
+    using step_t = tuple_element_t<K, steps_t>;
+
+    Graph& m_graph;
+    states_t m_states;
+    buffers_t m_buffers{};
+
+    template <typename T>
+    static T& nodeAt(T& node, const std::index_sequence<>&)
+    {
+        return node;
+    }
+    template <typename T, size_t I, size_t... Is>
+    static auto& nodeAt(T& node, const std::index_sequence<I, Is...>&)
+    {
+        return nodeAt(node.template input<I>(), std::index_sequence<Is...>{});
+    }
+    template <size_t K>
+    auto& state()
+    {
+        constexpr size_t group = layout_t::template group<K>();
+        return std::get<group>(m_states)[layout_t::template indexInGroup<K>()];
+    }
+    // frames rendered by a step below the control rate nodes found at Paths, outermost first
+    template <typename... Paths>
+    size_t framesOf(const std::tuple<Paths...>*, size_t frames)
+    {
+        ((frames = nodeAt(m_graph, Paths{}).ticks(frames)), ...);
+        return frames;
+    }
+    // moves the processors of the graph into the schedule, or back to the graph
+    template <size_t... Ks>
+    void exchange(bool take, const std::index_sequence<Ks...>&)
+    {
+        const auto move = [take](auto& processor, auto& state) {
+            if (take)
+            {
+                state = std::move(processor);
+            }
+            else
+            {
+                processor = std::move(state);
+            }
+        };
+        const auto visit = [this, &move](auto k) {
+            constexpr size_t K = decltype(k)::value;
+            if constexpr (!std::is_void<typename step_t<K>::processor>::value)
+            {
+                move(nodeAt(m_graph, typename step_t<K>::path{}).processor(), state<K>());
+            }
+        };
+        (visit(std::integral_constant<size_t, Ks>{}), ...);
+    }
+    template <typename Node, typename Processor, size_t... Ks>
+    void findProcessor(const Node& node, Processor*& processor, const std::index_sequence<Ks...>&)
+    {
+        const auto visit = [this, &node, &processor](auto k) {
+            constexpr size_t K = decltype(k)::value;
+            if constexpr (std::is_same<typename step_t<K>::processor, Processor>::value)
+            {
+                const void* scheduled = &nodeAt(m_graph, typename step_t<K>::path{});
+                if (scheduled == static_cast<const void*>(&node))
+                {
+                    processor = &state<K>();
+                }
+            }
+        };
+        (visit(std::integral_constant<size_t, Ks>{}), ...);
+    }
+    template <InputKind Kind, size_t Slot, typename T>
+    decltype(auto) argument(T& input, size_t frames)
+    {
+        if constexpr (Kind == InputKind::Scheduled)
+        {
+            return std::get<Slot>(m_buffers);
+        }
+        else if constexpr (Kind == InputKind::Pulled)
+        {
+            return detail::pullBlock(input, frames);
+        }
+        else
+        {
+            return dispatch(input);
+        }
+    }
+    template <size_t K,
+              typename Processor,
+              typename Path,
+              size_t Slot,
+              InputKind... Kinds,
+              typename Domain,
+              size_t... Is>
+    inline void execute(
+        const detail::schedule::
+            Step<Processor, Path, Slot, std::integer_sequence<InputKind, Kinds...>, Domain>&,
+        const std::index_sequence<Is...>& indices,
+        sample_t* out,
+        size_t frames)
+    {
+        frames = framesOf(static_cast<const Domain*>(nullptr), frames);
+        if (frames == 0)
+        {
+            return;
+        }
+        auto& node      = nodeAt(m_graph, Path{});
+        auto& processor = state<K>();
+        // the last step is the graph output
+        sample_t* output = K + 1 == stepCount() ? out : std::get<Slot>(m_buffers).data();
+        if constexpr (node_profiler_t<Processor>::profiled)
+        {
+            // inputs are rendered first so they are not accounted to this node
+            using arguments_t = std::tuple<decltype(
+                argument<Kinds, Slot + 1 + Is>(std::get<Is>(node.inputs()), frames))...>;
+            const arguments_t arguments(
+                argument<Kinds, Slot + 1 + Is>(std::get<Is>(node.inputs()), frames)...);
+            const typename node_profiler_t<Processor>::Scope scope(node, frames);
+            detail::processBlocks(processor, output, frames, arguments, indices);
+        }
+        else
+        {
+            detail::processBlocks(
+                processor,
+                output,
+                frames,
+                std::forward_as_tuple(
+                    argument<Kinds, Slot + 1 + Is>(std::get<Is>(node.inputs()), frames)...),
+                indices);
+        }
+    }
+    template <size_t K, typename Path, size_t Slot, typename Domain>
+    inline void execute(const detail::schedule::ControlStep<Path, Slot, Domain>&,
+                        sample_t* out,
+                        size_t frames)
+    {
+        frames = framesOf(static_cast<const Domain*>(nullptr), frames);
+        sample_t* output = K + 1 == stepCount() ? out : std::get<Slot>(m_buffers).data();
+        nodeAt(m_graph, Path{}).processBlock(output, frames, std::get<Slot + 1>(m_buffers).data());
+    }
+    template <size_t K>
+    inline void execute(sample_t* out, size_t frames)
+    {
+        if constexpr (std::is_void<typename step_t<K>::processor>::value)
+        {
+            execute<K>(step_t<K>{}, out, frames);
+        }
+        else
+        {
+            execute<K>(step_t<K>{}, step_t<K>::inputs(), out, frames);
+        }
+    }
+    template <size_t... Ks>
+    inline void processBlock(sample_t* out, size_t frames, const std::index_sequence<Ks...>&)
+    {
+        (execute<Ks>(out, frames), ...);
+    }
+
+public:
+    // takes the processors of graph over
+    explicit StaticSchedule(Graph& graph)
+    : m_graph(graph)
+    {
+        exchange(true, std::make_index_sequence<stepCount()>{});
+    }
+    StaticSchedule(const StaticSchedule&) = delete;
+    // gives the processors back to the graph
+    ~StaticSchedule()
+    {
+        exchange(false, std::make_index_sequence<stepCount()>{});
+    }
+    StaticSchedule& operator=(const StaticSchedule&) = delete;
+
+    static constexpr size_t stepCount()
+    {
+        return std::tuple_size<steps_t>::value;
+    }
+    static constexpr size_t bufferCount()
+    {
+        return layout_t::bufferCount();
+    }
+    static constexpr size_t stateGroupCount()
+    {
+        return std::tuple_size<states_t>::value;
+    }
+    Graph& graph()
+    {
+        return m_graph;
+    }
+    // the processor of a scheduled node of the graph, held by the schedule
+    template <typename Node>
+    auto& processorOf(const Node& node)
+    {
+        using processor_t = std::decay_t<decltype(std::declval<Node&>().processor())>;
+        processor_t* processor = nullptr;
+        findProcessor(node, processor, std::make_index_sequence<stepCount()>{});
+        assert(processor != nullptr && "node not scheduled");
+        return *processor;
+    }
+    // resets the scheduled processors and the nodes left in the graph
+    void reset()
+    {
+        for_each(m_states, [](auto& group) {
+            for (auto& processor : group)
+            {
+                if constexpr (detail::HasReset<std::decay_t<decltype(processor)>>::value)
+                {
+                    processor.reset();
+                }
+            }
+        });
+        resetState(m_graph);
+    }
+    // renders frames samples of the graph into out
+    void process(sample_t* out, size_t frames)
+    {
+        if constexpr (stepCount() == 0)
+        {
+            m_graph.process(out, frames);
+        }
+        else
+        {
+            static constexpr auto steps = std::make_index_sequence<stepCount()>{};
+            for (size_t offset = 0; offset < frames; offset += max_block_size_t::value)
+            {
+                processBlock(
+                    out + offset, std::min(frames - offset, max_block_size_t::value), steps);
+            }
+        }
+    }
+};
+
+#endif // CRTP_UTILITY_STATIC_SCHEDULE_H
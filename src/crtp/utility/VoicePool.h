@@ -0,0 +1,208 @@
+#ifndef CRTP_UTILITY_VOICE_POOL_H
+#define CRTP_UTILITY_VOICE_POOL_H
+
+#include "StateReset.h"
+#include "base/Constants.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
+
+namespace dap
+{
+    namespace crtp
+    {
+        enum class VoiceStealing
+        {
+            Oldest,
+            Quietest
+        };
+
+        template <typename Graph, size_t Voices>
+        class VoicePool;
+    }
+}
+
+// Voices instances of Graph allocated once in a contiguous arena, each one starting on its own
+// cache line. Note events and rendering never allocate: a note-on takes a free voice and resets
+// its state, or steals one when all of them are busy, released voices first and then the oldest
+// or quietest one. A released voice keeps rendering until its output falls below the silence
+// threshold, so the graph can fade it out, e.g. by setting its gain to zero on note-off.
+template <typename Graph, size_t Voices>
+class dap::crtp::VoicePool final
+{
+    static_assert(Voices > 0, "Voices must be greater than zero");
+    using value_type = std::decay_t<decltype(std::declval<Graph&>()())>;
+    static_assert(std::is_floating_point<value_type>::value,
+                  "voices must render floating point samples");
+
+    struct alignas(CACHE_LINE_SIZE) Voice
+    {
+        Graph graph;
+    };
+    struct State
+    {
+        uint64_t started{0};
+        value_type level{0}; // peak of the last rendered block
+        int note{0};
+        bool active{false};
+        bool released{false};
+    };
+
+    std::unique_ptr<Voice[]> m_voices;
+    std::array<State, Voices> m_states{};
+    detail::block_t<value_type> m_block{};
+    uint64_t m_clock{0};
+    size_t m_activeCount{0};
+    VoiceStealing m_stealing;
+    value_type m_silence;
+
+    // true if a should be stolen rather than b
+    bool isCheaperToSteal(const State& a, const State& b) const
+    {
+        if (a.released != b.released)
+        {
+            return a.released;
+        }
+        if (m_stealing == VoiceStealing::Quietest && a.level != b.level)
+        {
+            return a.level < b.level;
+        }
+        return a.started < b.started;
+    }
+    size_t voiceToSteal() const
+    {
+        size_t stolen = 0;
+        for (size_t i = 1; i < Voices; ++i)
+        {
+            if (isCheaperToSteal(m_states[i], m_states[stolen]))
+            {
+                stolen = i;
+            }
+        }
+        return stolen;
+    }
+    size_t freeVoice() const
+    {
+        const auto it = std::find_if(
+            m_states.begin(), m_states.end(), [](const State& state) { return !state.active; });
+        return static_cast<size_t>(it - m_states.begin());
+    }
+    void renderBlock(value_type* out, size_t frames)
+    {
+        for (size_t i = 0; i < Voices; ++i)
+        {
+            State& state = m_states[i];
+            if (!state.active)
+            {
+                continue;
+            }
+            m_voices[i].graph.processBlock(m_block.data(), frames);
+            value_type peak(0);
+            for (size_t n = 0; n < frames; ++n)
+            {
+                out[n] += m_block[n];
+                peak = std::max(peak, std::abs(m_block[n]));
+            }
+            state.level = peak;
+            if (state.released && peak < m_silence)
+            {
+                stop(i);
+            }
+        }
+    }
+
+public:
+    explicit VoicePool(VoiceStealing stealing = VoiceStealing::Oldest,
+                       value_type silence     = value_type(1e-4))
+    : m_voices(new Voice[Voices])
+    , m_stealing(stealing)
+    , m_silence(silence)
+    {
+    }
+
+    static constexpr size_t size()
+    {
+        return Voices;
+    }
+    size_t activeCount() const
+    {
+        return m_activeCount;
+    }
+    bool isActive(size_t voice) const
+    {
+        return m_states[voice].active;
+    }
+    Graph& voice(size_t voice)
+    {
+        return m_voices[voice].graph;
+    }
+    // e.g. to set the samplerate of every voice
+    template <typename F>
+    void forEachVoice(F&& f)
+    {
+        for (size_t i = 0; i < Voices; ++i)
+        {
+            f(m_voices[i].graph);
+        }
+    }
+    // starts note on a free or stolen voice, which is returned so its parameters can be set
+    Graph& noteOn(int note)
+    {
+        size_t voice = freeVoice();
+        if (voice == Voices)
+        {
+            voice = voiceToSteal();
+        }
+        else
+        {
+            ++m_activeCount;
+        }
+        // a voice which has not rendered yet is the last one to be stolen by loudness
+        m_states[voice] = State{++m_clock, std::numeric_limits<value_type>::max(), note, true, false};
+        resetState(m_voices[voice].graph);
+        return m_voices[voice].graph;
+    }
+    // releases the latest voice playing note, returns nullptr if none is
+    Graph* noteOff(int note)
+    {
+        State* latest = nullptr;
+        for (auto& state : m_states)
+        {
+            if (state.active && !state.released && state.note == note &&
+                (latest == nullptr || state.started > latest->started))
+            {
+                latest = &state;
+            }
+        }
+        if (latest == nullptr)
+        {
+            return nullptr;
+        }
+        latest->released = true;
+        return &m_voices[static_cast<size_t>(latest - m_states.data())].graph;
+    }
+    // frees a voice immediately
+    void stop(size_t voice)
+    {
+        if (m_states[voice].active)
+        {
+            m_states[voice].active = false;
+            --m_activeCount;
+        }
+    }
+    // writes the sum of the active voices into out
+    void process(value_type* out, size_t frames)
+    {
+        std::fill(out, out + frames, value_type(0));
+        for (size_t offset = 0; offset < frames && m_activeCount > 0;
+             offset += max_block_size_t::value)
+        {
+            renderBlock(out + offset, std::min(frames - offset, max_block_size_t::value));
+        }
+    }
+};
+
+#endif // CRTP_UTILITY_VOICE_POOL_H
@@ -0,0 +1,82 @@
+#ifndef CRTP_UTILITY_WORKER_POOL_SETTER_H
+#define CRTP_UTILITY_WORKER_POOL_SETTER_H
+
+#include "NodeVisitor.h"
+#include "crtp/nodes/Parallel.h"
+#include <algorithm>
+
+namespace dap
+{
+    namespace crtp
+    {
+        class WorkerPoolSetter;
+
+        // the largest number of ParallelNodes on a path from node to its leaves
+        template <typename T>
+        constexpr size_t parallelDepth();
+
+        // renders every ParallelNode of graph on pool, nullptr renders them serially. The graph
+        // must not nest ParallelNodes, see ParallelNode::setWorkerPool
+        template <typename Graph>
+        void setWorkerPool(Graph& graph, threadsafe::WorkerPool* pool);
+
+        namespace detail
+        {
+            template <typename T, size_t... Is>
+            constexpr size_t inputParallelDepth(const std::index_sequence<Is...>&)
+            {
+                return std::max({size_t(0),
+                                 parallelDepth<std::remove_const_t<
+                                     tuple_element_t<Is, typename T::input_type>>>()...});
+            }
+        }
+    }
+}
+
+// sets the worker pool of every visited ParallelNode
+class dap::crtp::WorkerPoolSetter
+{
+    threadsafe::WorkerPool* m_pool;
+
+public:
+    explicit WorkerPoolSetter(threadsafe::WorkerPool* pool)
+    : m_pool(pool)
+    {
+    }
+    template <typename Processor, typename Inputs, typename InputNames>
+    void visit(ParallelNode<Processor, Inputs, InputNames>& node)
+    {
+        node.setWorkerPool(m_pool);
+    }
+    template <typename T>
+    void visit(T&)
+    {
+        // rendered on the thread of its parent
+    }
+};
+
+template <typename T>
+constexpr size_t dap::crtp::parallelDepth()
+{
+    if constexpr (traits::IsCrtpNode<T>::value)
+    {
+        return (traits::IsParallelNode<T>::value ? 1 : 0) +
+               detail::inputParallelDepth<T>(
+                   std::make_index_sequence<std::tuple_size<typename T::input_type>::value>{});
+    }
+    else
+    {
+        return 0;
+    }
+}
+
+template <typename Graph>
+void dap::crtp::setWorkerPool(Graph& graph, threadsafe::WorkerPool* pool)
+{
+    static_assert(parallelDepth<Graph>() <= 1,
+                  "nested ParallelNodes would call WorkerPool::run from a worker thread");
+    NodeVisitor<WorkerPoolSetter> visit(WorkerPoolSetter{pool});
+    visit(graph);
+}
+
+#endif // CRTP_UTILITY_WORKER_POOL_SETTER_H
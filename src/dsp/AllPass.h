@@ -1,28 +1,51 @@
 #ifndef DAP_DSP_ALLPASS_H
 #define DAP_DSP_ALLPASS_H
 
+#include "CoefficientCache.h"
+#include "fastmath/Approx.h"
 #include <cmath>
 
 namespace dap
 {
     namespace dsp
     {
-        template <typename T>
+        template <typename T,
+                  typename Tolerance           = std::ratio<0>,
+                  fastmath::approx::Accuracy A = fastmath::approx::Accuracy::Exact>
         class AllPass;
     }
 }
-template <typename T>
+// Tolerance is the relative change of the frequency tolerated before the coefficient is computed
+// again, see CoefficientCache. tan is computed with the accuracy A, see fastmath/Approx.h.
+template <typename T, typename Tolerance, dap::fastmath::approx::Accuracy A>
 class dap::dsp::AllPass final
 {
     T m_output{0};
     T m_d{0};
+    CoefficientCache<T, T, Tolerance> m_coefficient;
 
 public:
-    inline auto operator()(T input, T frequency, T samplerate)
+    // coefficient of the normalized frequency pi * frequency / samplerate
+    static T coefficient(T w)
     {
-        const T w = std::tan(M_PI * frequency / samplerate);
-        const T k = (w - T(1)) / (w + T(1));
+        const T t = fastmath::approx::tan<A>(w);
+        return (t - T(1)) / (t + T(1));
+    }
 
+    void reset()
+    {
+        m_output = T(0);
+        m_d      = T(0);
+        m_coefficient.reset();
+    }
+    inline auto operator()(T input, T frequency, T samplerate)
+    {
+        const T k = m_coefficient(M_PI * frequency / samplerate, &AllPass::coefficient);
+        return process(input, k);
+    }
+    // filters input with a coefficient given by coefficient()
+    inline auto process(T input, T k)
+    {
         m_output = k * input + m_d;
         m_d      = input - k * m_output;
         return m_output;
@@ -0,0 +1,188 @@
+#ifndef DAP_DSP_BAND_LIMITED_FUNCTIONS_H
+#define DAP_DSP_BAND_LIMITED_FUNCTIONS_H
+
+#include "Frames.h"
+#include "OscillatorFunctions.h"
+#include "base/TypeTraits.h"
+#include "fastmath/Approx.h"
+#include "fastmath/Pack.h"
+
+namespace dap
+{
+    namespace dsp
+    {
+        // how an oscillator renders the discontinuities of its shapes
+        enum class Antialiasing
+        {
+            None,     // naive shapes, aliasing unless oversampled
+            PolyBlep, // polynomial residuals of band-limited steps (PolyBLEP) and ramps (PolyBLAMP)
+        };
+
+        class BandLimitedFunctions;
+    }
+}
+
+// Shapes of OscillatorFunctions with polynomial band-limited residuals added around their
+// discontinuities, see V. Valimaki, "Antialiasing oscillators in subtractive synthesis" and F.
+// Esqueda et al., "Rounding corners with BLAMP". Phases t are in turns, in [0, 1), and dt is the
+// phase increment per frame, i.e. frequency / samplerate, which must be below 1/2. Residuals
+// span one frame on each side of a discontinuity, away from them the shapes are the naive ones.
+class dap::dsp::BandLimitedFunctions final
+{
+    // distance to a discontinuity at t = 0, in frames, for the frames before and after it
+    template <typename T>
+    struct Neighbourhood
+    {
+        T after;
+        T before;
+        decltype(T{} < T{}) isAfter;
+        decltype(T{} < T{}) isBefore;
+
+        Neighbourhood(T t, T dt)
+        : after(t / dt)
+        , before((t - T(1)) / dt)
+        , isAfter(t < dt)
+        , isBefore(t > T(1) - dt)
+        {
+        }
+    };
+
+    template <typename T>
+    static inline T wrap(T t)
+    {
+        using std::floor;
+        return t - floor(t);
+    }
+
+public:
+    using Shape = OscillatorFunctions::Shape;
+
+    // residual of a step of height 2 at t = 0
+    template <typename T>
+    static inline T polyBlep(T t, T dt)
+    {
+        using fastmath::select;
+        const Neighbourhood<T> d(t, dt);
+        const T after  = d.after * (T(2) - d.after) - T(1);
+        const T before = d.before * (d.before + T(2)) + T(1);
+        return select(d.isAfter, after, select(d.isBefore, before, T(0)));
+    }
+    // residual of a change of slope of one per frame at t = 0
+    template <typename T>
+    static inline T polyBlamp(T t, T dt)
+    {
+        using fastmath::select;
+        const Neighbourhood<T> d(t, dt);
+        const T after  = T(1) - d.after;
+        const T before = T(1) + d.before;
+        return select(d.isAfter,
+                      after * after * after,
+                      select(d.isBefore, before * before * before, T(0))) *
+               lane_scalar_t<T>(1.0 / 6.0);
+    }
+
+    // 1 - 2t
+    template <typename T>
+    static inline T saw(T t, T dt)
+    {
+        return T(1) - T(2) * t + polyBlep(t, dt);
+    }
+    // 2t - 1
+    template <typename T>
+    static inline T inverseSaw(T t, T dt)
+    {
+        return T(2) * t - T(1) - polyBlep(t, dt);
+    }
+    // 1 for t < 1/2, -1 otherwise
+    template <typename T>
+    static inline T square(T t, T dt)
+    {
+        using fastmath::select;
+        const T naive = select(t < T(0.5), T(1), T(-1));
+        return naive + polyBlep(t, dt) - polyBlep(wrap(t + T(0.5)), dt);
+    }
+    // -1 at t = 0 and 1 at t = 1/2
+    template <typename T>
+    static inline T triangle(T t, T dt)
+    {
+        using fastmath::select;
+        const T naive = select(t < T(0.5), T(4) * t - T(1), T(3) - T(4) * t);
+        // the slope changes by 8 per turn, i.e. by 8 dt per frame
+        return naive + T(8) * dt * (polyBlamp(t, dt) - polyBlamp(wrap(t + T(0.5)), dt));
+    }
+    // 1 for t < dutyCycle, 0 otherwise, dutyCycle being in [0, 1]
+    template <typename T>
+    static inline T pwm(T t, T dt, T dutyCycle)
+    {
+        using fastmath::select;
+        const T naive = select(t < dutyCycle, T(1), T(0));
+        return naive +
+               lane_scalar_t<T>(0.5) * (polyBlep(t, dt) - polyBlep(wrap(t + T(1) - dutyCycle), dt));
+    }
+
+    // the shape is the same for all lanes, so a single branch is taken. Sines use the
+    // approximation of accuracy A and need no residual.
+    template <fastmath::approx::Accuracy A, typename T>
+    static inline T process(T t, T dt, Shape shape)
+    {
+        switch (shape)
+        {
+            case Shape::Sine:
+                return fastmath::approx::sin2pi<A>(t);
+            case Shape::Square:
+                return square(t, dt);
+            case Shape::Saw:
+                return saw(t, dt);
+            case Shape::InverseSaw:
+                return inverseSaw(t, dt);
+            case Shape::Triangle:
+                return triangle(t, dt);
+        }
+        return T(0);
+    }
+
+    // block version writing gain * shape(turn) for each frame of turns, which may be out, the
+    // increments being freq / samplerate. The shape is selected once per block.
+    template <fastmath::approx::Accuracy A,
+              typename T,
+              typename Gain,
+              typename Freq,
+              typename SampleRate>
+    static inline void process(T* out,
+                               const T* turns,
+                               size_t frames,
+                               const Gain& gain,
+                               const Freq& freq,
+                               const SampleRate& samplerate,
+                               Shape shape)
+    {
+        auto apply = [&](auto&& fn) {
+            using std::abs;
+            for (size_t n = 0; n < frames; ++n)
+            {
+                const T dt = abs(T(frameAt(freq, n) / frameAt(samplerate, n)));
+                out[n]     = frameAt(gain, n) * fn(T(turns[n]), dt);
+            }
+        };
+        switch (shape)
+        {
+            case Shape::Sine:
+                apply([](T t, T) { return fastmath::approx::sin2pi<A>(t); });
+                break;
+            case Shape::Square:
+                apply([](T t, T dt) { return square(t, dt); });
+                break;
+            case Shape::Saw:
+                apply([](T t, T dt) { return saw(t, dt); });
+                break;
+            case Shape::InverseSaw:
+                apply([](T t, T dt) { return inverseSaw(t, dt); });
+                break;
+            case Shape::Triangle:
+                apply([](T t, T dt) { return triangle(t, dt); });
+                break;
+        }
+    }
+};
+
+#endif // DAP_DSP_BAND_LIMITED_FUNCTIONS_H
@@ -0,0 +1,240 @@
+#ifndef DAP_DSP_BIQUAD_H
+#define DAP_DSP_BIQUAD_H
+
+#include "base/TypeTraits.h"
+#include <cmath>
+#include <cstddef>
+
+namespace dap
+{
+    namespace dsp
+    {
+        // the responses of Robert Bristow-Johnson's Audio EQ Cookbook
+        enum class BiquadResponse
+        {
+            LowPass,
+            HighPass,
+            BandPass, // 0dB peak gain
+            Notch,
+            AllPass,
+            Peak,
+            LowShelf,
+            HighShelf,
+        };
+
+        template <typename T>
+        struct BiquadCoefficients;
+        template <typename T>
+        class Biquad;
+    }
+}
+
+//           b0 + b1z[-1] + b2z[-2]
+// H(z) = ---------------------------
+//           1 + a1z[-1] + a2z[-2]
+//
+// T may be a Pack, each lane holding the coefficients of its own section. The default ones pass
+// the input through.
+template <typename T>
+struct dap::dsp::BiquadCoefficients final
+{
+    T b0{1};
+    T b1{0};
+    T b2{0};
+    T a1{0};
+    T a2{0};
+
+    // section of the given response at frequency, q being the quality factor, the width of the
+    // band for BandPass, Notch and Peak, and the slope of the shelves. gain is in dB and only used
+    // by Peak and the shelves.
+    static BiquadCoefficients design(BiquadResponse response,
+                                     double frequency,
+                                     double q,
+                                     double gain,
+                                     double samplerate)
+    {
+        const double w     = 2.0 * M_PI * frequency / samplerate;
+        const double cs    = std::cos(w);
+        const double alpha = std::sin(w) / (2.0 * q);
+        const double A     = std::pow(10.0, gain / 40.0);
+        const double sq    = 2.0 * std::sqrt(A) * alpha;
+
+        double b0 = 1.0, b1 = 0.0, b2 = 0.0, a0 = 1.0, a1 = 0.0, a2 = 0.0;
+        switch (response)
+        {
+            case BiquadResponse::LowPass:
+                b0 = b2 = 0.5 * (1.0 - cs);
+                b1      = 1.0 - cs;
+                a0      = 1.0 + alpha;
+                a1      = -2.0 * cs;
+                a2      = 1.0 - alpha;
+                break;
+            case BiquadResponse::HighPass:
+                b0 = b2 = 0.5 * (1.0 + cs);
+                b1      = -(1.0 + cs);
+                a0      = 1.0 + alpha;
+                a1      = -2.0 * cs;
+                a2      = 1.0 - alpha;
+                break;
+            case BiquadResponse::BandPass:
+                b0 = alpha;
+                b1 = 0.0;
+                b2 = -alpha;
+                a0 = 1.0 + alpha;
+                a1 = -2.0 * cs;
+                a2 = 1.0 - alpha;
+                break;
+            case BiquadResponse::Notch:
+                b0 = b2 = 1.0;
+                b1 = a1 = -2.0 * cs;
+                a0      = 1.0 + alpha;
+                a2      = 1.0 - alpha;
+                break;
+            case BiquadResponse::AllPass:
+                b0 = a2 = 1.0 - alpha;
+                b1 = a1 = -2.0 * cs;
+                b2 = a0 = 1.0 + alpha;
+                break;
+            case BiquadResponse::Peak:
+                b0 = 1.0 + alpha * A;
+                b1 = a1 = -2.0 * cs;
+                b2      = 1.0 - alpha * A;
+                a0      = 1.0 + alpha / A;
+                a2      = 1.0 - alpha / A;
+                break;
+            case BiquadResponse::LowShelf:
+                b0 = A * ((A + 1.0) - (A - 1.0) * cs + sq);
+                b1 = 2.0 * A * ((A - 1.0) - (A + 1.0) * cs);
+                b2 = A * ((A + 1.0) - (A - 1.0) * cs - sq);
+                a0 = (A + 1.0) + (A - 1.0) * cs + sq;
+                a1 = -2.0 * ((A - 1.0) + (A + 1.0) * cs);
+                a2 = (A + 1.0) + (A - 1.0) * cs - sq;
+                break;
+            case BiquadResponse::HighShelf:
+                b0 = A * ((A + 1.0) + (A - 1.0) * cs + sq);
+                b1 = -2.0 * A * ((A - 1.0) + (A + 1.0) * cs);
+                b2 = A * ((A + 1.0) + (A - 1.0) * cs - sq);
+                a0 = (A + 1.0) - (A - 1.0) * cs + sq;
+                a1 = 2.0 * ((A - 1.0) - (A + 1.0) * cs);
+                a2 = (A + 1.0) - (A - 1.0) * cs - sq;
+                break;
+        }
+        using S = lane_scalar_t<T>;
+        return {T(S(b0 / a0)), T(S(b1 / a0)), T(S(b2 / a0)), T(S(a1 / a0)), T(S(a2 / a0))};
+    }
+};
+
+// Second order section in transposed direct form II, which needs two state variables and keeps
+// the round off noise low at low frequencies. Coefficients either change at once or move
+// linearly to a target over a number of samples, typically the next block, which keeps a stable
+// section stable as the stability triangle of a1 and a2 is convex. T may be a Pack, its lanes
+// being independent sections, e.g. the channels of a signal or the bands of a BiquadBank.
+template <typename T>
+class dap::dsp::Biquad final
+{
+    using coefficients_t = BiquadCoefficients<T>;
+
+    coefficients_t m_c;
+    coefficients_t m_target;
+    coefficients_t m_step;
+    size_t m_remaining{0};
+    T m_s1{0};
+    T m_s2{0};
+
+    static inline T tick(const coefficients_t& c, T x, T& s1, T& s2)
+    {
+        const T y = c.b0 * x + s1;
+        s1        = c.b1 * x - c.a1 * y + s2;
+        s2        = c.b2 * x - c.a2 * y;
+        return y;
+    }
+    inline void advance()
+    {
+        if (--m_remaining == 0)
+        {
+            m_c = m_target;
+            return;
+        }
+        m_c.b0 += m_step.b0;
+        m_c.b1 += m_step.b1;
+        m_c.b2 += m_step.b2;
+        m_c.a1 += m_step.a1;
+        m_c.a2 += m_step.a2;
+    }
+
+public:
+    Biquad() = default;
+    explicit Biquad(const coefficients_t& coefficients)
+    : m_c(coefficients)
+    , m_target(coefficients)
+    {
+    }
+    const coefficients_t& coefficients() const
+    {
+        return m_c;
+    }
+    // the coefficients at the end of the current ramp, the current ones if none
+    const coefficients_t& target() const
+    {
+        return m_target;
+    }
+    void set(const coefficients_t& coefficients)
+    {
+        m_c         = coefficients;
+        m_target    = coefficients;
+        m_remaining = 0;
+    }
+    // the coefficients move linearly from the current ones to target over the next frames
+    // samples, reaching it on the last one
+    void setTarget(const coefficients_t& target, size_t frames)
+    {
+        if (frames == 0)
+        {
+            set(target);
+            return;
+        }
+        const T n   = T(lane_scalar_t<T>(frames));
+        m_target    = target;
+        m_step      = {(target.b0 - m_c.b0) / n,
+                  (target.b1 - m_c.b1) / n,
+                  (target.b2 - m_c.b2) / n,
+                  (target.a1 - m_c.a1) / n,
+                  (target.a2 - m_c.a2) / n};
+        m_remaining = frames;
+    }
+    // clears the state, the coefficients are kept
+    void reset()
+    {
+        m_s1 = T(0);
+        m_s2 = T(0);
+    }
+    inline T operator()(T x)
+    {
+        if (m_remaining > 0)
+        {
+            advance();
+        }
+        return tick(m_c, x, m_s1, m_s2);
+    }
+    // block overload, out may be in
+    inline void process(T* out, const T* in, size_t frames)
+    {
+        size_t n = 0;
+        for (; n < frames && m_remaining > 0; ++n)
+        {
+            out[n] = (*this)(in[n]);
+        }
+        // constant coefficients, state held in registers
+        const coefficients_t c = m_c;
+        T s1                   = m_s1;
+        T s2                   = m_s2;
+        for (; n < frames; ++n)
+        {
+            out[n] = tick(c, in[n], s1, s2);
+        }
+        m_s1 = s1;
+        m_s2 = s2;
+    }
+};
+
+#endif // DAP_DSP_BIQUAD_H
@@ -0,0 +1,114 @@
+#ifndef DAP_DSP_BIQUAD_BANK_H
+#define DAP_DSP_BIQUAD_BANK_H
+
+#include "Biquad.h"
+#include "fastmath/Array.h"
+#include "fastmath/Pack.h"
+#include <array>
+
+namespace dap
+{
+    namespace dsp
+    {
+        template <typename T, size_t Bands, size_t Lanes = 4>
+        class BiquadBank;
+    }
+}
+
+// Bands sections in parallel on the same input, their outputs summed, e.g. a resonator bank or a
+// parallel EQ. The sections run Lanes at a time in the lanes of a Pack, the groups of sections
+// being independent so that their recursions overlap. Bands not set are silent.
+template <typename T, size_t Bands, size_t Lanes>
+class dap::dsp::BiquadBank final
+{
+    static_assert(Bands > 0, "a bank needs at least one band");
+
+    using pack_t         = fastmath::Pack<T, Lanes>;
+    using coefficients_t = BiquadCoefficients<T>;
+
+    static constexpr size_t groups = (Bands + Lanes - 1) / Lanes;
+
+    std::array<Biquad<pack_t>, groups> m_groups;
+
+    static BiquadCoefficients<pack_t> withBand(BiquadCoefficients<pack_t> coefficients,
+                                               size_t lane,
+                                               const coefficients_t& band)
+    {
+        coefficients.b0[lane] = band.b0;
+        coefficients.b1[lane] = band.b1;
+        coefficients.b2[lane] = band.b2;
+        coefficients.a1[lane] = band.a1;
+        coefficients.a2[lane] = band.a2;
+        return coefficients;
+    }
+    static inline T sum(const pack_t& x)
+    {
+        T y = x[0];
+        for (size_t i = 1; i < Lanes; ++i)
+        {
+            y += x[i];
+        }
+        return y;
+    }
+
+public:
+    static constexpr size_t bands = Bands;
+
+    BiquadBank()
+    {
+        for (auto& group : m_groups)
+        {
+            group.set({pack_t(0), pack_t(0), pack_t(0), pack_t(0), pack_t(0)});
+        }
+    }
+    coefficients_t coefficients(size_t band) const
+    {
+        const auto& c     = m_groups[band / Lanes].coefficients();
+        const size_t lane = band % Lanes;
+        return {c.b0[lane], c.b1[lane], c.b2[lane], c.a1[lane], c.a2[lane]};
+    }
+    void set(size_t band, const coefficients_t& coefficients)
+    {
+        auto& group = m_groups[band / Lanes];
+        group.set(withBand(group.coefficients(), band % Lanes, coefficients));
+    }
+    // see Biquad::setTarget, the other bands of the group of band start a ramp of frames samples
+    // to their own target too, so bands moving together are given the same frames
+    void setTarget(size_t band, const coefficients_t& target, size_t frames)
+    {
+        auto& group = m_groups[band / Lanes];
+        group.setTarget(withBand(group.target(), band % Lanes, target), frames);
+    }
+    void reset()
+    {
+        for (auto& group : m_groups)
+        {
+            group.reset();
+        }
+    }
+    inline T operator()(T x)
+    {
+        const pack_t in(x);
+        pack_t y = m_groups[0](in);
+        for (size_t g = 1; g < groups; ++g)
+        {
+            y += m_groups[g](in);
+        }
+        return sum(y);
+    }
+    // block overload, out may be in
+    inline void process(T* out, const T* in, size_t frames)
+    {
+        for (size_t n = 0; n < frames; ++n)
+        {
+            out[n] = (*this)(in[n]);
+        }
+    }
+    template <typename Allocator>
+    inline void process(fastmath::Array<T, Allocator>& out, const fastmath::Array<T, Allocator>& in)
+    {
+        process(out.data(), in.data(), in.size());
+    }
+};
+
+#endif // DAP_DSP_BIQUAD_BANK_H
@@ -0,0 +1,126 @@
+#ifndef DAP_DSP_BIQUAD_CASCADE_H
+#define DAP_DSP_BIQUAD_CASCADE_H
+
+#include "Biquad.h"
+#include "fastmath/Array.h"
+#include "fastmath/AudioBuffer.h"
+#include <algorithm>
+#include <array>
+#include <cassert>
+
+namespace dap
+{
+    namespace dsp
+    {
+        template <typename T, size_t Sections>
+        class BiquadCascade;
+    }
+}
+
+// Sections in series, e.g. the factored sections of a higher order filter. T may be a Pack, each
+// lane filtering its own channel with its own coefficients. Blocks go through one section after
+// the other, each section keeping its state in registers for the whole block.
+template <typename T, size_t Sections>
+class dap::dsp::BiquadCascade final
+{
+    static_assert(Sections > 0, "a cascade needs at least one section");
+
+    using coefficients_t = BiquadCoefficients<T>;
+    using scalar_t       = lane_scalar_t<T>;
+
+    static constexpr size_t lanes = lane_traits<T>::size;
+
+    std::array<Biquad<T>, Sections> m_sections;
+
+public:
+    static constexpr size_t sections = Sections;
+
+    Biquad<T>& section(size_t i)
+    {
+        return m_sections[i];
+    }
+    const Biquad<T>& section(size_t i) const
+    {
+        return m_sections[i];
+    }
+    void set(size_t i, const coefficients_t& coefficients)
+    {
+        m_sections[i].set(coefficients);
+    }
+    // see Biquad::setTarget
+    void setTarget(size_t i, const coefficients_t& target, size_t frames)
+    {
+        m_sections[i].setTarget(target, frames);
+    }
+    void reset()
+    {
+        for (auto& section : m_sections)
+        {
+            section.reset();
+        }
+    }
+    inline T operator()(T x)
+    {
+        for (auto& section : m_sections)
+        {
+            x = section(x);
+        }
+        return x;
+    }
+    // block overload, out may be in
+    inline void process(T* out, const T* in, size_t frames)
+    {
+        m_sections[0].process(out, in, frames);
+        for (size_t i = 1; i < Sections; ++i)
+        {
+            m_sections[i].process(out, out, frames);
+        }
+    }
+    // filters x in place
+    template <typename Allocator>
+    inline void process(fastmath::Array<T, Allocator>& x)
+    {
+        process(x.data(), x.data(), x.size());
+    }
+    // filters the channels of buffer in place, channel c in lane c, so a cascade of Packs of N
+    // lanes filters up to N channels at once
+    inline void process(fastmath::AudioBuffer<scalar_t>& buffer)
+    {
+        const size_t channels = buffer.channelCount();
+        assert(channels <= lanes);
+        if constexpr (lanes == 1)
+        {
+            if (channels == 1)
+            {
+                process(buffer.channel(0).data(), buffer.channel(0).data(), buffer.channelSize());
+            }
+        }
+        else
+        {
+            constexpr size_t chunk = 64;
+            std::array<T, chunk> block;
+            for (size_t start = 0; start < buffer.channelSize(); start += chunk)
+            {
+                const size_t frames = std::min(chunk, buffer.channelSize() - start);
+                for (size_t n = 0; n < frames; ++n)
+                {
+                    block[n] = T(0);
+                    for (size_t c = 0; c < channels; ++c)
+                    {
+                        block[n][c] = buffer.channel(c)[start + n];
+                    }
+                }
+                process(block.data(), block.data(), frames);
+                for (size_t n = 0; n < frames; ++n)
+                {
+                    for (size_t c = 0; c < channels; ++c)
+                    {
+                        buffer.channel(c)[start + n] = block[n][c];
+                    }
+                }
+            }
+        }
+    }
+};
+
+#endif // DAP_DSP_BIQUAD_CASCADE_H
@@ -0,0 +1,137 @@
+#ifndef DAP_DSP_COEFFICIENT_CACHE_H
+#define DAP_DSP_COEFFICIENT_CACHE_H
+
+#include "base/TypeTraits.h"
+#include <cmath>
+#include <ratio>
+#include <utility>
+
+namespace dap
+{
+    namespace dsp
+    {
+        template <typename T, typename Parameter = T, typename Tolerance = std::ratio<0>>
+        class CoefficientCache;
+        template <typename T, size_t Period>
+        class CoefficientRamp;
+    }
+}
+
+// Coefficient computed from a parameter, computed again only once the parameter moved away from
+// the value it was last computed for by more than Tolerance relative to that value. With the
+// default zero tolerance the coefficient is the same as when computed every sample. Packed
+// parameters are compared lane by lane, parameters of other types are never cached.
+template <typename T, typename Parameter, typename Tolerance>
+class dap::dsp::CoefficientCache final
+{
+    static_assert(Tolerance::num >= 0 && Tolerance::den > 0, "Tolerance must not be negative");
+
+    static constexpr bool cached = isArithmetic<Parameter>() || isPacked<Parameter>();
+
+    Parameter m_parameter{};
+    T m_value{};
+    bool m_valid{false};
+
+    template <typename U>
+    static bool isNear(U x, U y)
+    {
+        if constexpr (Tolerance::num == 0)
+        {
+            return x == y;
+        }
+        else
+        {
+            using std::abs;
+            constexpr auto tolerance = double(Tolerance::num) / double(Tolerance::den);
+            return abs(double(x) - double(y)) <= tolerance * abs(double(y));
+        }
+    }
+    bool isNear(const Parameter& parameter) const
+    {
+        if constexpr (isPacked<Parameter>())
+        {
+            for (size_t i = 0; i < lane_traits<Parameter>::size; ++i)
+            {
+                if (!isNear(parameter[i], m_parameter[i]))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+        else
+        {
+            return isNear(parameter, m_parameter);
+        }
+    }
+
+public:
+    // the next call computes the coefficient
+    void reset()
+    {
+        m_valid = false;
+    }
+    // coefficient for parameter, compute(parameter) being called when the cached one is stale
+    template <typename Fn>
+    inline const T& operator()(const Parameter& parameter, Fn&& compute)
+    {
+        if constexpr (cached)
+        {
+            if (m_valid && isNear(parameter))
+            {
+                return m_value;
+            }
+            m_parameter = parameter;
+            m_valid     = true;
+        }
+        m_value = std::forward<Fn>(compute)(parameter);
+        return m_value;
+    }
+};
+
+// Coefficient moving linearly to the target it is given once per control period of Period
+// samples, for coefficients of parameters changing every sample. The first target is reached
+// right away.
+template <typename T, size_t Period>
+class dap::dsp::CoefficientRamp final
+{
+    static_assert(Period > 0, "Period must be greater than zero");
+
+    T m_value{0};
+    T m_step{0};
+    size_t m_counter{0};
+    bool m_valid{false};
+
+public:
+    void reset()
+    {
+        m_value   = T(0);
+        m_step    = T(0);
+        m_counter = 0;
+        m_valid   = false;
+    }
+    // true when the ramp needs a new target, i.e. at the beginning of a control period
+    bool isDue() const
+    {
+        return m_counter == 0;
+    }
+    // the value of the coefficient Period samples from now
+    void setTarget(T target)
+    {
+        if (!m_valid)
+        {
+            m_value = target;
+            m_valid = true;
+        }
+        m_step = (target - m_value) / T(Period);
+    }
+    // the coefficient for the current sample
+    inline const T& operator()()
+    {
+        m_value += m_step;
+        m_counter = m_counter + 1 == Period ? 0 : m_counter + 1;
+        return m_value;
+    }
+};
+
+#endif // DAP_DSP_COEFFICIENT_CACHE_H
@@ -1,7 +1,11 @@
 #ifndef DAP_DSP_COMB_FILTER_H
 #define DAP_DSP_COMB_FILTER_H
 
+#include "CoefficientCache.h"
 #include "DelayLine.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
 
 namespace dap
 {
@@ -9,6 +13,50 @@ namespace dap
     {
         struct CombFilter
         {
+            template <typename T>
+            static T normalization(T gain)
+            {
+                using std::sqrt;
+                return T(1) / sqrt(T(1) + gain * gain);
+            }
+            // x / sqrt(1 + gain^2), the normalization being cached for arithmetic and packed types
+            template <typename T, typename X, typename Gain>
+            static T normalize(CoefficientCache<T>& normalization, const X& x, const Gain& gain)
+            {
+                if constexpr (isArithmeticOrPacked<T>())
+                {
+                    return x * normalization(T(gain), &CombFilter::normalization<T>);
+                }
+                else
+                {
+                    using std::sqrt;
+                    return x / sqrt((T(1) + gain * gain));
+                }
+            }
+            // frames processed at once by the block overloads, their delayed samples being
+            // read in one go, at most half the size of their delay line
+            static constexpr size_t chunk = 64;
+
+            // the frames from the first one on, at most frames of them, whose frame k is delayed
+            // by at least k + offset samples, i.e. whose delayed samples are already written
+            template <typename Delay>
+            static size_t available(const Delay& delay, size_t frames, size_t offset)
+            {
+                if constexpr (isHeld<Delay>())
+                {
+                    const auto d = size_t(std::max(delay, Delay(0)));
+                    return std::min(frames, d + 1 >= offset ? d + 1 - offset : size_t(0));
+                }
+                else
+                {
+                    size_t k = 0;
+                    while (k < frames && frameAt(delay, k) >= float(k + offset))
+                    {
+                        ++k;
+                    }
+                    return k;
+                }
+            }
         };
         template <typename T, size_t N>
         class FeedforwardCombFilter;
@@ -21,12 +69,57 @@ template <typename T, size_t N>
 class dap::dsp::FeedforwardCombFilter final : public CombFilter
 {
     DelayLine<T, N> m_delay;
+    CoefficientCache<T> m_normalization;
 
 public:
+    static constexpr bool audio_rate_only = true;
+
+    // see DelayLine
+    size_t memorySize() const
+    {
+        return m_delay.memorySize();
+    }
+    bool attached() const
+    {
+        return m_delay.attached();
+    }
+    template <size_t M = N, DAP_REQUIRES(M == dynamic_delay)>
+    void setMaxDelay(size_t delay)
+    {
+        m_delay.setMaxDelay(delay);
+    }
+    template <size_t M = N, DAP_REQUIRES(M == dynamic_delay)>
+    void attach(DelayMemory& memory)
+    {
+        m_delay.attach(memory);
+    }
+    void reset()
+    {
+        m_delay.reset();
+        m_normalization.reset();
+    }
     template <typename T1, typename T2, typename T3>
     inline auto operator()(T1 input, T2 delay, T3 gain)
     {
-        return input + gain * m_delay(input, delay) / sqrt((T(1) + gain * gain));
+        return input + normalize(m_normalization, gain * m_delay(input, delay), gain);
+    }
+    // block overload, inputs being given per frame or held, see Frames.h
+    template <typename Input, typename Delay, typename Gain>
+    inline void process(
+        T* out, size_t frames, const Input& input, const Delay& delay, const Gain& gain)
+    {
+        const size_t limit = std::min(chunk, m_delay.size() / 2);
+        std::array<T, chunk> delayed;
+        for (size_t n = 0; n < frames; n += limit)
+        {
+            const size_t count = std::min(limit, frames - n);
+            m_delay.process(delayed.data(), count, fromFrame(input, n), fromFrame(delay, n));
+            for (size_t k = 0; k < count; ++k)
+            {
+                const T g  = frameAt(gain, n + k);
+                out[n + k] = frameAt(input, n + k) + normalize(m_normalization, g * delayed[k], g);
+            }
+        }
     }
 };
 
@@ -34,14 +127,71 @@ template <typename T, size_t N>
 class dap::dsp::FeedbackCombFilter final : public CombFilter
 {
     DelayLine<T, N> m_delay;
+    CoefficientCache<T> m_normalization;
     T m_output{0};
 
 public:
+    static constexpr bool audio_rate_only = true;
+
+    // see DelayLine
+    size_t memorySize() const
+    {
+        return m_delay.memorySize();
+    }
+    bool attached() const
+    {
+        return m_delay.attached();
+    }
+    template <size_t M = N, DAP_REQUIRES(M == dynamic_delay)>
+    void setMaxDelay(size_t delay)
+    {
+        m_delay.setMaxDelay(delay);
+    }
+    template <size_t M = N, DAP_REQUIRES(M == dynamic_delay)>
+    void attach(DelayMemory& memory)
+    {
+        m_delay.attach(memory);
+    }
+    void reset()
+    {
+        m_delay.reset();
+        m_normalization.reset();
+        m_output = T(0);
+    }
     template <typename T1, typename T2, typename T3>
     inline auto operator()(T1 input, T2 delay, T3 gain)
     {
-        m_output = (input + gain * m_delay(m_output, delay)) / sqrt((T(1) + gain * gain));
+        m_output = normalize(m_normalization, input + gain * m_delay(m_output, delay), gain);
         return m_output;
     }
+    // block overload, inputs being given per frame or held, see Frames.h. The output of each
+    // frame is written to the delay line before the next one is read, as operator() does, so
+    // the frames are processed by chunks no longer than the delay, whose outputs are read at once.
+    template <typename Input, typename Delay, typename Gain>
+    inline void process(
+        T* out, size_t frames, const Input& input, const Delay& delay, const Gain& gain)
+    {
+        const size_t limit = std::min(chunk, m_delay.size() / 2);
+        std::array<T, chunk> delayed;
+        size_t n = 0;
+        while (n < frames)
+        {
+            // the first frame of a chunk reads the output last written at the earliest
+            m_delay.write(&m_output, 1);
+            const auto d       = fromFrame(delay, n);
+            const size_t count =
+                std::max<size_t>(1, available(d, std::min(limit, frames - n), 0));
+            m_delay.template readAt<Interpolation::Linear>(
+                delayed.data(), count, d, m_delay.m_write - 1, m_delay.m_write - 1);
+            for (size_t k = 0; k < count; ++k)
+            {
+                const T g  = frameAt(gain, n + k);
+                m_output   = normalize(m_normalization, frameAt(input, n + k) + g * delayed[k], g);
+                out[n + k] = m_output;
+            }
+            m_delay.write(out + n, count - 1);
+            n += count;
+        }
+    }
 };
 #endif // DAP_DSP_COMB_FILTER_H
@@ -0,0 +1,292 @@
+#ifndef DAP_DSP_CONVOLVER_H
+#define DAP_DSP_CONVOLVER_H
+
+#include "UniformConvolver.h"
+#include "base/Semaphore.h"
+#include "fastmath/AudioBuffer.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace dap
+{
+    namespace dsp
+    {
+        template <typename T>
+        class Convolver;
+    }
+}
+
+// Convolution of every channel of a buffer with its impulse response, without latency.
+//
+// The impulse response is split in a head, convolved by partitions of partitionSize() samples
+// as the frames arrive, and, when a tail partition size is given, a tail convolved by partitions
+// of that size. A tail block is convolved once complete, while the next block arrives, on a
+// background thread unless it runs on the audio thread, its output being mixed in during the
+// block after. The head therefore spans two tail partitions, so that long impulse responses cost
+// the large FFTs of the tail once per tail block, away from the audio thread, and the small ones
+// of the head per block.
+//
+// The audio thread never waits for the background thread. When the tail job of a block is not done
+// by the time the next tail block is complete, that block is dropped and the output of the tail
+// block before it is mixed in once more, which underruns() counts.
+template <typename T>
+class dap::dsp::Convolver final
+{
+    using buffer_t = fastmath::AudioBuffer<T>;
+
+    size_t m_channels;
+    size_t m_partitionSize;
+    size_t m_tailPartitionSize;
+    bool m_background;
+    std::vector<UniformConvolver<T>> m_head;
+    std::vector<UniformConvolver<T>> m_tail;
+    // the tail block being filled and the output of the tail block before the previous one at
+    // m_current, the block and output of the tail job at the other index
+    buffer_t m_tailInput[2];
+    buffer_t m_tailOutput[2];
+    size_t m_current{0};
+    size_t m_fill{0};
+    bool m_pending{false};
+    Semaphore m_start;
+    std::atomic<bool> m_jobDone{true};
+    std::atomic<size_t> m_underruns{0};
+    std::atomic<bool> m_stop{false};
+    std::thread m_thread;
+
+    size_t headLength() const
+    {
+        return 2 * m_tailPartitionSize;
+    }
+    bool hasTail() const
+    {
+        return !m_tail.empty() && m_tail.front().partitions() > 0;
+    }
+    void runJob()
+    {
+        for (size_t c = 0; c < m_channels; ++c)
+        {
+            m_tail[c].process(m_tailOutput[1 - m_current].channel(c).data(),
+                              m_tailInput[1 - m_current].channel(c).data(),
+                              m_tailPartitionSize);
+        }
+    }
+    // not on the audio thread
+    void waitJob()
+    {
+        if (m_pending)
+        {
+            while (!m_jobDone.load(std::memory_order_acquire))
+            {
+                std::this_thread::yield();
+            }
+            m_pending = false;
+        }
+    }
+    // the tail block is complete, its job is queued unless the previous one is late
+    void exchange()
+    {
+        m_fill = 0;
+        if (m_pending && !m_jobDone.load(std::memory_order_acquire))
+        {
+            m_underruns.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        m_pending = false;
+        m_current = 1 - m_current;
+        if (m_thread.joinable())
+        {
+            m_jobDone.store(false, std::memory_order_relaxed);
+            m_pending = true;
+            m_start.signal();
+        }
+        else
+        {
+            runJob();
+        }
+    }
+    void stop()
+    {
+        waitJob();
+        if (m_thread.joinable())
+        {
+            m_stop = true;
+            m_start.signal();
+            m_thread.join();
+        }
+    }
+    template <typename Out, typename In>
+    void render(Out out, In in, size_t frames)
+    {
+        if (!hasTail())
+        {
+            for (size_t c = 0; c < m_channels; ++c)
+            {
+                m_head[c].process(out(c), in(c), frames);
+            }
+            return;
+        }
+        size_t done = 0;
+        while (done < frames)
+        {
+            const size_t count = std::min(frames - done, m_tailPartitionSize - m_fill);
+            for (size_t c = 0; c < m_channels; ++c)
+            {
+                T* y       = out(c) + done;
+                const T* x = in(c) + done;
+                const T* z = m_tailOutput[m_current].channel(c).data() + m_fill;
+                std::copy_n(x, count, m_tailInput[m_current].channel(c).data() + m_fill);
+                m_head[c].process(y, x, count);
+                for (size_t n = 0; n < count; ++n)
+                {
+                    y[n] += z[n];
+                }
+            }
+            m_fill += count;
+            done += count;
+            if (m_fill == m_tailPartitionSize)
+            {
+                exchange();
+            }
+        }
+    }
+
+public:
+    // partitionSize and tailPartitionSize are powers of two, tailPartitionSize 0 convolving the
+    // whole impulse response by partitions of partitionSize. Unless background is false, the
+    // tail is convolved on a thread of the convolver.
+    Convolver(size_t channels,
+              size_t partitionSize,
+              size_t tailPartitionSize = 0,
+              bool background          = true)
+    : m_channels(channels)
+    , m_partitionSize(partitionSize)
+    , m_tailPartitionSize(tailPartitionSize)
+    , m_background(background)
+    , m_head(channels, UniformConvolver<T>(partitionSize))
+    , m_tailInput{buffer_t(channels, tailPartitionSize), buffer_t(channels, tailPartitionSize)}
+    , m_tailOutput{buffer_t(channels, tailPartitionSize), buffer_t(channels, tailPartitionSize)}
+    {
+        if (tailPartitionSize != 0 && tailPartitionSize < partitionSize)
+        {
+            throw std::invalid_argument("The tail partitions cannot be smaller than the head ones");
+        }
+        if (tailPartitionSize != 0)
+        {
+            m_tail.assign(channels, UniformConvolver<T>(tailPartitionSize));
+        }
+    }
+    Convolver(const Convolver&) = delete;
+    Convolver& operator=(const Convolver&) = delete;
+    ~Convolver()
+    {
+        stop();
+    }
+    size_t channels() const
+    {
+        return m_channels;
+    }
+    size_t partitionSize() const
+    {
+        return m_partitionSize;
+    }
+    size_t tailPartitionSize() const
+    {
+        return m_tailPartitionSize;
+    }
+    // channel c is convolved with channel c of ir, or with its last channel if ir has fewer.
+    // Allocates and stops the background thread, so not to be called while processing.
+    void setImpulseResponse(const buffer_t& ir)
+    {
+        if (ir.channelCount() == 0)
+        {
+            throw std::invalid_argument("The impulse response has no channels");
+        }
+        stop();
+        const size_t length = ir.channelSize();
+        const size_t head   = m_tail.empty() ? length : std::min(length, headLength());
+        for (size_t c = 0; c < m_channels; ++c)
+        {
+            const T* samples = ir.channel(std::min(c, ir.channelCount() - 1)).data();
+            m_head[c].setImpulseResponse(samples, head);
+            if (!m_tail.empty())
+            {
+                m_tail[c].setImpulseResponse(samples + head, length - head);
+            }
+        }
+        reset();
+        if (hasTail() && m_background)
+        {
+            m_stop   = false;
+            m_thread = std::thread([this] {
+                while (true)
+                {
+                    m_start.wait();
+                    if (m_stop)
+                    {
+                        return;
+                    }
+                    runJob();
+                    m_jobDone.store(true, std::memory_order_release);
+                }
+            });
+        }
+    }
+    // every channel is convolved with the length samples of ir
+    void setImpulseResponse(const T* ir, size_t length)
+    {
+        buffer_t buffer(1, length);
+        std::copy_n(ir, length, buffer.channel(0).data());
+        setImpulseResponse(buffer);
+    }
+    // tail blocks dropped because their job was late since the last reset
+    size_t underruns() const
+    {
+        return m_underruns.load(std::memory_order_relaxed);
+    }
+    // waits for the tail job, e.g. to render offline without underruns, so not to be called
+    // while processing
+    void waitTail()
+    {
+        waitJob();
+    }
+    // waits for the tail job, so not to be called while processing
+    void reset()
+    {
+        waitJob();
+        m_underruns = 0;
+        for (auto& head : m_head)
+        {
+            head.reset();
+        }
+        for (auto& tail : m_tail)
+        {
+            tail.reset();
+        }
+        for (size_t c = 0; c < m_channels; ++c)
+        {
+            for (size_t i = 0; i < 2; ++i)
+            {
+                std::fill_n(m_tailInput[i].channel(c).data(), m_tailPartitionSize, T(0));
+                std::fill_n(m_tailOutput[i].channel(c).data(), m_tailPartitionSize, T(0));
+            }
+        }
+        m_fill = 0;
+    }
+    // convolves the channels of buffer in place, buffer having channels() channels
+    void process(buffer_t& buffer)
+    {
+        assert(buffer.channelCount() == m_channels);
+        render([&buffer](size_t c) { return buffer.channel(c).data(); },
+               [&buffer](size_t c) { return buffer.channel(c).data(); },
+               buffer.channelSize());
+    }
+    // convolves a single channel, out may be in
+    void process(T* out, const T* in, size_t frames)
+    {
+        assert(m_channels == 1);
+        render([out](size_t) { return out; }, [in](size_t) { return in; }, frames);
+    }
+};
+
+#endif // DAP_DSP_CONVOLVER_H
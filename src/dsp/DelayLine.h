@@ -1,47 +1,355 @@
 #ifndef DAP_DSP_DELAY_LINE_H
 #define DAP_DSP_DELAY_LINE_H
 
+#include "DelayMemory.h"
+#include "Frames.h"
+#include "InterpolationFunctions.h"
+#include "fastmath/Pack.h"
 #include "base/TypeTraits.h"
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
 
 namespace dap
 {
     namespace dsp
     {
+        // N of the delay lines whose maximum delay is set at runtime, their samples being taken
+        // from a DelayMemory, see DelayLine::setMaxDelay
+        constexpr size_t dynamic_delay = 0;
+
         template <typename T, size_t N>
         class DelayLine;
+
+        namespace detail
+        {
+            // sample p of a line of size() samples is at data()[p + 1], see DelayLine::mirror
+            template <typename T, size_t N>
+            struct DelayStorage
+            {
+                static_assert(IsPowerOfTwo<N>::value, "N must be a power of two");
+                static_assert(N > 2 && N <= (size_t(1) << 30), "N must be in (2, 2^30]");
+
+                std::array<T, N + 3> m_buffer{};
+
+                static constexpr size_t size()
+                {
+                    return N;
+                }
+                static constexpr bool attached()
+                {
+                    return true;
+                }
+                T* data()
+                {
+                    return m_buffer.data();
+                }
+            };
+            // a copy keeps the size of the line but is not attached, the samples belonging to the
+            // line copied, while a move takes them over
+            template <typename T>
+            struct DelayStorage<T, dynamic_delay>
+            {
+                T* m_buffer{nullptr};
+                size_t m_size{4};
+
+                DelayStorage() = default;
+                DelayStorage(const DelayStorage& other)
+                : m_size{other.m_size}
+                {
+                }
+                DelayStorage(DelayStorage&& other) noexcept
+                : m_buffer{other.m_buffer}
+                , m_size{other.m_size}
+                {
+                    other.m_buffer = nullptr;
+                }
+                DelayStorage& operator=(const DelayStorage& other)
+                {
+                    if (this != &other)
+                    {
+                        m_buffer = nullptr;
+                        m_size   = other.m_size;
+                    }
+                    return *this;
+                }
+                DelayStorage& operator=(DelayStorage&& other) noexcept
+                {
+                    if (this != &other)
+                    {
+                        m_buffer       = other.m_buffer;
+                        m_size         = other.m_size;
+                        other.m_buffer = nullptr;
+                    }
+                    return *this;
+                }
+                ~DelayStorage() = default;
+
+                size_t size() const
+                {
+                    return m_size;
+                }
+                bool attached() const
+                {
+                    return m_buffer != nullptr;
+                }
+                T* data()
+                {
+                    assert(m_buffer != nullptr && "delay line not attached to its memory");
+                    return m_buffer;
+                }
+            };
+        }
     }
 }
 
+// Delay of up to N - 1 samples. Samples are written and read either one at a time, the sample
+// written being read with a delay of 0, or by blocks: write() appends a block and read() returns
+// the block last written delayed, copied in at most two contiguous segments for a held integral
+// delay, or interpolated frame by frame for a modulated one.
+//
+// The N samples are held inline, or taken from a DelayMemory when N is dynamic_delay, the size of
+// the line being then the power of two fitting the maximum delay given at runtime. Large delays
+// are better kept out of the processors, e.g. out of the nodes of a graph. A copy of a dynamic
+// line must be attached to memory of its own before use.
 template <typename T, size_t N>
 class dap::dsp::DelayLine final
 {
-    static_assert(IsPowerOfTwo<N>::value, "N must be a power of two");
-    static_assert(N > 0, "N must be greater than zero");
-    using bitmask = std::integral_constant<size_t, N - 1>;
-    std::array<T, N> m_buffer{};
+    detail::DelayStorage<T, N> m_storage;
     size_t m_write{0};
+    T m_allpass{0};
+
+    size_t storageSize() const
+    {
+        return m_storage.size() + 3;
+    }
+    size_t mask() const
+    {
+        return m_storage.size() - 1;
+    }
+    T* samples()
+    {
+        return m_storage.data() + 1;
+    }
+    static void copy(T* to, const T* from, size_t count)
+    {
+        if constexpr (std::is_trivially_copyable<T>::value)
+        {
+            std::memcpy(to, from, count * sizeof(T));
+        }
+        else
+        {
+            std::copy(from, from + count, to);
+        }
+    }
+    // the first sample mirrors sample size() - 1 and the last two samples 0 and 1, so that
+    // interpolated reads need no masking of their taps
+    void mirror()
+    {
+        T* buffer          = m_storage.data();
+        buffer[0]          = buffer[size()];
+        buffer[size() + 1] = buffer[1];
+        buffer[size() + 2] = buffer[2];
+    }
+
+    // out[n] is the sample at position first + n delayed by delay[n], delays being clamped so
+    // that the oldest tap is not older than the sample at newest - N + 1. The delays of a chunk of
+    // frames are clamped and split four at a time in the lanes of a float4, the taps being then
+    // read frame by frame.
+    template <Interpolation I, typename Delay>
+    inline void readAt(T* out, size_t frames, const Delay& delay, size_t first, size_t newest)
+    {
+        using float4              = fastmath::float4;
+        constexpr bool fourPoints = I == Interpolation::Cubic || I == Interpolation::Lagrange;
+        constexpr bool thiran     = I == Interpolation::Thiran;
+        constexpr int taps        = fourPoints ? 2 : 1;
+        constexpr float minDelay  = fourPoints ? 1.0f : thiran ? 0.5f : 0.0f;
+        // the allpass of Thiran takes fractions in [0.5, 1.5), borrowing a sample of the integral
+        // delay, as its pole reaches z = -1 at a fraction of 0
+        constexpr float borrowed = thiran ? 0.5f : 0.0f;
+        const auto maxDelay       = float(size() - 1 - taps);
+        constexpr size_t chunk    = 64;
+        // positions wrap around but not their difference
+        const float older = float(std::ptrdiff_t(newest - first));
+        const float4 lanes(0.0f, 1.0f, 2.0f, 3.0f);
+        mirror();
+        const T* x = samples();
+
+        alignas(16) float delays[chunk];
+        alignas(16) float fractions[chunk];
+        for (size_t start = 0; start < frames; start += chunk)
+        {
+            const size_t count = std::min(chunk, frames - start);
+            for (size_t k = 0; k < count; k += 4)
+            {
+                float4 input;
+                for (size_t i = 0; i < 4; ++i)
+                {
+                    input[i] = float(frameAt(delay, start + std::min(k + i, count - 1)));
+                }
+                const float4 ramp = lanes + (maxDelay - older + float(start + k));
+                const float4 d    = min(max(input, minDelay), min(ramp, maxDelay));
+                const float4 id   = floor(d - borrowed);
+                id.store(delays + k);
+                (d - id).store(fractions + k);
+            }
+            // the position of the newer tap, or of the older one for four point interpolations
+            const auto t0 = int32_t((first + start) & mask()) - (taps - 1);
+            for (size_t k = 0; k < count; ++k)
+            {
+                const auto position = (t0 + int32_t(k) - int32_t(delays[k])) & mask();
+                const T* tap        = x + position;
+                const float frac    = fractions[k];
+                if constexpr (fourPoints)
+                {
+                    // taps in time order, the fraction measured from the older sample
+                    out[start + k] = InterpolationFunctions::process<I>(tap, T(1.0f - frac));
+                }
+                else if constexpr (thiran)
+                {
+                    const T eta    = T((1.0f - frac) / (1.0f + frac));
+                    m_allpass      = tap[-1] + eta * (tap[0] - m_allpass);
+                    out[start + k] = m_allpass;
+                }
+                else
+                {
+                    out[start + k] = tap[0] + frac * (tap[-1] - tap[0]);
+                }
+            }
+        }
+    }
+
+    template <typename, size_t>
+    friend class FeedbackCombFilter;
+    template <typename, size_t>
+    friend class FeedbackLine;
 
 public:
+    // N, or the size fitting the maximum delay of a dynamic line
+    size_t size() const
+    {
+        return m_storage.size();
+    }
+    // the bytes of the samples of the line, inline or in its DelayMemory
+    size_t memorySize() const
+    {
+        return storageSize() * sizeof(T);
+    }
+    // false for a dynamic line until attached to its memory
+    bool attached() const
+    {
+        return m_storage.attached();
+    }
+    // sets the maximum delay of a dynamic line, the line being then attached to its memory again.
+    // The delays of interpolated reads reach delay, integral ones a bit further.
+    template <size_t M = N, DAP_REQUIRES(M == dynamic_delay)>
+    void setMaxDelay(size_t delay)
+    {
+        size_t samples = 4;
+        while (samples < delay + 2)
+        {
+            samples *= 2;
+        }
+        m_storage.m_size   = samples;
+        m_storage.m_buffer = nullptr;
+    }
+    // takes the samples of a dynamic line from memory, the line being reset, as the samples
+    // allocated are zeroed
+    template <size_t M = N, DAP_REQUIRES(M == dynamic_delay)>
+    void attach(DelayMemory& memory)
+    {
+        m_storage.m_buffer = memory.allocate<T>(storageSize());
+        m_write            = 0;
+        m_allpass          = T(0);
+    }
+    void reset()
+    {
+        if (m_storage.attached())
+        {
+            std::fill(m_storage.data(), m_storage.data() + storageSize(), T(0));
+        }
+        m_write   = 0;
+        m_allpass = T(0);
+    }
     template <typename T1, typename T2, DAP_REQUIRES(!isIntegral<T2>())>
     inline auto operator()(T1 input, T2 delay)
     {
-        const float d         = std::min<float>(N - 1, delay);
-        m_buffer[m_write]     = input;
+        T* x                  = samples();
+        const float d         = std::min<float>(size() - 2, delay);
+        x[m_write]            = input;
         const auto int_delay  = static_cast<size_t>(d);
         const auto frac_delay = d - static_cast<size_t>(int_delay);
-        const size_t read     = (m_write - int_delay) & bitmask::value;
-        const auto cur        = m_buffer[read];
-        const auto prev       = m_buffer[(read - 1u) & bitmask::value];
-        m_write               = (m_write + 1u) & bitmask::value;
+        const size_t read     = (m_write - int_delay) & mask();
+        const auto cur        = x[read];
+        const auto prev       = x[(read - 1u) & mask()];
+        m_write               = (m_write + 1u) & mask();
         return cur + frac_delay * (prev - cur);
     }
     template <typename T1, typename T2, DAP_REQUIRES(isIntegral<T2>())>
     inline auto operator()(T1 input, T2 delay)
     {
-        m_buffer[m_write] = input;
-        const auto read   = (m_write - std::min<T2>(N - 1, delay)) & bitmask::value;
-        m_write           = (m_write + 1u) & bitmask::value;
-        return m_buffer[read];
+        T* x            = samples();
+        x[m_write]      = input;
+        const auto read = (m_write - std::min<T2>(size() - 1, delay)) & mask();
+        m_write         = (m_write + 1u) & mask();
+        return x[read];
+    }
+    // appends frames samples, frames being at most N
+    void write(const T* in, size_t frames)
+    {
+        const size_t first = std::min(frames, size() - m_write);
+        copy(samples() + m_write, in, first);
+        copy(samples(), in + first, frames - first);
+        m_write = (m_write + frames) & mask();
+    }
+    // out[n] is in[n - delay] of the block in last written, the delay being at most N - frames
+    void read(T* out, size_t frames, size_t delay)
+    {
+        const size_t d     = std::min(delay, size() - frames);
+        const size_t start = (m_write - frames - d) & mask();
+        const size_t first = std::min(frames, size() - start);
+        const T* x         = samples();
+        copy(out, x + start, first);
+        copy(out + first, x, frames - first);
+    }
+    // modulated read of the block last written with the interpolation I, delay being given per
+    // frame or held, see Frames.h. The delay of frame n is at most N - 2 - (frames - 1 - n), or
+    // N - 3 - (frames - 1 - n) and at least 1 for the four point interpolations. Thiran
+    // interpolation suits slowly moving delays of at least 1/2, its allpass state being carried
+    // from read to read.
+    template <Interpolation I = Interpolation::Linear,
+              typename Delay,
+              DAP_REQUIRES(!isIntegral<Delay>() || !isHeld<Delay>())>
+    void read(T* out, size_t frames, const Delay& delay)
+    {
+        readAt<I>(out, frames, delay, m_write - frames, m_write - 1);
+    }
+    // block overload of operator(), input and delay being given per frame or held, frames being
+    // at most N
+    template <typename Input, typename Delay>
+    inline void process(T* out, size_t frames, const Input& input, const Delay& delay)
+    {
+        if constexpr (isHeld<Input>())
+        {
+            std::fill(out, out + frames, T(input));
+            write(out, frames);
+        }
+        else
+        {
+            write(input, frames);
+        }
+        if constexpr (isHeld<Delay>() && isIntegral<Delay>())
+        {
+            read(out, frames, size_t(delay));
+        }
+        else
+        {
+            read(out, frames, delay);
+        }
     }
 };
 #endif // DAP_DSP_DELAY_LINE_H
@@ -0,0 +1,84 @@
+#ifndef DAP_DSP_DELAY_MEMORY_H
+#define DAP_DSP_DELAY_MEMORY_H
+
+#include "fastmath/FastmathAlignedAllocator.h"
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace dap
+{
+    namespace dsp
+    {
+        class DelayMemory;
+    }
+}
+
+// Arena the dynamic delay lines of a graph take their samples from, see DelayLine::attach. It is
+// sized once, typically at graph construction, so that the delay buffers live apart from the
+// state of the processors, which stays compact. Blocks start on a cache line and may hold
+// samples of different types, e.g. the lines of scalar and packed processors.
+class dap::dsp::DelayMemory final
+{
+    static constexpr size_t alignment = 64;
+
+    std::vector<unsigned char, fastmath::AlignedAllocator<unsigned char, alignment>> m_bytes;
+    size_t m_used{0};
+
+public:
+    // the bytes a block of the given bytes takes, rounded up to whole cache lines
+    static constexpr size_t footprint(size_t bytes)
+    {
+        return (bytes + alignment - 1) / alignment * alignment;
+    }
+
+    DelayMemory() = default;
+    explicit DelayMemory(size_t capacity)
+    : m_bytes(capacity)
+    {
+    }
+    // the lines hold pointers into the arena
+    DelayMemory(const DelayMemory&) = delete;
+    DelayMemory& operator=(const DelayMemory&) = delete;
+
+    // in bytes
+    size_t capacity() const
+    {
+        return m_bytes.size();
+    }
+    size_t used() const
+    {
+        return m_used;
+    }
+    // count zeroed samples, throws std::bad_alloc when the arena is exhausted
+    template <typename T>
+    T* allocate(size_t count)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "delay samples must be trivial");
+        static_assert(alignof(T) <= alignment, "delay samples are aligned on cache lines");
+        const size_t size = footprint(count * sizeof(T));
+        if (size > capacity() - m_used)
+        {
+            throw std::bad_alloc();
+        }
+        auto* block = reinterpret_cast<T*>(m_bytes.data() + m_used); // NOLINT
+        std::uninitialized_fill_n(block, count, T(0));
+        m_used += size;
+        return block;
+    }
+    // takes all blocks back, the lines attached to them must be attached again
+    void clear()
+    {
+        m_used = 0;
+    }
+    // clears the arena, then sets its capacity in bytes
+    void resize(size_t capacity)
+    {
+        clear();
+        m_bytes.resize(capacity);
+    }
+};
+
+#endif // DAP_DSP_DELAY_MEMORY_H
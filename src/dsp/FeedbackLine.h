@@ -1,6 +1,7 @@
 #ifndef DAP_DSP_FEEDBACK_LINE_H
 #define DAP_DSP_FEEDBACK_LINE_H
 
+#include "CombFilter.h"
 #include "DelayLine.h"
 
 namespace dap
@@ -15,15 +16,77 @@ template <typename T, size_t N>
 class dap::dsp::FeedbackLine final
 {
     DelayLine<T, N> m_delay;
+    CoefficientCache<T> m_normalization;
     T m_output{0};
 
 public:
+    static constexpr bool audio_rate_only = true;
+
+    // see DelayLine
+    size_t memorySize() const
+    {
+        return m_delay.memorySize();
+    }
+    bool attached() const
+    {
+        return m_delay.attached();
+    }
+    template <size_t M = N, DAP_REQUIRES(M == dynamic_delay)>
+    void setMaxDelay(size_t delay)
+    {
+        m_delay.setMaxDelay(delay);
+    }
+    template <size_t M = N, DAP_REQUIRES(M == dynamic_delay)>
+    void attach(DelayMemory& memory)
+    {
+        m_delay.attach(memory);
+    }
+    void reset()
+    {
+        m_delay.reset();
+        m_normalization.reset();
+        m_output = T(0);
+    }
     template <typename T1, typename T2, typename T3>
     inline auto operator()(T1 input, T2 delay, T3 feedback)
     {
-        m_output =
-            m_delay((input + m_output * feedback) / sqrt((T(1) + feedback * feedback)), delay);
+        m_output = m_delay(
+            CombFilter::normalize(m_normalization, input + m_output * feedback, feedback), delay);
         return m_output;
     }
+    // block overload, inputs being given per frame or held, see Frames.h. Frames are processed by
+    // chunks shorter than the delay, whose delayed samples are read at once, and frame by frame
+    // when the delay is shorter than a sample.
+    template <typename Input, typename Delay, typename Feedback>
+    inline void process(
+        T* out, size_t frames, const Input& input, const Delay& delay, const Feedback& feedback)
+    {
+        constexpr size_t chunk = CombFilter::chunk;
+        const size_t limit     = std::min(chunk, m_delay.size() / 2);
+        std::array<T, chunk> written;
+        size_t n = 0;
+        while (n < frames)
+        {
+            const auto d       = fromFrame(delay, n);
+            const size_t count = CombFilter::available(d, std::min(limit, frames - n), 1);
+            if (count == 0)
+            {
+                out[n] = (*this)(frameAt(input, n), frameAt(delay, n), frameAt(feedback, n));
+                ++n;
+                continue;
+            }
+            m_delay.template readAt<Interpolation::Linear>(
+                out + n, count, d, m_delay.m_write, m_delay.m_write - 1);
+            for (size_t k = 0; k < count; ++k)
+            {
+                const T fb = frameAt(feedback, n + k);
+                written[k] = CombFilter::normalize(
+                    m_normalization, frameAt(input, n + k) + m_output * fb, fb);
+                m_output = out[n + k];
+            }
+            m_delay.write(written.data(), count);
+            n += count;
+        }
+    }
 };
 #endif // DAP_DSP_FEEDBACK_LINE_H
@@ -0,0 +1,54 @@
+#ifndef DAP_DSP_FRAMES_H
+#define DAP_DSP_FRAMES_H
+
+#include <cstddef>
+#include <type_traits>
+
+// Inputs of the block overloads of processors, process(out, frames, inputs...), are either a
+// pointer to one value per frame or a value held for the whole block.
+
+namespace dap
+{
+    namespace dsp
+    {
+        template <typename T>
+        inline const T& frameAt(const T* input, size_t n)
+        {
+            return input[n];
+        }
+        template <typename T>
+        inline const T& frameAt(T* input, size_t n)
+        {
+            return input[n];
+        }
+        template <typename T>
+        inline const T& frameAt(const T& input, size_t)
+        {
+            return input;
+        }
+        // the inputs of the frames from n on
+        template <typename T>
+        inline const T* fromFrame(const T* input, size_t n)
+        {
+            return input + n;
+        }
+        template <typename T>
+        inline const T* fromFrame(T* input, size_t n)
+        {
+            return input + n;
+        }
+        template <typename T>
+        inline const T& fromFrame(const T& input, size_t)
+        {
+            return input;
+        }
+        // true if input is held for the whole block
+        template <typename T>
+        constexpr bool isHeld()
+        {
+            return !std::is_pointer<std::decay_t<T>>::value;
+        }
+    }
+}
+
+#endif // DAP_DSP_FRAMES_H
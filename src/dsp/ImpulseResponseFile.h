@@ -0,0 +1,49 @@
+#ifndef DAP_DSP_IMPULSE_RESPONSE_FILE_H
+#define DAP_DSP_IMPULSE_RESPONSE_FILE_H
+
+#include "fastmath/AudioBuffer.h"
+#include <sndfile.hh>
+#include <string>
+
+// Targets including this header link SndFile::sndfile.
+
+namespace dap
+{
+    namespace dsp
+    {
+        // the channels of the impulse response in the sound file at path, see
+        // Convolver::setImpulseResponse
+        template <typename T>
+        fastmath::AudioBuffer<T> loadImpulseResponse(const std::string& path);
+    }
+}
+
+template <typename T>
+dap::fastmath::AudioBuffer<T> dap::dsp::loadImpulseResponse(const std::string& path)
+{
+    SndfileHandle file(path);
+    if (file.error() != 0)
+    {
+        throw std::runtime_error("Cannot open impulse response " + path + ": " + file.strError());
+    }
+    const auto channels = size_t(file.channels());
+    const auto length   = size_t(file.frames());
+    if (length == 0)
+    {
+        throw std::runtime_error("Impulse response " + path + " is empty.");
+    }
+    std::vector<float> interleaved(length * channels);
+    file.readf(interleaved.data(), sf_count_t(length));
+    fastmath::AudioBuffer<T> ir(channels, length);
+    for (size_t c = 0; c < channels; ++c)
+    {
+        T* samples = ir.channel(c).data();
+        for (size_t n = 0; n < length; ++n)
+        {
+            samples[n] = T(interleaved[n * channels + c]);
+        }
+    }
+    return ir;
+}
+
+#endif // DAP_DSP_IMPULSE_RESPONSE_FILE_H
@@ -0,0 +1,70 @@
+#ifndef DAP_DSP_INTERPOLATION_FUNCTIONS_H
+#define DAP_DSP_INTERPOLATION_FUNCTIONS_H
+
+namespace dap
+{
+    namespace dsp
+    {
+        enum class Interpolation
+        {
+            Linear,   // through x[0] and x[1]
+            Cubic,    // through x[-1], ..., x[2], Catmull-Rom
+            Lagrange, // through x[-1], ..., x[2], 3rd order polynomial
+            Thiran,   // 1st order allpass, holds state so delay lines only
+        };
+
+        class InterpolationFunctions;
+    }
+}
+
+// value between the samples x[0] and x[1] at fraction frac in [0, 1)
+class dap::dsp::InterpolationFunctions final
+{
+public:
+    template <typename T>
+    static inline T linear(const T* x, T frac)
+    {
+        return x[0] + frac * (x[1] - x[0]);
+    }
+    // 4-point, 3rd-order Hermite (Catmull-Rom spline)
+    template <typename T>
+    static inline T cubic(const T* x, T frac)
+    {
+        const T c1 = T(0.5) * (x[1] - x[-1]);
+        const T c2 = x[-1] - T(2.5) * x[0] + T(2) * x[1] - T(0.5) * x[2];
+        const T c3 = T(0.5) * (x[2] - x[-1]) + T(1.5) * (x[0] - x[1]);
+        return ((c3 * frac + c2) * frac + c1) * frac + x[0];
+    }
+    // 4-point, 3rd-order Lagrange, flatter in magnitude than cubic at the cost of a less smooth
+    // derivative
+    template <typename T>
+    static inline T lagrange(const T* x, T frac)
+    {
+        const T fp1 = frac + T(1);
+        const T fm1 = frac - T(1);
+        const T fm2 = frac - T(2);
+        const T c0  = fm1 * fm2 * T(0.5);
+        const T c1  = frac * fm2 * T(0.5);
+        return fm1 * fm2 * frac * T(-1.0 / 6.0) * x[-1] + fp1 * (c0 * x[0] - c1 * x[1]) +
+               fp1 * frac * fm1 * T(1.0 / 6.0) * x[2];
+    }
+    template <Interpolation I, typename T>
+    static inline T process(const T* x, T frac)
+    {
+        static_assert(I != Interpolation::Thiran, "Thiran interpolation holds state");
+        if constexpr (I == Interpolation::Cubic)
+        {
+            return cubic(x, frac);
+        }
+        else if constexpr (I == Interpolation::Lagrange)
+        {
+            return lagrange(x, frac);
+        }
+        else
+        {
+            return linear(x, frac);
+        }
+    }
+};
+
+#endif // DAP_DSP_INTERPOLATION_FUNCTIONS_H
@@ -2,26 +2,38 @@
 #define DAP_DSP_LADDER_FILTER_H
 
 #include <cmath>
+#include "CoefficientCache.h"
 #include "base/TypeTraits.h"
+#include "fastmath/Approx.h"
 
 namespace dap
 {
     namespace dsp
     {
-        template <typename T>
+        template <typename T,
+                  typename Tolerance           = std::ratio<0>,
+                  fastmath::approx::Accuracy A = fastmath::approx::Accuracy::Exact>
         class LadderFilter;
     }
 }
 
-template <typename T>
+// Tolerance is the relative change of the frequency tolerated before the gain of the stages is
+// computed again, see CoefficientCache. tanh, exp and tan are computed with the accuracy A, see
+// fastmath/Approx.h.
+template <typename T, typename Tolerance, dap::fastmath::approx::Accuracy A>
 class dap::dsp::LadderFilter final
 {
     struct Stage
     {
         T output{0};
+        void reset()
+        {
+            output = T(0);
+        }
         inline auto operator()(T x, T gain)
         {
-            output += gain * (std::tanh(x) - std::tanh(output));
+            using fastmath::approx::tanh;
+            output += gain * (tanh<A>(x) - tanh<A>(output));
             return output;
         }
     };
@@ -31,13 +43,33 @@ class dap::dsp::LadderFilter final
     Stage m_stage1;
     Stage m_stage2;
     Stage m_stage3;
+    CoefficientCache<T, T, Tolerance> m_gain;
+
+    static T gain(T w)
+    {
+        using fastmath::approx::exp;
+        using fastmath::approx::tan;
+        return T(1) - exp<A>(T(-2) * tan<A>(w));
+    }
 
 public:
+    static constexpr bool audio_rate_only = true;
+
+    void reset()
+    {
+        m_y  = T(0);
+        m_y1 = T(0);
+        m_stage1.reset();
+        m_stage2.reset();
+        m_stage3.reset();
+        m_gain.reset();
+    }
     inline auto operator()(T x, T frequency, T resonance, T samplerate)
     {
-        auto g = T(1) - std::exp(T(-2) * std::tan(M_PI / samplerate * frequency));
-        m_y += g * (std::tanh(x - clip(resonance, T(0), T(4)) * (m_stage3.output + m_y1) * T(0.5)) -
-                    std::tanh(m_y));
+        using fastmath::approx::tanh;
+        const T g        = m_gain(M_PI / samplerate * frequency, &LadderFilter::gain);
+        const T feedback = clip(resonance, T(0), T(4)) * (m_stage3.output + m_y1) * T(0.5);
+        m_y += g * (tanh<A>(T(x - feedback)) - tanh<A>(m_y));
         m_y1 = m_stage3.output;
         m_stage3(m_stage2(m_stage1(m_y, g), g), g);
         return m_y;
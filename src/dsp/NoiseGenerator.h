@@ -1,9 +1,10 @@
 #ifndef DAP_DSP_NOISE_GENERATOR_H
 #define DAP_DSP_NOISE_GENERATOR_H
 
-#include "IIRFilter.h"
-#include "fastmath/Variable.h"
+#include "BiquadCascade.h"
+#include "Frames.h"
 #include <ostream>
+#include <type_traits>
 
 namespace dap
 {
@@ -11,6 +12,22 @@ namespace dap
     {
         template <typename TRandomGenerator>
         class NoiseGenerator;
+
+        namespace detail
+        {
+            // true if TRandomGenerator draws blocks with fill(out, frames)
+            template <typename TRandomGenerator, typename = void>
+            struct HasFill : std::false_type
+            {
+            };
+            template <typename TRandomGenerator>
+            struct HasFill<TRandomGenerator,
+                           std::void_t<decltype(std::declval<TRandomGenerator&>().fill(
+                               std::declval<typename TRandomGenerator::value_type*>(), size_t{}))>>
+            : std::true_type
+            {
+            };
+        }
     }
 }
 
@@ -18,14 +35,15 @@ template <typename TRandomGenerator>
 class dap::dsp::NoiseGenerator final
 {
     using value_type = typename TRandomGenerator::value_type;
-    using var_type   = dap::fastmath::Variable<value_type>;
-    using Filter     = IIRFilter<var_type, 4>;
+    using Filter     = BiquadCascade<value_type, 2>;
     TRandomGenerator m_rand;
     Filter m_f1;
     Filter m_f2;
     Filter m_f3;
 
 public:
+    static constexpr bool audio_rate_only = true;
+
     enum class Color
     {
         White,
@@ -35,27 +53,48 @@ public:
     };
 
     NoiseGenerator()
+    : NoiseGenerator(TRandomGenerator())
+    {
+    }
+    // draws from rand, e.g. a generator seeded for reproducible noise
+    explicit NoiseGenerator(TRandomGenerator rand)
+    : m_rand(std::move(rand))
     {
         // coefficients for an aproximated 1/f amplitude response roll-off IIR filter
         // see https://www.dsprelated.com/freebooks/sasp/Example_Synthesis_1_F_Noise.html
         // ideally we should be normalizing by 1.1 which seems to be the maximum at 0Hz,
         // however noise will not be at 0Hz, so we can increase gain.
-        using Array = std::array<var_type, 4>;
-        const Array a{{1.0f, -2.494956002f, 2.017265875f, -0.522189400f}};
-
-        auto computeBCoefs = [](var_type norm) {
-            return Array{{var_type(0.049922035f) / norm,
-                          var_type(-0.095993537f) / norm,
-                          var_type(0.050612699f) / norm,
-                          var_type(-0.004408786f) / norm}};
+        // The 3rd order filter
+        //   b = {0.049922035, -0.095993537, 0.050612699, -0.004408786}
+        //   a = {1, -2.494956002, 2.017265875, -0.522189400}
+        // is factored in a second order section, with the two poles closest to the unit circle,
+        // and a first order one.
+        using Coefficients = BiquadCoefficients<value_type>;
+        auto setCoefficients = [](Filter& filter, value_type norm) {
+            filter.set(0,
+                       Coefficients{value_type(0.049922035 / norm),
+                                    value_type(-0.090602911 / norm),
+                                    value_type(0.040829316 / norm),
+                                    value_type(-1.939010743),
+                                    value_type(0.939282045)});
+            filter.set(1,
+                       Coefficients{value_type(1.0),
+                                    value_type(-0.107980894),
+                                    value_type(0.0),
+                                    value_type(-0.555945259),
+                                    value_type(0.0)});
         };
 
-        Array b = computeBCoefs(0.25); // trial error value
-        m_f1.set(b.data(), a.data());
-        b = computeBCoefs(0.45); // trial error value
-        m_f2.set(b.data(), a.data());
-        b = computeBCoefs(1.0); // trial error value
-        m_f3.set(b.data(), a.data());
+        setCoefficients(m_f1, 0.25); // trial error value
+        setCoefficients(m_f2, 0.45); // trial error value
+        setCoefficients(m_f3, 1.0);  // trial error value
+    }
+    // clears the filters, the random sequence carries on
+    void reset()
+    {
+        m_f1.reset();
+        m_f2.reset();
+        m_f3.reset();
     }
     inline auto operator()(value_type gain, Color color)
     {
@@ -64,14 +103,58 @@ public:
             case Color::White:
                 return gain*m_rand();
             case Color::Pink:
-                return gain*m_f1(m_rand())();
+                return gain*m_f1(m_rand());
             case Color::Brown:
-                return gain*m_f2(m_f1(m_rand()))();
+                return gain*m_f2(m_f1(m_rand()));
             case Color::OneOverF3:
-                return gain*m_f3(m_f2(m_f1(m_rand())))();
+                return gain*m_f3(m_f2(m_f1(m_rand())));
         }
         return value_type(0);
     }
+    // block overload, the color being held for the whole block
+    template <typename Gain>
+    void process(value_type* out, size_t frames, const Gain& gain, Color color)
+    {
+        if constexpr (detail::HasFill<TRandomGenerator>::value)
+        {
+            m_rand.fill(out, frames);
+        }
+        else
+        {
+            for (size_t n = 0; n < frames; ++n)
+            {
+                out[n] = m_rand();
+            }
+        }
+        // the cascades filter frame by frame, their sections then overlap
+        switch (color)
+        {
+            case Color::White:
+                for (size_t n = 0; n < frames; ++n)
+                {
+                    out[n] = frameAt(gain, n) * out[n];
+                }
+                break;
+            case Color::Pink:
+                for (size_t n = 0; n < frames; ++n)
+                {
+                    out[n] = frameAt(gain, n) * m_f1(out[n]);
+                }
+                break;
+            case Color::Brown:
+                for (size_t n = 0; n < frames; ++n)
+                {
+                    out[n] = frameAt(gain, n) * m_f2(m_f1(out[n]));
+                }
+                break;
+            case Color::OneOverF3:
+                for (size_t n = 0; n < frames; ++n)
+                {
+                    out[n] = frameAt(gain, n) * m_f3(m_f2(m_f1(out[n])));
+                }
+                break;
+        }
+    }
     friend std::ostream& operator<<(std::ostream& out, Color color)
     {
         switch (color)
@@ -1,27 +1,106 @@
 #ifndef DAP_DSP_OSCILLATOR_H
 #define DAP_DSP_OSCILLATOR_H
 
+#include "BandLimitedFunctions.h"
 #include "Phasor.h"
 #include "OscillatorFunctions.h"
+#include <type_traits>
 
 namespace dap
 {
     namespace dsp
     {
-        template <typename T>
+        template <typename T,
+                  fastmath::approx::Accuracy A = fastmath::approx::Accuracy::Exact,
+                  Antialiasing AA              = Antialiasing::None>
         class Oscillator;
     }
 }
 
-template <typename T>
+// Sines are computed with the accuracy A, see fastmath/Approx.h. Approximated oscillators keep
+// their phase in turns, so that it wraps without a division and the phases of a block of held
+// frequency are computed independently of each other. Band-limited oscillators, see
+// BandLimitedFunctions.h, keep their phase in turns as well.
+template <typename T, dap::fastmath::approx::Accuracy A, dap::dsp::Antialiasing AA>
 class dap::dsp::Oscillator final
 {
-    Phasor<T> m_phasor;
+    static constexpr bool exact       = A == fastmath::approx::Accuracy::Exact;
+    static constexpr bool bandLimited = AA != Antialiasing::None;
+    using phasor_t = std::conditional_t<exact && !bandLimited, Phasor<T>, NormalizedPhasor<T>>;
+    using scalar_t = lane_scalar_t<T>;
+
+    phasor_t m_phasor;
 
 public:
+    void reset()
+    {
+        m_phasor.reset();
+    }
     inline auto operator()(T gain, T freq, T phase, T samplerate, OscillatorFunctions::Shape shape)
     {
-        return gain*dsp::OscillatorFunctions::process(m_phasor(freq, samplerate) + phase, shape);
+        if constexpr (bandLimited)
+        {
+            using std::abs;
+            using std::floor;
+            T turns    = m_phasor(freq, samplerate) + phase * scalar_t(0.5 / M_PI);
+            turns      = turns - floor(turns);
+            const T dt = abs(T(freq / samplerate));
+            return T(gain * BandLimitedFunctions::process<A>(turns, dt, shape));
+        }
+        else if constexpr (exact)
+        {
+            return gain * OscillatorFunctions::process(m_phasor(freq, samplerate) + phase, shape);
+        }
+        else
+        {
+            const T turns = m_phasor(freq, samplerate);
+            if (shape == OscillatorFunctions::Shape::Sine)
+            {
+                return T(gain * fastmath::approx::sin2pi<A>(turns + phase * scalar_t(0.5 / M_PI)));
+            }
+            return T(gain * OscillatorFunctions::process(turns * TWO_PI + phase, shape));
+        }
+    }
+    // block overload, gain, freq and phase (i.e. frequency and phase modulation) may be given per
+    // frame, see Frames.h
+    template <typename Gain, typename Freq, typename Phase, typename SampleRate>
+    inline void process(T* out,
+                        size_t frames,
+                        const Gain& gain,
+                        const Freq& freq,
+                        const Phase& phase,
+                        const SampleRate& samplerate,
+                        OscillatorFunctions::Shape shape)
+    {
+        m_phasor.process(out, frames, freq, samplerate);
+        if constexpr (bandLimited)
+        {
+            using std::floor;
+            for (size_t n = 0; n < frames; ++n)
+            {
+                const T turns = out[n] + frameAt(phase, n) * scalar_t(0.5 / M_PI);
+                out[n]        = turns - floor(turns);
+            }
+            BandLimitedFunctions::process<A>(out, out, frames, gain, freq, samplerate, shape);
+            return;
+        }
+        if constexpr (!exact)
+        {
+            if (shape == OscillatorFunctions::Shape::Sine)
+            {
+                for (size_t n = 0; n < frames; ++n)
+                {
+                    const T turns = out[n] + frameAt(phase, n) * scalar_t(0.5 / M_PI);
+                    out[n]        = frameAt(gain, n) * fastmath::approx::sin2pi<A>(turns);
+                }
+                return;
+            }
+            for (size_t n = 0; n < frames; ++n)
+            {
+                out[n] = out[n] * TWO_PI;
+            }
+        }
+        OscillatorFunctions::process<A>(out, out, frames, gain, phase, shape);
     }
 };
 
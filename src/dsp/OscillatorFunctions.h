@@ -1,7 +1,10 @@
 #ifndef DAP_DSP_OSCILLATOR_FUNCTIONS_H
 #define DAP_DSP_OSCILLATOR_FUNCTIONS_H
 
+#include "Frames.h"
 #include "base/Constants.h"
+#include "fastmath/Approx.h"
+#include "fastmath/Pack.h"
 #include <ostream>
 
 namespace dap
@@ -40,15 +43,17 @@ public:
     {
     };
 
+    // T may be a fastmath::Pack, in which case each lane is processed as an independent scalar
     template <typename T>
     inline static auto process(T phase, SineTag&&)
     {
-        return std::sin(phase);
+        using std::sin;
+        return sin(phase);
     }
     template <typename T>
     inline static auto process(T phase, SquareTag)
     {
-        return phase < M_PI ? 1.0f : -1.0f;
+        return fastmath::select(phase < T(M_PI), T(1), T(-1));
     }
     template <typename T>
     inline static auto process(T phase, SawTag&&)
@@ -58,15 +63,16 @@ public:
     template <typename T>
     inline static auto process(T phase, InverseSawTag&&)
     {
-        return phase - 1.0f / M_PI;
+        return phase / M_PI - 1.0f;
     }
     template <typename T>
     inline static auto process(T phase, TriangleTag&&)
     {
-        auto triangle = [](T ph) { return ph < 2.0f ? ph - 1.0f : 3.0f - ph; };
+        auto triangle = [](T ph) { return fastmath::select(ph < T(2), ph - T(1), T(3) - ph); };
         return triangle(phase * INV_HALF_PI);
     }
 
+    // the shape is the same for all lanes, so a single branch is taken
     template <typename T>
     inline static T process(T phase, Shape shape)
     {
@@ -85,6 +91,42 @@ public:
         }
         return T(0);
     }
+
+    // block version writing gain * shape(phase + offset) for each frame of phases, which may be
+    // out. The shape is selected once per block and sines use the approximation of accuracy A.
+    template <fastmath::approx::Accuracy A, typename T, typename Gain, typename Offset>
+    inline static void process(T* out,
+                               const T* phases,
+                               size_t frames,
+                               const Gain& gain,
+                               const Offset& offset,
+                               Shape shape)
+    {
+        auto apply = [&](auto&& fn) {
+            for (size_t n = 0; n < frames; ++n)
+            {
+                out[n] = frameAt(gain, n) * fn(T(phases[n] + frameAt(offset, n)));
+            }
+        };
+        switch (shape)
+        {
+            case Shape::Sine:
+                apply([](T phase) { return fastmath::approx::sin<A>(phase); });
+                break;
+            case Shape::Square:
+                apply([](T phase) { return process(phase, SquareTag{}); });
+                break;
+            case Shape::Saw:
+                apply([](T phase) { return T(process(phase, SawTag{})); });
+                break;
+            case Shape::InverseSaw:
+                apply([](T phase) { return T(process(phase, InverseSawTag{})); });
+                break;
+            case Shape::Triangle:
+                apply([](T phase) { return process(phase, TriangleTag{}); });
+                break;
+        }
+    }
 };
 namespace dap
 {
@@ -3,50 +3,83 @@
 
 #include "fastmath/Var.h"
 #include "AllPass.h"
+#include "CoefficientCache.h"
 #include "Phasor.h"
-#include "OscillatorFunctions.h"
+#include "fastmath/Approx.h"
 
 namespace dap
 {
     namespace dsp
     {
-        template <typename T>
+        template <typename T,
+                  size_t ControlPeriod         = 16,
+                  fastmath::approx::Accuracy A = fastmath::approx::Accuracy::Exact>
         class Phaser;
     }
 }
-template <typename T>
+// The all pass stages are tuned by a sine lfo, their coefficients are computed once per control
+// period of ControlPeriod samples and linearly interpolated in between. The lfo and the
+// coefficients are computed with the accuracy A, see fastmath/Approx.h.
+template <typename T, size_t ControlPeriod, dap::fastmath::approx::Accuracy A>
 class dap::dsp::Phaser final
 {
     static constexpr int m_stageCount{6};
     constexpr auto freqs(int i)
     {
-        constexpr std::array<T, m_stageCount> f{{T(16), T(33), T(48), T(98), T(160), T(260)}};
+        using scalar_t = lane_scalar_t<T>;
+        constexpr std::array<scalar_t, m_stageCount> f{
+            {scalar_t(16), scalar_t(33), scalar_t(48), scalar_t(98), scalar_t(160), scalar_t(260)}};
         return f[i];
     }
-    std::array<AllPass<T>, m_stageCount> m_allpass;
+    using allpass_t = AllPass<T, std::ratio<0>, A>;
+
+    std::array<allpass_t, m_stageCount> m_allpass;
+    std::array<CoefficientRamp<T, ControlPeriod>, m_stageCount> m_coefficients;
     Phasor<T> m_phasor;
-    T m_output;
+    T m_output{0};
 
-public:
-    inline auto operator()(T input, T frequency, T depth, T feedback, T wet, T samplerate)
+    // targets the coefficients of the lfo phase at the end of the control period
+    void updateCoefficients(T frequency, T depth, T samplerate)
     {
         const auto lfo =
             T(1) + depth * T(0.5) *
-                       (T(1) + OscillatorFunctions::process(m_phasor(frequency, samplerate),
-                                                            OscillatorFunctions::SineTag{}));
-        m_output = (T(1) - wet) * input + wet *
-                    m_allpass[5](
-                    m_allpass[4](
-                    m_allpass[3](
-                    m_allpass[2](
-                    m_allpass[1](
-                    m_allpass[0]((input + feedback*m_output)
-                                      , freqs(0) * lfo, samplerate)
-                                      , freqs(1) * lfo, samplerate)
-                                      , freqs(2) * lfo, samplerate)
-                                      , freqs(3) * lfo, samplerate)
-                                      , freqs(4) * lfo, samplerate)
-                                      , freqs(5) * lfo, samplerate);
+                       (T(1) + fastmath::approx::sin<A>(
+                                   T(m_phasor(frequency * T(ControlPeriod), samplerate))));
+        const T w = T(M_PI) * lfo / samplerate;
+        for (int i = 0; i < m_stageCount; ++i)
+        {
+            m_coefficients[i].setTarget(allpass_t::coefficient(freqs(i) * w));
+        }
+    }
+
+public:
+    static constexpr bool audio_rate_only = true;
+
+    void reset()
+    {
+        for (auto& allpass : m_allpass)
+        {
+            allpass.reset();
+        }
+        for (auto& coefficient : m_coefficients)
+        {
+            coefficient.reset();
+        }
+        m_phasor.reset();
+        m_output = T(0);
+    }
+    inline auto operator()(T input, T frequency, T depth, T feedback, T wet, T samplerate)
+    {
+        if (m_coefficients[0].isDue())
+        {
+            updateCoefficients(frequency, depth, samplerate);
+        }
+        auto x = input + feedback * m_output;
+        for (int i = 0; i < m_stageCount; ++i)
+        {
+            x = m_allpass[i].process(x, m_coefficients[i]());
+        }
+        m_output = (T(1) - wet) * input + wet * x;
         return m_output;
     }
 };
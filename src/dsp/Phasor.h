@@ -2,6 +2,7 @@
 #define DAP_DSP_PHASOR_H
 
 #include "base/Constants.h"
+#include "Frames.h"
 #include "base/TypeTraits.h"
 
 namespace dap
@@ -10,6 +11,8 @@ namespace dap
     {
         template <typename T>
         class Phasor;
+        template <typename T>
+        class NormalizedPhasor;
     }
 }
 
@@ -18,16 +21,108 @@ class dap::dsp::Phasor final
 {
     T m_phase{0};
 
-    static_assert(dap::isFloatingPoint<T>(), "T must be floating point.");
+    static_assert(dap::isFloatingPoint<lane_scalar_t<T>>(), "T must be floating point.");
+
+    static inline T wrap(T&& x)
+    {
+        using std::floor;
+        return x - floor(x / TWO_PI) * TWO_PI;
+    }
+
+public:
+    void reset()
+    {
+        m_phase = T(0);
+    }
+    template <typename T1, typename T2>
+    inline auto operator()(T1 freq, T2 sampleRate)
+    {
+        m_phase = wrap(std::move(m_phase + TWO_PI * freq / sampleRate));
+        return m_phase;
+    }
+    // block overload writing the phase of each frame, see Frames.h. The increment is computed
+    // once for a held frequency and sample rate, the phases being the same as per frame.
+    template <typename Freq, typename SampleRate>
+    inline void process(T* out, size_t frames, const Freq& freq, const SampleRate& sampleRate)
+    {
+        if constexpr (isHeld<Freq>() && isHeld<SampleRate>())
+        {
+            const T increment = TWO_PI * freq / sampleRate;
+            for (size_t n = 0; n < frames; ++n)
+            {
+                m_phase = wrap(m_phase + increment);
+                out[n]  = m_phase;
+            }
+        }
+        else
+        {
+            for (size_t n = 0; n < frames; ++n)
+            {
+                out[n] = (*this)(frameAt(freq, n), frameAt(sampleRate, n));
+            }
+        }
+    }
+};
+
+// phase in turns, i.e. in [0, 1), which wraps without a division. Blocks are accumulated from the
+// phase at their start and wrapped at once, so that only additions depend on the previous frame.
+template <typename T>
+class dap::dsp::NormalizedPhasor final
+{
+    T m_phase{0};
+
+    static_assert(dap::isFloatingPoint<lane_scalar_t<T>>(), "T must be floating point.");
+
+    static inline T wrap(T x)
+    {
+        using std::floor;
+        return x - floor(x);
+    }
 
 public:
+    void reset()
+    {
+        m_phase = T(0);
+    }
     template <typename T1, typename T2>
     inline auto operator()(T1 freq, T2 sampleRate)
     {
-        auto wrap = [](T&& x) { return x - std::floor(x / TWO_PI) * TWO_PI; };
-        m_phase   = wrap(std::move(m_phase + TWO_PI * freq / sampleRate));
+        m_phase = wrap(m_phase + freq / sampleRate);
         return m_phase;
     }
+    // block overload writing the phase of each frame, see Frames.h
+    template <typename Freq, typename SampleRate>
+    inline void process(T* out, size_t frames, const Freq& freq, const SampleRate& sampleRate)
+    {
+        if (frames == 0)
+        {
+            return;
+        }
+        if constexpr (isHeld<Freq>() && isHeld<SampleRate>())
+        {
+            const T increment = freq / sampleRate;
+            const T start     = m_phase;
+            for (size_t n = 0; n < frames; ++n)
+            {
+                out[n] = wrap(start + T(lane_scalar_t<T>(n + 1)) * increment);
+            }
+            m_phase = out[frames - 1];
+        }
+        else
+        {
+            T phase = m_phase;
+            for (size_t n = 0; n < frames; ++n)
+            {
+                phase += frameAt(freq, n) / frameAt(sampleRate, n);
+                out[n] = phase;
+            }
+            for (size_t n = 0; n < frames; ++n)
+            {
+                out[n] = wrap(out[n]);
+            }
+            m_phase = out[frames - 1];
+        }
+    }
 };
 
 #endif // DAP_DSP_PHASOR_H
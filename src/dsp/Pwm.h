@@ -1,27 +1,49 @@
 #ifndef DAP_DSP_PWM_H
 #define DAP_DSP_PWM_H
 
+#include "BandLimitedFunctions.h"
 #include "Phasor.h"
 #include "PwmFunctions.h"
+#include <type_traits>
 
 namespace dap
 {
     namespace dsp
     {
-        template <typename T>
+        template <typename T, Antialiasing AA = Antialiasing::None>
         class Pwm;
     }
 }
 
-template <typename T>
+// band-limited pulses, see BandLimitedFunctions.h, keep their phase in turns
+template <typename T, dap::dsp::Antialiasing AA>
 class dap::dsp::Pwm final
 {
-    Phasor<T> m_phasor;
+    static constexpr bool bandLimited = AA != Antialiasing::None;
+    using phasor_t = std::conditional_t<bandLimited, NormalizedPhasor<T>, Phasor<T>>;
+
+    phasor_t m_phasor;
 
 public:
+    void reset()
+    {
+        m_phasor.reset();
+    }
     inline auto operator()(T gain, T freq, T phase, T samplerate, T dutyCycle)
     {
-        return gain * dsp::PwmFunctions::process(m_phasor(freq, samplerate) + phase, dutyCycle);
+        if constexpr (bandLimited)
+        {
+            using std::abs;
+            using std::floor;
+            T turns    = m_phasor(freq, samplerate) + phase * T(0.5 / M_PI);
+            turns      = turns - floor(turns);
+            const T dt = abs(freq / samplerate);
+            return gain * BandLimitedFunctions::pwm(turns, dt, clip(dutyCycle, T(0), T(1)));
+        }
+        else
+        {
+            return gain * dsp::PwmFunctions::process(m_phasor(freq, samplerate) + phase, dutyCycle);
+        }
     }
 };
 
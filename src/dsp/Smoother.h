@@ -2,6 +2,8 @@
 #define DAP_DSP_SMOOTHER_H
 
 #include "base/Constants.h"
+#include "CoefficientCache.h"
+#include "base/TypeTraits.h"
 #include <cmath>
 
 namespace dap
@@ -18,13 +20,24 @@ template <typename T>
 class dap::dsp::Smoother
 {
     T m_value{0};
+    CoefficientCache<lane_scalar_t<T>, size_t> m_a;
 
-    static_assert(dap::isFloatingPoint<T>(), "T must be floating point.");
+    static_assert(dap::isFloatingPoint<lane_scalar_t<T>>(), "T must be floating point.");
+
+    static lane_scalar_t<T> coefficient(size_t samples)
+    {
+        return std::exp(-TWO_PI / lane_scalar_t<T>(samples));
+    }
 
 public:
+    void reset()
+    {
+        m_value = T(0);
+        m_a.reset();
+    }
     inline auto operator()(T target, size_t samples = 4096)
     {
-        auto a = std::exp(-TWO_PI / T(samples));
+        const auto a = m_a(samples, &Smoother::coefficient);
         m_value = a * m_value + (T(1) - a) * target;
         return m_value;
     }
@@ -33,17 +46,31 @@ template <typename T, size_t Samples>
 class dap::dsp::FixedSmoother
 {
     T m_value{0};
-    T m_a{std::exp(-TWO_PI / T(Samples))};
-    T m_b{T(1.0) - std::exp(-TWO_PI / T(Samples))}; // 1-m_a
+    T m_a{std::exp(-TWO_PI / lane_scalar_t<T>(Samples))};
+    T m_b{T(1.0) - std::exp(-TWO_PI / lane_scalar_t<T>(Samples))}; // 1-m_a
 
-    static_assert(dap::isFloatingPoint<T>(), "T must be floating point.");
+    static_assert(dap::isFloatingPoint<lane_scalar_t<T>>(), "T must be floating point.");
 
 public:
+    void reset()
+    {
+        m_value = T(0);
+    }
     inline auto operator()(T target)
     {
         m_value = m_a * m_value + m_b * target;
         return m_value;
     }
+    // block overload for a target which is constant over the block
+    inline void process(T* out, size_t frames, T target)
+    {
+        const T b = m_b * target;
+        for (size_t n = 0; n < frames; ++n)
+        {
+            m_value = m_a * m_value + b;
+            out[n]  = m_value;
+        }
+    }
 };
 
 #endif // DAP_DSP_SMOOTHER_H
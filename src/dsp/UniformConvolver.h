@@ -0,0 +1,196 @@
+#ifndef DAP_DSP_UNIFORM_CONVOLVER_H
+#define DAP_DSP_UNIFORM_CONVOLVER_H
+
+#include "fastmath/AlignedVector.h"
+#include "fastmath/FFT.h"
+#include <algorithm>
+
+namespace dap
+{
+    namespace dsp
+    {
+        template <typename T>
+        class UniformConvolver;
+    }
+}
+
+// Convolution of a signal with an impulse response split into partitions of partitionSize()
+// samples, by uniformly partitioned overlap-save: the spectra of the last input blocks are kept
+// in a frequency-domain delay line and multiplied by the spectra of the partitions they meet.
+// There is no latency, a block being transformed again as its frames arrive, so that blocks of
+// the partition size cost one forward and one inverse FFT each while smaller blocks cost more.
+template <typename T>
+class dap::dsp::UniformConvolver final
+{
+    using vector_t = fastmath::AlignedVector<T>;
+
+    size_t m_partitionSize;
+    size_t m_length{0};
+    size_t m_partitions{0};
+    fastmath::FFT<T> m_fft;
+    // spectra of the partitions, scaled by 1 / fft size, one after the other
+    vector_t m_filterRe;
+    vector_t m_filterIm;
+    // spectra of the last partitions - 1 input blocks, m_newest being the slot of the last one
+    vector_t m_delayRe;
+    vector_t m_delayIm;
+    size_t m_newest{0};
+    // the contribution of the delayed blocks to the current one
+    vector_t m_tailRe;
+    vector_t m_tailIm;
+    // the previous input block then the current one, filled up to m_fill and zero padded
+    vector_t m_input;
+    size_t m_fill{0};
+    vector_t m_spectrumRe;
+    vector_t m_spectrumIm;
+    vector_t m_productRe;
+    vector_t m_productIm;
+    vector_t m_output;
+
+    size_t bins() const
+    {
+        return m_fft.bins();
+    }
+    // the input block is complete and m_spectrum holds its spectrum
+    void advance()
+    {
+        const size_t bins  = this->bins();
+        const size_t slots = m_partitions - 1;
+        if (slots > 0)
+        {
+            m_newest = (m_newest + 1) % slots;
+            std::copy_n(m_spectrumRe.data(), bins, m_delayRe.data() + m_newest * bins);
+            std::copy_n(m_spectrumIm.data(), bins, m_delayIm.data() + m_newest * bins);
+        }
+        std::copy_n(m_input.data() + m_partitionSize, m_partitionSize, m_input.data());
+        std::fill_n(m_input.data() + m_partitionSize, m_partitionSize, T(0));
+        m_fill = 0;
+
+        // partition k meets the block k - 1 blocks before the newest one
+        std::fill(m_tailRe.begin(), m_tailRe.end(), T(0));
+        std::fill(m_tailIm.begin(), m_tailIm.end(), T(0));
+        for (size_t k = 1; k < m_partitions; ++k)
+        {
+            const size_t slot = (m_newest + slots - (k - 1)) % slots;
+            multiplyAdd(m_tailRe.data(),
+                        m_tailIm.data(),
+                        m_delayRe.data() + slot * bins,
+                        m_delayIm.data() + slot * bins,
+                        m_filterRe.data() + k * bins,
+                        m_filterIm.data() + k * bins);
+        }
+    }
+    // re + i im += (aRe + i aIm) (bRe + i bIm)
+    void multiplyAdd(T* re, T* im, const T* aRe, const T* aIm, const T* bRe, const T* bIm) const
+    {
+        for (size_t k = 0; k < bins(); ++k)
+        {
+            re[k] += aRe[k] * bRe[k] - aIm[k] * bIm[k];
+            im[k] += aRe[k] * bIm[k] + aIm[k] * bRe[k];
+        }
+    }
+
+public:
+    // partitionSize is a power of two of at least 4
+    explicit UniformConvolver(size_t partitionSize)
+    : m_partitionSize(partitionSize)
+    , m_fft(2 * partitionSize)
+    , m_tailRe(m_fft.bins())
+    , m_tailIm(m_fft.bins())
+    , m_input(m_fft.size())
+    , m_spectrumRe(m_fft.bins())
+    , m_spectrumIm(m_fft.bins())
+    , m_productRe(m_fft.bins())
+    , m_productIm(m_fft.bins())
+    , m_output(m_fft.size())
+    {
+    }
+    size_t partitionSize() const
+    {
+        return m_partitionSize;
+    }
+    size_t partitions() const
+    {
+        return m_partitions;
+    }
+    // samples of the impulse response
+    size_t length() const
+    {
+        return m_length;
+    }
+    // allocates, so not to be called while processing. The convolver is reset.
+    void setImpulseResponse(const T* ir, size_t length)
+    {
+        const size_t bins = this->bins();
+        m_length          = length;
+        m_partitions      = (length + m_partitionSize - 1) / m_partitionSize;
+        m_filterRe.assign(m_partitions * bins, T(0));
+        m_filterIm.assign(m_partitions * bins, T(0));
+        m_delayRe.assign(m_partitions > 1 ? (m_partitions - 1) * bins : 0, T(0));
+        m_delayIm.assign(m_delayRe.size(), T(0));
+        vector_t padded(m_fft.size());
+        const T scale = T(1) / T(m_fft.size());
+        for (size_t k = 0; k < m_partitions; ++k)
+        {
+            const size_t offset = k * m_partitionSize;
+            const size_t count  = std::min(m_partitionSize, length - offset);
+            std::fill(padded.begin(), padded.end(), T(0));
+            for (size_t n = 0; n < count; ++n)
+            {
+                padded[n] = scale * ir[offset + n];
+            }
+            m_fft.forward(
+                padded.data(), m_filterRe.data() + k * bins, m_filterIm.data() + k * bins);
+        }
+        reset();
+    }
+    void reset()
+    {
+        std::fill(m_delayRe.begin(), m_delayRe.end(), T(0));
+        std::fill(m_delayIm.begin(), m_delayIm.end(), T(0));
+        std::fill(m_tailRe.begin(), m_tailRe.end(), T(0));
+        std::fill(m_tailIm.begin(), m_tailIm.end(), T(0));
+        std::fill(m_input.begin(), m_input.end(), T(0));
+        m_newest = 0;
+        m_fill   = 0;
+    }
+    // out may be in
+    void process(T* out, const T* in, size_t frames)
+    {
+        if (m_partitions == 0)
+        {
+            std::fill_n(out, frames, T(0));
+            return;
+        }
+        const size_t bins = this->bins();
+        while (frames > 0)
+        {
+            const size_t count = std::min(frames, m_partitionSize - m_fill);
+            std::copy_n(in, count, m_input.data() + m_partitionSize + m_fill);
+            m_fill += count;
+
+            m_fft.forward(m_input.data(), m_spectrumRe.data(), m_spectrumIm.data());
+            std::copy_n(m_tailRe.data(), bins, m_productRe.data());
+            std::copy_n(m_tailIm.data(), bins, m_productIm.data());
+            multiplyAdd(m_productRe.data(),
+                        m_productIm.data(),
+                        m_spectrumRe.data(),
+                        m_spectrumIm.data(),
+                        m_filterRe.data(),
+                        m_filterIm.data());
+            m_fft.inverse(m_productRe.data(), m_productIm.data(), m_output.data());
+            // the second half is free of circular aliasing
+            std::copy_n(m_output.data() + m_partitionSize + m_fill - count, count, out);
+
+            if (m_fill == m_partitionSize)
+            {
+                advance();
+            }
+            in += count;
+            out += count;
+            frames -= count;
+        }
+    }
+};
+
+#endif // DAP_DSP_UNIFORM_CONVOLVER_H
@@ -1,8 +1,14 @@
 #ifndef DAP_DSP_UNIFORM_DISTRIBUTION_H
 #define DAP_DSP_UNIFORM_DISTRIBUTION_H
 
-#include <map>
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <random>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 namespace dap
 {
@@ -12,23 +18,172 @@ namespace dap
     }
 }
 
+// Uniform random samples in [-1, 1), drawn from four interleaved xoshiro128+ generators so that
+// blocks are filled four samples at a time in vector registers. Samples come in the same order
+// whether drawn one by one or by blocks, and a seed gives the same sequence on every platform.
+// Generators of the same seed and different streams draw non overlapping sequences, e.g. one
+// stream per voice.
 class dap::dsp::UniformDistribution final
 {
-    std::mt19937 m_generator;
-    std::uniform_int_distribution<> m_distribution;
+    static constexpr size_t lanes = 4;
+    using state_t                 = uint32_t[4];
+
+    // word w of the state of lane l at m_state[w][l]
+    alignas(16) uint32_t m_state[4][lanes];
+    alignas(16) float m_samples[lanes];
+    size_t m_next{lanes};
+
+    static uint32_t rotl(uint32_t x, int k)
+    {
+        return (x << k) | (x >> (32 - k));
+    }
+    static uint64_t splitmix64(uint64_t& x)
+    {
+        uint64_t z = (x += 0x9e3779b97f4a7c15u);
+        z          = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9u;
+        z          = (z ^ (z >> 27)) * 0x94d049bb133111ebu;
+        return z ^ (z >> 31);
+    }
+    static void next(state_t& s)
+    {
+        const uint32_t t = s[1] << 9;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotl(s[3], 11);
+    }
+    // advances s by 2^64 draws, or 2^96 when long
+    static void jump(state_t& s, bool isLong)
+    {
+        static constexpr uint32_t polynomials[2][4] = {
+            {0x8764000b, 0xf542d2d3, 0x6fa035c3, 0x77f2db5b},
+            {0xb523952e, 0x0b6f099f, 0xccf5a0ef, 0x1c580662}};
+        state_t jumped = {};
+        for (uint32_t word : polynomials[isLong ? 1 : 0])
+        {
+            for (int b = 0; b < 32; ++b)
+            {
+                if ((word & (1u << b)) != 0)
+                {
+                    for (size_t w = 0; w < 4; ++w)
+                    {
+                        jumped[w] ^= s[w];
+                    }
+                }
+                next(s);
+            }
+        }
+        std::copy_n(jumped, 4, s);
+    }
+    // std::random_device is only read once per process, every instance then takes the next
+    // seed of a sequence so that constructing many generators (e.g. one per voice) stays cheap
+    static uint64_t nextSeed()
+    {
+        static const uint64_t base = [] {
+            std::random_device device;
+            return (uint64_t(device()) << 32) | device();
+        }();
+        static std::atomic<uint64_t> instance{0};
+        return base + 0x9e3779b97f4a7c15u * instance.fetch_add(1, std::memory_order_relaxed);
+    }
+    // the next blocks samples of every lane, one after the other, the upper 24 bits of the draws
+    // being mantissas
+    void draw(float* out, size_t blocks)
+    {
+        constexpr float scale = 1.0f / 8388608.0f;
+#if defined(__SSE2__)
+        auto* state = reinterpret_cast<__m128i*>(m_state); // NOLINT
+        __m128i s0  = _mm_load_si128(state);
+        __m128i s1  = _mm_load_si128(state + 1);
+        __m128i s2  = _mm_load_si128(state + 2);
+        __m128i s3  = _mm_load_si128(state + 3);
+        for (size_t b = 0; b < blocks; ++b)
+        {
+            const __m128i value = _mm_add_epi32(s0, s3);
+            const __m128i t     = _mm_slli_epi32(s1, 9);
+            s2                  = _mm_xor_si128(s2, s0);
+            s3                  = _mm_xor_si128(s3, s1);
+            s1                  = _mm_xor_si128(s1, s2);
+            s0                  = _mm_xor_si128(s0, s3);
+            s2                  = _mm_xor_si128(s2, t);
+            s3 = _mm_or_si128(_mm_slli_epi32(s3, 11), _mm_srli_epi32(s3, 21));
+            const __m128 x = _mm_cvtepi32_ps(_mm_srli_epi32(value, 8));
+            _mm_storeu_ps(out + b * lanes,
+                          _mm_sub_ps(_mm_mul_ps(x, _mm_set1_ps(scale)), _mm_set1_ps(1.0f)));
+        }
+        _mm_store_si128(state, s0);
+        _mm_store_si128(state + 1, s1);
+        _mm_store_si128(state + 2, s2);
+        _mm_store_si128(state + 3, s3);
+#else
+        for (size_t b = 0; b < blocks; ++b)
+        {
+            for (size_t l = 0; l < lanes; ++l)
+            {
+                state_t s = {m_state[0][l], m_state[1][l], m_state[2][l], m_state[3][l]};
+                const uint32_t value = s[0] + s[3];
+                next(s);
+                for (size_t w = 0; w < 4; ++w)
+                {
+                    m_state[w][l] = s[w];
+                }
+                out[b * lanes + l] = float(int32_t(value >> 8)) * scale - 1.0f;
+            }
+        }
+#endif
+    }
 
 public:
     using value_type = float;
+
     UniformDistribution()
-    : m_generator(std::random_device()())
-    , m_distribution(0, RAND_MAX)
+    : UniformDistribution(nextSeed())
+    {
+    }
+    // stream s starts 2^96 s draws after the seed, its lane l 2^64 l draws further, so that
+    // constructing stream s takes s jumps of 128 draws
+    explicit UniformDistribution(uint64_t seed, size_t stream = 0)
+    {
+        const uint64_t low  = splitmix64(seed);
+        const uint64_t high = splitmix64(seed);
+        state_t s = {uint32_t(low), uint32_t(low >> 32), uint32_t(high), uint32_t(high >> 32)};
+        for (size_t i = 0; i < stream; ++i)
+        {
+            jump(s, true);
+        }
+        for (size_t l = 0; l < lanes; ++l)
+        {
+            for (size_t w = 0; w < 4; ++w)
+            {
+                m_state[w][l] = s[w];
+            }
+            jump(s, false);
+        }
+    }
+    inline value_type operator()()
     {
-        std::srand(std::time(0));
+        if (m_next == lanes)
+        {
+            draw(m_samples, 1);
+            m_next = 0;
+        }
+        return m_samples[m_next++];
     }
-    inline auto operator()()
+    // the next frames samples, as many calls of operator() would return
+    void fill(value_type* out, size_t frames)
     {
-        static constexpr value_type factor(2.0f / (RAND_MAX + 1.0f));
-        return m_distribution(m_generator) * factor - 1.0f;
+        size_t n = std::min(frames, lanes - m_next);
+        std::copy_n(m_samples + m_next, n, out);
+        m_next += n;
+        const size_t blocks = (frames - n) / lanes;
+        draw(out + n, blocks);
+        n += blocks * lanes;
+        for (; n < frames; ++n)
+        {
+            out[n] = (*this)();
+        }
     }
 };
 
@@ -0,0 +1,194 @@
+#ifndef DAP_DSP_WAVETABLE_H
+#define DAP_DSP_WAVETABLE_H
+
+#include "base/TypeTraits.h"
+#include "fastmath/FastmathAlignedAllocator.h"
+#include "fastmath/Taylor.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace dap
+{
+    namespace dsp
+    {
+        template <typename T, size_t Size>
+        class Wavetable;
+    }
+}
+
+// Single cycle waveforms of Size samples, the frames a WavetableOscillator morphs between, each one
+// mipmapped per octave: the table of level l holds the harmonics up to Size / 2^(l + 1), so that
+// the harmonics of the table of level(dt) are below the Nyquist frequency when it is read with
+// increments of dt = frequency / samplerate. Tables are generated once from their harmonics and
+// are read only afterwards, all of them being in one cache aligned pool that the oscillators of
+// every voice share through a shared_ptr<const Wavetable>.
+template <typename T, size_t Size = 2048>
+class dap::dsp::Wavetable final
+{
+    static_assert(isFloatingPoint<T>(), "T must be floating point");
+    static_assert(IsPowerOfTwo<Size>::value && Size >= 4, "Size must be a power of two");
+
+    using mask = std::integral_constant<size_t, Size - 1>;
+
+    static constexpr size_t log2(size_t n)
+    {
+        return n > 1 ? 1 + log2(n / 2) : 0;
+    }
+    // a sample before and two after each table, wrapped around, so that cubic interpolation reads
+    // without masking, and rows padded to whole cache lines
+    static constexpr size_t cacheLine = 64;
+    static constexpr size_t stride =
+        (((Size + 3) * sizeof(T) + cacheLine - 1) / cacheLine) * cacheLine / sizeof(T);
+
+    // one period of sine, generated at compile time
+    static constexpr std::array<double, Size> sines = taylor::sine_array<double, Size>();
+
+    size_t m_frames;
+    std::vector<T, fastmath::AlignedAllocator<T, cacheLine>> m_pool;
+
+    explicit Wavetable(size_t frames)
+    : m_frames(frames)
+    , m_pool(frames * levels * stride, T(0))
+    {
+    }
+
+    T* row(size_t frame, size_t level)
+    {
+        return &m_pool[(frame * levels + level) * stride + 1];
+    }
+    // sums the harmonics h of frame, sin(2 pi h t) weighted by sine[h] and cos(2 pi h t) by
+    // cosine[h], from the highest level, a sine, down to level 0, each level adding its octave
+    void generate(size_t frame, const std::vector<double>& sine, const std::vector<double>& cosine)
+    {
+        std::vector<double> table(Size, 0.0);
+        size_t harmonic = 1;
+        for (size_t level = levels; level-- > 0;)
+        {
+            for (; harmonic <= (Size >> (level + 1)); ++harmonic)
+            {
+                const double s = harmonic < sine.size() ? sine[harmonic] : 0.0;
+                const double c = harmonic < cosine.size() ? cosine[harmonic] : 0.0;
+                if (s == 0.0 && c == 0.0)
+                {
+                    continue;
+                }
+                for (size_t n = 0; n < Size; ++n)
+                {
+                    const size_t i = (harmonic * n) & mask::value;
+                    table[n] += s * sines[i] + c * sines[(i + Size / 4) & mask::value];
+                }
+            }
+            T* out = row(frame, level);
+            for (size_t n = 0; n < Size; ++n)
+            {
+                out[n] = T(table[n]);
+            }
+            out[-1]       = out[Size - 1];
+            out[Size]     = out[0];
+            out[Size + 1] = out[1];
+        }
+    }
+
+public:
+    static constexpr size_t size   = Size;
+    static constexpr size_t levels = log2(Size);
+
+    // frames of sine harmonics, amplitudes[f][h - 1] being the amplitude of sin(2 pi h t) in
+    // frame f
+    static std::shared_ptr<const Wavetable> fromHarmonics(
+        const std::vector<std::vector<T>>& amplitudes)
+    {
+        if (amplitudes.empty())
+        {
+            throw std::runtime_error("Wavetable needs at least one frame.");
+        }
+        std::shared_ptr<Wavetable> wavetable(new Wavetable(amplitudes.size()));
+        const std::vector<double> none;
+        for (size_t f = 0; f < amplitudes.size(); ++f)
+        {
+            std::vector<double> sine(amplitudes[f].size() + 1, 0.0);
+            std::copy(amplitudes[f].begin(), amplitudes[f].end(), sine.begin() + 1);
+            wavetable->generate(f, sine, none);
+        }
+        return wavetable;
+    }
+    // frames of single cycle waveforms of cycle samples each, e.g. read from a wavetable file,
+    // resampled to Size samples without their DC offset
+    static std::shared_ptr<const Wavetable> fromCycles(const T* samples,
+                                                       size_t frames,
+                                                       size_t cycle)
+    {
+        if (frames == 0 || cycle < 2)
+        {
+            throw std::runtime_error("Wavetable needs at least one cycle of two samples.");
+        }
+        std::shared_ptr<Wavetable> wavetable(new Wavetable(frames));
+        std::vector<double> cycleSines(cycle);
+        std::vector<double> cycleCosines(cycle);
+        for (size_t n = 0; n < cycle; ++n)
+        {
+            cycleSines[n]   = std::sin(2.0 * M_PI * double(n) / double(cycle));
+            cycleCosines[n] = std::cos(2.0 * M_PI * double(n) / double(cycle));
+        }
+        // the harmonics of a cycle below its Nyquist frequency, up to those a table can hold
+        const size_t harmonics = std::min((cycle - 1) / 2, Size / 2);
+        std::vector<double> sine(harmonics + 1);
+        std::vector<double> cosine(harmonics + 1);
+        for (size_t f = 0; f < frames; ++f)
+        {
+            const T* x = samples + f * cycle;
+            for (size_t h = 1; h <= harmonics; ++h)
+            {
+                double s = 0.0;
+                double c = 0.0;
+                for (size_t n = 0; n < cycle; ++n)
+                {
+                    const size_t i = (h * n) % cycle;
+                    s += double(x[n]) * cycleSines[i];
+                    c += double(x[n]) * cycleCosines[i];
+                }
+                sine[h]   = 2.0 * s / double(cycle);
+                cosine[h] = 2.0 * c / double(cycle);
+            }
+            wavetable->generate(f, sine, cosine);
+        }
+        return wavetable;
+    }
+
+    size_t frames() const
+    {
+        return m_frames;
+    }
+    // level whose harmonics are below the Nyquist frequency at increments of dt, Size * dt being
+    // at most 2^level
+    static inline size_t level(T dt)
+    {
+        // floor(log2(Size * dt)) + 1, read from the exponent bits, as frexp is a library call
+        using bits_t = std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>;
+        constexpr int mantissa = std::numeric_limits<T>::digits - 1;
+        constexpr int bias     = std::numeric_limits<T>::max_exponent - 1;
+        const T x              = dt * T(Size);
+        bits_t bits;
+        std::memcpy(&bits, &x, sizeof(T));
+        const int exponent = int((bits >> mantissa) & bits_t(2 * bias + 1)) - bias + 1;
+        return size_t(std::min(std::max(exponent, 0), int(levels) - 1));
+    }
+    // Size samples of frame at level, the samples at -1, Size and Size + 1 wrapping around
+    const T* table(size_t frame, size_t level) const
+    {
+        return &m_pool[(frame * levels + level) * stride + 1];
+    }
+    // the pool, aligned on a cache line
+    const T* data() const
+    {
+        return m_pool.data();
+    }
+};
+
+#endif // DAP_DSP_WAVETABLE_H
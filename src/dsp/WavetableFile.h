@@ -0,0 +1,48 @@
+#ifndef DAP_DSP_WAVETABLE_FILE_H
+#define DAP_DSP_WAVETABLE_FILE_H
+
+#include "Wavetable.h"
+#include <sndfile.hh>
+#include <string>
+
+// Targets including this header link SndFile::sndfile.
+
+namespace dap
+{
+    namespace dsp
+    {
+        // wavetable of the single cycle waveforms of cycle samples each, one after the other in
+        // the first channel of the sound file at path, the remaining samples being ignored
+        template <typename T, size_t Size = 2048>
+        std::shared_ptr<const Wavetable<T, Size>> loadWavetable(const std::string& path,
+                                                                size_t cycle = Size);
+    }
+}
+
+template <typename T, size_t Size>
+std::shared_ptr<const dap::dsp::Wavetable<T, Size>>
+    dap::dsp::loadWavetable(const std::string& path, size_t cycle)
+{
+    SndfileHandle file(path);
+    if (file.error() != 0)
+    {
+        throw std::runtime_error("Cannot open wavetable " + path + ": " + file.strError());
+    }
+    const auto channels = size_t(file.channels());
+    const auto length   = size_t(file.frames());
+    const size_t frames = cycle > 0 ? length / cycle : 0;
+    if (frames == 0)
+    {
+        throw std::runtime_error("Wavetable " + path + " is shorter than a cycle.");
+    }
+    std::vector<float> interleaved(length * channels);
+    file.readf(interleaved.data(), sf_count_t(length));
+    std::vector<T> samples(frames * cycle);
+    for (size_t n = 0; n < samples.size(); ++n)
+    {
+        samples[n] = T(interleaved[n * channels]);
+    }
+    return Wavetable<T, Size>::fromCycles(samples.data(), frames, cycle);
+}
+
+#endif // DAP_DSP_WAVETABLE_FILE_H
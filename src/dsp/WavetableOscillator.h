@@ -0,0 +1,114 @@
+#ifndef DAP_DSP_WAVETABLE_OSCILLATOR_H
+#define DAP_DSP_WAVETABLE_OSCILLATOR_H
+
+#include "Frames.h"
+#include "InterpolationFunctions.h"
+#include "Phasor.h"
+#include "Wavetable.h"
+#include <algorithm>
+#include <memory>
+
+namespace dap
+{
+    namespace dsp
+    {
+        template <typename T, size_t Size = 2048, Interpolation I = Interpolation::Linear>
+        class WavetableOscillator;
+    }
+}
+
+// Oscillator reading the frames of a Wavetable, at the mipmap level of its frequency, with the
+// interpolation I. position in [0, 1] morphs from the first frame to the last one. Oscillators
+// without a wavetable output zeros.
+template <typename T, size_t Size, dap::dsp::Interpolation I>
+class dap::dsp::WavetableOscillator final
+{
+    using wavetable_t = Wavetable<T, Size>;
+
+    std::shared_ptr<const wavetable_t> m_wavetable;
+    NormalizedPhasor<T> m_phasor;
+
+    // turns in [0, 1)
+    inline T read(T turns, T dt, T position) const
+    {
+        const size_t level = wavetable_t::level(dt);
+        const T x          = turns * T(Size);
+        const auto i       = size_t(x);
+        const T frac       = x - T(i);
+        const size_t index = i & (Size - 1); // turns just below 1 may round to Size
+
+        const size_t last = m_wavetable->frames() - 1;
+        const T f         = std::min(std::max(position, T(0)), T(1)) * T(last);
+        const auto frame  = size_t(f);
+        const T morph     = f - T(frame);
+        const T a = InterpolationFunctions::process<I>(m_wavetable->table(frame, level) + index,
+                                                       frac);
+        if (frame == last)
+        {
+            return a;
+        }
+        const T b = InterpolationFunctions::process<I>(
+            m_wavetable->table(frame + 1, level) + index, frac);
+        return a + morph * (b - a);
+    }
+    static inline T wrap(T turns)
+    {
+        using std::floor;
+        return turns - floor(turns);
+    }
+
+public:
+    WavetableOscillator() = default;
+    explicit WavetableOscillator(std::shared_ptr<const wavetable_t> wavetable)
+    : m_wavetable(std::move(wavetable))
+    {
+    }
+    void setWavetable(std::shared_ptr<const wavetable_t> wavetable)
+    {
+        m_wavetable = std::move(wavetable);
+    }
+    const std::shared_ptr<const wavetable_t>& wavetable() const
+    {
+        return m_wavetable;
+    }
+    void reset()
+    {
+        m_phasor.reset();
+    }
+    inline T operator()(T gain, T freq, T phase, T samplerate, T position)
+    {
+        using std::abs;
+        const T turns = wrap(m_phasor(freq, samplerate) + phase * T(0.5 / M_PI));
+        if (!m_wavetable)
+        {
+            return T(0);
+        }
+        return gain * read(turns, abs(freq / samplerate), position);
+    }
+    // block overload, gain, freq, phase and position may be given per frame, see Frames.h
+    template <typename Gain, typename Freq, typename Phase, typename SampleRate, typename Position>
+    inline void process(T* out,
+                        size_t frames,
+                        const Gain& gain,
+                        const Freq& freq,
+                        const Phase& phase,
+                        const SampleRate& samplerate,
+                        const Position& position)
+    {
+        using std::abs;
+        m_phasor.process(out, frames, freq, samplerate);
+        if (!m_wavetable)
+        {
+            std::fill(out, out + frames, T(0));
+            return;
+        }
+        for (size_t n = 0; n < frames; ++n)
+        {
+            const T turns = wrap(out[n] + frameAt(phase, n) * T(0.5 / M_PI));
+            const T dt    = abs(T(frameAt(freq, n) / frameAt(samplerate, n)));
+            out[n]        = frameAt(gain, n) * read(turns, dt, frameAt(position, n));
+        }
+    }
+};
+
+#endif // DAP_DSP_WAVETABLE_OSCILLATOR_H
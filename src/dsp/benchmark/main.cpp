@@ -0,0 +1,522 @@
+#include <benchmark/benchmark.h>
+#include "dsp/AllPass.h"
+#include "dsp/BiquadBank.h"
+#include "dsp/CombFilter.h"
+#include "dsp/Convolver.h"
+#include "dsp/FeedbackLine.h"
+#include "dsp/LadderFilter.h"
+#include "dsp/NoiseGenerator.h"
+#include "dsp/Oscillator.h"
+#include "dsp/Phaser.h"
+#include "dsp/Smoother.h"
+#include "dsp/UniformDistribution.h"
+#include "dsp/WavetableOscillator.h"
+#include <cmath>
+#include <vector>
+
+// Each benchmark renders a block of frames with its parameter either held, so that coefficients
+// come from their cache, or moving every frame, so that they are computed every frame as before
+// the caches were introduced.
+
+namespace
+{
+    constexpr size_t frames     = 512;
+    constexpr float samplerate = 48000.0f;
+
+    std::vector<float> input()
+    {
+        std::vector<float> x(frames);
+        for (size_t n = 0; n < frames; ++n)
+        {
+            x[n] = std::sin(0.05f * float(n));
+        }
+        return x;
+    }
+    // the parameter of frame n, moving when swept
+    inline float parameter(float value, size_t n, bool swept)
+    {
+        return swept ? value + 0.01f * float(n) : value;
+    }
+}
+
+static void BM_LadderFilter(benchmark::State& state)
+{
+    const bool swept = state.range(0) != 0;
+    const auto x     = input();
+    dap::dsp::LadderFilter<float> filter;
+    for (auto _ : state)
+    {
+        for (size_t n = 0; n < frames; ++n)
+        {
+            benchmark::DoNotOptimize(filter(x[n], parameter(1000.0f, n, swept), 1.0f, samplerate));
+        }
+    }
+}
+BENCHMARK(BM_LadderFilter)->ArgName("swept")->Arg(0)->Arg(1);
+
+// the coefficient is computed again once the frequency moved by 1%
+static void BM_TolerantLadderFilter(benchmark::State& state)
+{
+    const auto x = input();
+    dap::dsp::LadderFilter<float, std::ratio<1, 100>> filter;
+    for (auto _ : state)
+    {
+        for (size_t n = 0; n < frames; ++n)
+        {
+            benchmark::DoNotOptimize(filter(x[n], parameter(1000.0f, n, true), 1.0f, samplerate));
+        }
+    }
+}
+BENCHMARK(BM_TolerantLadderFilter);
+
+static void BM_AllPass(benchmark::State& state)
+{
+    const bool swept = state.range(0) != 0;
+    const auto x     = input();
+    dap::dsp::AllPass<float> allpass;
+    for (auto _ : state)
+    {
+        for (size_t n = 0; n < frames; ++n)
+        {
+            benchmark::DoNotOptimize(allpass(x[n], parameter(1000.0f, n, swept), samplerate));
+        }
+    }
+}
+BENCHMARK(BM_AllPass)->ArgName("swept")->Arg(0)->Arg(1);
+
+// the lfo sweeps the coefficients every frame, they are computed once per control period
+template <size_t ControlPeriod>
+static void BM_Phaser(benchmark::State& state)
+{
+    const auto x = input();
+    dap::dsp::Phaser<float, ControlPeriod> phaser;
+    for (auto _ : state)
+    {
+        for (size_t n = 0; n < frames; ++n)
+        {
+            benchmark::DoNotOptimize(phaser(x[n], 0.5f, 0.8f, 0.5f, 0.5f, samplerate));
+        }
+    }
+}
+BENCHMARK_TEMPLATE(BM_Phaser, 1);
+BENCHMARK_TEMPLATE(BM_Phaser, 16);
+
+static void BM_Smoother(benchmark::State& state)
+{
+    const bool swept = state.range(0) != 0;
+    const auto x     = input();
+    dap::dsp::Smoother<float> smoother;
+    for (auto _ : state)
+    {
+        for (size_t n = 0; n < frames; ++n)
+        {
+            benchmark::DoNotOptimize(smoother(x[n], swept ? 4096 + n : 4096));
+        }
+    }
+}
+BENCHMARK(BM_Smoother)->ArgName("swept")->Arg(0)->Arg(1);
+
+static void BM_FeedbackCombFilter(benchmark::State& state)
+{
+    const bool swept = state.range(0) != 0;
+    const auto x     = input();
+    dap::dsp::FeedbackCombFilter<float, 1024> comb;
+    for (auto _ : state)
+    {
+        for (size_t n = 0; n < frames; ++n)
+        {
+            benchmark::DoNotOptimize(comb(x[n], 100.5f, parameter(0.5f, n, swept)));
+        }
+    }
+}
+BENCHMARK(BM_FeedbackCombFilter)->ArgName("swept")->Arg(0)->Arg(1);
+
+static void BM_FeedbackLine(benchmark::State& state)
+{
+    const bool swept = state.range(0) != 0;
+    const auto x     = input();
+    dap::dsp::FeedbackLine<float, 1024> line;
+    for (auto _ : state)
+    {
+        for (size_t n = 0; n < frames; ++n)
+        {
+            benchmark::DoNotOptimize(line(x[n], 100.5f, parameter(0.5f, n, swept)));
+        }
+    }
+}
+BENCHMARK(BM_FeedbackLine)->ArgName("swept")->Arg(0)->Arg(1);
+
+// a flanger, i.e. a feedback comb filter whose delay is modulated between 80 and 120 samples,
+// rendered frame by frame or in blocks of 64 frames
+static void BM_Flanger(benchmark::State& state)
+{
+    const bool block = state.range(0) != 0;
+    const auto x     = input();
+    std::vector<float> delay(frames);
+    std::vector<float> out(frames);
+    for (size_t n = 0; n < frames; ++n)
+    {
+        delay[n] = 100.0f + 20.0f * std::sin(0.01f * float(n));
+    }
+    dap::dsp::FeedbackCombFilter<float, 1024> comb;
+    for (auto _ : state)
+    {
+        for (size_t n = 0; n < frames; n += 64)
+        {
+            if (block)
+            {
+                comb.process(&out[n], 64, &x[n], &delay[n], 0.5f);
+                continue;
+            }
+            for (size_t i = n; i < n + 64; ++i)
+            {
+                out[i] = comb(x[i], delay[i], 0.5f);
+            }
+        }
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK(BM_Flanger)->ArgName("block")->Arg(0)->Arg(1);
+
+// modulated reads of a delay line with the interpolation I
+template <dap::dsp::Interpolation I>
+static void BM_DelayLineRead(benchmark::State& state)
+{
+    const auto x = input();
+    std::vector<float> delay(frames);
+    std::vector<float> out(frames);
+    for (size_t n = 0; n < frames; ++n)
+    {
+        delay[n] = 100.0f + 20.0f * std::sin(0.01f * float(n));
+    }
+    dap::dsp::DelayLine<float, 1024> line;
+    for (auto _ : state)
+    {
+        for (size_t n = 0; n < frames; n += 64)
+        {
+            line.write(&x[n], 64);
+            line.template read<I>(&out[n], 64, &delay[n]);
+        }
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK_TEMPLATE(BM_DelayLineRead, dap::dsp::Interpolation::Linear);
+BENCHMARK_TEMPLATE(BM_DelayLineRead, dap::dsp::Interpolation::Cubic);
+BENCHMARK_TEMPLATE(BM_DelayLineRead, dap::dsp::Interpolation::Lagrange);
+BENCHMARK_TEMPLATE(BM_DelayLineRead, dap::dsp::Interpolation::Thiran);
+
+// frequency modulated sine rendered frame by frame or in blocks of 64 frames
+template <dap::fastmath::approx::Accuracy A>
+static void BM_Oscillator(benchmark::State& state)
+{
+    using shape_t    = dap::dsp::OscillatorFunctions::Shape;
+    const bool block = state.range(0) != 0;
+    std::vector<float> freq(frames);
+    std::vector<float> out(frames);
+    for (size_t n = 0; n < frames; ++n)
+    {
+        freq[n] = 440.0f + 100.0f * std::sin(0.01f * float(n));
+    }
+    dap::dsp::Oscillator<float, A> osc;
+    for (auto _ : state)
+    {
+        if (block)
+        {
+            for (size_t n = 0; n < frames; n += 64)
+            {
+                osc.process(&out[n], 64, 0.5f, &freq[n], 0.0f, samplerate, shape_t::Sine);
+            }
+        }
+        else
+        {
+            for (size_t n = 0; n < frames; ++n)
+            {
+                out[n] = osc(0.5f, freq[n], 0.0f, samplerate, shape_t::Sine);
+            }
+        }
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK_TEMPLATE(BM_Oscillator, dap::fastmath::approx::Accuracy::Exact)->ArgName("block")->Arg(0)->Arg(1);
+BENCHMARK_TEMPLATE(BM_Oscillator, dap::fastmath::approx::Accuracy::High)->ArgName("block")->Arg(0)->Arg(1);
+BENCHMARK_TEMPLATE(BM_Oscillator, dap::fastmath::approx::Accuracy::Low)->ArgName("block")->Arg(0)->Arg(1);
+
+// the frequency modulated sine of BM_Oscillator read from a wavetable, morphing between two frames
+template <dap::dsp::Interpolation I>
+static void BM_WavetableOscillator(benchmark::State& state)
+{
+    std::vector<float> freq(frames);
+    std::vector<float> out(frames);
+    for (size_t n = 0; n < frames; ++n)
+    {
+        freq[n] = 440.0f + 100.0f * std::sin(0.01f * float(n));
+    }
+    dap::dsp::WavetableOscillator<float, 2048, I> osc(
+        dap::dsp::Wavetable<float>::fromHarmonics({{1.0f}, {1.0f, 0.5f}}));
+    for (auto _ : state)
+    {
+        for (size_t n = 0; n < frames; n += 64)
+        {
+            osc.process(&out[n], 64, 0.5f, &freq[n], 0.0f, samplerate, 0.25f);
+        }
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK_TEMPLATE(BM_WavetableOscillator, dap::dsp::Interpolation::Linear);
+BENCHMARK_TEMPLATE(BM_WavetableOscillator, dap::dsp::Interpolation::Cubic);
+
+namespace
+{
+    constexpr float sawFrequency = 1234.5f;
+
+    // power of the frequencies more than a few bins away from the harmonics of sawFrequency
+    // relative to the power of the harmonics, in dB, measured on a Blackman-Harris window
+    double aliasing(const std::vector<float>& x)
+    {
+        const size_t size = x.size();
+        std::vector<double> windowed(size);
+        for (size_t n = 0; n < size; ++n)
+        {
+            const double w = 2.0 * M_PI * double(n) / double(size);
+            windowed[n] = x[n] * (0.35875 - 0.48829 * std::cos(w) + 0.14128 * std::cos(2.0 * w) -
+                                  0.01168 * std::cos(3.0 * w));
+        }
+        const double bin = samplerate / double(size);
+        double harmonics = 0.0;
+        double aliases   = 0.0;
+        for (size_t k = 4; k < size / 2; ++k)
+        {
+            double re = 0.0;
+            double im = 0.0;
+            for (size_t n = 0; n < size; ++n)
+            {
+                const double w = 2.0 * M_PI * double(k * n % size) / double(size);
+                re += windowed[n] * std::cos(w);
+                im -= windowed[n] * std::sin(w);
+            }
+            const double f        = double(k) * bin;
+            const double harmonic = std::round(f / sawFrequency) * sawFrequency;
+            (std::abs(f - harmonic) < 4.0 * bin ? harmonics : aliases) += re * re + im * im;
+        }
+        return 10.0 * std::log10(aliases / harmonics);
+    }
+
+    // naive saw rendered at Factor times the sample rate, low passed by a Blackman windowed sinc
+    // and decimated
+    template <size_t Factor>
+    class OversampledSaw
+    {
+        static constexpr size_t taps = 16 * Factor;
+
+        dap::dsp::Oscillator<float, dap::fastmath::approx::Accuracy::High> m_osc;
+        std::vector<float> m_coefficients;
+        std::vector<float> m_input;
+
+    public:
+        OversampledSaw()
+        : m_coefficients(taps)
+        , m_input(taps - 1 + 64 * Factor)
+        {
+            const double cutoff = 0.45 / double(Factor);
+            double sum          = 0.0;
+            for (size_t k = 0; k < taps; ++k)
+            {
+                const double x = double(k) - 0.5 * double(taps - 1);
+                const double w = 2.0 * M_PI * double(k) / double(taps - 1);
+                const double sinc =
+                    x == 0.0 ? 2.0 * cutoff : std::sin(2.0 * M_PI * cutoff * x) / (M_PI * x);
+                const double window = 0.42 - 0.5 * std::cos(w) + 0.08 * std::cos(2.0 * w);
+                m_coefficients[k]   = float(sinc * window);
+                sum += m_coefficients[k];
+            }
+            for (auto& c : m_coefficients)
+            {
+                c = float(c / sum);
+            }
+        }
+        // renders 64 frames
+        void process(float* out)
+        {
+            using shape_t = dap::dsp::OscillatorFunctions::Shape;
+            std::copy(m_input.end() - (taps - 1), m_input.end(), m_input.begin());
+            m_osc.process(&m_input[taps - 1],
+                          64 * Factor,
+                          0.5f,
+                          sawFrequency,
+                          0.0f,
+                          samplerate * float(Factor),
+                          shape_t::Saw);
+            for (size_t n = 0; n < 64; ++n)
+            {
+                const float* x = &m_input[n * Factor];
+                float y        = 0.0f;
+                for (size_t k = 0; k < taps; ++k)
+                {
+                    y += m_coefficients[k] * x[k];
+                }
+                out[n] = y;
+            }
+        }
+    };
+    class BandLimitedSaw
+    {
+        dap::dsp::Oscillator<float,
+                             dap::fastmath::approx::Accuracy::High,
+                             dap::dsp::Antialiasing::PolyBlep>
+            m_osc;
+
+    public:
+        // renders 64 frames
+        void process(float* out)
+        {
+            using shape_t = dap::dsp::OscillatorFunctions::Shape;
+            m_osc.process(out, 64, 0.5f, sawFrequency, 0.0f, samplerate, shape_t::Saw);
+        }
+    };
+
+    template <typename Saw>
+    std::vector<float> render(Saw& saw, size_t size)
+    {
+        std::vector<float> x(size);
+        for (size_t n = 0; n < size; n += 64)
+        {
+            saw.process(&x[n]);
+        }
+        return x;
+    }
+}
+
+// Saws rendered naively at one to eight times the sample rate, with PolyBLEP residuals at the
+// sample rate, the aliasing counter comparing their alias rejection
+template <typename Saw>
+static void BM_Saw(benchmark::State& state)
+{
+    Saw saw;
+    state.counters["aliasing_dB"] = aliasing(render(saw, 2048));
+    std::vector<float> out(frames);
+    for (auto _ : state)
+    {
+        for (size_t n = 0; n < frames; n += 64)
+        {
+            saw.process(&out[n]);
+        }
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK_TEMPLATE(BM_Saw, OversampledSaw<1>);
+BENCHMARK_TEMPLATE(BM_Saw, OversampledSaw<2>);
+BENCHMARK_TEMPLATE(BM_Saw, OversampledSaw<4>);
+BENCHMARK_TEMPLATE(BM_Saw, OversampledSaw<8>);
+BENCHMARK_TEMPLATE(BM_Saw, BandLimitedSaw);
+
+// a resonator bank of 32 bands, Lanes bands at a time, or band after band with scalar Biquads
+// when Lanes is 1
+template <size_t Lanes>
+static void BM_BiquadBank(benchmark::State& state)
+{
+    using coefficients_t   = dap::dsp::BiquadCoefficients<float>;
+    constexpr size_t bands = 32;
+    const auto x           = input();
+    std::vector<float> out(frames);
+    std::vector<float> band(frames);
+    dap::dsp::BiquadBank<float, bands, Lanes> bank;
+    std::vector<dap::dsp::Biquad<float>> biquads(bands);
+    for (size_t i = 0; i < bands; ++i)
+    {
+        const auto c = coefficients_t::design(
+            dap::dsp::BiquadResponse::BandPass, 100.0 * double(i + 1), 30.0, 0.0, samplerate);
+        bank.set(i, c);
+        biquads[i].set(c);
+    }
+    for (auto _ : state)
+    {
+        if constexpr (Lanes == 1)
+        {
+            std::fill(out.begin(), out.end(), 0.0f);
+            for (auto& biquad : biquads)
+            {
+                biquad.process(band.data(), x.data(), frames);
+                for (size_t n = 0; n < frames; ++n)
+                {
+                    out[n] += band[n];
+                }
+            }
+        }
+        else
+        {
+            bank.process(out.data(), x.data(), frames);
+        }
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK_TEMPLATE(BM_BiquadBank, 1);
+BENCHMARK_TEMPLATE(BM_BiquadBank, 4);
+BENCHMARK_TEMPLATE(BM_BiquadBank, 8);
+
+// pink noise rendered frame by frame or in a block, the random samples then being drawn four at a
+// time
+static void BM_NoiseGenerator(benchmark::State& state)
+{
+    using noise_t    = dap::dsp::NoiseGenerator<dap::dsp::UniformDistribution>;
+    const bool block = state.range(0) != 0;
+    std::vector<float> out(frames);
+    noise_t noise(dap::dsp::UniformDistribution(1));
+    for (auto _ : state)
+    {
+        if (block)
+        {
+            noise.process(out.data(), frames, 0.5f, noise_t::Color::Pink);
+        }
+        else
+        {
+            for (size_t n = 0; n < frames; ++n)
+            {
+                out[n] = noise(0.5f, noise_t::Color::Pink);
+            }
+        }
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK(BM_NoiseGenerator)->ArgName("block")->Arg(0)->Arg(1);
+
+// a mono convolution with a decaying noise of the given length, rendered by blocks of the given
+// frames, the partitions having the size of the blocks. With a tail, the impulse response past
+// twice the tail partition is convolved by partitions of that size, here on the audio thread so
+// that the whole cost is measured. The realtime counter is the number of channels a core
+// renders in real time at 48kHz, the cpu per channel being its inverse.
+static void BM_Convolver(benchmark::State& state)
+{
+    const auto length = size_t(state.range(0));
+    const auto block  = size_t(state.range(1));
+    const auto tail   = size_t(state.range(2));
+    std::vector<float> ir(length);
+    for (size_t n = 0; n < length; ++n)
+    {
+        ir[n] = std::sin(0.7f * float(n * n)) * std::exp(-4.0f * float(n) / float(length));
+    }
+    std::vector<float> out(block);
+    const auto x = input();
+    dap::dsp::Convolver<float> convolver(1, block, tail, false);
+    convolver.setImpulseResponse(ir.data(), ir.size());
+    for (auto _ : state)
+    {
+        convolver.process(out.data(), x.data(), block);
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    const double seconds = double(state.iterations()) * double(block) / double(samplerate);
+    state.counters["realtime"] = benchmark::Counter(seconds, benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_Convolver)
+    ->ArgNames({"ir", "block", "tail"})
+    ->ArgsProduct({{1024, 8192, 65536}, {64, 256, 512}, {0}})
+    ->ArgsProduct({{8192, 65536}, {64, 256, 512}, {1024}});
+
+BENCHMARK_MAIN();
@@ -0,0 +1,181 @@
+#include "dsp/BiquadBank.h"
+#include "dsp/BiquadCascade.h"
+#include "dsp/IIRFilter.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <complex>
+#include <vector>
+
+using namespace testing;
+using namespace dap;
+using namespace dap::dsp;
+
+namespace
+{
+    constexpr double samplerate = 48000.0;
+
+    // |H| in dB at frequency
+    double magnitude(const BiquadCoefficients<double>& c, double frequency)
+    {
+        const auto z = std::polar(1.0, -2.0 * M_PI * frequency / samplerate);
+        const auto h = (c.b0 + c.b1 * z + c.b2 * z * z) / (1.0 + c.a1 * z + c.a2 * z * z);
+        return 20.0 * std::log10(std::abs(h));
+    }
+    BiquadCoefficients<double> design(BiquadResponse response, double gain = 0.0)
+    {
+        return BiquadCoefficients<double>::design(response, 1000.0, 0.707, gain, samplerate);
+    }
+    std::vector<float> input(size_t frames)
+    {
+        std::vector<float> x(frames);
+        for (size_t n = 0; n < frames; ++n)
+        {
+            x[n] = std::sin(0.05f * float(n)) + 0.5f * std::sin(1.3f * float(n));
+        }
+        return x;
+    }
+}
+
+TEST(BiquadTest, design)
+{
+    const double nyquist = samplerate / 2.0 - 1.0;
+    ASSERT_NEAR(0.0, magnitude(design(BiquadResponse::LowPass), 0.0), 1e-9);
+    ASSERT_NEAR(-3.0, magnitude(design(BiquadResponse::LowPass), 1000.0), 0.05);
+    ASSERT_LT(magnitude(design(BiquadResponse::LowPass), nyquist), -100.0);
+    ASSERT_NEAR(0.0, magnitude(design(BiquadResponse::HighPass), nyquist), 1e-6);
+    ASSERT_LT(magnitude(design(BiquadResponse::HighPass), 1.0), -100.0);
+    ASSERT_NEAR(0.0, magnitude(design(BiquadResponse::BandPass), 1000.0), 1e-9);
+    ASSERT_LT(magnitude(design(BiquadResponse::Notch), 1000.0), -100.0);
+    for (double f : {10.0, 1000.0, 10000.0})
+    {
+        ASSERT_NEAR(0.0, magnitude(design(BiquadResponse::AllPass), f), 1e-9);
+    }
+    ASSERT_NEAR(6.0, magnitude(design(BiquadResponse::Peak, 6.0), 1000.0), 1e-9);
+    ASSERT_NEAR(0.0, magnitude(design(BiquadResponse::Peak, 6.0), nyquist), 0.01);
+    ASSERT_NEAR(-6.0, magnitude(design(BiquadResponse::LowShelf, -6.0), 0.0), 1e-9);
+    ASSERT_NEAR(0.0, magnitude(design(BiquadResponse::LowShelf, -6.0), nyquist), 0.01);
+    ASSERT_NEAR(-3.0, magnitude(design(BiquadResponse::LowShelf, -6.0), 1000.0), 1e-9);
+    ASSERT_NEAR(6.0, magnitude(design(BiquadResponse::HighShelf, 6.0), nyquist), 0.01);
+    ASSERT_NEAR(0.0, magnitude(design(BiquadResponse::HighShelf, 6.0), 0.0), 1e-9);
+}
+
+TEST(BiquadTest, cascade_matches_iir_filter)
+{
+    // the 1/f filter of NoiseGenerator, factored in two sections
+    std::vector<double> a = {1, -2.494956002, 2.017265875, -0.522189400};
+    std::vector<double> b = {0.049922035, -0.095993537, 0.050612699, -0.004408786};
+    IIRFilter<double, 4> filter;
+    filter.set(b.data(), a.data());
+    BiquadCascade<double, 2> cascade;
+    cascade.set(0, {0.049922035, -0.090602911, 0.040829316, -1.939010743, 0.939282045});
+    cascade.set(1, {1.0, -0.107980894, 0.0, -0.555945259, 0.0});
+    const auto x = input(1000);
+    for (size_t n = 0; n < x.size(); ++n)
+    {
+        ASSERT_NEAR(filter(x[n]), cascade(x[n]), 1e-6) << n;
+    }
+}
+
+TEST(BiquadTest, ramp)
+{
+    using coefficients_t = BiquadCoefficients<float>;
+    const auto from = coefficients_t::design(BiquadResponse::LowPass, 500.0, 1.0, 0.0, samplerate);
+    const auto to   = coefficients_t::design(BiquadResponse::LowPass, 5000.0, 1.0, 0.0, samplerate);
+    Biquad<float> frameFilter(from);
+    Biquad<float> blockFilter(from);
+    frameFilter.setTarget(to, 48);
+    blockFilter.setTarget(to, 48);
+    ASSERT_EQ(to.b0, blockFilter.target().b0);
+
+    const auto x = input(64);
+    std::vector<float> out(x.size());
+    blockFilter.process(out.data(), x.data(), 32);
+    ASSERT_LT(blockFilter.coefficients().b0, to.b0);
+    ASSERT_GT(blockFilter.coefficients().b0, from.b0);
+    blockFilter.process(out.data() + 32, x.data() + 32, 32);
+    for (size_t n = 0; n < x.size(); ++n)
+    {
+        ASSERT_FLOAT_EQ(frameFilter(x[n]), out[n]) << n;
+    }
+    ASSERT_EQ(to.b0, blockFilter.coefficients().b0);
+    ASSERT_EQ(to.a1, blockFilter.coefficients().a1);
+    ASSERT_EQ(to.a2, blockFilter.coefficients().a2);
+}
+
+TEST(BiquadTest, cascade_channels_in_lanes)
+{
+    using float4 = fastmath::float4;
+    const size_t frames = 100;
+    const auto x        = input(frames);
+    fastmath::AudioBuffer<float> buffer(3, frames);
+    for (size_t c = 0; c < 3; ++c)
+    {
+        for (size_t n = 0; n < frames; ++n)
+        {
+            buffer.channel(c)[n] = float(c + 1) * x[n];
+        }
+    }
+    using coefficients_t = BiquadCoefficients<float>;
+    const auto lowPass =
+        coefficients_t::design(BiquadResponse::LowPass, 800.0, 2.0, 0.0, samplerate);
+    const auto peak = coefficients_t::design(BiquadResponse::Peak, 3000.0, 1.0, 6.0, samplerate);
+    BiquadCascade<float4, 2> cascade;
+    cascade.set(0, {lowPass.b0, lowPass.b1, lowPass.b2, lowPass.a1, lowPass.a2});
+    cascade.set(1, {peak.b0, peak.b1, peak.b2, peak.a1, peak.a2});
+    cascade.process(buffer);
+
+    for (size_t c = 0; c < 3; ++c)
+    {
+        BiquadCascade<float, 2> reference;
+        reference.set(0, lowPass);
+        reference.set(1, peak);
+        fastmath::Array<float> y(frames);
+        for (size_t n = 0; n < frames; ++n)
+        {
+            y[n] = float(c + 1) * x[n];
+        }
+        reference.process(y);
+        for (size_t n = 0; n < frames; ++n)
+        {
+            ASSERT_FLOAT_EQ(y[n], buffer.channel(c)[n]) << c << " " << n;
+        }
+    }
+}
+
+TEST(BiquadTest, bank_sums_bands)
+{
+    constexpr size_t bands = 10;
+    BiquadBank<float, bands, 4> bank;
+    std::vector<Biquad<float>> references(bands);
+    for (size_t i = 0; i < bands; ++i)
+    {
+        const auto c = BiquadCoefficients<float>::design(
+            BiquadResponse::BandPass, 100.0 * double(i + 1), 20.0, 0.0, samplerate);
+        bank.set(i, c);
+        references[i].set(c);
+        ASSERT_EQ(c.a1, bank.coefficients(i).a1);
+    }
+    const auto x = input(200);
+    std::vector<float> out(x.size());
+    std::vector<float> expected(x.size(), 0.0f);
+    auto assertBlock = [&](size_t start) {
+        bank.process(out.data() + start, x.data() + start, 100);
+        for (size_t n = start; n < start + 100; ++n)
+        {
+            for (auto& reference : references)
+            {
+                expected[n] += reference(x[n]);
+            }
+            ASSERT_NEAR(expected[n], out[n], 1e-5f) << n;
+        }
+    };
+    assertBlock(0);
+
+    // the last band moves over the next block
+    const auto target = BiquadCoefficients<float>::design(
+        BiquadResponse::BandPass, 2000.0, 20.0, 0.0, samplerate);
+    bank.setTarget(bands - 1, target, 100);
+    references[bands - 1].setTarget(target, 100);
+    assertBlock(100);
+    ASSERT_EQ(target.a1, bank.coefficients(bands - 1).a1);
+}
@@ -0,0 +1,99 @@
+#include "dsp/AllPass.h"
+#include "dsp/CoefficientCache.h"
+#include "dsp/LadderFilter.h"
+#include <gtest/gtest.h>
+#include <cmath>
+
+using namespace testing;
+using namespace dap;
+using namespace dap::dsp;
+
+namespace
+{
+    struct Counted
+    {
+        int calls{0};
+        float operator()(float x)
+        {
+            ++calls;
+            return 2.0f * x;
+        }
+    };
+}
+
+TEST(CoefficientCacheTest, computes_when_the_parameter_changes)
+{
+    Counted compute;
+    CoefficientCache<float> cache;
+    auto fn = [&](float x) { return compute(x); };
+    ASSERT_EQ(2.0f, cache(1.0f, fn));
+    ASSERT_EQ(2.0f, cache(1.0f, fn));
+    ASSERT_EQ(1, compute.calls);
+    ASSERT_EQ(4.0f, cache(2.0f, fn));
+    ASSERT_EQ(2, compute.calls);
+
+    cache.reset();
+    ASSERT_EQ(4.0f, cache(2.0f, fn));
+    ASSERT_EQ(3, compute.calls);
+}
+
+TEST(CoefficientCacheTest, tolerance)
+{
+    Counted compute;
+    CoefficientCache<float, float, std::ratio<1, 100>> cache;
+    auto fn = [&](float x) { return compute(x); };
+    cache(100.0f, fn);
+    ASSERT_EQ(200.0f, cache(100.9f, fn));
+    ASSERT_EQ(200.0f, cache(99.1f, fn));
+    ASSERT_EQ(1, compute.calls);
+    ASSERT_EQ(202.2f, cache(101.1f, fn));
+    ASSERT_EQ(2, compute.calls);
+}
+
+TEST(CoefficientCacheTest, ramp)
+{
+    CoefficientRamp<float, 4> ramp;
+    ASSERT_TRUE(ramp.isDue());
+    ramp.setTarget(1.0f);
+    for (int n = 0; n < 4; ++n)
+    {
+        ASSERT_EQ(1.0f, ramp()); // the first target is reached right away
+    }
+    ASSERT_TRUE(ramp.isDue());
+    ramp.setTarget(3.0f);
+    ASSERT_FLOAT_EQ(1.5f, ramp());
+    ASSERT_FALSE(ramp.isDue());
+    ASSERT_FLOAT_EQ(2.0f, ramp());
+    ASSERT_FLOAT_EQ(2.5f, ramp());
+    ASSERT_FLOAT_EQ(3.0f, ramp());
+    ASSERT_TRUE(ramp.isDue());
+}
+
+TEST(CoefficientCacheTest, processors_match_uncached_formulas)
+{
+    const float samplerate = 44100.0f;
+    AllPass<float> allpass;
+    float y = 0.0f;
+    float d = 0.0f;
+    for (int n = 0; n < 256; ++n)
+    {
+        const float x         = std::sin(0.1f * float(n));
+        const float frequency = n < 128 ? 1000.0f : 1000.0f + float(n);
+        const float w         = std::tan(float(M_PI) * frequency / samplerate);
+        const float k         = (w - 1.0f) / (w + 1.0f);
+        y                     = k * x + d;
+        d                     = x - k * y;
+        ASSERT_NEAR(y, allpass(x, frequency, samplerate), 1e-5f);
+    }
+
+    LadderFilter<float> cached;
+    LadderFilter<float, std::ratio<1, 1000>> tolerant;
+    for (int n = 0; n < 256; ++n)
+    {
+        const float x         = std::sin(0.1f * float(n));
+        const float frequency = 1000.0f + 0.1f * float(n);
+        ASSERT_NEAR(cached(x, frequency, 1.0f, samplerate),
+                    tolerant(x, frequency, 1.0f, samplerate),
+                    1e-3f);
+    }
+}
@@ -0,0 +1,208 @@
+#include "dsp/Convolver.h"
+#include "dsp/ImpulseResponseFile.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace testing;
+using namespace dap;
+using namespace dap::dsp;
+
+namespace
+{
+    std::vector<float> noise(size_t size, unsigned seed)
+    {
+        std::mt19937 engine(seed);
+        std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+        std::vector<float> x(size);
+        for (auto& value : x)
+        {
+            value = distribution(engine);
+        }
+        return x;
+    }
+    // a decaying noise, like a room response
+    std::vector<float> impulseResponse(size_t length, unsigned seed)
+    {
+        auto ir = noise(length, seed);
+        for (size_t n = 0; n < length; ++n)
+        {
+            ir[n] *= std::exp(-4.0f * float(n) / float(length));
+        }
+        return ir;
+    }
+    std::vector<double> convolve(const std::vector<float>& x, const std::vector<float>& h)
+    {
+        std::vector<double> y(x.size());
+        for (size_t n = 0; n < x.size(); ++n)
+        {
+            for (size_t m = 0; m < h.size() && m <= n; ++m)
+            {
+                y[n] += double(h[m]) * double(x[n - m]);
+            }
+        }
+        return y;
+    }
+    // renders x by blocks of irregular sizes
+    template <typename Process>
+    std::vector<float> render(const std::vector<float>& x, Process process)
+    {
+        const size_t blocks[] = {1, 64, 17, 200, 3, 128, 511};
+        std::vector<float> y(x);
+        size_t block = 0;
+        for (size_t n = 0; n < y.size(); block = (block + 1) % 7)
+        {
+            const size_t frames = std::min(blocks[block], y.size() - n);
+            process(y.data() + n, frames);
+            n += frames;
+        }
+        return y;
+    }
+    template <typename T>
+    void assertNear(const std::vector<double>& expected, const std::vector<T>& y)
+    {
+        ASSERT_EQ(expected.size(), y.size());
+        for (size_t n = 0; n < y.size(); ++n)
+        {
+            ASSERT_NEAR(expected[n], y[n], 1e-3) << n;
+        }
+    }
+}
+
+TEST(ConvolverTest, uniform)
+{
+    const auto x = noise(3000, 1);
+    for (size_t length : {1, 31, 64, 1000})
+    {
+        const auto h = impulseResponse(length, 2);
+        UniformConvolver<float> convolver(64);
+        convolver.setImpulseResponse(h.data(), h.size());
+        ASSERT_EQ((length + 63) / 64, convolver.partitions());
+        const auto y = render(x, [&convolver](float* block, size_t frames) {
+            convolver.process(block, block, frames);
+        });
+        assertNear(convolve(x, h), y);
+    }
+}
+
+TEST(ConvolverTest, non_uniform)
+{
+    const auto x = noise(6000, 3);
+    const auto h = impulseResponse(2500, 4);
+    const auto expected = convolve(x, h);
+    for (bool background : {false, true})
+    {
+        Convolver<float> convolver(1, 32, 256, background);
+        convolver.setImpulseResponse(h.data(), h.size());
+        // the job of each tail block is waited for, as if rendering in real time
+        const auto process = [&convolver](float* block, size_t frames) {
+            for (size_t n = 0; n < frames; n += 256)
+            {
+                const size_t count = std::min<size_t>(256, frames - n);
+                convolver.process(block + n, block + n, count);
+                convolver.waitTail();
+            }
+        };
+        assertNear(expected, render(x, process));
+
+        // starts over
+        convolver.reset();
+        std::vector<float> z(x);
+        process(z.data(), z.size());
+        assertNear(expected, z);
+        ASSERT_EQ(0u, convolver.underruns());
+    }
+    // shorter than the head
+    Convolver<float> convolver(1, 32, 256);
+    convolver.setImpulseResponse(h.data(), 300);
+    std::vector<float> y(x);
+    convolver.process(y.data(), y.data(), y.size());
+    assertNear(convolve(x, std::vector<float>(h.begin(), h.begin() + 300)), y);
+
+    ASSERT_THROW(Convolver<float>(1, 256, 32), std::invalid_argument);
+}
+
+TEST(ConvolverTest, channels)
+{
+    const auto x = noise(2000, 5);
+    fastmath::AudioBuffer<float> ir(2, 700);
+    const auto left  = impulseResponse(700, 6);
+    const auto right = impulseResponse(700, 7);
+    std::copy(left.begin(), left.end(), ir.channel(0).data());
+    std::copy(right.begin(), right.end(), ir.channel(1).data());
+
+    // the third channel takes the last channel of the impulse response
+    Convolver<float> convolver(3, 64, 128);
+    convolver.setImpulseResponse(ir);
+    fastmath::AudioBuffer<float> buffer(3, 100);
+    std::vector<std::vector<float>> y(3);
+    for (size_t n = 0; n < x.size(); n += 100)
+    {
+        for (size_t c = 0; c < 3; ++c)
+        {
+            std::copy_n(x.begin() + n, 100, buffer.channel(c).data());
+        }
+        convolver.process(buffer);
+        convolver.waitTail();
+        for (size_t c = 0; c < 3; ++c)
+        {
+            const float* samples = buffer.channel(c).data();
+            y[c].insert(y[c].end(), samples, samples + 100);
+        }
+    }
+    assertNear(convolve(x, left), y[0]);
+    assertNear(convolve(x, right), y[1]);
+    assertNear(convolve(x, right), y[2]);
+}
+
+TEST(ConvolverTest, slow_worker)
+{
+    // the job of a tail block takes several times longer than its head, rendering many tail
+    // blocks at once does not wait for the jobs but drops tail blocks
+    const size_t partition = 4096;
+    const auto h = impulseResponse(256 * partition, 10);
+    const auto x = noise(32 * partition, 11);
+    Convolver<float> convolver(1, partition, partition);
+    convolver.setImpulseResponse(h.data(), h.size());
+    std::vector<float> y(x);
+    convolver.process(y.data(), y.data(), y.size());
+    ASSERT_GT(convolver.underruns(), 0u);
+
+    // the head, which alone is heard before the first tail block, is still convolved
+    const size_t head = 2 * partition;
+    const auto expected = convolve(std::vector<float>(x.begin(), x.begin() + head),
+                                   std::vector<float>(h.begin(), h.begin() + head));
+    assertNear(expected, std::vector<float>(y.begin(), y.begin() + head));
+
+    convolver.reset();
+    ASSERT_EQ(0u, convolver.underruns());
+}
+
+TEST(ConvolverTest, load)
+{
+    const char* path = "impulse_response.wav";
+    const auto left  = impulseResponse(300, 8);
+    const auto right = impulseResponse(300, 9);
+    {
+        std::vector<float> interleaved;
+        for (size_t n = 0; n < 300; ++n)
+        {
+            interleaved.push_back(0.5f * left[n]);
+            interleaved.push_back(0.5f * right[n]);
+        }
+        SndfileHandle file(path, SFM_WRITE, SF_FORMAT_WAV | SF_FORMAT_PCM_16, 2, 48000);
+        file.writef(interleaved.data(), 300);
+    }
+    const auto ir = loadImpulseResponse<float>(path);
+    std::remove(path);
+    ASSERT_EQ(2u, ir.channelCount());
+    ASSERT_EQ(300u, ir.channelSize());
+    for (size_t n = 0; n < 300; ++n)
+    {
+        ASSERT_NEAR(0.5f * left[n], ir.channel(0)[n], 1e-4f);
+        ASSERT_NEAR(0.5f * right[n], ir.channel(1)[n], 1e-4f);
+    }
+    ASSERT_THROW(loadImpulseResponse<float>("missing.wav"), std::runtime_error);
+}
@@ -1,6 +1,11 @@
+#include "dsp/CombFilter.h"
 #include "dsp/DelayLine.h"
+#include "dsp/DelayMemory.h"
 #include "dsp/FeedbackLine.h"
 #include <gtest/gtest.h>
+#include <cmath>
+#include <utility>
+#include <vector>
 
 using namespace testing;
 using namespace dap;
@@ -60,3 +65,264 @@ TEST(DelayTest, 4samplesWithFeedback)
         ASSERT_FLOAT_EQ(expected[i], delay(i, 4.0f, g));
     }
 }
+
+namespace
+{
+    std::vector<float> signal(size_t frames)
+    {
+        std::vector<float> x(frames);
+        for (size_t n = 0; n < frames; ++n)
+        {
+            x[n] = std::sin(0.1f * float(n)) + 0.25f * std::sin(0.77f * float(n));
+        }
+        return x;
+    }
+    // delays moving between from and to
+    std::vector<float> delays(size_t frames, float from, float to)
+    {
+        std::vector<float> d(frames);
+        for (size_t n = 0; n < frames; ++n)
+        {
+            d[n] = from + (to - from) * (0.5f + 0.5f * std::sin(0.03f * float(n)));
+        }
+        return d;
+    }
+}
+
+TEST(DelayTest, block_write_read)
+{
+    // blocks of 24 samples wrap around the 64 samples of the line
+    DelayLine<float, 64> delay;
+    std::vector<float> x(240);
+    for (size_t n = 0; n < x.size(); ++n)
+    {
+        x[n] = float(n + 1);
+    }
+    std::vector<float> out(24);
+    for (size_t start = 0; start < x.size(); start += 24)
+    {
+        delay.write(&x[start], 24);
+        for (size_t d : {0u, 1u, 17u, 40u})
+        {
+            delay.read(out.data(), 24, d);
+            for (size_t n = 0; n < 24; ++n)
+            {
+                const float expected = start + n >= d ? x[start + n - d] : 0.0f;
+                ASSERT_EQ(expected, out[n]) << start << " " << d << " " << n;
+            }
+        }
+    }
+}
+
+TEST(DelayTest, block_matches_frames)
+{
+    const auto x = signal(300);
+    const auto d = delays(x.size(), 0.2f, 40.0f);
+    DelayLine<float, 64> frameDelay;
+    DelayLine<float, 64> blockDelay;
+    DelayLine<float, 64> heldDelay;
+    std::vector<float> out(x.size());
+    std::vector<float> held(x.size());
+    for (size_t n = 0; n < x.size(); n += 20)
+    {
+        blockDelay.process(&out[n], 20, &x[n], &d[n]);
+        heldDelay.process(&held[n], 20, &x[n], 7);
+    }
+    for (size_t n = 0; n < x.size(); ++n)
+    {
+        ASSERT_FLOAT_EQ(frameDelay(x[n], d[n]), out[n]) << n;
+        ASSERT_EQ(n >= 7 ? x[n - 7] : 0.0f, held[n]) << n;
+    }
+}
+
+TEST(DelayTest, interpolations)
+{
+    // a sine delayed by 10.3 samples, the error of each interpolation being measured after the
+    // allpass of Thiran settled
+    const float w = 0.2f;
+    auto maxError = [&](auto read) {
+        DelayLine<float, 64> delay;
+        std::vector<float> out(16);
+        float error = 0.0f;
+        for (size_t start = 0; start < 320; start += 16)
+        {
+            std::vector<float> x(16);
+            for (size_t n = 0; n < 16; ++n)
+            {
+                x[n] = std::sin(w * float(start + n));
+            }
+            delay.write(x.data(), 16);
+            read(delay, out.data());
+            for (size_t n = 0; start >= 160 && n < 16; ++n)
+            {
+                const float expected = std::sin(w * (float(start + n) - 10.3f));
+                error                = std::max(error, std::abs(expected - out[n]));
+            }
+        }
+        return error;
+    };
+    const float linear = maxError([](auto& delay, float* out) {
+        delay.template read<Interpolation::Linear>(out, 16, 10.3f);
+    });
+    const float cubic = maxError([](auto& delay, float* out) {
+        delay.template read<Interpolation::Cubic>(out, 16, 10.3f);
+    });
+    const float lagrange = maxError([](auto& delay, float* out) {
+        delay.template read<Interpolation::Lagrange>(out, 16, 10.3f);
+    });
+    const float thiran = maxError([](auto& delay, float* out) {
+        delay.template read<Interpolation::Thiran>(out, 16, 10.3f);
+    });
+    ASSERT_LT(linear, 5e-3f);
+    ASSERT_LT(cubic, 2e-4f);
+    ASSERT_LT(lagrange, 5e-5f);
+    // the allpass is exact in magnitude, its phase delay being exact at low frequencies only, here
+    // for a fraction of 1.3
+    ASSERT_LT(thiran, 7e-4f);
+}
+
+TEST(DelayTest, thiran_integral_and_modulated_delays)
+{
+    // a sine read through a held delay with a short excursion of half a sample, then through a
+    // slowly swept one, the errors being measured once the allpass settled
+    const float w = 0.2f;
+    auto maxError = [&](float held) {
+        DelayLine<float, 64> delay;
+        std::vector<float> x(16);
+        std::vector<float> d(16);
+        std::vector<float> out(16);
+        float settled   = 0.0f;
+        float modulated = 0.0f;
+        for (size_t start = 0; start < 1600; start += 16)
+        {
+            for (size_t n = 0; n < 16; ++n)
+            {
+                const float t = float(start + n);
+                x[n]          = std::sin(w * t);
+                d[n]          = held + (start >= 160 && start < 176 ? 0.5f : 0.0f);
+                if (start >= 800)
+                {
+                    d[n] = held + std::min(4.0f, held - 1.0f) * std::sin(0.005f * (t - 800.0f));
+                }
+            }
+            delay.write(x.data(), 16);
+            delay.template read<Interpolation::Thiran>(out.data(), 16, d.data());
+            for (size_t n = 0; n < 16; ++n)
+            {
+                const float t     = float(start + n);
+                const float error = std::abs(std::sin(w * (t - d[n])) - out[n]);
+                if (start >= 480 && start < 800)
+                {
+                    settled = std::max(settled, error);
+                }
+                else if (start >= 960)
+                {
+                    modulated = std::max(modulated, error);
+                }
+            }
+        }
+        return std::make_pair(settled, modulated);
+    };
+    for (float held : {1.0f, 10.0f, 10.3f, 10.5f, 10.7f, 20.0f})
+    {
+        const auto errors = maxError(held);
+        // the phase delay error of the allpass at w, at most 1.3e-3 for a fraction of 1.5
+        ASSERT_LT(errors.first, 1.5e-3f) << held;
+        ASSERT_LT(errors.second, 5e-3f) << held;
+    }
+}
+
+TEST(DelayTest, comb_filters_block_matches_frames)
+{
+    const auto x = signal(500);
+    // delays shorter than a sample, shorter and longer than a chunk
+    for (const auto& d : {delays(x.size(), 0.1f, 3.5f), delays(x.size(), 2.0f, 100.0f)})
+    {
+        FeedforwardCombFilter<float, 256> frameFeedforward;
+        FeedforwardCombFilter<float, 256> blockFeedforward;
+        FeedbackCombFilter<float, 256> frameFeedback;
+        FeedbackCombFilter<float, 256> blockFeedback;
+        FeedbackLine<float, 256> frameLine;
+        FeedbackLine<float, 256> blockLine;
+        std::vector<float> feedforward(x.size());
+        std::vector<float> feedback(x.size());
+        std::vector<float> line(x.size());
+        for (size_t n = 0; n < x.size(); n += 50)
+        {
+            blockFeedforward.process(&feedforward[n], 50, &x[n], &d[n], 0.7f);
+            blockFeedback.process(&feedback[n], 50, &x[n], &d[n], 0.7f);
+            blockLine.process(&line[n], 50, &x[n], &d[n], 0.7f);
+        }
+        for (size_t n = 0; n < x.size(); ++n)
+        {
+            ASSERT_FLOAT_EQ(frameFeedforward(x[n], d[n], 0.7f), feedforward[n]) << n;
+            ASSERT_FLOAT_EQ(frameFeedback(x[n], d[n], 0.7f), feedback[n]) << n;
+            ASSERT_FLOAT_EQ(frameLine(x[n], d[n], 0.7f), line[n]) << n;
+        }
+    }
+
+    // held integral delays
+    FeedbackCombFilter<float, 256> frameFeedback;
+    FeedbackCombFilter<float, 256> blockFeedback;
+    std::vector<float> feedback(x.size());
+    for (size_t n = 0; n < x.size(); n += 50)
+    {
+        blockFeedback.process(&feedback[n], 50, &x[n], 9, 0.5f);
+    }
+    for (size_t n = 0; n < x.size(); ++n)
+    {
+        ASSERT_FLOAT_EQ(frameFeedback(x[n], 9, 0.5f), feedback[n]) << n;
+    }
+}
+
+TEST(DelayTest, delay_memory)
+{
+    DelayMemory memory(3 * 1024);
+    DelayLine<float, dynamic_delay> line;
+    line.setMaxDelay(200); // 256 samples and the guards
+    ASSERT_EQ(256u, line.size());
+    ASSERT_EQ(259 * sizeof(float), line.memorySize());
+    line.attach(memory);
+    ASSERT_EQ(DelayMemory::footprint(line.memorySize()), memory.used());
+
+    // a dynamic line behaves as an inline one of the same size
+    FeedbackCombFilter<float, 256> inlineComb;
+    FeedbackCombFilter<float, dynamic_delay> arenaComb;
+    arenaComb.setMaxDelay(200);
+    arenaComb.attach(memory);
+    const auto x = signal(500);
+    const auto d = delays(x.size(), 2.0f, 100.0f);
+    std::vector<float> out(x.size());
+    for (size_t n = 0; n < x.size(); n += 50)
+    {
+        arenaComb.process(&out[n], 50, &x[n], &d[n], 0.7f);
+    }
+    for (size_t n = 0; n < x.size(); ++n)
+    {
+        ASSERT_FLOAT_EQ(inlineComb(x[n], d[n], 0.7f), out[n]) << n;
+    }
+
+    // blocks start on cache lines, the arena being exhausted by the next line
+    FeedbackLine<float, dynamic_delay> arenaLine;
+    arenaLine.setMaxDelay(1000);
+    ASSERT_EQ(0u, memory.used() % 64);
+    ASSERT_THROW(arenaLine.attach(memory), std::bad_alloc);
+    memory.resize(8 * 1024);
+    arenaLine.attach(memory);
+    ASSERT_FLOAT_EQ(1.0f, arenaLine(1.0f, 0, 0.0f));
+
+    // a copy is not attached, a move takes the samples over
+    auto copy = arenaLine;
+    ASSERT_FALSE(copy.attached());
+    ASSERT_TRUE(arenaLine.attached());
+    ASSERT_EQ(arenaLine.memorySize(), copy.memorySize());
+    copy = arenaLine;
+    ASSERT_FALSE(copy.attached());
+    auto moved = std::move(arenaLine);
+    ASSERT_TRUE(moved.attached());
+    ASSERT_FLOAT_EQ(1.0f, moved(0.0f, 1, 0.0f));
+    DelayMemory copyMemory(8 * 1024);
+    copy.attach(copyMemory);
+    ASSERT_TRUE(copy.attached());
+    ASSERT_FLOAT_EQ(0.0f, copy(0.0f, 1, 0.0f));
+}
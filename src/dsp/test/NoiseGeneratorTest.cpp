@@ -1,6 +1,7 @@
 #include "dsp/NoiseGenerator.h"
 #include "dsp/UniformDistribution.h"
 #include <gtest/gtest.h>
+#include <vector>
 
 using namespace testing;
 using namespace dap;
@@ -22,3 +23,88 @@ TEST(NoiseGeneratorTest, normalized)
         ASSERT_LE(std::fabs(oneOverF3(g, NoiseGen::Color::OneOverF3)), 1.0f);
     }
 }
+
+TEST(NoiseGeneratorTest, seeded)
+{
+    // xoshiro128+ seeded by splitmix64, the first sample of each lane then the second ones
+    const float reference[] = {-0.43805194f,
+                               0.29453444f,
+                               0.04426074f,
+                               -0.62629771f,
+                               0.40546870f,
+                               0.05182433f,
+                               -0.89912951f,
+                               0.66771030f};
+    UniformDistribution rand(1);
+    for (float expected : reference)
+    {
+        ASSERT_FLOAT_EQ(expected, rand());
+    }
+
+    UniformDistribution a(42);
+    UniformDistribution b(42);
+    UniformDistribution c(42, 1);
+    size_t same = 0;
+    double sum   = 0.0;
+    double power = 0.0;
+    for (size_t n = 0; n < 100000; ++n)
+    {
+        const float x = a();
+        ASSERT_EQ(x, b());
+        ASSERT_GE(x, -1.0f);
+        ASSERT_LT(x, 1.0f);
+        same += x == c() ? 1 : 0;
+        sum += x;
+        power += x * x;
+    }
+    ASSERT_LT(same, 10u);
+    ASSERT_NEAR(0.0, sum / 100000.0, 0.01);
+    ASSERT_NEAR(1.0 / 3.0, power / 100000.0, 0.01);
+}
+
+TEST(NoiseGeneratorTest, fill)
+{
+    UniformDistribution a(7, 3);
+    UniformDistribution b(7, 3);
+    std::vector<float> block(200);
+    for (size_t frames : {1, 3, 64, 7, 200, 2})
+    {
+        a.fill(block.data(), frames);
+        for (size_t n = 0; n < frames; ++n)
+        {
+            ASSERT_EQ(b(), block[n]) << frames << " " << n;
+        }
+    }
+}
+
+TEST(NoiseGeneratorTest, block_matches_frames)
+{
+    using NoiseGen = NoiseGenerator<UniformDistribution>;
+    for (auto color : {NoiseGen::Color::White,
+                       NoiseGen::Color::Pink,
+                       NoiseGen::Color::Brown,
+                       NoiseGen::Color::OneOverF3})
+    {
+        NoiseGen frames(UniformDistribution(3));
+        NoiseGen blocks(UniformDistribution(3));
+        std::vector<float> gain(100);
+        std::vector<float> out(100);
+        for (size_t n = 0; n < gain.size(); ++n)
+        {
+            gain[n] = 0.01f * float(n);
+        }
+        for (size_t block = 0; block < 5; ++block)
+        {
+            blocks.process(out.data(), out.size(), gain.data(), color);
+            for (size_t n = 0; n < out.size(); ++n)
+            {
+                ASSERT_FLOAT_EQ(frames(gain[n], color), out[n]) << color << " " << n;
+            }
+            blocks.process(out.data(), out.size(), 0.5f, color);
+            for (size_t n = 0; n < out.size(); ++n)
+            {
+                ASSERT_FLOAT_EQ(frames(0.5f, color), out[n]) << color << " " << n;
+            }
+        }
+    }
+}
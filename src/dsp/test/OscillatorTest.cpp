@@ -0,0 +1,172 @@
+#include "dsp/Oscillator.h"
+#include "dsp/Pwm.h"
+#include <gtest/gtest.h>
+#include <array>
+#include <cmath>
+#include <vector>
+
+using namespace testing;
+using namespace dap;
+using namespace dap::dsp;
+using Shape    = OscillatorFunctions::Shape;
+using Accuracy = fastmath::approx::Accuracy;
+
+namespace
+{
+    // approximated oscillators accumulate the phases of a block before wrapping them
+    constexpr float samplerate = 48000.0f;
+    constexpr float frequency  = 1234.5f;
+
+    // power of the frequencies more than a few bins away from the harmonics of frequency relative
+    // to the power of the harmonics, in dB, measured on a Blackman-Harris window. The bins next to
+    // DC are left out, pulses having an offset.
+    double aliasing(const std::vector<float>& x)
+    {
+        const size_t size = x.size();
+        std::vector<double> windowed(size);
+        for (size_t n = 0; n < size; ++n)
+        {
+            const double w = 2.0 * M_PI * double(n) / double(size);
+            windowed[n] = x[n] * (0.35875 - 0.48829 * std::cos(w) + 0.14128 * std::cos(2.0 * w) -
+                                  0.01168 * std::cos(3.0 * w));
+        }
+        const double bin = samplerate / double(size);
+        double harmonics = 0.0;
+        double aliases   = 0.0;
+        for (size_t k = 4; k < size / 2; ++k)
+        {
+            double re = 0.0;
+            double im = 0.0;
+            for (size_t n = 0; n < size; ++n)
+            {
+                const double w = 2.0 * M_PI * double(k * n % size) / double(size);
+                re += windowed[n] * std::cos(w);
+                im -= windowed[n] * std::sin(w);
+            }
+            const double f        = double(k) * bin;
+            const double harmonic = std::round(f / frequency) * frequency;
+            (std::abs(f - harmonic) < 4.0 * bin ? harmonics : aliases) +=
+                re * re + im * im;
+        }
+        return 10.0 * std::log10(aliases / harmonics);
+    }
+    template <Antialiasing AA>
+    std::vector<float> render(Shape shape)
+    {
+        std::vector<float> x(2048);
+        Oscillator<float, Accuracy::Exact, AA> osc;
+        osc.process(x.data(), x.size(), 1.0f, frequency, 0.0f, samplerate, shape);
+        return x;
+    }
+    template <Antialiasing AA>
+    std::vector<float> renderPwm(float dutyCycle)
+    {
+        std::vector<float> x(2048);
+        Pwm<float, AA> pwm;
+        for (auto& y : x)
+        {
+            y = pwm(1.0f, frequency, 0.0f, samplerate, dutyCycle);
+        }
+        return x;
+    }
+
+    template <Accuracy A, Antialiasing AA = Antialiasing::None>
+    void assertBlockMatchesFrames(Shape shape, float tolerance)
+    {
+        constexpr size_t frames = 64;
+        std::array<float, frames> freq{};
+        std::array<float, frames> phase{};
+        for (size_t n = 0; n < frames; ++n)
+        {
+            freq[n]  = 440.0f + 100.0f * std::sin(0.1f * float(n));
+            phase[n] = 0.5f * std::cos(0.2f * float(n));
+        }
+        Oscillator<float, A, AA> frameOsc;
+        Oscillator<float, A, AA> blockOsc;
+        std::array<float, frames> fm{};
+        std::array<float, frames> pm{};
+        std::array<float, frames> held{};
+        blockOsc.process(fm.data(), frames, 0.5f, freq.data(), 0.0f, 44100.0f, shape);
+        blockOsc.process(pm.data(), frames, 0.5f, 220.0f, phase.data(), 44100.0f, shape);
+        blockOsc.process(held.data(), frames, 0.5f, 220.0f, 0.25f, 44100.0f, shape);
+        for (size_t n = 0; n < frames; ++n)
+        {
+            ASSERT_NEAR(frameOsc(0.5f, freq[n], 0.0f, 44100.0f, shape), fm[n], tolerance) << n;
+        }
+        for (size_t n = 0; n < frames; ++n)
+        {
+            ASSERT_NEAR(frameOsc(0.5f, 220.0f, phase[n], 44100.0f, shape), pm[n], tolerance) << n;
+        }
+        for (size_t n = 0; n < frames; ++n)
+        {
+            ASSERT_NEAR(frameOsc(0.5f, 220.0f, 0.25f, 44100.0f, shape), held[n], tolerance) << n;
+        }
+    }
+}
+
+TEST(OscillatorTest, block_matches_frames)
+{
+    for (auto shape : {Shape::Sine, Shape::Square, Shape::Saw, Shape::InverseSaw, Shape::Triangle})
+    {
+        assertBlockMatchesFrames<Accuracy::Exact>(shape, 0.0f);
+        assertBlockMatchesFrames<Accuracy::High>(shape, 1e-5f);
+        assertBlockMatchesFrames<Accuracy::Low>(shape, 1e-5f);
+        // the residuals are steep, they amplify the differences of the phases
+        assertBlockMatchesFrames<Accuracy::Exact, Antialiasing::PolyBlep>(shape, 1e-3f);
+        assertBlockMatchesFrames<Accuracy::High, Antialiasing::PolyBlep>(shape, 1e-3f);
+    }
+}
+
+TEST(OscillatorTest, approximated_sine)
+{
+    Oscillator<float, Accuracy::High> high;
+    Oscillator<float, Accuracy::Low> low;
+    for (size_t n = 0; n < 100; ++n)
+    {
+        // the phase accumulated in float drifts a little from the exact one
+        const double expected = std::sin(2.0 * M_PI * 1000.0 * double(n + 1) / 48000.0);
+        ASSERT_NEAR(expected, high(1.0f, 1000.0f, 0.0f, 48000.0f, Shape::Sine), 5e-6);
+        ASSERT_NEAR(expected, low(1.0f, 1000.0f, 0.0f, 48000.0f, Shape::Sine), 1.5e-4);
+    }
+}
+
+TEST(OscillatorTest, poly_blep_residuals)
+{
+    const float dt = 0.1f;
+    // the steps and corners are halfway at the discontinuity and the residuals vanish a frame
+    // away from it
+    ASSERT_FLOAT_EQ(-1.0f, BandLimitedFunctions::polyBlep(0.0f, dt));
+    ASSERT_FLOAT_EQ(0.0f, BandLimitedFunctions::polyBlep(dt, dt));
+    ASSERT_FLOAT_EQ(0.0f, BandLimitedFunctions::polyBlep(1.0f - dt, dt));
+    ASSERT_NEAR(1.0f, BandLimitedFunctions::polyBlep(0.99999f, dt), 1e-3f);
+    ASSERT_FLOAT_EQ(1.0f / 6.0f, BandLimitedFunctions::polyBlamp(0.0f, dt));
+    ASSERT_FLOAT_EQ(0.0f, BandLimitedFunctions::polyBlamp(dt, dt));
+    ASSERT_NEAR(1.0f / 6.0f, BandLimitedFunctions::polyBlamp(0.99999f, dt), 1e-3f);
+
+    ASSERT_FLOAT_EQ(0.0f, BandLimitedFunctions::saw(0.0f, dt));
+    ASSERT_FLOAT_EQ(0.0f, BandLimitedFunctions::square(0.5f, dt));
+    ASSERT_FLOAT_EQ(0.5f, BandLimitedFunctions::pwm(0.25f, dt, 0.25f));
+    ASSERT_FLOAT_EQ(0.6f, BandLimitedFunctions::saw(0.2f, dt));
+    ASSERT_FLOAT_EQ(-0.2f, BandLimitedFunctions::triangle(0.2f, dt));
+
+    using Pack = fastmath::Pack<float, 4>;
+    const Pack t(0.0f, 0.05f, 0.5f, 0.97f);
+    const Pack saw = BandLimitedFunctions::saw(t, Pack(dt));
+    for (size_t i = 0; i < 4; ++i)
+    {
+        ASSERT_FLOAT_EQ(BandLimitedFunctions::saw(t[i], dt), saw[i]);
+    }
+}
+
+TEST(OscillatorTest, band_limited_shapes_alias_less)
+{
+    for (auto shape : {Shape::Square, Shape::Saw, Shape::InverseSaw, Shape::Triangle})
+    {
+        const double naive       = aliasing(render<Antialiasing::None>(shape));
+        const double bandLimited = aliasing(render<Antialiasing::PolyBlep>(shape));
+        ASSERT_LT(bandLimited, naive - 10.0) << shape;
+    }
+    const double naive       = aliasing(renderPwm<Antialiasing::None>(0.3f));
+    const double bandLimited = aliasing(renderPwm<Antialiasing::PolyBlep>(0.3f));
+    ASSERT_LT(bandLimited, naive - 10.0);
+}
@@ -0,0 +1,156 @@
+#include "dsp/WavetableFile.h"
+#include "dsp/WavetableOscillator.h"
+#include <gtest/gtest.h>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+using namespace testing;
+using namespace dap;
+using namespace dap::dsp;
+
+namespace
+{
+    using wavetable_t = Wavetable<float, 2048>;
+
+    template <Interpolation I>
+    void assertSine(float tolerance)
+    {
+        WavetableOscillator<float, 2048, I> osc(wavetable_t::fromHarmonics({{1.0f}}));
+        NormalizedPhasor<float> phasor;
+        for (size_t n = 0; n < 1000; ++n)
+        {
+            const double expected = std::sin(2.0 * M_PI * double(phasor(1000.0f, 48000.0f)));
+            ASSERT_NEAR(expected, osc(1.0f, 1000.0f, 0.0f, 48000.0f, 0.0f), tolerance) << n;
+        }
+    }
+}
+
+TEST(WavetableTest, sine)
+{
+    assertSine<Interpolation::Linear>(2e-6f);
+    assertSine<Interpolation::Cubic>(2e-7f);
+}
+
+TEST(WavetableTest, mipmaps)
+{
+    // level 0 holds the harmonics up to 1024, level 1 up to 512
+    std::vector<float> amplitudes(600, 0.0f);
+    amplitudes[0]   = 1.0f;
+    amplitudes[599] = 1.0f;
+    const auto wavetable = wavetable_t::fromHarmonics({amplitudes});
+    ASSERT_EQ(11u, wavetable_t::levels);
+    for (size_t n = 0; n < 2048; ++n)
+    {
+        const double t = double(n) / 2048.0;
+        ASSERT_NEAR(std::sin(2.0 * M_PI * t) + std::sin(2.0 * M_PI * 600.0 * t),
+                    wavetable->table(0, 0)[n],
+                    1e-5);
+        ASSERT_NEAR(std::sin(2.0 * M_PI * t), wavetable->table(0, 1)[n], 1e-5);
+    }
+
+    ASSERT_EQ(0u, wavetable_t::level(0.0f));
+    ASSERT_EQ(0u, wavetable_t::level(0.4f / 2048.0f));
+    ASSERT_EQ(5u, wavetable_t::level(0.01f));
+    ASSERT_EQ(10u, wavetable_t::level(0.4f));
+    for (float dt : {0.001f, 0.01f, 0.1f, 0.3f})
+    {
+        const size_t harmonics = 2048 >> (wavetable_t::level(dt) + 1);
+        ASSERT_LE(float(harmonics) * dt, 0.5f);
+    }
+}
+
+TEST(WavetableTest, morphing)
+{
+    const auto wavetable = wavetable_t::fromHarmonics({{1.0f}, {0.0f, 1.0f}});
+    ASSERT_EQ(2u, wavetable->frames());
+    WavetableOscillator<float> osc(wavetable);
+    for (size_t n = 0; n < 100; ++n)
+    {
+        const double t = 100.0 * double(n + 1) / 48000.0;
+        ASSERT_NEAR(0.5 * std::sin(2.0 * M_PI * t) + 0.5 * std::sin(4.0 * M_PI * t),
+                    osc(1.0f, 100.0f, 0.0f, 48000.0f, 0.5f),
+                    1e-5);
+    }
+}
+
+TEST(WavetableTest, cycles)
+{
+    // cycles of 600 samples are resampled to 2048 samples without their DC offset
+    std::vector<double> cycles(1200);
+    for (size_t n = 0; n < 600; ++n)
+    {
+        const double t = double(n) / 600.0;
+        cycles[n]       = 0.25 + std::sin(2.0 * M_PI * t) + 0.5 * std::cos(6.0 * M_PI * t);
+        cycles[n + 600] = std::sin(4.0 * M_PI * t);
+    }
+    const auto wavetable = Wavetable<double>::fromCycles(cycles.data(), 2, 600);
+    for (size_t n = 0; n < 2048; ++n)
+    {
+        const double t = double(n) / 2048.0;
+        ASSERT_NEAR(std::sin(2.0 * M_PI * t) + 0.5 * std::cos(6.0 * M_PI * t),
+                    wavetable->table(0, 0)[n],
+                    1e-9);
+        ASSERT_NEAR(std::sin(4.0 * M_PI * t), wavetable->table(1, 0)[n], 1e-9);
+    }
+}
+
+TEST(WavetableTest, shared_pool)
+{
+    const auto wavetable = wavetable_t::fromHarmonics({{1.0f}, {0.5f, 0.5f}});
+    ASSERT_EQ(0u, reinterpret_cast<std::uintptr_t>(wavetable->data()) % 64);
+    std::vector<WavetableOscillator<float>> voices(8, WavetableOscillator<float>(wavetable));
+    ASSERT_EQ(9, wavetable.use_count());
+    ASSERT_EQ(wavetable.get(), voices.back().wavetable().get());
+
+    WavetableOscillator<float> silent;
+    ASSERT_EQ(0.0f, silent(1.0f, 440.0f, 0.0f, 48000.0f, 0.0f));
+}
+
+TEST(WavetableTest, block_matches_frames)
+{
+    constexpr size_t frames = 64;
+    std::array<float, frames> freq{};
+    std::array<float, frames> position{};
+    for (size_t n = 0; n < frames; ++n)
+    {
+        freq[n]     = 440.0f + 100.0f * std::sin(0.1f * float(n));
+        position[n] = float(n) / float(frames);
+    }
+    const auto wavetable = wavetable_t::fromHarmonics({{1.0f}, {0.2f, 0.3f, 0.4f}});
+    WavetableOscillator<float, 2048, Interpolation::Cubic> frameOsc(wavetable);
+    WavetableOscillator<float, 2048, Interpolation::Cubic> blockOsc(wavetable);
+    std::array<float, frames> out{};
+    blockOsc.process(out.data(), frames, 0.5f, freq.data(), 0.0f, 44100.0f, position.data());
+    for (size_t n = 0; n < frames; ++n)
+    {
+        ASSERT_NEAR(frameOsc(0.5f, freq[n], 0.0f, 44100.0f, position[n]), out[n], 1e-5f) << n;
+    }
+}
+
+TEST(WavetableTest, load)
+{
+    const char* path = "wavetable.wav";
+    {
+        std::vector<float> cycles(2 * 256 + 10);
+        for (size_t n = 0; n < 256; ++n)
+        {
+            cycles[n]       = 0.5f * std::sin(2.0f * float(M_PI) * float(n) / 256.0f);
+            cycles[n + 256] = 0.5f * std::sin(6.0f * float(M_PI) * float(n) / 256.0f);
+        }
+        SndfileHandle file(path, SFM_WRITE, SF_FORMAT_WAV | SF_FORMAT_PCM_16, 1, 48000);
+        file.writef(cycles.data(), sf_count_t(cycles.size()));
+    }
+    const auto wavetable = loadWavetable<float, 1024>(path, 256);
+    std::remove(path);
+    ASSERT_EQ(2u, wavetable->frames());
+    for (size_t n = 0; n < 1024; ++n)
+    {
+        const double t = double(n) / 1024.0;
+        ASSERT_NEAR(0.5 * std::sin(2.0 * M_PI * t), wavetable->table(0, 0)[n], 1e-3);
+        ASSERT_NEAR(0.5 * std::sin(6.0 * M_PI * t), wavetable->table(1, 0)[n], 1e-3);
+    }
+    ASSERT_THROW(loadWavetable<float>("missing.wav"), std::runtime_error);
+}
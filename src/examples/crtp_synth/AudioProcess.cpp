@@ -19,8 +19,7 @@ AudioProcess::AudioProcess(int32_t outputId,
 AudioProcess::~AudioProcess() = default;
 bool AudioProcess::process()
 {
-    _MM_SET_FLUSH_ZERO_MODE(_MM_FLUSH_ZERO_ON);
-    _MM_SET_DENORMALS_ZERO_MODE(_MM_DENORMALS_ZERO_ON);
+    dap::flushDenormalsToZero();
 
     m_synth.process();
     const auto& buf = m_synth.output();
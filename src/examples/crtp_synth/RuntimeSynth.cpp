@@ -0,0 +1,128 @@
+#include "RuntimeSynth.h"
+
+using crtp_synth::RuntimeSynth;
+using dap::runtime::Graph;
+
+namespace
+{
+    using NodeId = Graph::NodeId;
+
+    NodeId control(Graph& graph, float value)
+    {
+        const auto id = graph.add("Control");
+        graph.set(id, "value", value);
+        return id;
+    }
+
+    float shape(crtp_synth::osc_shape_t s)
+    {
+        return static_cast<float>(static_cast<int>(s));
+    }
+
+    // oscillator whose gain, frequency and phase are controls
+    NodeId controlOsc(Graph& graph, float gain, float frequency, float phase, float samplerate)
+    {
+        const auto osc = graph.add("Oscillator");
+        graph.connect(control(graph, gain), osc, "gain");
+        graph.connect(control(graph, frequency), osc, "frequency");
+        graph.connect(control(graph, phase), osc, "phase");
+        graph.set(osc, "samplerate", samplerate);
+        graph.set(osc, "shape", shape(crtp_synth::osc_shape_t::Sine));
+        return osc;
+    }
+
+    struct OscSettings
+    {
+        float gain;
+        float frequency;
+        float phase;
+    };
+
+    // am_fm_t: the gain is modulated by am and the portamento frequency by fm
+    NodeId amFmOsc(Graph& graph,
+                   const OscSettings& am,
+                   const OscSettings& fm,
+                   const OscSettings& carrier,
+                   size_t portamento,
+                   float samplerate)
+    {
+        const auto gain = graph.add("Add");
+        graph.connect(controlOsc(graph, am.gain, am.frequency, am.phase, samplerate), gain, "x");
+        graph.connect(control(graph, carrier.gain), gain, "y");
+
+        const auto smoother = graph.add("Smoother");
+        graph.set(smoother, "value", carrier.frequency);
+        graph.set(smoother, "duration", float(portamento));
+        const auto frequency = graph.add("Add");
+        graph.connect(controlOsc(graph, fm.gain, fm.frequency, fm.phase, samplerate), frequency, "x");
+        graph.connect(smoother, frequency, "y");
+
+        const auto osc = graph.add("Oscillator");
+        graph.connect(gain, osc, "gain");
+        graph.connect(frequency, osc, "frequency");
+        graph.connect(control(graph, carrier.phase), osc, "phase");
+        graph.set(osc, "samplerate", samplerate);
+        graph.set(osc, "shape", shape(crtp_synth::osc_shape_t::Sine));
+        return osc;
+    }
+
+    NodeId bus(Graph& graph, NodeId signal, float gain)
+    {
+        const auto id = graph.add("Bus");
+        graph.connect(control(graph, gain), id, "gain");
+        graph.connect(signal, id, "signal");
+        return id;
+    }
+}
+
+RuntimeSynth::RuntimeSynth(size_t bufferSize, scalar_t samplerate)
+: m_output(1, bufferSize, 0.0f)
+{
+    swap(makeGraph(bufferSize, samplerate));
+}
+
+std::unique_ptr<Graph> RuntimeSynth::makeGraph(size_t bufferSize, scalar_t samplerate)
+{
+    auto graph = std::make_unique<Graph>();
+    auto& g    = *graph;
+
+    // same settings as Synth
+    const auto osc5 = amFmOsc(g,
+                              {1.0f, 4.0f, 0.0f},
+                              {500.0f, 220.0f, 0.0f},
+                              {0.5f, 440.0f, 0.0f},
+                              bufferSize,
+                              samplerate);
+    const auto osc6 = amFmOsc(g,
+                              {1.0f, 55.0f, float(M_PI / 2.0)},
+                              {150.0f, 220.0f, float(M_PI / 4.0)},
+                              {0.5f, 329.63f, 0.0f},
+                              bufferSize,
+                              samplerate);
+    const auto noise = g.add("NoiseGenerator");
+    g.connect(control(g, 1.0f), noise, "gain");
+    g.set(noise, "color", static_cast<float>(static_cast<int>(noise_gen_t::Color::Pink)));
+
+    const auto mixer = g.add("Mixer", 3);
+    g.connect(bus(g, osc5, 1.0f), mixer, 0);
+    g.connect(bus(g, osc6, 1.0f), mixer, 1);
+    g.connect(bus(g, noise, 1.0f), mixer, 2);
+
+    const auto filter = g.add("LadderFilter");
+    g.connect(mixer, filter, "signal");
+    g.connect(control(g, 500.0f), filter, "frequency");
+    g.connect(control(g, 3.5f), filter, "resonance");
+    g.set(filter, "samplerate", samplerate);
+
+    const auto phaser = g.add("Phaser");
+    g.connect(filter, phaser, "signal");
+    g.connect(control(g, 0.1f), phaser, "frequency");
+    g.connect(control(g, 0.5f), phaser, "depth");
+    g.connect(control(g, 1.0f), phaser, "feedback");
+    g.connect(control(g, 0.9f), phaser, "wet");
+    g.set(phaser, "samplerate", samplerate);
+
+    g.setOutput(phaser);
+    g.compile();
+    return graph;
+}
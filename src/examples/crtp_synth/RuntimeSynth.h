@@ -0,0 +1,40 @@
+#ifndef DAP_EXAMPLES_CRTP_SYNTH_RUNTIME_SYNTH_H
+#define DAP_EXAMPLES_CRTP_SYNTH_RUNTIME_SYNTH_H
+
+#include "Types.h"
+#include "fastmath/AudioBuffer.h"
+#include "runtime/Engine.h"
+
+namespace crtp_synth
+{
+    class RuntimeSynth;
+}
+
+// the patch of Synth built at runtime out of dap::runtime processors
+class crtp_synth::RuntimeSynth final
+{
+    using buffer_t = dap::fastmath::AudioBuffer<float>;
+
+    buffer_t m_output;
+    dap::runtime::Engine m_engine;
+
+public:
+    RuntimeSynth(size_t bufferSize, scalar_t samplerate);
+    // builds the patch, may be called from any thread but the audio one
+    static std::unique_ptr<dap::runtime::Graph> makeGraph(size_t bufferSize, scalar_t samplerate);
+    // replaces the patch playing, crossfading to the new one
+    dap::runtime::Graph& swap(std::unique_ptr<dap::runtime::Graph> graph)
+    {
+        return m_engine.swap(std::move(graph));
+    }
+    void process()
+    {
+        m_engine.process(m_output.channel(0).data(), m_output.channelSize());
+    }
+    const buffer_t& output() const
+    {
+        return m_output;
+    }
+};
+
+#endif // DAP_EXAMPLES_CRTP_SYNTH_RUNTIME_SYNTH_H
@@ -86,6 +86,9 @@ Synth::Synth(size_t bufferSize, scalar_t samplerate)
     This["/synth/set/osc4/shape"_s] = osc_shape_t::Sine;
 
     setSamplerate(samplerate);
+    dap::crtp::attachDelayMemory(m_delayMemory, m_graph);
+    // the schedule takes the processors over once configured
+    m_schedule.emplace(m_graph);
     // dap::crtp::NodeVisitor<dap::crtp::InputNamesPrinter>()(m_graph); // TODO: seems broken for
     // mixer processor
 }
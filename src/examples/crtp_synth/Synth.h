@@ -2,8 +2,12 @@
 #define DAP_EXAMPLES_CRTP_SYNTH_SYNTH_H
 
 #include "Types.h"
+#include "crtp/utility/DelayMemory.h"
+#include "crtp/utility/ProfileReporter.h"
+#include "crtp/utility/WorkerPoolSetter.h"
 #include "base/KeyValueTuple.h"
 #include "fastmath/AudioBuffer.h"
+#include <optional>
 
 namespace crtp_synth
 {
@@ -57,9 +61,14 @@ namespace crtp_synth
 class crtp_synth::Synth final
 {
     using buffer_t = dap::fastmath::AudioBuffer<float>;
+    using graph_t  = phaser_t<filter_t<parallel_mixer_t<am_fm_t, am_fm_t, noise_t>>>;
 
     buffer_t m_output;
-    phaser_t<filter_t<mixer_t<am_fm_t, am_fm_t, noise_t>>> m_graph;
+    graph_t m_graph;
+    // samples of the delay lines of the graph, attached at construction
+    dap::dsp::DelayMemory m_delayMemory;
+    // renders the graph serially, holding its processors, unless the buses run on a worker pool
+    std::optional<dap::crtp::StaticSchedule<graph_t>> m_schedule;
 
     auto params()
     {
@@ -132,22 +141,51 @@ class crtp_synth::Synth final
     }
 
 public:
+    // nodes the graph optimizer would eliminate from the graph
+    using optimization_report_t = dap::crtp::OptimizationReport<graph_t>;
+
     Synth(size_t bufferSize, scalar_t samplerate);
     void setSamplerate(scalar_t samplerate);
+    // renders the mixer buses on pool, nullptr renders them serially
+    void setWorkerPool(dap::threadsafe::WorkerPool* pool)
+    {
+        dap::crtp::setWorkerPool(m_graph, pool);
+        if (pool != nullptr)
+        {
+            // gives the processors back to the graph
+            m_schedule.reset();
+        }
+        else if (!m_schedule)
+        {
+            m_schedule.emplace(m_graph);
+        }
+    }
     void process()
     {
-#if defined(__clang__)
-#pragma clang loop unroll_count(16)
-#endif
-        for (auto& x : m_output.channel(0))
+        if (m_schedule)
         {
-            x = m_graph();
+            m_schedule->process(m_output.channel(0).data(), m_output.channelSize());
+        }
+        else
+        {
+            m_graph.process(m_output.channel(0).data(), m_output.channelSize());
         }
     }
     const buffer_t& output() const
     {
         return m_output;
     }
+    // cost of each processor node, nothing is printed unless nodes are profiled, e.g. when
+    // building with DAP_PROFILE_NODES
+    void printProfile(std::ostream& out)
+    {
+        dap::crtp::printProfile(out, m_graph);
+    }
+    // delay memory of each processor of the graph holding delay lines, and in total
+    void printDelayMemory(std::ostream& out)
+    {
+        dap::crtp::printDelayMemory(out, m_graph);
+    }
     template <char... Chars>
     auto& operator[](dap::constexpr_string<Chars...> key)
     {
@@ -1,7 +1,10 @@
 #ifndef DAP_EXAMPLES_CRTP_SYNTH_TYPES_H
 #define DAP_EXAMPLES_CRTP_SYNTH_TYPES_H
 
+#include "crtp/nodes/Optimizer.h"
+#include "crtp/nodes/Parallel.h"
 #include "crtp/nodes/Processor.h"
+#include "crtp/utility/StaticSchedule.h"
 
 #include "dsp/CombFilter.h"
 #include "dsp/LadderFilter.h"
@@ -14,6 +17,8 @@
 
 namespace crtp_synth
 {
+    using dap::crtp::control_rate;
+    using dap::crtp::parallel_join;
     using dap::crtp::processor;
 
     using dap::operator""_s;
@@ -27,14 +32,25 @@ namespace crtp_synth
             "value"_s,
             "duration"_s));
 
-    using control_t = decltype(
-        processor<dap::dsp::FixedSmoother<scalar_t, smoothing_samples_t::value>>::with_inputs<
-            scalar_t>::named("value"_s));
+    // controls are smoothed and evaluated once every control_divisor_t samples, the smoother
+    // runs at control rate so its length is scaled down accordingly
+    using control_divisor_t = std::integral_constant<size_t, 16>;
+    using smoother_t        = decltype(
+        processor<dap::dsp::FixedSmoother<scalar_t,
+                                          smoothing_samples_t::value / control_divisor_t::value>>::
+            with_inputs<scalar_t>::named("value"_s));
+    using control_t = control_rate<smoother_t,
+                                   control_divisor_t::value,
+                                   dap::crtp::ControlInterpolation::Linear>;
 
-    using osc_shape_t = dap::dsp::OscillatorFunctions::Shape;
+    // the oscillators, filters and phasers compute their transcendental functions with the
+    // polynomial approximations of fastmath/Approx.h
+    using accuracy_t   = dap::fastmath::approx::Accuracy;
+    using osc_shape_t  = dap::dsp::OscillatorFunctions::Shape;
+    using oscillator_t = dap::dsp::Oscillator<scalar_t, accuracy_t::High>;
     template <typename Amp, typename Freq, typename Ph>
     using osc_t =
-        decltype(processor<dap::dsp::Oscillator<scalar_t>>::
+        decltype(processor<oscillator_t>::
                      with_inputs<Amp, Freq, Ph, samplerate_t, osc_shape_t>::named("gain"_s,
                                                                                   "frequency"_s,
                                                                                   "phase"_s,
@@ -53,14 +69,17 @@ namespace crtp_synth
         processor<noise_gen_t>::with_inputs<control_t, noise_gen_t::Color>::named("gain"_s,
                                                                                   "color"_s));
 
+    // the delay line takes its samples from the DelayMemory of the graph holding the flanger.
+    // Before that memory is attached, give the line its maximum delay with
+    // dap::crtp::setMaxDelay(flanger, max_delay_t::value), see crtp/utility/DelayMemory.h
     template <typename T>
     using flanger_t = decltype(
-        processor<dap::dsp::FeedbackCombFilter<scalar_t, max_delay_t::value>>::
+        processor<dap::dsp::FeedbackCombFilter<scalar_t, dap::dsp::dynamic_delay>>::
             with_inputs<T, mod_control_t, control_t>::named("signal"_s, "delay"_s, "feedback"_s));
 
     template <typename T>
     using phaser_t = decltype(
-        processor<dap::dsp::Phaser<scalar_t>>::
+        processor<dap::dsp::Phaser<scalar_t, 16, accuracy_t::High>>::
             with_inputs<T, control_t, control_t, control_t, control_t, samplerate_t>::named(
                 "signal"_s,
                 "frequency"_s,
@@ -71,7 +90,7 @@ namespace crtp_synth
 
     template <typename T>
     using filter_t =
-        decltype(processor<dap::dsp::LadderFilter<scalar_t>>::
+        decltype(processor<dap::dsp::LadderFilter<scalar_t, std::ratio<0>, accuracy_t::High>>::
                      with_inputs<T, control_t, control_t, samplerate_t>::named("signal"_s,
                                                                                "frequency"_s,
                                                                                "resonance"_s,
@@ -84,6 +103,10 @@ namespace crtp_synth
     template <typename... Ts>
     using mixer_t =
         decltype(processor<dap::dsp::Mixer>::with_inputs<bus_t<Ts>...>::prefixed_by("bus_"_s));
+
+    // renders its buses concurrently once given a worker pool
+    template <typename... Ts>
+    using parallel_mixer_t = parallel_join<mixer_t<Ts...>>;
 }
 
 #endif // DAP_EXAMPLES_CRTP_SYNTH_SYNTH_H
@@ -1,4 +1,5 @@
 #include <benchmark/benchmark.h>
+#include "../RuntimeSynth.h"
 #include "../Synth.h"
 
 static crtp_synth::Synth synth(512, 48000.0f);
@@ -12,4 +13,29 @@ static void BM_Synth(benchmark::State& state)
 }
 BENCHMARK(BM_Synth);
 
+// the mixer has three buses, the calling thread renders one of them so more than two workers
+// would only spin
+static void BM_ParallelSynth(benchmark::State& state)
+{
+    dap::threadsafe::WorkerPool pool(static_cast<size_t>(state.range(0)));
+    synth.setWorkerPool(&pool);
+    for (auto _ : state)
+    {
+        synth.process();
+    }
+    synth.setWorkerPool(nullptr);
+}
+BENCHMARK(BM_ParallelSynth)->Arg(1)->Arg(2)->UseRealTime();
+
+// same patch built at runtime, it should stay within 1.5x of BM_Synth
+static void BM_RuntimeSynth(benchmark::State& state)
+{
+    static crtp_synth::RuntimeSynth runtimeSynth(512, 48000.0f);
+    for (auto _ : state)
+    {
+        runtimeSynth.process();
+    }
+}
+BENCHMARK(BM_RuntimeSynth);
+
 BENCHMARK_MAIN();
@@ -1,5 +1,6 @@
 #include "AudioProcess.h"
 #include "OscEventSystem.h"
+#include "Synth.h"
 #include "audioio/AudioDeviceList.h"
 #include <cassert>
 #include <thread>
@@ -29,6 +30,7 @@ int main()
 
     std::cout << "deviceId: " << deviceId << " bufferSize: " << bufferSize
               << " sampleRate: " << sampleRate << " channelCount: " << channelCount << std::endl;
+    std::cout << "synth graph " << crtp_synth::Synth::optimization_report_t{} << std::endl;
 
     crtp_synth::AudioProcess process(deviceId, channelCount, bufferSize, sampleRate);
     crtp_synth::OscEventSystem eventSystem(process);
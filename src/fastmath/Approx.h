@@ -0,0 +1,480 @@
+#ifndef DAP_FASTMATH_APPROX_H
+#define DAP_FASTMATH_APPROX_H
+
+#include "Pack.h"
+#include "base/TypeTraits.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+// Polynomial and rational approximations of transcendental functions, cheaper than libm and
+// written with arithmetic, floor, abs, min, max and select so that loops over them vectorize and T
+// may be a fastmath::Pack, exponents being read and written lane by lane. Accuracy selects a tier,
+// each function documents the maximum error of its tiers, absolute unless stated otherwise.
+
+namespace dap
+{
+    namespace fastmath
+    {
+        template <typename T, typename Allocator>
+        class Array;
+
+        namespace approx
+        {
+            enum class Accuracy
+            {
+                Low,
+                Medium,
+                High,
+                Exact, // libm
+            };
+
+            namespace detail
+            {
+                template <Accuracy A>
+                struct SinePolynomial;
+                template <Accuracy A>
+                struct Exp2Polynomial;
+                template <Accuracy A>
+                struct Log2Polynomial;
+            }
+
+            // sine of x radians, max error: Low 1.4e-4, Medium 1.5e-6, High 1.2e-8 (float results
+            // are limited by their precision, about 3e-7)
+            template <Accuracy A, typename T>
+            inline T sin(T x);
+            // cosine of x radians, same errors as sin
+            template <Accuracy A, typename T>
+            inline T cos(T x);
+            // sine of 2 pi t, i.e. of t turns, same errors as sin without the reduction of x
+            template <Accuracy A, typename T>
+            inline T sin2pi(T t);
+            // tangent of x radians, sin / cos, max relative error for |x| < 1.5: Low 1e-4, Medium
+            // 2.3e-6, High 1.2e-8
+            template <Accuracy A, typename T>
+            inline T tan(T x);
+            // 2^x, max relative error: Low 1.1e-4, Medium 3.8e-6, High 2.7e-9. x is clamped to
+            // the range of normal exponents of T.
+            template <Accuracy A, typename T>
+            inline T exp2(T x);
+            // e^x, exp2(x log2(e)), same errors as exp2 plus the rounding of x log2(e)
+            template <Accuracy A, typename T>
+            inline T exp(T x);
+            // base 2 logarithm of normal x > 0, max error: Low 1.1e-5, Medium 6.1e-8, High 4.3e-10
+            template <Accuracy A, typename T>
+            inline T log2(T x);
+            // hyperbolic tangent, max error: Low 7.1e-5 (rational Pade [7/6] approximant), Medium
+            // 1.8e-6, High 1.3e-9 (from exp2)
+            template <Accuracy A, typename T>
+            inline T tanh(T x);
+
+            // coefficient-wise versions of the functions above on arrays, result may be x, e.g.
+            // void sin<A>(T* result, const T* x, size_t size) and
+            // void sin<A>(Array<T, Allocator>& result, const Array<T, Allocator>& x)
+        }
+    }
+}
+
+// odd minimax polynomials of sin(2 pi z) for z in [-1/4, 1/4]
+template <>
+struct dap::fastmath::approx::detail::SinePolynomial<dap::fastmath::approx::Accuracy::Low>
+{
+    template <typename T>
+    static inline T eval(T z)
+    {
+        using S    = lane_scalar_t<T>;
+        const T z2 = z * z;
+        return z * (S(6.282562617053e+00) +
+                    z2 * (S(-4.115426959370e+01) + z2 * S(7.413228369298e+01)));
+    }
+};
+template <>
+struct dap::fastmath::approx::detail::SinePolynomial<dap::fastmath::approx::Accuracy::Medium>
+{
+    template <typename T>
+    static inline T eval(T z)
+    {
+        using S    = lane_scalar_t<T>;
+        const T z2 = z * z;
+        return z * (S(6.283182910317e+00) +
+                    z2 * (S(-4.133966881548e+01) +
+                          z2 * (S(8.141552057369e+01) + z2 * S(-7.161031308553e+01))));
+    }
+};
+template <>
+struct dap::fastmath::approx::detail::SinePolynomial<dap::fastmath::approx::Accuracy::High>
+{
+    template <typename T>
+    static inline T eval(T z)
+    {
+        using S    = lane_scalar_t<T>;
+        const T z2 = z * z;
+        return z * (S(6.283185301891e+00) +
+                    z2 * (S(-4.134169186436e+01) +
+                          z2 * (S(8.160326572990e+01) +
+                                z2 * (S(-7.659820794508e+01) + z2 * S(3.987323195632e+01)))));
+    }
+};
+
+// minimax polynomials of 2^f for f in [-1/2, 1/2]
+template <>
+struct dap::fastmath::approx::detail::Exp2Polynomial<dap::fastmath::approx::Accuracy::Low>
+{
+    template <typename T>
+    static inline T eval(T f)
+    {
+        using S = lane_scalar_t<T>;
+        return S(9.999245116872e-01) +
+               f * (S(6.931053257378e-01) +
+                    f * (S(2.426397198291e-01) + f * S(5.600580501397e-02)));
+    }
+};
+template <>
+struct dap::fastmath::approx::detail::Exp2Polynomial<dap::fastmath::approx::Accuracy::Medium>
+{
+    template <typename T>
+    static inline T eval(T f)
+    {
+        using S = lane_scalar_t<T>;
+        return S(1.000000151035e+00) +
+               f * (S(6.931210410988e-01) +
+                    f * (S(2.402186565087e-01) +
+                         f * (S(5.592198376773e-02) + f * S(9.685704667211e-03))));
+    }
+};
+template <>
+struct dap::fastmath::approx::detail::Exp2Polynomial<dap::fastmath::approx::Accuracy::High>
+{
+    template <typename T>
+    static inline T eval(T f)
+    {
+        using S = lane_scalar_t<T>;
+        return S(9.999999999191e-01) +
+               f * (S(6.931472067018e-01) +
+                    f * (S(2.402265150481e-01) +
+                         f * (S(5.550327232521e-02) +
+                              f * (S(9.617994541174e-03) +
+                                   f * (S(1.340042496513e-03) + f * S(1.547801479753e-04))))));
+    }
+};
+
+// odd minimax polynomials of log2((1 + s) / (1 - s)) for s in [0, (sqrt(2) - 1) / (sqrt(2) + 1)]
+template <>
+struct dap::fastmath::approx::detail::Log2Polynomial<dap::fastmath::approx::Accuracy::Low>
+{
+    template <typename T>
+    static inline T eval(T s)
+    {
+        using S = lane_scalar_t<T>;
+        return s * (S(2.885261698346e+00) + s * s * S(9.835111092633e-01));
+    }
+};
+template <>
+struct dap::fastmath::approx::detail::Log2Polynomial<dap::fastmath::approx::Accuracy::Medium>
+{
+    template <typename T>
+    static inline T eval(T s)
+    {
+        using S    = lane_scalar_t<T>;
+        const T s2 = s * s;
+        return s * (S(2.885390465603e+00) +
+                    s2 * (S(9.615521532786e-01) + s2 * S(5.973609367784e-01)));
+    }
+};
+template <>
+struct dap::fastmath::approx::detail::Log2Polynomial<dap::fastmath::approx::Accuracy::High>
+{
+    template <typename T>
+    static inline T eval(T s)
+    {
+        using S    = lane_scalar_t<T>;
+        const T s2 = s * s;
+        return s * (S(2.885390080791e+00) +
+                    s2 * (S(9.617984707331e-01) +
+                          s2 * (S(5.767285463375e-01) + s2 * S(4.317292114053e-01))));
+    }
+};
+
+namespace dap
+{
+    namespace fastmath
+    {
+        namespace approx
+        {
+            namespace detail
+            {
+                template <typename T>
+                using bits_t = std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>;
+                template <typename T>
+                constexpr int mantissaBits = std::numeric_limits<T>::digits - 1;
+                template <typename T>
+                constexpr int exponentBias = std::numeric_limits<T>::max_exponent - 1;
+
+                // 2^k for integral k within the range of normal exponents, from its exponent bits
+                template <typename T>
+                inline T pow2(T k)
+                {
+                    if constexpr (isPacked<T>())
+                    {
+                        return k.map([](lane_scalar_t<T> lane) { return pow2(lane); });
+                    }
+                    else
+                    {
+                        const auto bits = bits_t<T>(int64_t(k) + exponentBias<T>)
+                                          << mantissaBits<T>;
+                        T x;
+                        std::memcpy(&x, &bits, sizeof(T));
+                        return x;
+                    }
+                }
+                // exponent e of normal x = m 2^e with m in [1, 2)
+                template <typename T>
+                inline T exponent(T x)
+                {
+                    if constexpr (isPacked<T>())
+                    {
+                        return x.map([](lane_scalar_t<T> lane) { return exponent(lane); });
+                    }
+                    else
+                    {
+                        bits_t<T> bits;
+                        std::memcpy(&bits, &x, sizeof(T));
+                        const auto biased = int64_t(bits >> mantissaBits<T>) &
+                                            int64_t(2 * exponentBias<T> + 1);
+                        return T(biased - exponentBias<T>);
+                    }
+                }
+                // mantissa m in [1, 2) of normal x = m 2^e
+                template <typename T>
+                inline T mantissa(T x)
+                {
+                    if constexpr (isPacked<T>())
+                    {
+                        return x.map([](lane_scalar_t<T> lane) { return mantissa(lane); });
+                    }
+                    else
+                    {
+                        constexpr auto fraction = (bits_t<T>(1) << mantissaBits<T>) - 1;
+                        constexpr auto one      = bits_t<T>(exponentBias<T>) << mantissaBits<T>;
+                        bits_t<T> bits;
+                        std::memcpy(&bits, &x, sizeof(T));
+                        bits = (bits & fraction) | one;
+                        std::memcpy(&x, &bits, sizeof(T));
+                        return x;
+                    }
+                }
+
+                // x in turns reduced to [-1/2, 1/2], 2 pi being split in two so that the
+                // multiple of the period subtracted from x is exact
+                template <typename T>
+                inline T turns(T x)
+                {
+                    using std::floor;
+                    using S   = lane_scalar_t<T>;
+                    const T k = floor(x * S(0.5 / M_PI) + S(0.5));
+                    const T r = (x - k * S(6.28125)) - k * S(2.0 * M_PI - 6.28125);
+                    return r * S(0.5 / M_PI);
+                }
+                // sin(2 pi t) for t in [-1/2, 1/2], sin(2 pi t) = sin(2 pi (1/2 - t)) folds t into
+                // [-1/4, 1/4]
+                template <Accuracy A, typename T>
+                inline T sin2pi(T t)
+                {
+                    using S = lane_scalar_t<T>;
+                    return SinePolynomial<A>::eval(
+                        select(t > S(0.25), S(0.5) - t, select(t < S(-0.25), S(-0.5) - t, t)));
+                }
+            }
+
+            template <Accuracy A, typename T>
+            inline T sin(T x)
+            {
+                if constexpr (A == Accuracy::Exact)
+                {
+                    using std::sin;
+                    return sin(x);
+                }
+                else
+                {
+                    return detail::sin2pi<A>(detail::turns(x));
+                }
+            }
+            template <Accuracy A, typename T>
+            inline T cos(T x)
+            {
+                if constexpr (A == Accuracy::Exact)
+                {
+                    using std::cos;
+                    return cos(x);
+                }
+                else
+                {
+                    // cos(2 pi t) = sin(2 pi (1/4 - |t|))
+                    using std::abs;
+                    using S = lane_scalar_t<T>;
+                    return detail::SinePolynomial<A>::eval(S(0.25) - abs(detail::turns(x)));
+                }
+            }
+            template <Accuracy A, typename T>
+            inline T sin2pi(T t)
+            {
+                using S = lane_scalar_t<T>;
+                if constexpr (A == Accuracy::Exact)
+                {
+                    using std::sin;
+                    return sin(S(2.0 * M_PI) * t);
+                }
+                else
+                {
+                    using std::floor;
+                    return detail::sin2pi<A>(t - floor(t + S(0.5)));
+                }
+            }
+
+            template <Accuracy A, typename T>
+            inline T tan(T x)
+            {
+                if constexpr (A == Accuracy::Exact)
+                {
+                    using std::tan;
+                    return tan(x);
+                }
+                else
+                {
+                    using std::abs;
+                    using S       = lane_scalar_t<T>;
+                    const T turns = detail::turns(x);
+                    return detail::sin2pi<A>(turns) /
+                           detail::SinePolynomial<A>::eval(S(0.25) - abs(turns));
+                }
+            }
+            template <Accuracy A, typename T>
+            inline T exp2(T x)
+            {
+                if constexpr (A == Accuracy::Exact)
+                {
+                    using std::exp2;
+                    return exp2(x);
+                }
+                else
+                {
+                    using std::floor;
+                    using std::max;
+                    using std::min;
+                    using S          = lane_scalar_t<T>;
+                    constexpr auto e = detail::exponentBias<S>;
+                    const T clamped  = min(max(x, T(S(1 - e))), T(S(e)));
+                    const T k        = floor(clamped + S(0.5));
+                    return detail::pow2(k) * detail::Exp2Polynomial<A>::eval(T(clamped - k));
+                }
+            }
+            template <Accuracy A, typename T>
+            inline T exp(T x)
+            {
+                if constexpr (A == Accuracy::Exact)
+                {
+                    using std::exp;
+                    return exp(x);
+                }
+                else
+                {
+                    using S = lane_scalar_t<T>;
+                    return exp2<A>(T(x * S(M_LOG2E)));
+                }
+            }
+            template <Accuracy A, typename T>
+            inline T log2(T x)
+            {
+                if constexpr (A == Accuracy::Exact)
+                {
+                    using std::log2;
+                    return log2(x);
+                }
+                else
+                {
+                    // x = m 2^e with m in [sqrt(1/2), sqrt(2)), log2(m) = log2((1 + s) / (1 - s))
+                    using S          = lane_scalar_t<T>;
+                    T e              = detail::exponent(x);
+                    T m              = detail::mantissa(x);
+                    const auto above = m > S(M_SQRT2);
+                    m                = select(above, T(m * S(0.5)), m);
+                    e                = select(above, T(e + S(1)), e);
+                    return e + detail::Log2Polynomial<A>::eval(T((m - S(1)) / (m + S(1))));
+                }
+            }
+            template <Accuracy A, typename T>
+            inline T tanh(T x)
+            {
+                using S = lane_scalar_t<T>;
+                if constexpr (A == Accuracy::Exact)
+                {
+                    using std::tanh;
+                    return tanh(x);
+                }
+                else if constexpr (A == Accuracy::Low)
+                {
+                    // Pade approximant, clamped where it is closest to +-1
+                    using std::max;
+                    using std::min;
+                    const T c  = min(max(x, T(S(-4.79))), T(S(4.79)));
+                    const T c2 = c * c;
+                    return c * (S(135135) + c2 * (S(17325) + c2 * (S(378) + c2))) /
+                           (S(135135) + c2 * (S(62370) + c2 * (S(3150) + c2 * S(28))));
+                }
+                else
+                {
+                    // tanh(|x|) = (1 - e^(-2|x|)) / (1 + e^(-2|x|)), without overflow
+                    using std::abs;
+                    const T s = exp2<A>(T(abs(x) * S(-2.0 * M_LOG2E)));
+                    const T y = (S(1) - s) / (S(1) + s);
+                    return select(x < S(0), T(-y), y);
+                }
+            }
+        }
+    }
+}
+
+#define DAP_FASTMATH_APPROX_ARRAY_FUNCTION(func)                                                 \
+    namespace dap                                                                                 \
+    {                                                                                             \
+        namespace fastmath                                                                        \
+        {                                                                                         \
+            namespace approx                                                                      \
+            {                                                                                     \
+                template <Accuracy A, typename T>                                                 \
+                void func(T* result, const T* x, size_t size)                                     \
+                {                                                                                 \
+                    for (size_t i = 0; i < size; ++i)                                             \
+                    {                                                                             \
+                        result[i] = func<A>(x[i]);                                                \
+                    }                                                                             \
+                }                                                                                 \
+                template <Accuracy A, typename T, typename Allocator>                             \
+                void func(Array<T, Allocator>& result, const Array<T, Allocator>& x)              \
+                {                                                                                 \
+                    if (result.size() != x.size())                                                \
+                    {                                                                             \
+                        throw std::runtime_error("Array size mismatch.");                         \
+                    }                                                                             \
+                    func<A>(result.data(), x.data(), x.size());                                   \
+                }                                                                                 \
+            }                                                                                     \
+        }                                                                                         \
+    }
+
+DAP_FASTMATH_APPROX_ARRAY_FUNCTION(sin)
+DAP_FASTMATH_APPROX_ARRAY_FUNCTION(cos)
+DAP_FASTMATH_APPROX_ARRAY_FUNCTION(tan)
+DAP_FASTMATH_APPROX_ARRAY_FUNCTION(exp2)
+DAP_FASTMATH_APPROX_ARRAY_FUNCTION(exp)
+DAP_FASTMATH_APPROX_ARRAY_FUNCTION(log2)
+DAP_FASTMATH_APPROX_ARRAY_FUNCTION(tanh)
+
+#undef DAP_FASTMATH_APPROX_ARRAY_FUNCTION
+
+#endif // DAP_FASTMATH_APPROX_H
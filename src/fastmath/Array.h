@@ -23,7 +23,7 @@ namespace dap
 template <typename T, typename Allocator = dap::fastmath::AlignedAllocator<T> >
 class dap::fastmath::Array
 {
-    static_assert(isArithmeticOrComplex<T>(),
+    static_assert(isArithmeticOrComplex<T>() && !isPacked<T>(),
                   "dap::fastmath::Array does not support non arithmetic types");
 
 public:
@@ -198,8 +198,6 @@ public:
     }
     Array(pointer ptr, size_type start, size_type end, bool ownMemory = true)
     {
-        checkAlignment(ptr);
-
         if (end < start)
         {
             throw std::runtime_error("Array::Array start > end.");
@@ -218,8 +216,6 @@ public:
     }
     Array(const_pointer ptr, size_type start, size_type end)
     {
-        checkAlignment(ptr);
-
         if (end < start)
         {
             throw std::runtime_error("Array::Array start > end.");
@@ -276,10 +272,6 @@ public:
     explicit Array(const std::vector<value_type, VectorAlloc>& v, bool ownMemory = true)
     : Array(const_cast<pointer>(v.data()), 0, v.size(), ownMemory) // NOLINT
     {
-        if (!ownMemory)
-        {
-            checkAlignment(v.data());
-        }
     }
     virtual ~Array()
     {
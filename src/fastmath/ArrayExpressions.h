@@ -0,0 +1,158 @@
+#ifndef DAP_FASTMATH_ARRAY_EXPRESSIONS_H
+#define DAP_FASTMATH_ARRAY_EXPRESSIONS_H
+
+#include "base/TypeTraits.h"
+#include "VarArray.h"
+#include <type_traits>
+
+// Coefficient-wise expressions of Array and VarArray, e.g. gain * tanh(a + b * c), built on the
+// Eigen expression templates of their maps. Assigned to an Array or VarArray, a whole chain runs in
+// a single vectorized loop, and a reduction of a chain, e.g. sum(x * y), in a single pass, neither
+// of them making temporaries. Assignment allocates only to grow the result, throwing
+// AllocationForbiddenException when its allocation is forbidden.
+
+namespace dap
+{
+    namespace fastmath
+    {
+        template <typename>
+        struct isArrayOperand : std::false_type
+        {
+        };
+        template <typename T, typename Allocator>
+        struct isArrayOperand<Array<T, Allocator>> : std::true_type
+        {
+        };
+        template <typename T, typename Allocator>
+        struct isArrayOperand<VarArray<T, Allocator>> : std::true_type
+        {
+        };
+
+        // an Array, a VarArray or an Eigen array expression
+        template <typename E>
+        constexpr bool isArrayExpression()
+        {
+            return isArrayOperand<E>::value || std::is_base_of<Eigen::ArrayBase<E>, E>::value;
+        }
+        // the operators need an Array or VarArray operand, Eigen having those of its expressions
+        template <typename L, typename R>
+        constexpr bool isArrayOperation()
+        {
+            return (isArrayOperand<L>::value || isArrayOperand<R>::value) &&
+                   (isArrayExpression<L>() || dap::isArithmetic<L>()) &&
+                   (isArrayExpression<R>() || dap::isArithmetic<R>());
+        }
+
+        // the Eigen expression of an operand
+        template <typename T, typename Allocator>
+        auto expr(const Array<T, Allocator>& x)
+        {
+            return x.map();
+        }
+        template <typename T, typename Allocator>
+        auto expr(const VarArray<T, Allocator>& x)
+        {
+            return x.map();
+        }
+        template <typename E, DAP_REQUIRES(std::is_base_of<Eigen::ArrayBase<E>, E>::value)>
+        const E& expr(const E& x)
+        {
+            return x;
+        }
+
+        namespace detail
+        {
+            // the expression of an operand of an operation with other, a scalar having the type
+            // of the coefficients of other
+            template <typename Other, typename E>
+            decltype(auto) operand(const E& x)
+            {
+                if constexpr (dap::isArithmetic<E>())
+                {
+                    using expression_t = std::decay_t<decltype(expr(std::declval<Other>()))>;
+                    return typename expression_t::Scalar(x);
+                }
+                else
+                {
+                    return expr(x);
+                }
+            }
+        }
+
+#define DAP_FASTMATH_ARRAY_BINARY_OPERATOR(op)                                                    \
+    template <typename L, typename R, DAP_REQUIRES(isArrayOperation<L, R>())>                      \
+    auto operator op(const L& lhs, const R& rhs)                                                   \
+    {                                                                                              \
+        return detail::operand<R>(lhs) op detail::operand<L>(rhs);                                 \
+    }
+
+        DAP_FASTMATH_ARRAY_BINARY_OPERATOR(+)
+        DAP_FASTMATH_ARRAY_BINARY_OPERATOR(-)
+        DAP_FASTMATH_ARRAY_BINARY_OPERATOR(*)
+        DAP_FASTMATH_ARRAY_BINARY_OPERATOR(/)
+
+#undef DAP_FASTMATH_ARRAY_BINARY_OPERATOR
+
+        template <typename E, DAP_REQUIRES(isArrayOperand<E>::value)>
+        auto operator-(const E& x)
+        {
+            return -expr(x);
+        }
+
+#define DAP_FASTMATH_ARRAY_UNARY_FUNCTION(function)                                               \
+    template <typename E, DAP_REQUIRES(isArrayExpression<E>())>                                    \
+    auto function(const E& x)                                                                      \
+    {                                                                                              \
+        return expr(x).function();                                                                 \
+    }
+
+        DAP_FASTMATH_ARRAY_UNARY_FUNCTION(abs)
+        DAP_FASTMATH_ARRAY_UNARY_FUNCTION(abs2)
+        DAP_FASTMATH_ARRAY_UNARY_FUNCTION(sqrt)
+        DAP_FASTMATH_ARRAY_UNARY_FUNCTION(exp)
+        DAP_FASTMATH_ARRAY_UNARY_FUNCTION(log)
+        DAP_FASTMATH_ARRAY_UNARY_FUNCTION(sin)
+        DAP_FASTMATH_ARRAY_UNARY_FUNCTION(cos)
+        DAP_FASTMATH_ARRAY_UNARY_FUNCTION(tan)
+        DAP_FASTMATH_ARRAY_UNARY_FUNCTION(tanh)
+        DAP_FASTMATH_ARRAY_UNARY_FUNCTION(square)
+        DAP_FASTMATH_ARRAY_UNARY_FUNCTION(cube)
+        DAP_FASTMATH_ARRAY_UNARY_FUNCTION(inverse)
+
+#undef DAP_FASTMATH_ARRAY_UNARY_FUNCTION
+
+        // reductions, in a single pass over the operands of the expression
+        template <typename E, DAP_REQUIRES(isArrayExpression<E>())>
+        auto sum(const E& x)
+        {
+            return expr(x).sum();
+        }
+        template <typename E, DAP_REQUIRES(isArrayExpression<E>())>
+        auto mean(const E& x)
+        {
+            return expr(x).mean();
+        }
+        template <typename E, DAP_REQUIRES(isArrayExpression<E>())>
+        auto max(const E& x)
+        {
+            return expr(x).maxCoeff();
+        }
+        template <typename E, DAP_REQUIRES(isArrayExpression<E>())>
+        auto min(const E& x)
+        {
+            return expr(x).minCoeff();
+        }
+        template <typename E, DAP_REQUIRES(isArrayExpression<E>())>
+        auto squaredNorm(const E& x)
+        {
+            return expr(x).matrix().squaredNorm();
+        }
+        template <typename E, DAP_REQUIRES(isArrayExpression<E>())>
+        auto norm(const E& x)
+        {
+            return expr(x).matrix().norm();
+        }
+    }
+}
+
+#endif // DAP_FASTMATH_ARRAY_EXPRESSIONS_H
@@ -0,0 +1,206 @@
+#include "ArrayKernels.h"
+#include "array_kernels_impl.h"
+#include <atomic>
+#include <cmath>
+#include <ostream>
+#include <stdexcept>
+#include <Eigen/Core>
+
+using dap::fastmath::ArrayBackend;
+using dap::fastmath::ArrayKernels;
+
+namespace
+{
+    using array_t       = Eigen::Map<Eigen::ArrayXf>;
+    using const_array_t = Eigen::Map<const Eigen::ArrayXf>;
+
+    // floats one at a time, for the sample conversions of the Eigen kernels
+    struct Scalar
+    {
+        using V                       = float;
+        static constexpr size_t width = 1;
+
+        static V load(const float* x)
+        {
+            return *x;
+        }
+        static void store(float* x, V a)
+        {
+            *x = a;
+        }
+        static V loadAligned(const float* x)
+        {
+            return *x;
+        }
+        static void storeAligned(float* x, V a)
+        {
+            *x = a;
+        }
+        static V set1(float a)
+        {
+            return a;
+        }
+        static V mul(V a, V b)
+        {
+            return a * b;
+        }
+        static V fmadd(V a, V b, V c)
+        {
+            return a * b + c;
+        }
+        // b if a is nan, as the vector instructions
+        static V min(V a, V b)
+        {
+            return a < b ? a : b;
+        }
+        static V max(V a, V b)
+        {
+            return a > b ? a : b;
+        }
+        static void storeInt16(int16_t* x, V a)
+        {
+            *x = int16_t(std::nearbyint(a));
+        }
+        static void storeInt32(int32_t* x, V a)
+        {
+            *x = int32_t(std::nearbyint(a));
+        }
+        static V loadInt16(const int16_t* x)
+        {
+            return float(*x);
+        }
+        static V loadInt32(const int32_t* x)
+        {
+            return float(*x);
+        }
+    };
+
+    // the kernels of the Eigen build flags, without the alignment requirement of the ops
+    constexpr ArrayKernels eigenKernels = {
+        ArrayBackend::Eigen,
+        [](float* result, const float* x, const float* y, size_t size) {
+            array_t(result, size) = const_array_t(x, size) + const_array_t(y, size);
+        },
+        [](float* result, const float* x, const float* y, size_t size) {
+            array_t(result, size) = const_array_t(x, size) - const_array_t(y, size);
+        },
+        [](float* result, const float* x, const float* y, size_t size) {
+            array_t(result, size) = const_array_t(x, size) * const_array_t(y, size);
+        },
+        [](float* result, const float* x, const float* y, const float* z, size_t size) {
+            array_t(result, size) =
+                const_array_t(x, size) * const_array_t(y, size) + const_array_t(z, size);
+        },
+        [](float* result, const float* x, size_t size) {
+            array_t(result, size) = const_array_t(x, size).abs();
+        },
+        [](float* result, const float* x, size_t size) {
+            array_t(result, size) = const_array_t(x, size).sqrt();
+        },
+        [](float* result, const float* x, size_t size) {
+            array_t(result, size) = const_array_t(x, size).exp();
+        },
+        [](float* result, const float* x, size_t size) {
+            array_t(result, size) = const_array_t(x, size).log();
+        },
+        [](const float* x, size_t size) { return const_array_t(x, size).minCoeff(); },
+        [](const float* x, size_t size) { return const_array_t(x, size).maxCoeff(); },
+        [](const float* x, size_t size) { return const_array_t(x, size).sum(); },
+        [](const float* x, size_t size) { return const_array_t(x, size).square().sum(); },
+        &dap::fastmath::detail::kernels::toInt16<Scalar>,
+        &dap::fastmath::detail::kernels::toInt24<Scalar>,
+        &dap::fastmath::detail::kernels::toInt32<Scalar>,
+        &dap::fastmath::detail::kernels::fromInt16<Scalar>,
+        &dap::fastmath::detail::kernels::fromInt24<Scalar>,
+        &dap::fastmath::detail::kernels::fromInt32<Scalar>,
+        &dap::fastmath::detail::kernels::interleave<Scalar>,
+        &dap::fastmath::detail::kernels::deinterleave<Scalar>,
+    };
+
+    const ArrayKernels& kernels(ArrayBackend backend)
+    {
+        switch (backend)
+        {
+#if defined(DAP_FASTMATH_X86_KERNELS)
+            case ArrayBackend::Sse41:
+                return dap::fastmath::detail::sse41ArrayKernels();
+            case ArrayBackend::Avx2:
+                return dap::fastmath::detail::avx2ArrayKernels();
+            case ArrayBackend::Avx512:
+                return dap::fastmath::detail::avx512ArrayKernels();
+#endif
+            default:
+                return eigenKernels;
+        }
+    }
+    const ArrayKernels& best()
+    {
+        for (auto backend : {ArrayBackend::Avx512, ArrayBackend::Avx2, ArrayBackend::Sse41})
+        {
+            if (dap::fastmath::supported(backend))
+            {
+                return kernels(backend);
+            }
+        }
+        return eigenKernels;
+    }
+    std::atomic<const ArrayKernels*>& current()
+    {
+        static std::atomic<const ArrayKernels*> current{&best()};
+        return current;
+    }
+}
+
+const ArrayKernels& dap::fastmath::arrayKernels()
+{
+    return *current().load(std::memory_order_acquire);
+}
+
+ArrayBackend dap::fastmath::arrayBackend()
+{
+    return arrayKernels().backend;
+}
+
+bool dap::fastmath::supported(ArrayBackend backend)
+{
+#if defined(DAP_FASTMATH_X86_KERNELS)
+    __builtin_cpu_init();
+    switch (backend)
+    {
+        case ArrayBackend::Eigen:
+            return true;
+        case ArrayBackend::Sse41:
+            return __builtin_cpu_supports("sse4.1") != 0;
+        case ArrayBackend::Avx2:
+            return __builtin_cpu_supports("avx2") != 0 && __builtin_cpu_supports("fma") != 0;
+        case ArrayBackend::Avx512:
+            return __builtin_cpu_supports("avx512f") != 0;
+    }
+#endif
+    return backend == ArrayBackend::Eigen;
+}
+
+void dap::fastmath::setArrayBackend(ArrayBackend backend)
+{
+    if (!supported(backend))
+    {
+        throw std::invalid_argument("Array backend not supported");
+    }
+    current().store(&kernels(backend), std::memory_order_release);
+}
+
+std::ostream& dap::fastmath::operator<<(std::ostream& out, ArrayBackend backend)
+{
+    switch (backend)
+    {
+        case ArrayBackend::Eigen:
+            return out << "Eigen";
+        case ArrayBackend::Sse41:
+            return out << "SSE4.1";
+        case ArrayBackend::Avx2:
+            return out << "AVX2";
+        case ArrayBackend::Avx512:
+            return out << "AVX-512";
+    }
+    return out;
+}
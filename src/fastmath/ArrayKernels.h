@@ -0,0 +1,83 @@
+#ifndef DAP_FASTMATH_ARRAY_KERNELS_H
+#define DAP_FASTMATH_ARRAY_KERNELS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+
+namespace dap
+{
+    namespace fastmath
+    {
+        // instruction sets of the float kernels of ArrayOps.h, Eigen being the portable fallback
+        enum class ArrayBackend
+        {
+            Eigen,
+            Sse41,
+            Avx2,   // with FMA
+            Avx512, // AVX-512F
+        };
+        struct ArrayKernels;
+
+        // the kernels of the current backend, at first the best one the cpu supports
+        const ArrayKernels& arrayKernels();
+        ArrayBackend arrayBackend();
+        // true if the backend is built and the cpu supports it
+        bool supported(ArrayBackend backend);
+        // selects the kernels of backend, e.g. to compare backends, throws std::invalid_argument
+        // when it is not supported. Not to be called while other threads run array ops.
+        void setArrayBackend(ArrayBackend backend);
+        std::ostream& operator<<(std::ostream& out, ArrayBackend backend);
+    }
+}
+
+// Float kernels of one backend. They take unaligned pointers of any size, results may be
+// arguments, min and max need at least one coefficient. exp and log are polynomial
+// approximations within 2 ulps, exp saturating below -87.3 and above 88.3, log of a negative
+// number being nan and of 0 -inf.
+// The sample conversions of SampleConversion.h scale floats by 2^15, 2^23 or 2^31, add dither,
+// if not null, in lsbs, then clip and round to nearest, 24 bit samples being 3 little endian
+// bytes. interleave and deinterleave take 1 to 8 channels.
+struct dap::fastmath::ArrayKernels final
+{
+    using unary_t   = void (*)(float* result, const float* x, size_t size);
+    using binary_t  = void (*)(float* result, const float* x, const float* y, size_t size);
+    using ternary_t = void (*)(float* result,
+                               const float* x,
+                               const float* y,
+                               const float* z,
+                               size_t size);
+    using reduce_t = float (*)(const float* x, size_t size);
+    template <typename Int>
+    using quantize_t = void (*)(Int* result, const float* x, const float* dither, size_t size);
+    template <typename Int>
+    using dequantize_t = void (*)(float* result, const Int* x, size_t size);
+    using interleave_t =
+        void (*)(float* result, const float* const* x, size_t channels, size_t frames);
+    using deinterleave_t =
+        void (*)(float* const* result, const float* x, size_t channels, size_t frames);
+
+    ArrayBackend backend;
+    binary_t add;
+    binary_t sub;
+    binary_t mul;
+    ternary_t fma; // x * y + z
+    unary_t abs;
+    unary_t sqrt;
+    unary_t exp;
+    unary_t log;
+    reduce_t min;
+    reduce_t max;
+    reduce_t sum;
+    reduce_t squaredNorm;
+    quantize_t<int16_t> toInt16;
+    quantize_t<uint8_t> toInt24;
+    quantize_t<int32_t> toInt32;
+    dequantize_t<int16_t> fromInt16;
+    dequantize_t<uint8_t> fromInt24;
+    dequantize_t<int32_t> fromInt32;
+    interleave_t interleave;     // planar channels to frames
+    deinterleave_t deinterleave; // frames to planar channels
+};
+
+#endif // DAP_FASTMATH_ARRAY_KERNELS_H
@@ -0,0 +1,145 @@
+#include "array_kernels_impl.h"
+#include <immintrin.h>
+
+// compiled with -mavx2 -mfma
+
+namespace
+{
+    struct Avx2
+    {
+        using V                       = __m256;
+        using mask_t                  = __m256;
+        static constexpr size_t width = 8;
+
+        static V load(const float* x)
+        {
+            return _mm256_loadu_ps(x);
+        }
+        static void store(float* x, V a)
+        {
+            _mm256_storeu_ps(x, a);
+        }
+        static V loadAligned(const float* x)
+        {
+            return _mm256_load_ps(x);
+        }
+        static void storeAligned(float* x, V a)
+        {
+            _mm256_store_ps(x, a);
+        }
+        static V set1(float a)
+        {
+            return _mm256_set1_ps(a);
+        }
+        static V add(V a, V b)
+        {
+            return _mm256_add_ps(a, b);
+        }
+        static V sub(V a, V b)
+        {
+            return _mm256_sub_ps(a, b);
+        }
+        static V mul(V a, V b)
+        {
+            return _mm256_mul_ps(a, b);
+        }
+        static V fmadd(V a, V b, V c)
+        {
+            return _mm256_fmadd_ps(a, b, c);
+        }
+        static V min(V a, V b)
+        {
+            return _mm256_min_ps(a, b);
+        }
+        static V max(V a, V b)
+        {
+            return _mm256_max_ps(a, b);
+        }
+        static V abs(V a)
+        {
+            return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a);
+        }
+        static V sqrt(V a)
+        {
+            return _mm256_sqrt_ps(a);
+        }
+        static V floor(V a)
+        {
+            return _mm256_floor_ps(a);
+        }
+        static mask_t lt(V a, V b)
+        {
+            return _mm256_cmp_ps(a, b, _CMP_LT_OQ);
+        }
+        static mask_t eq(V a, V b)
+        {
+            return _mm256_cmp_ps(a, b, _CMP_EQ_OQ);
+        }
+        static mask_t nge(V a, V b)
+        {
+            return _mm256_cmp_ps(a, b, _CMP_NGE_UQ);
+        }
+        static V select(mask_t mask, V a, V b)
+        {
+            return _mm256_blendv_ps(b, a, mask);
+        }
+        static V pow2(V n)
+        {
+            const __m256i e = _mm256_add_epi32(_mm256_cvtps_epi32(n), _mm256_set1_epi32(127));
+            return _mm256_castsi256_ps(_mm256_slli_epi32(e, 23));
+        }
+        static V frexp(V x, V& e)
+        {
+            const __m256i bits = _mm256_castps_si256(x);
+            e                  = _mm256_cvtepi32_ps(
+                _mm256_sub_epi32(_mm256_srli_epi32(bits, 23), _mm256_set1_epi32(126)));
+            const __m256i m = _mm256_and_si256(bits, _mm256_set1_epi32(0x007fffff));
+            return _mm256_castsi256_ps(_mm256_or_si256(m, _mm256_set1_epi32(0x3f000000)));
+        }
+        static float hsum(V a)
+        {
+            __m128 h = _mm_add_ps(_mm256_castps256_ps128(a), _mm256_extractf128_ps(a, 1));
+            h        = _mm_add_ps(h, _mm_movehl_ps(h, h));
+            return _mm_cvtss_f32(_mm_add_ss(h, _mm_shuffle_ps(h, h, 1)));
+        }
+        static float hmin(V a)
+        {
+            __m128 h = _mm_min_ps(_mm256_castps256_ps128(a), _mm256_extractf128_ps(a, 1));
+            h        = _mm_min_ps(h, _mm_movehl_ps(h, h));
+            return _mm_cvtss_f32(_mm_min_ss(h, _mm_shuffle_ps(h, h, 1)));
+        }
+        static float hmax(V a)
+        {
+            __m128 h = _mm_max_ps(_mm256_castps256_ps128(a), _mm256_extractf128_ps(a, 1));
+            h        = _mm_max_ps(h, _mm_movehl_ps(h, h));
+            return _mm_cvtss_f32(_mm_max_ss(h, _mm_shuffle_ps(h, h, 1)));
+        }
+        static void storeInt16(int16_t* x, V a)
+        {
+            const __m256i b = _mm256_cvtps_epi32(a);
+            const __m128i c =
+                _mm_packs_epi32(_mm256_castsi256_si128(b), _mm256_extracti128_si256(b, 1));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(x), c);
+        }
+        static void storeInt32(int32_t* x, V a)
+        {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(x), _mm256_cvtps_epi32(a));
+        }
+        static V loadInt16(const int16_t* x)
+        {
+            const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(x));
+            return _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(b));
+        }
+        static V loadInt32(const int32_t* x)
+        {
+            return _mm256_cvtepi32_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(x)));
+        }
+    };
+    constexpr dap::fastmath::ArrayKernels table =
+        dap::fastmath::detail::kernels::make<Avx2>(dap::fastmath::ArrayBackend::Avx2);
+}
+
+const dap::fastmath::ArrayKernels& dap::fastmath::detail::avx2ArrayKernels()
+{
+    return table;
+}
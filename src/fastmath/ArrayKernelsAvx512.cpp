@@ -0,0 +1,153 @@
+#include "array_kernels_impl.h"
+#include <immintrin.h>
+
+// compiled with -mavx512f -mfma
+
+// gcc 12 warns of the undefined vectors of its own AVX-512 intrinsics
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+namespace
+{
+    struct Avx512
+    {
+        using V                       = __m512;
+        using mask_t                  = __mmask16;
+        static constexpr size_t width = 16;
+
+        static V load(const float* x)
+        {
+            return _mm512_loadu_ps(x);
+        }
+        static void store(float* x, V a)
+        {
+            _mm512_storeu_ps(x, a);
+        }
+        static V loadAligned(const float* x)
+        {
+            return _mm512_load_ps(x);
+        }
+        static void storeAligned(float* x, V a)
+        {
+            _mm512_store_ps(x, a);
+        }
+        static V set1(float a)
+        {
+            return _mm512_set1_ps(a);
+        }
+        static V add(V a, V b)
+        {
+            return _mm512_add_ps(a, b);
+        }
+        static V sub(V a, V b)
+        {
+            return _mm512_sub_ps(a, b);
+        }
+        static V mul(V a, V b)
+        {
+            return _mm512_mul_ps(a, b);
+        }
+        static V fmadd(V a, V b, V c)
+        {
+            return _mm512_fmadd_ps(a, b, c);
+        }
+        static V min(V a, V b)
+        {
+            return _mm512_min_ps(a, b);
+        }
+        static V max(V a, V b)
+        {
+            return _mm512_max_ps(a, b);
+        }
+        static V abs(V a)
+        {
+            return _mm512_abs_ps(a);
+        }
+        static V sqrt(V a)
+        {
+            return _mm512_sqrt_ps(a);
+        }
+        static V floor(V a)
+        {
+            return _mm512_roundscale_ps(a, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+        }
+        static mask_t lt(V a, V b)
+        {
+            return _mm512_cmp_ps_mask(a, b, _CMP_LT_OQ);
+        }
+        static mask_t eq(V a, V b)
+        {
+            return _mm512_cmp_ps_mask(a, b, _CMP_EQ_OQ);
+        }
+        static mask_t nge(V a, V b)
+        {
+            return _mm512_cmp_ps_mask(a, b, _CMP_NGE_UQ);
+        }
+        static V select(mask_t mask, V a, V b)
+        {
+            return _mm512_mask_blend_ps(mask, b, a);
+        }
+        static V pow2(V n)
+        {
+            const __m512i e = _mm512_add_epi32(_mm512_cvtps_epi32(n), _mm512_set1_epi32(127));
+            return _mm512_castsi512_ps(_mm512_slli_epi32(e, 23));
+        }
+        static V frexp(V x, V& e)
+        {
+            const __m512i bits = _mm512_castps_si512(x);
+            e                  = _mm512_cvtepi32_ps(
+                _mm512_sub_epi32(_mm512_srli_epi32(bits, 23), _mm512_set1_epi32(126)));
+            const __m512i m = _mm512_and_si512(bits, _mm512_set1_epi32(0x007fffff));
+            return _mm512_castsi512_ps(_mm512_or_si512(m, _mm512_set1_epi32(0x3f000000)));
+        }
+        // op of the floats of a, halving the vector
+        template <typename Op>
+        static float reduce(V a, Op op)
+        {
+            a = op(a, _mm512_shuffle_f32x4(a, a, _MM_SHUFFLE(1, 0, 3, 2)));
+            a = op(a, _mm512_shuffle_f32x4(a, a, _MM_SHUFFLE(2, 3, 0, 1)));
+            a = op(a, _mm512_permute_ps(a, _MM_SHUFFLE(1, 0, 3, 2)));
+            a = op(a, _mm512_permute_ps(a, _MM_SHUFFLE(2, 3, 0, 1)));
+            return _mm512_cvtss_f32(a);
+        }
+        static float hsum(V a)
+        {
+            return reduce(a, add);
+        }
+        static float hmin(V a)
+        {
+            return reduce(a, min);
+        }
+        static float hmax(V a)
+        {
+            return reduce(a, max);
+        }
+        static void storeInt16(int16_t* x, V a)
+        {
+            const __m256i b = _mm512_cvtsepi32_epi16(_mm512_cvtps_epi32(a));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(x), b);
+        }
+        static void storeInt32(int32_t* x, V a)
+        {
+            _mm512_storeu_si512(x, _mm512_cvtps_epi32(a));
+        }
+        static V loadInt16(const int16_t* x)
+        {
+            const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(x));
+            return _mm512_cvtepi32_ps(_mm512_cvtepi16_epi32(b));
+        }
+        static V loadInt32(const int32_t* x)
+        {
+            return _mm512_cvtepi32_ps(_mm512_loadu_si512(x));
+        }
+    };
+    constexpr dap::fastmath::ArrayKernels table =
+        dap::fastmath::detail::kernels::make<Avx512>(dap::fastmath::ArrayBackend::Avx512);
+}
+
+const dap::fastmath::ArrayKernels& dap::fastmath::detail::avx512ArrayKernels()
+{
+    return table;
+}
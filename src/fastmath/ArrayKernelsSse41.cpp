@@ -0,0 +1,139 @@
+#include "array_kernels_impl.h"
+#include <smmintrin.h>
+
+// compiled with -msse4.1
+
+namespace
+{
+    struct Sse41
+    {
+        using V                       = __m128;
+        using mask_t                  = __m128;
+        static constexpr size_t width = 4;
+
+        static V load(const float* x)
+        {
+            return _mm_loadu_ps(x);
+        }
+        static void store(float* x, V a)
+        {
+            _mm_storeu_ps(x, a);
+        }
+        static V loadAligned(const float* x)
+        {
+            return _mm_load_ps(x);
+        }
+        static void storeAligned(float* x, V a)
+        {
+            _mm_store_ps(x, a);
+        }
+        static V set1(float a)
+        {
+            return _mm_set1_ps(a);
+        }
+        static V add(V a, V b)
+        {
+            return _mm_add_ps(a, b);
+        }
+        static V sub(V a, V b)
+        {
+            return _mm_sub_ps(a, b);
+        }
+        static V mul(V a, V b)
+        {
+            return _mm_mul_ps(a, b);
+        }
+        static V fmadd(V a, V b, V c)
+        {
+            return _mm_add_ps(_mm_mul_ps(a, b), c);
+        }
+        static V min(V a, V b)
+        {
+            return _mm_min_ps(a, b);
+        }
+        static V max(V a, V b)
+        {
+            return _mm_max_ps(a, b);
+        }
+        static V abs(V a)
+        {
+            return _mm_andnot_ps(_mm_set1_ps(-0.0f), a);
+        }
+        static V sqrt(V a)
+        {
+            return _mm_sqrt_ps(a);
+        }
+        static V floor(V a)
+        {
+            return _mm_floor_ps(a);
+        }
+        static mask_t lt(V a, V b)
+        {
+            return _mm_cmplt_ps(a, b);
+        }
+        static mask_t eq(V a, V b)
+        {
+            return _mm_cmpeq_ps(a, b);
+        }
+        static mask_t nge(V a, V b)
+        {
+            return _mm_cmpnge_ps(a, b);
+        }
+        static V select(mask_t mask, V a, V b)
+        {
+            return _mm_blendv_ps(b, a, mask);
+        }
+        static V pow2(V n)
+        {
+            const __m128i e = _mm_add_epi32(_mm_cvtps_epi32(n), _mm_set1_epi32(127));
+            return _mm_castsi128_ps(_mm_slli_epi32(e, 23));
+        }
+        static V frexp(V x, V& e)
+        {
+            const __m128i bits = _mm_castps_si128(x);
+            e = _mm_cvtepi32_ps(_mm_sub_epi32(_mm_srli_epi32(bits, 23), _mm_set1_epi32(126)));
+            const __m128i m = _mm_and_si128(bits, _mm_set1_epi32(0x007fffff));
+            return _mm_castsi128_ps(_mm_or_si128(m, _mm_set1_epi32(0x3f000000)));
+        }
+        static float hsum(V a)
+        {
+            a = _mm_add_ps(a, _mm_movehl_ps(a, a));
+            return _mm_cvtss_f32(_mm_add_ss(a, _mm_shuffle_ps(a, a, 1)));
+        }
+        static float hmin(V a)
+        {
+            a = _mm_min_ps(a, _mm_movehl_ps(a, a));
+            return _mm_cvtss_f32(_mm_min_ss(a, _mm_shuffle_ps(a, a, 1)));
+        }
+        static float hmax(V a)
+        {
+            a = _mm_max_ps(a, _mm_movehl_ps(a, a));
+            return _mm_cvtss_f32(_mm_max_ss(a, _mm_shuffle_ps(a, a, 1)));
+        }
+        static void storeInt16(int16_t* x, V a)
+        {
+            const __m128i b = _mm_cvtps_epi32(a);
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(x), _mm_packs_epi32(b, b));
+        }
+        static void storeInt32(int32_t* x, V a)
+        {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(x), _mm_cvtps_epi32(a));
+        }
+        static V loadInt16(const int16_t* x)
+        {
+            const __m128i b = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(x));
+            return _mm_cvtepi32_ps(_mm_cvtepi16_epi32(b));
+        }
+        static V loadInt32(const int32_t* x)
+        {
+            return _mm_cvtepi32_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(x)));
+        }
+    };
+    constexpr dap::fastmath::ArrayKernels table =
+        dap::fastmath::detail::kernels::make<Sse41>(dap::fastmath::ArrayBackend::Sse41);
+}
+
+const dap::fastmath::ArrayKernels& dap::fastmath::detail::sse41ArrayKernels()
+{
+    return table;
+}
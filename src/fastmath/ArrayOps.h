@@ -8,6 +8,9 @@ namespace dap
 {
     namespace fastmath
     {
+        // alignment in bytes of a cache line and of the widest vectors, those of AVX-512
+        constexpr size_t maxAlignment = 64;
+
         template <typename T>
         constexpr bool aligned(const T* ptr, size_t bytes)
         {
@@ -18,97 +21,108 @@ namespace dap
         {
             return (size_t(ptr1) & (bytes - 1)) == (size_t(ptr2) & (bytes - 1));
         }
-        template <typename T>
+        template <size_t Alignment = 16, typename T>
         void checkAlignment(const T* ptr)
         {
-            if (!aligned(ptr, 16))
+            static_assert((Alignment & (Alignment - 1)) == 0 && Alignment <= maxAlignment,
+                          "Alignment must be a power of two up to maxAlignment");
+            if (!aligned(ptr, Alignment))
             {
                 throw std::runtime_error("Pointer not correctly aligned");
             }
         }
 
+        // Alignment is the alignment in bytes the pointers given to an op are known to have, up
+        // to maxAlignment, any pointer being fine by default. It is checked and lets Eigen use
+        // aligned loads, while the float ops run the kernels of ArrayKernels.h, which align
+        // their vector loops themselves.
+
         // constant ops
-        template <typename T>
+        template <typename T, size_t Alignment = alignof(T)>
         bool all(const T* x, size_t size); // true if all coefficients are true
-        template <typename T>
+        template <typename T, size_t Alignment = alignof(T)>
         bool any(const T* x, size_t size); // true if at least one coefficient is true
-        template <typename T>
+        template <typename T, size_t Alignment = alignof(T)>
         bool allFinite(const T* x, size_t size); // true if contains only finite numbers, i.e., no
                                                  // NaN and no +/-INF values.
-        template <typename T>
+        template <typename T, size_t Alignment = alignof(T)>
         bool hasNaN(const T* x, size_t size); // true if contains one NaN coefficient
 
         // unary ops
-        template <typename T>
+        template <typename T, size_t Alignment = alignof(T)>
         void abs(T* result, const T* x, size_t size); // coefficient-wise absolute value
-        template <typename T>
+        template <typename T, size_t Alignment = alignof(T)>
         void abs2(T* result, const T* x, size_t size); // coefficient-wise squqre absolute value
-        template <typename T>
+        template <typename T, size_t Alignment = alignof(T)>
         void normalize(T* x, size_t size); // coefficient-wise normalize
-        template <typename T>
+        template <typename T, size_t Alignment = alignof(T)>
         void cos(T* result, const T* x, size_t size); // coefficient-wise cosine
-        template <typename T>
+        template <typename T, size_t Alignment = alignof(T)>
         void sin(T* result, const T* x, size_t size); // coefficient-wise sine
-        template <typename T>
+        template <typename T, size_t Alignment = alignof(T)>
         void tan(T* result, const T* x, size_t size); // coefficient-wise tan
-        template <typename T>
+        template <typename T, size_t Alignment = alignof(T)>
         void acos(T* result, const T* x, size_t size); // coefficient-wise arc cosine
-        template <typename T>
+        template <typename T, size_t Alignment = alignof(T)>
         void asin(T* result, const T* x, size_t size); // coefficient-wise arc sine
 
-        template <typename T>
+        template <typename T, size_t Alignment = alignof(T)>
         T max(const T* x,
               size_t size); // the maximum of all coefficients (undefined if there is a NaN)
-        template <typename T>
+        template <typename T, size_t Alignment = alignof(T)>
         T min(const T* x,
               size_t size); // the minimum of all coefficients (undefined if there is a NaN)
-        template <typename T>
+        template <typename T, size_t Alignment = alignof(T)>
         T sum(const T* x, size_t size); // the sum of all coefficients
-        template <typename T>
+        template <typename T, size_t Alignment = alignof(T)>
         T prod(const T* x, size_t size); // the product of all coefficients
-        template <typename T>
+        template <typename T, size_t Alignment = alignof(T)>
         void fill(const T& value, T* x, size_t size); // set all coefficients to value
-        template <typename T>
+        template <typename T, size_t Alignment = alignof(T)>
         void linspace(const T& low, const T& high, T* x, size_t size); // linearly spaced vector
-        template <typename T>
+        template <typename T, size_t Alignment = alignof(T)>
         T mean(const T* x, size_t size); // the mean of all coefficients
-        template <typename T, typename U>
+        template <typename T, typename U, size_t Alignment = alignof(T)>
         void mean(U* result, const T* x, size_t size); // the mean of all coefficients
-        template <typename T>
+        template <typename T, size_t Alignment = alignof(T)>
         T norm(const T* x, size_t size); // norm of the vector
-        template <typename T, typename U>
+        template <typename T, typename U, size_t Alignment = alignof(T)>
         void norm(U* result, const T* x, size_t size); // norm of the vector
-        template <typename T>
+        template <typename T, size_t Alignment = alignof(T)>
         T squaredNorm(const T* x, size_t size); // sum of squares of the vector coefficients
-        template <typename T>
+        template <typename T, size_t Alignment = alignof(T)>
         void square(T* result, const T* x, size_t size); // coefficient-wise square
-        template <typename T>
+        template <typename T, size_t Alignment = alignof(T)>
         void cube(T* result, const T* x, size_t size); // coefficient-wise cube
-        template <typename T>
+        template <typename T, size_t Alignment = alignof(T)>
         void pow(const T& value, T* result, const T* x, size_t size); // coefficient-wise pow(value)
-        template <typename T>
+        template <typename T, size_t Alignment = alignof(T)>
         void sqrt(T* result, const T* x, size_t size); // coefficient-wise sqrt
-        template <typename T>
+        template <typename T, size_t Alignment = alignof(T)>
         void exp(T* result, const T* x, size_t size); // coefficient-wise exp
-        template <typename T>
+        template <typename T, size_t Alignment = alignof(T)>
         void log(T* result, const T* x, size_t size); // coefficient-wise log
-        template <typename T>
+        template <typename T, size_t Alignment = alignof(T)>
         void inverse(T* result, const T* x, size_t size); // coefficient-wise inverse
-        template <typename T>
+        template <typename T, size_t Alignment = alignof(T)>
         void conjugate(std::complex<T>* result,
                        const std::complex<T>* x,
                        size_t size); // complex conjugate
 
         // binary ops
-        template <typename T>
+        template <typename T, size_t Alignment = alignof(T)>
         void add(T* result, const T* x, const T* y, size_t size); // x+y
-        template <typename T>
+        template <typename T, size_t Alignment = alignof(T)>
         void sub(T* result, const T* x, const T* y, size_t size); // x-y
-        template <typename T>
+        template <typename T, size_t Alignment = alignof(T)>
         void mul(T* result, const T* x, const T* y, size_t size); // x*y
-        template <typename T>
+        template <typename T, size_t Alignment = alignof(T)>
         void div(T* result, const T* x, const T* y, size_t size); // x/y
 
+        // ternary ops
+        template <typename T, size_t Alignment = alignof(T)>
+        void fma(T* result, const T* x, const T* y, const T* z, size_t size); // x*y+z
+
     } // namespace fastmath
 } // namespace dap
 
@@ -3,61 +3,167 @@
 
 #include "fastmath/Array.h"
 #include "fastmath/AlignedVector.h"
+#include <algorithm>
+#include <cassert>
+#include <utility>
 #include <vector>
 
 namespace dap
 {
     namespace fastmath
     {
+        template <typename T>
+        class AudioBufferView;
         template <typename T>
         class AudioBuffer;
     }
 }
 
+// Non-owning view of frames [offset, offset + channelSize) of channels given by a table of channel
+// pointers, those of an AudioBuffer or the float** of an audio device, so that a block or a range
+// of its channels can be processed in place. T may be const, e.g. for the float const* const* of
+// IAudioProcess::setInputs. Copying a view copies neither samples nor channel pointers.
+template <typename T>
+class dap::fastmath::AudioBufferView
+{
+public:
+    using value_type      = T;
+    using pointer         = value_type*;
+    using reference       = value_type&;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+private:
+    pointer const* m_channels{nullptr};
+    size_type m_channelCount{0};
+    size_type m_offset{0};
+    size_type m_channelSize{0};
+
+public:
+    AudioBufferView() = default;
+    AudioBufferView(pointer const* channels,
+                    size_type channelCount,
+                    size_type channelSize,
+                    size_type offset = 0)
+    : m_channels(channels)
+    , m_channelCount(channelCount)
+    , m_offset(offset)
+    , m_channelSize(channelSize)
+    {
+    }
+    // a view of const samples of a view of mutable ones
+    template <typename U, DAP_REQUIRES(isSame<const U, T>() && !isSame<U, T>())>
+    AudioBufferView(const AudioBufferView<U>& other)
+    : AudioBufferView(other.channels(), other.channelCount(), other.channelSize(), other.offset())
+    {
+    }
+
+    size_type channelCount() const
+    {
+        return m_channelCount;
+    }
+    size_type channelSize() const
+    {
+        return m_channelSize;
+    }
+    size_type offset() const
+    {
+        return m_offset;
+    }
+    pointer const* channels() const
+    {
+        return m_channels;
+    }
+    pointer channel(size_type ch) const
+    {
+        assert(ch < m_channelCount);
+        return m_channels[ch] + m_offset;
+    }
+    reference operator()(size_type ch, size_type frame) const
+    {
+        assert(frame < m_channelSize);
+        return channel(ch)[frame];
+    }
+
+    // channels [first, first + count) of the view
+    AudioBufferView channels(size_type first, size_type count) const
+    {
+        assert(first + count <= m_channelCount);
+        return {m_channels + first, count, m_channelSize, m_offset};
+    }
+    // frames [first, first + count) of the view
+    AudioBufferView frames(size_type first, size_type count) const
+    {
+        assert(first + count <= m_channelSize);
+        return {m_channels, m_channelCount, count, m_offset + first};
+    }
+
+    void clear() const
+    {
+        fill(value_type(0));
+    }
+    void fill(const value_type& value) const
+    {
+        for (size_type ch = 0; ch < m_channelCount; ++ch)
+        {
+            std::fill_n(channel(ch), m_channelSize, value);
+        }
+    }
+    // copies the common channels and frames of other
+    template <typename U>
+    void copy(const AudioBufferView<U>& other) const
+    {
+        const size_type channelCount = std::min(m_channelCount, other.channelCount());
+        const size_type channelSize  = std::min(m_channelSize, other.channelSize());
+        for (size_type ch = 0; ch < channelCount; ++ch)
+        {
+            std::copy_n(other.channel(ch), channelSize, channel(ch));
+        }
+    }
+};
+
+// Channels of samples in a single allocation aligned to a cache line, each channel starting a
+// multiple of a cache line, channelStride samples, after the previous one. Moves steal the
+// allocation, and resize allocates only when the shape changes.
 template <typename T>
 class dap::fastmath::AudioBuffer
 {
 
 public:
-    using value_type = T;
-    using pointer = value_type *;
-    using const_pointer = const value_type *;
-    using reference = value_type &;
-    using const_reference = const value_type &;
-    using size_type = std::size_t;
+    using value_type      = T;
+    using pointer         = value_type*;
+    using const_pointer   = const value_type*;
+    using reference       = value_type&;
+    using const_reference = const value_type&;
+    using size_type       = std::size_t;
     using difference_type = std::ptrdiff_t;
 
     template <typename U>
     using Allocator = fastmath::AlignedAllocator<U>;
 
-    using array_type = Array<T, Allocator<T> >;
-    using vector_type = AlignedVector<array_type>;
+    using array_type      = Array<T, Allocator<T>>;
+    using vector_type     = AlignedVector<array_type>;
     using ptr_vector_type = AlignedVector<pointer>;
+    using view_type       = AudioBufferView<T>;
+    using const_view_type = AudioBufferView<const T>;
 
-    using iterator = typename vector_type::iterator;
+    using iterator       = typename vector_type::iterator;
+    using const_iterator = typename vector_type::const_iterator;
 
     using Channel = array_type;
 
 private:
     size_type m_channelCount{0};
     size_type m_channelSize{0};
-    vector_type m_buffer;
+    size_type m_channelStride{0};
+    AlignedVector<value_type> m_samples;
+    vector_type m_buffer; // non-owning arrays of the channels in m_samples
     ptr_vector_type m_ptrs;
 
-    void updatePtrs()
-    {
-        for (size_type i = 0; i < m_ptrs.size(); ++i)
-        {
-            m_ptrs[i] = m_buffer[i].data();
-        }
-    }
-
-    void forbidAllocation(bool b)
+    static size_type stride(size_type channelSize)
     {
-        for (auto& channel : m_buffer)
-        {
-            channel.forbidAllocation(b);
-        }
+        const size_type line = std::max(size_type(1), maxAlignment / sizeof(value_type));
+        return (channelSize + line - 1) / line * line;
     }
     void
     allocate(size_type channelCount, size_type channelSize, const_reference value = value_type(0))
@@ -66,13 +172,19 @@ private:
         {
             return;
         }
-        m_channelCount = channelCount;
-        m_channelSize = channelSize;
-        forbidAllocation(false);
-        m_buffer.resize(m_channelCount, Channel(m_channelSize, value));
-        m_ptrs.resize(m_channelCount, nullptr);
-        updatePtrs();
-        forbidAllocation(true);
+        m_channelCount  = channelCount;
+        m_channelSize   = channelSize;
+        m_channelStride = stride(channelSize);
+        m_samples.assign(m_channelCount * m_channelStride, value);
+        m_ptrs.resize(m_channelCount);
+        m_buffer.clear();
+        m_buffer.reserve(m_channelCount);
+        for (size_type ch = 0; ch < m_channelCount; ++ch)
+        {
+            m_ptrs[ch] = m_samples.data() + ch * m_channelStride;
+            m_buffer.emplace_back(m_ptrs[ch], m_channelSize, false);
+            m_buffer.back().forbidAllocation(true);
+        }
     }
 
 public:
@@ -85,19 +197,17 @@ public:
     }
     AudioBuffer(const AudioBuffer& other)
     {
-        allocate(other.channelCount(), other.channelSize());
-        for (size_type i = 0; i < m_channelCount; ++i)
-        {
-            m_buffer[i] = other.channel(i);
-        }
+        *this = other;
     }
     AudioBuffer(AudioBuffer&& other) noexcept
     {
-        allocate(other.channelCount(), 0);
-        for (size_type i = 0; i < m_channelCount; ++i)
-        {
-            m_buffer[i] = std::move(other.channel(i));
-        }
+        swap(other);
+    }
+    // copies the channels of a view, e.g. of the float** of an audio device
+    explicit AudioBuffer(const const_view_type& view)
+    {
+        allocate(view.channelCount(), view.channelSize());
+        this->view().copy(view);
     }
     AudioBuffer(const std::initializer_list<Channel>& list)
     {
@@ -120,30 +230,34 @@ public:
             m_buffer[i++] = channel;
         }
     }
+    // a single channel
     AudioBuffer(const std::initializer_list<value_type>& list)
     {
-        allocate(list.size(), size_type(1));
+        allocate(size_type(1), list.size());
         m_buffer[0] = list;
     }
     AudioBuffer& operator=(const AudioBuffer& other)
     {
         allocate(other.channelCount(), other.channelSize());
-        for (size_type i = 0; i < m_channelCount; ++i)
-        {
-            m_buffer[i] = other.channel(i);
-        }
+        std::copy(other.m_samples.begin(), other.m_samples.end(), m_samples.begin());
         return *this;
     }
+    // the samples of this are given to other, to be released with it
     AudioBuffer& operator=(AudioBuffer&& other) noexcept
     {
-        allocate(other.channelCount(), 0);
-        for (size_type i = 0; i < m_channelCount; ++i)
-        {
-            m_buffer[i] = std::move(other.channel(i));
-        }
+        swap(other);
         return *this;
     }
     ~AudioBuffer() = default;
+    void swap(AudioBuffer& other) noexcept
+    {
+        std::swap(m_channelCount, other.m_channelCount);
+        std::swap(m_channelSize, other.m_channelSize);
+        std::swap(m_channelStride, other.m_channelStride);
+        m_samples.swap(other.m_samples);
+        m_buffer.swap(other.m_buffer);
+        m_ptrs.swap(other.m_ptrs);
+    }
     Channel& channel(size_type ch)
     {
         return m_buffer[ch];
@@ -160,6 +274,11 @@ public:
     {
         return m_channelSize;
     }
+    // samples from the start of a channel to the start of the next one
+    size_type channelStride() const
+    {
+        return m_channelStride;
+    }
     ptr_vector_type& channelData()
     {
         return m_ptrs;
@@ -168,6 +287,7 @@ public:
     {
         return m_ptrs;
     }
+    // the channel pointers, e.g. for IAudioProcess::setOutputs
     pointer* data()
     {
         return m_ptrs.data();
@@ -176,6 +296,28 @@ public:
     {
         return m_ptrs.data();
     }
+    view_type view()
+    {
+        return {m_ptrs.data(), m_channelCount, m_channelSize};
+    }
+    const_view_type view() const
+    {
+        return {m_ptrs.data(), m_channelCount, m_channelSize};
+    }
+    // channels [firstChannel, firstChannel + channelCount) of frames
+    // [firstFrame, firstFrame + frameCount)
+    view_type
+    view(size_type firstChannel, size_type channelCount, size_type firstFrame, size_type frameCount)
+    {
+        return view().channels(firstChannel, channelCount).frames(firstFrame, frameCount);
+    }
+    const_view_type view(size_type firstChannel,
+                         size_type channelCount,
+                         size_type firstFrame,
+                         size_type frameCount) const
+    {
+        return view().channels(firstChannel, channelCount).frames(firstFrame, frameCount);
+    }
     void
     resize(size_type channelCount, size_type channelSize, const_reference value = value_type(0))
     {
@@ -185,7 +327,7 @@ public:
     {
         return m_buffer.begin();
     }
-    const iterator begin() const
+    const_iterator begin() const
     {
         return m_buffer.begin();
     }
@@ -193,23 +335,17 @@ public:
     {
         return m_buffer.end();
     }
-    const iterator end() const
+    const_iterator end() const
     {
         return m_buffer.end();
     }
     void clear()
     {
-        for (auto& channel : m_buffer)
-        {
-            channel.clear();
-        }
+        std::fill(m_samples.begin(), m_samples.end(), value_type(0));
     }
     void fill(const_reference value)
     {
-        for (auto& channel : m_buffer)
-        {
-            channel.fill(value);
-        }
+        std::fill(m_samples.begin(), m_samples.end(), value);
     }
 };
 
@@ -0,0 +1,228 @@
+#ifndef DAP_FASTMATH_FFT_H
+#define DAP_FASTMATH_FFT_H
+
+#include "AlignedVector.h"
+#include "Pack.h"
+#include "base/TypeTraits.h"
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+
+namespace dap
+{
+    namespace fastmath
+    {
+        template <typename T>
+        class FFT;
+    }
+}
+
+// FFT of real signals of a power of two size, computed as a complex radix-2 FFT of half the size.
+// Spectra hold the size() / 2 + 1 bins from DC to Nyquist, their real and imaginary parts in two
+// separate arrays, so that both the butterflies and the products of spectra vectorize. The
+// inverse is not normalized, inverse(forward(x)) being size() * x. An FFT holds its work buffers
+// and so must not be shared by threads.
+template <typename T>
+class dap::fastmath::FFT final
+{
+    static_assert(isFloatingPoint<T>(), "FFT needs floating point samples");
+
+    using pack_t = Pack<T, 4>;
+
+    size_t m_size;
+    size_t m_half;
+    std::vector<uint32_t> m_reverse;
+    // twiddles of the butterflies of half h at offset h - 1, those splitting the real spectrum
+    AlignedVector<T> m_twiddleRe;
+    AlignedVector<T> m_twiddleIm;
+    AlignedVector<T> m_splitRe;
+    AlignedVector<T> m_splitIm;
+    // the complex FFT, followed by a copy of its first bin so that bin half - k reads as bin -k
+    AlignedVector<T> m_re;
+    AlignedVector<T> m_im;
+
+    static pack_t reversed(const T* x)
+    {
+        return pack_t(x[3], x[2], x[1], x[0]);
+    }
+    // in place complex FFT of the bit reversed m_re and m_im, its first two stages fused
+    template <bool Inverse>
+    void transform()
+    {
+        T* re = m_re.data();
+        T* im = m_im.data();
+        // the twiddles of the second stage are 1 and -i, or i when inverse
+        const T sign = Inverse ? T(-1) : T(1);
+        for (size_t k = 0; k < m_half; k += 4)
+        {
+            const T r0 = re[k] + re[k + 1];
+            const T i0 = im[k] + im[k + 1];
+            const T r1 = re[k] - re[k + 1];
+            const T i1 = im[k] - im[k + 1];
+            const T r2 = re[k + 2] + re[k + 3];
+            const T i2 = im[k + 2] + im[k + 3];
+            const T tr = sign * (im[k + 2] - im[k + 3]);
+            const T ti = sign * (re[k + 3] - re[k + 2]);
+            re[k]      = r0 + r2;
+            im[k]      = i0 + i2;
+            re[k + 2]  = r0 - r2;
+            im[k + 2]  = i0 - i2;
+            re[k + 1]  = r1 + tr;
+            im[k + 1]  = i1 + ti;
+            re[k + 3]  = r1 - tr;
+            im[k + 3]  = i1 - ti;
+        }
+        // the butterflies of the later stages, 4 at a time
+        for (size_t h = 4; h < m_half; h *= 2)
+        {
+            const T* wr = m_twiddleRe.data() + h - 1;
+            const T* wi = m_twiddleIm.data() + h - 1;
+            for (size_t start = 0; start < m_half; start += 2 * h)
+            {
+                T* re0 = re + start;
+                T* im0 = im + start;
+                T* re1 = re0 + h;
+                T* im1 = im0 + h;
+                for (size_t j = 0; j < h; j += 4)
+                {
+                    const auto c  = pack_t::load(wr + j);
+                    const auto s  = Inverse ? -pack_t::load(wi + j) : pack_t::load(wi + j);
+                    const auto r0 = pack_t::load(re0 + j);
+                    const auto i0 = pack_t::load(im0 + j);
+                    const auto r1 = pack_t::load(re1 + j);
+                    const auto i1 = pack_t::load(im1 + j);
+                    const auto tr = c * r1 - s * i1;
+                    const auto ti = c * i1 + s * r1;
+                    (r0 - tr).store(re1 + j);
+                    (i0 - ti).store(im1 + j);
+                    (r0 + tr).store(re0 + j);
+                    (i0 + ti).store(im0 + j);
+                }
+            }
+        }
+    }
+
+public:
+    explicit FFT(size_t size)
+    : m_size(size)
+    , m_half(size / 2)
+    , m_reverse(m_half)
+    , m_twiddleRe(m_half)
+    , m_twiddleIm(m_half)
+    , m_splitRe(m_half + 1)
+    , m_splitIm(m_half + 1)
+    , m_re(m_half + 1)
+    , m_im(m_half + 1)
+    {
+        if (size < 8 || (size & (size - 1)) != 0)
+        {
+            throw std::invalid_argument("FFT size must be a power of two of at least 8");
+        }
+        size_t bits = 0;
+        while ((size_t(1) << bits) < m_half)
+        {
+            ++bits;
+        }
+        for (size_t k = 0; k < m_half; ++k)
+        {
+            uint32_t reversed = 0;
+            for (size_t b = 0; b < bits; ++b)
+            {
+                reversed |= uint32_t((k >> b) & 1u) << (bits - 1 - b);
+            }
+            m_reverse[k] = reversed;
+        }
+        for (size_t h = 1; h < m_half; h *= 2)
+        {
+            for (size_t j = 0; j < h; ++j)
+            {
+                const double w         = -M_PI * double(j) / double(h);
+                m_twiddleRe[h - 1 + j] = T(std::cos(w));
+                m_twiddleIm[h - 1 + j] = T(std::sin(w));
+            }
+        }
+        for (size_t k = 0; k <= m_half; ++k)
+        {
+            const double w = -2.0 * M_PI * double(k) / double(size);
+            m_splitRe[k]   = T(std::cos(w));
+            m_splitIm[k]   = T(std::sin(w));
+        }
+    }
+    size_t size() const
+    {
+        return m_size;
+    }
+    // bins of a spectrum
+    size_t bins() const
+    {
+        return m_half + 1;
+    }
+    // spectrum of the size() samples of in
+    void forward(const T* in, T* re, T* im)
+    {
+        T* zr                = m_re.data();
+        T* zi                = m_im.data();
+        const uint32_t* bits = m_reverse.data();
+        for (size_t k = 0; k < m_half; ++k)
+        {
+            zr[bits[k]] = in[2 * k];
+            zi[bits[k]] = in[2 * k + 1];
+        }
+        transform<false>();
+        zr[m_half] = zr[0];
+        zi[m_half] = zi[0];
+        // the spectra of the even and odd samples, Z[k] +- conj(Z[half - k]), joined
+        re[0] = zr[0] + zi[0];
+        im[0] = T(0);
+        for (size_t k = 1; k <= m_half; k += 4)
+        {
+            const auto ar  = pack_t::load(zr + k);
+            const auto ai  = pack_t::load(zi + k);
+            const auto br  = reversed(zr + m_half - k - 3);
+            const auto bi  = reversed(zi + m_half - k - 3);
+            const auto er  = T(0.5) * (ar + br);
+            const auto ei  = T(0.5) * (ai - bi);
+            const auto orr = T(0.5) * (ai + bi);
+            const auto oi  = T(0.5) * (br - ar);
+            const auto wr  = pack_t::load(m_splitRe.data() + k);
+            const auto wi  = pack_t::load(m_splitIm.data() + k);
+            (er + wr * orr - wi * oi).store(re + k);
+            (ei + wr * oi + wi * orr).store(im + k);
+        }
+        im[m_half] = T(0);
+    }
+    // size() times the samples whose spectrum is re and im
+    void inverse(const T* re, const T* im, T* out)
+    {
+        T* zr                = m_re.data();
+        T* zi                = m_im.data();
+        const uint32_t* bits = m_reverse.data();
+        for (size_t k = 0; k < m_half; k += 4)
+        {
+            // E[k] + i O[k], O[k] being (X[k] - conj(X[half - k])) / W[k]
+            const auto ar  = pack_t::load(re + k);
+            const auto ai  = pack_t::load(im + k);
+            const auto br  = reversed(re + m_half - k - 3);
+            const auto bi  = reversed(im + m_half - k - 3);
+            const auto wr  = pack_t::load(m_splitRe.data() + k);
+            const auto wi  = pack_t::load(m_splitIm.data() + k);
+            const auto orr = wr * (ar - br) + wi * (ai + bi);
+            const auto oi  = wr * (ai + bi) - wi * (ar - br);
+            const auto r   = ar + br - oi;
+            const auto i   = ai - bi + orr;
+            for (size_t lane = 0; lane < 4; ++lane)
+            {
+                zr[bits[k + lane]] = r[lane];
+                zi[bits[k + lane]] = i[lane];
+            }
+        }
+        transform<true>();
+        for (size_t k = 0; k < m_half; ++k)
+        {
+            out[2 * k]     = zr[k];
+            out[2 * k + 1] = zi[k];
+        }
+    }
+};
+
+#endif // DAP_FASTMATH_FFT_H
@@ -17,7 +17,8 @@ namespace dap
     }
 }
 
-template <typename T, unsigned int Alignas = 16>
+// aligned to a cache line by default, which is also the size of the widest vectors, AVX-512
+template <typename T, unsigned int Alignas = 64>
 class dap::fastmath::AlignedAllocator
 {
     static_assert(IsPowerOfTwo<Alignas>::value, "Alignment size needs to be a power of two");
@@ -35,7 +36,7 @@ public:
     template <typename U>
     struct rebind
     {
-        using other = AlignedAllocator<U>;
+        using other = AlignedAllocator<U, Alignas>;
     };
 
     inline pointer allocate(size_type cnt,
@@ -0,0 +1,569 @@
+#ifndef DAP_FASTMATH_PACK_H
+#define DAP_FASTMATH_PACK_H
+
+#include "base/TypeTraits.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+
+#if defined(__SSE__)
+#include <xmmintrin.h>
+#endif
+#if defined(__SSE4_1__)
+#include <smmintrin.h>
+#endif
+#if defined(__AVX__)
+#include <immintrin.h>
+#endif
+
+// Pack<T, N> holds N floating point lanes that behave as N independent scalars, so a processor
+// templated on its scalar type computes N voices at once when given a Pack. Arithmetic, min/max,
+// sqrt and floor use SSE (float4) or AVX (float8) when available and plain loops otherwise,
+// transcendental functions are evaluated lane by lane. Comparisons return a PackMask to be used
+// with select, as branching on a condition is only possible when it is the same for all lanes.
+
+namespace dap
+{
+    namespace fastmath
+    {
+        template <typename T, size_t N>
+        class Pack;
+        template <typename T, size_t N>
+        class PackMask;
+
+        using float4 = Pack<float, 4>;
+        using float8 = Pack<float, 8>;
+
+        namespace detail
+        {
+            template <typename T, size_t N>
+            struct GenericPackKernels;
+            template <typename T, size_t N>
+            struct PackKernels;
+        }
+    }
+
+    template <typename T, size_t N>
+    struct lane_traits<fastmath::Pack<T, N>>
+    {
+        using scalar_type               = T;
+        static constexpr size_t size    = N;
+        static constexpr bool is_packed = true;
+    };
+}
+
+template <typename T, size_t N>
+struct dap::fastmath::detail::GenericPackKernels
+{
+    using bits_t = std::conditional_t<sizeof(T) == 8, uint64_t, uint32_t>;
+
+    static T fromBool(bool x)
+    {
+        const bits_t bits = x ? ~bits_t(0) : bits_t(0);
+        T t;
+        std::memcpy(&t, &bits, sizeof(T));
+        return t;
+    }
+    static bits_t toBits(T x)
+    {
+        bits_t bits;
+        std::memcpy(&bits, &x, sizeof(T));
+        return bits;
+    }
+    template <typename Op>
+    static void map(const T* a, const T* b, T* out, Op op)
+    {
+        for (size_t i = 0; i < N; ++i)
+        {
+            out[i] = op(a[i], b[i]);
+        }
+    }
+    template <typename Op>
+    static void map(const T* a, T* out, Op op)
+    {
+        for (size_t i = 0; i < N; ++i)
+        {
+            out[i] = op(a[i]);
+        }
+    }
+    static void add(const T* a, const T* b, T* out)
+    {
+        map(a, b, out, [](T x, T y) { return x + y; });
+    }
+    static void sub(const T* a, const T* b, T* out)
+    {
+        map(a, b, out, [](T x, T y) { return x - y; });
+    }
+    static void mul(const T* a, const T* b, T* out)
+    {
+        map(a, b, out, [](T x, T y) { return x * y; });
+    }
+    static void div(const T* a, const T* b, T* out)
+    {
+        map(a, b, out, [](T x, T y) { return x / y; });
+    }
+    static void min(const T* a, const T* b, T* out)
+    {
+        map(a, b, out, [](T x, T y) { return y < x ? y : x; });
+    }
+    static void max(const T* a, const T* b, T* out)
+    {
+        map(a, b, out, [](T x, T y) { return x < y ? y : x; });
+    }
+    static void sqrt(const T* a, T* out)
+    {
+        map(a, out, [](T x) { return std::sqrt(x); });
+    }
+    static void floor(const T* a, T* out)
+    {
+        map(a, out, [](T x) { return std::floor(x); });
+    }
+    static void less(const T* a, const T* b, T* mask)
+    {
+        map(a, b, mask, [](T x, T y) { return fromBool(x < y); });
+    }
+    static void lessEqual(const T* a, const T* b, T* mask)
+    {
+        map(a, b, mask, [](T x, T y) { return fromBool(x <= y); });
+    }
+    static void equal(const T* a, const T* b, T* mask)
+    {
+        map(a, b, mask, [](T x, T y) { return fromBool(x == y); });
+    }
+    static void select(const T* mask, const T* a, const T* b, T* out)
+    {
+        for (size_t i = 0; i < N; ++i)
+        {
+            out[i] = toBits(mask[i]) != 0 ? a[i] : b[i];
+        }
+    }
+};
+
+template <typename T, size_t N>
+struct dap::fastmath::detail::PackKernels : GenericPackKernels<T, N>
+{
+};
+
+#if defined(__SSE__)
+template <>
+struct dap::fastmath::detail::PackKernels<float, 4> : GenericPackKernels<float, 4>
+{
+    static void add(const float* a, const float* b, float* out)
+    {
+        _mm_store_ps(out, _mm_add_ps(_mm_load_ps(a), _mm_load_ps(b)));
+    }
+    static void sub(const float* a, const float* b, float* out)
+    {
+        _mm_store_ps(out, _mm_sub_ps(_mm_load_ps(a), _mm_load_ps(b)));
+    }
+    static void mul(const float* a, const float* b, float* out)
+    {
+        _mm_store_ps(out, _mm_mul_ps(_mm_load_ps(a), _mm_load_ps(b)));
+    }
+    static void div(const float* a, const float* b, float* out)
+    {
+        _mm_store_ps(out, _mm_div_ps(_mm_load_ps(a), _mm_load_ps(b)));
+    }
+    static void min(const float* a, const float* b, float* out)
+    {
+        _mm_store_ps(out, _mm_min_ps(_mm_load_ps(a), _mm_load_ps(b)));
+    }
+    static void max(const float* a, const float* b, float* out)
+    {
+        _mm_store_ps(out, _mm_max_ps(_mm_load_ps(a), _mm_load_ps(b)));
+    }
+    static void sqrt(const float* a, float* out)
+    {
+        _mm_store_ps(out, _mm_sqrt_ps(_mm_load_ps(a)));
+    }
+#if defined(__SSE4_1__)
+    static void floor(const float* a, float* out)
+    {
+        _mm_store_ps(out, _mm_floor_ps(_mm_load_ps(a)));
+    }
+#endif
+    static void less(const float* a, const float* b, float* mask)
+    {
+        _mm_store_ps(mask, _mm_cmplt_ps(_mm_load_ps(a), _mm_load_ps(b)));
+    }
+    static void lessEqual(const float* a, const float* b, float* mask)
+    {
+        _mm_store_ps(mask, _mm_cmple_ps(_mm_load_ps(a), _mm_load_ps(b)));
+    }
+    static void equal(const float* a, const float* b, float* mask)
+    {
+        _mm_store_ps(mask, _mm_cmpeq_ps(_mm_load_ps(a), _mm_load_ps(b)));
+    }
+    static void select(const float* mask, const float* a, const float* b, float* out)
+    {
+        const __m128 m = _mm_load_ps(mask);
+        _mm_store_ps(out,
+                     _mm_or_ps(_mm_and_ps(m, _mm_load_ps(a)), _mm_andnot_ps(m, _mm_load_ps(b))));
+    }
+};
+#endif
+
+#if defined(__AVX__)
+template <>
+struct dap::fastmath::detail::PackKernels<float, 8> : GenericPackKernels<float, 8>
+{
+    static void add(const float* a, const float* b, float* out)
+    {
+        _mm256_store_ps(out, _mm256_add_ps(_mm256_load_ps(a), _mm256_load_ps(b)));
+    }
+    static void sub(const float* a, const float* b, float* out)
+    {
+        _mm256_store_ps(out, _mm256_sub_ps(_mm256_load_ps(a), _mm256_load_ps(b)));
+    }
+    static void mul(const float* a, const float* b, float* out)
+    {
+        _mm256_store_ps(out, _mm256_mul_ps(_mm256_load_ps(a), _mm256_load_ps(b)));
+    }
+    static void div(const float* a, const float* b, float* out)
+    {
+        _mm256_store_ps(out, _mm256_div_ps(_mm256_load_ps(a), _mm256_load_ps(b)));
+    }
+    static void min(const float* a, const float* b, float* out)
+    {
+        _mm256_store_ps(out, _mm256_min_ps(_mm256_load_ps(a), _mm256_load_ps(b)));
+    }
+    static void max(const float* a, const float* b, float* out)
+    {
+        _mm256_store_ps(out, _mm256_max_ps(_mm256_load_ps(a), _mm256_load_ps(b)));
+    }
+    static void sqrt(const float* a, float* out)
+    {
+        _mm256_store_ps(out, _mm256_sqrt_ps(_mm256_load_ps(a)));
+    }
+    static void floor(const float* a, float* out)
+    {
+        _mm256_store_ps(out, _mm256_floor_ps(_mm256_load_ps(a)));
+    }
+    static void less(const float* a, const float* b, float* mask)
+    {
+        _mm256_store_ps(mask, _mm256_cmp_ps(_mm256_load_ps(a), _mm256_load_ps(b), _CMP_LT_OQ));
+    }
+    static void lessEqual(const float* a, const float* b, float* mask)
+    {
+        _mm256_store_ps(mask, _mm256_cmp_ps(_mm256_load_ps(a), _mm256_load_ps(b), _CMP_LE_OQ));
+    }
+    static void equal(const float* a, const float* b, float* mask)
+    {
+        _mm256_store_ps(mask, _mm256_cmp_ps(_mm256_load_ps(a), _mm256_load_ps(b), _CMP_EQ_OQ));
+    }
+    static void select(const float* mask, const float* a, const float* b, float* out)
+    {
+        _mm256_store_ps(out,
+                        _mm256_blendv_ps(_mm256_load_ps(b), _mm256_load_ps(a), _mm256_load_ps(mask)));
+    }
+};
+#endif
+
+template <typename T, size_t N>
+class dap::fastmath::Pack final
+{
+    static_assert(isFloatingPoint<T>(), "Pack lanes must be floating point");
+    static_assert(IsPowerOfTwo<N>::value, "Pack size must be a power of two");
+
+    using kernels = detail::PackKernels<T, N>;
+
+    alignas(N * sizeof(T)) T m_lanes[N];
+
+public:
+    using value_type = T;
+
+    Pack() = default;
+    // broadcasts value to all lanes
+    template <typename U, DAP_REQUIRES(isArithmetic<U>())>
+    constexpr Pack(U value) noexcept // NOLINT, implicit so scalars mix with packs
+    : m_lanes{}
+    {
+        for (size_t i = 0; i < N; ++i)
+        {
+            m_lanes[i] = T(value);
+        }
+    }
+    template <typename... Us,
+              DAP_REQUIRES(sizeof...(Us) == N && N > 1 && dap::all(isArithmetic<Us>()...))>
+    constexpr Pack(Us... lanes) noexcept
+    : m_lanes{T(lanes)...}
+    {
+    }
+    static constexpr size_t size()
+    {
+        return N;
+    }
+    static Pack load(const T* data)
+    {
+        Pack p;
+        std::memcpy(p.m_lanes, data, sizeof(m_lanes));
+        return p;
+    }
+    void store(T* data) const
+    {
+        std::memcpy(data, m_lanes, sizeof(m_lanes));
+    }
+    T* data()
+    {
+        return m_lanes;
+    }
+    const T* data() const
+    {
+        return m_lanes;
+    }
+    T& operator[](size_t lane)
+    {
+        return m_lanes[lane];
+    }
+    const T& operator[](size_t lane) const
+    {
+        return m_lanes[lane];
+    }
+    // applies fn to each lane
+    template <typename Fn>
+    Pack map(Fn&& fn) const
+    {
+        Pack p;
+        kernels::map(m_lanes, p.m_lanes, std::forward<Fn>(fn));
+        return p;
+    }
+
+    Pack& operator+=(const Pack& rhs)
+    {
+        kernels::add(m_lanes, rhs.m_lanes, m_lanes);
+        return *this;
+    }
+    Pack& operator-=(const Pack& rhs)
+    {
+        kernels::sub(m_lanes, rhs.m_lanes, m_lanes);
+        return *this;
+    }
+    Pack& operator*=(const Pack& rhs)
+    {
+        kernels::mul(m_lanes, rhs.m_lanes, m_lanes);
+        return *this;
+    }
+    Pack& operator/=(const Pack& rhs)
+    {
+        kernels::div(m_lanes, rhs.m_lanes, m_lanes);
+        return *this;
+    }
+    Pack operator-() const
+    {
+        Pack p(T(0));
+        kernels::sub(p.m_lanes, m_lanes, p.m_lanes);
+        return p;
+    }
+
+    friend Pack min(const Pack& a, const Pack& b)
+    {
+        Pack p;
+        kernels::min(a.m_lanes, b.m_lanes, p.m_lanes);
+        return p;
+    }
+    friend Pack max(const Pack& a, const Pack& b)
+    {
+        Pack p;
+        kernels::max(a.m_lanes, b.m_lanes, p.m_lanes);
+        return p;
+    }
+    friend Pack sqrt(const Pack& a)
+    {
+        Pack p;
+        kernels::sqrt(a.m_lanes, p.m_lanes);
+        return p;
+    }
+    friend Pack floor(const Pack& a)
+    {
+        Pack p;
+        kernels::floor(a.m_lanes, p.m_lanes);
+        return p;
+    }
+    friend PackMask<T, N> operator<(const Pack& a, const Pack& b)
+    {
+        PackMask<T, N> m;
+        kernels::less(a.m_lanes, b.m_lanes, m.data());
+        return m;
+    }
+    friend PackMask<T, N> operator<=(const Pack& a, const Pack& b)
+    {
+        PackMask<T, N> m;
+        kernels::lessEqual(a.m_lanes, b.m_lanes, m.data());
+        return m;
+    }
+    friend PackMask<T, N> operator>(const Pack& a, const Pack& b)
+    {
+        return b < a;
+    }
+    friend PackMask<T, N> operator>=(const Pack& a, const Pack& b)
+    {
+        return b <= a;
+    }
+    friend PackMask<T, N> operator==(const Pack& a, const Pack& b)
+    {
+        PackMask<T, N> m;
+        kernels::equal(a.m_lanes, b.m_lanes, m.data());
+        return m;
+    }
+};
+
+// per lane result of a comparison, true lanes have all bits set
+template <typename T, size_t N>
+class dap::fastmath::PackMask final
+{
+    using kernels = detail::PackKernels<T, N>;
+
+    alignas(N * sizeof(T)) T m_lanes[N];
+
+public:
+    T* data()
+    {
+        return m_lanes;
+    }
+    const T* data() const
+    {
+        return m_lanes;
+    }
+    bool operator[](size_t lane) const
+    {
+        return kernels::toBits(m_lanes[lane]) != 0;
+    }
+    bool any() const
+    {
+        for (size_t i = 0; i < N; ++i)
+        {
+            if ((*this)[i])
+                return true;
+        }
+        return false;
+    }
+    bool all() const
+    {
+        for (size_t i = 0; i < N; ++i)
+        {
+            if (!(*this)[i])
+                return false;
+        }
+        return true;
+    }
+};
+
+namespace dap
+{
+    namespace fastmath
+    {
+        // scalar counterpart of select(PackMask, Pack, Pack)
+        template <typename T, DAP_REQUIRES(isArithmetic<T>())>
+        constexpr T select(bool condition, T a, T b)
+        {
+            return condition ? a : b;
+        }
+        // lanes of a where mask is true, lanes of b otherwise
+        template <typename T, size_t N>
+        inline Pack<T, N> select(const PackMask<T, N>& mask, const Pack<T, N>& a, const Pack<T, N>& b)
+        {
+            Pack<T, N> p;
+            detail::PackKernels<T, N>::select(mask.data(), a.data(), b.data(), p.data());
+            return p;
+        }
+
+#define DAP_FASTMATH_PACK_BINARY_OPERATOR(op)                                                   \
+    template <typename T, size_t N>                                                            \
+    inline Pack<T, N> operator op(Pack<T, N> a, const Pack<T, N>& b)                           \
+    {                                                                                          \
+        return a op## = b;                                                                     \
+    }                                                                                          \
+    template <typename T, size_t N, typename U, DAP_REQUIRES(isArithmetic<U>())>               \
+    inline Pack<T, N> operator op(Pack<T, N> a, U b)                                           \
+    {                                                                                          \
+        return a op## = Pack<T, N>(b);                                                         \
+    }                                                                                          \
+    template <typename U, typename T, size_t N, DAP_REQUIRES(isArithmetic<U>())>               \
+    inline Pack<T, N> operator op(U a, const Pack<T, N>& b)                                    \
+    {                                                                                          \
+        return Pack<T, N>(a) op## = b;                                                         \
+    }
+
+        DAP_FASTMATH_PACK_BINARY_OPERATOR(+)
+        DAP_FASTMATH_PACK_BINARY_OPERATOR(-)
+        DAP_FASTMATH_PACK_BINARY_OPERATOR(*)
+        DAP_FASTMATH_PACK_BINARY_OPERATOR(/)
+
+#undef DAP_FASTMATH_PACK_BINARY_OPERATOR
+
+#define DAP_FASTMATH_PACK_COMPARE_OPERATOR(op)                                                  \
+    template <typename T, size_t N, typename U, DAP_REQUIRES(isArithmetic<U>())>               \
+    inline PackMask<T, N> operator op(const Pack<T, N>& a, U b)                                \
+    {                                                                                          \
+        return a op Pack<T, N>(b);                                                             \
+    }                                                                                          \
+    template <typename U, typename T, size_t N, DAP_REQUIRES(isArithmetic<U>())>               \
+    inline PackMask<T, N> operator op(U a, const Pack<T, N>& b)                                \
+    {                                                                                          \
+        return Pack<T, N>(a) op b;                                                             \
+    }
+
+        DAP_FASTMATH_PACK_COMPARE_OPERATOR(<)
+        DAP_FASTMATH_PACK_COMPARE_OPERATOR(<=)
+        DAP_FASTMATH_PACK_COMPARE_OPERATOR(>)
+        DAP_FASTMATH_PACK_COMPARE_OPERATOR(>=)
+        DAP_FASTMATH_PACK_COMPARE_OPERATOR(==)
+
+#undef DAP_FASTMATH_PACK_COMPARE_OPERATOR
+
+#define DAP_FASTMATH_PACK_UNARY_FUNCTION(func)                  \
+    template <typename T, size_t N>                             \
+    inline Pack<T, N> func(const Pack<T, N>& a)                 \
+    {                                                           \
+        return a.map([](T x) { return std::func(x); });         \
+    }
+
+        DAP_FASTMATH_PACK_UNARY_FUNCTION(abs)
+        DAP_FASTMATH_PACK_UNARY_FUNCTION(fabs)
+        DAP_FASTMATH_PACK_UNARY_FUNCTION(sin)
+        DAP_FASTMATH_PACK_UNARY_FUNCTION(cos)
+        DAP_FASTMATH_PACK_UNARY_FUNCTION(tan)
+        DAP_FASTMATH_PACK_UNARY_FUNCTION(tanh)
+        DAP_FASTMATH_PACK_UNARY_FUNCTION(exp)
+        DAP_FASTMATH_PACK_UNARY_FUNCTION(log)
+
+#undef DAP_FASTMATH_PACK_UNARY_FUNCTION
+
+        template <typename T, size_t N>
+        inline Pack<T, N> pow(const Pack<T, N>& a, const Pack<T, N>& b)
+        {
+            Pack<T, N> p;
+            for (size_t i = 0; i < N; ++i)
+            {
+                p[i] = std::pow(a[i], b[i]);
+            }
+            return p;
+        }
+        template <typename T, size_t N>
+        inline Pack<T, N> hypot(const Pack<T, N>& a, const Pack<T, N>& b)
+        {
+            return sqrt(a * a + b * b);
+        }
+        template <typename T, size_t N>
+        inline Pack<T, N> clip(const Pack<T, N>& x, const Pack<T, N>& low, const Pack<T, N>& high)
+        {
+            return min(max(x, low), high);
+        }
+
+        template <typename T, size_t N>
+        std::ostream& operator<<(std::ostream& out, const Pack<T, N>& p)
+        {
+            out << "(";
+            for (size_t i = 0; i < N; ++i)
+            {
+                out << (i == 0 ? "" : ", ") << p[i];
+            }
+            out << ")";
+            return out;
+        }
+    }
+}
+
+#endif // DAP_FASTMATH_PACK_H
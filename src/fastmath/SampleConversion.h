@@ -0,0 +1,222 @@
+#ifndef DAP_FASTMATH_SAMPLE_CONVERSION_H
+#define DAP_FASTMATH_SAMPLE_CONVERSION_H
+
+#include "fastmath/ArrayKernels.h"
+#include "fastmath/AudioBuffer.h"
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+
+// Conversions of float samples, of full scale [-1, 1], to the 16, 24 and 32 bit integers of sound
+// files and audio devices and back, and of the planar channels of an AudioBuffer to interleaved
+// frames of 1 to 8 channels and back, running the kernels of the current ArrayBackend. Integers
+// are rounded to nearest and clipped, optionally with a triangular dither of one lsb drawn from
+// random, any generator with fill(float* x, size_t size) of uniform floats in [-1, 1), as
+// dsp::UniformDistribution. Nothing allocates, so that they can run in an audio callback.
+
+namespace dap
+{
+    namespace fastmath
+    {
+        // packed little endian 24 bit sample, as in WAV files
+        struct Int24
+        {
+            uint8_t bytes[3];
+        };
+        static_assert(sizeof(Int24) == 3, "Int24 must be packed");
+
+        namespace detail
+        {
+            // the most channels of interleaved frames
+            constexpr size_t maxInterleavedChannels = 8;
+
+            inline void quantize(int16_t* result, const float* x, const float* dither, size_t size)
+            {
+                arrayKernels().toInt16(result, x, dither, size);
+            }
+            inline void quantize(Int24* result, const float* x, const float* dither, size_t size)
+            {
+                arrayKernels().toInt24(reinterpret_cast<uint8_t*>(result), x, dither, size);
+            }
+            inline void quantize(int32_t* result, const float* x, const float* dither, size_t size)
+            {
+                arrayKernels().toInt32(result, x, dither, size);
+            }
+            inline void dequantize(float* result, const int16_t* x, size_t size)
+            {
+                arrayKernels().fromInt16(result, x, size);
+            }
+            inline void dequantize(float* result, const Int24* x, size_t size)
+            {
+                arrayKernels().fromInt24(result, reinterpret_cast<const uint8_t*>(x), size);
+            }
+            inline void dequantize(float* result, const int32_t* x, size_t size)
+            {
+                arrayKernels().fromInt32(result, x, size);
+            }
+
+            // triangular noise in (-1, 1), the sum of two uniform floats in [-1/2, 1/2)
+            template <typename Random>
+            void tpdf(float* result, float* scratch, size_t size, Random& random)
+            {
+                random.fill(result, size);
+                random.fill(scratch, size);
+                for (size_t i = 0; i < size; ++i)
+                {
+                    result[i] = 0.5f * (result[i] + scratch[i]);
+                }
+            }
+
+            // the channels of x from its offset
+            template <typename T>
+            void channels(T* (&result)[maxInterleavedChannels], const AudioBufferView<T>& x)
+            {
+                if (x.channelCount() == 0 || x.channelCount() > maxInterleavedChannels)
+                {
+                    throw std::invalid_argument("Interleaved frames have 1 to 8 channels.");
+                }
+                for (size_t ch = 0; ch < x.channelCount(); ++ch)
+                {
+                    result[ch] = x.channel(ch);
+                }
+            }
+        }
+
+        // x clipped to full scale
+        inline void convert(int16_t* result, const float* x, size_t size)
+        {
+            detail::quantize(result, x, nullptr, size);
+        }
+        inline void convert(Int24* result, const float* x, size_t size)
+        {
+            detail::quantize(result, x, nullptr, size);
+        }
+        inline void convert(int32_t* result, const float* x, size_t size)
+        {
+            detail::quantize(result, x, nullptr, size);
+        }
+        // x dithered then clipped to full scale
+        template <typename Int, typename Random>
+        void convert(Int* result, const float* x, size_t size, Random& random)
+        {
+            constexpr size_t block = 256;
+            float dither[block];
+            float scratch[block];
+            for (size_t i = 0; i < size; i += block)
+            {
+                const size_t count = std::min(block, size - i);
+                detail::tpdf(dither, scratch, count, random);
+                detail::quantize(result + i, x + i, dither, count);
+            }
+        }
+        inline void convert(float* result, const int16_t* x, size_t size)
+        {
+            detail::dequantize(result, x, size);
+        }
+        inline void convert(float* result, const Int24* x, size_t size)
+        {
+            detail::dequantize(result, x, size);
+        }
+        inline void convert(float* result, const int32_t* x, size_t size)
+        {
+            detail::dequantize(result, x, size);
+        }
+
+        // the frames of x, of float, int16_t, Int24 or int32_t samples, each frame holding one
+        // sample of every channel
+        template <typename Sample>
+        void interleave(Sample* result, const AudioBufferView<const float>& x);
+        // the dithered integer frames of x
+        template <typename Int, typename Random>
+        void interleave(Int* result, const AudioBufferView<const float>& x, Random& random);
+        // the channels of the frames x, of float, int16_t, Int24 or int32_t samples
+        template <typename Sample>
+        void deinterleave(const AudioBufferView<float>& result, const Sample* x);
+
+        template <typename Sample>
+        void interleave(Sample* result, const AudioBuffer<float>& x)
+        {
+            interleave(result, x.view());
+        }
+        template <typename Int, typename Random>
+        void interleave(Int* result, const AudioBuffer<float>& x, Random& random)
+        {
+            interleave(result, x.view(), random);
+        }
+        template <typename Sample>
+        void deinterleave(AudioBuffer<float>& result, const Sample* x)
+        {
+            deinterleave(result.view(), x);
+        }
+
+        namespace detail
+        {
+            // frames of x interleaved as floats on the stack, then quantized into result
+            template <typename Int, typename Quantize>
+            void interleave(Int* result, const AudioBufferView<const float>& x, Quantize quantize)
+            {
+                constexpr size_t block = 512;
+                float frames[block];
+                const size_t channelCount = std::max(size_t(1), x.channelCount());
+                const size_t step         = block / channelCount;
+                for (size_t i = 0; i < x.channelSize(); i += step)
+                {
+                    const size_t count = std::min(step, x.channelSize() - i);
+                    fastmath::interleave(frames, x.frames(i, count));
+                    quantize(result + i * channelCount, frames, count * channelCount);
+                }
+            }
+        }
+
+        template <typename Sample>
+        void interleave(Sample* result, const AudioBufferView<const float>& x)
+        {
+            if constexpr (std::is_same<Sample, float>::value)
+            {
+                const float* channels[detail::maxInterleavedChannels];
+                detail::channels(channels, x);
+                arrayKernels().interleave(result, channels, x.channelCount(), x.channelSize());
+            }
+            else
+            {
+                detail::interleave(result, x, [](Sample* r, const float* frames, size_t size) {
+                    detail::quantize(r, frames, nullptr, size);
+                });
+            }
+        }
+        template <typename Int, typename Random>
+        void interleave(Int* result, const AudioBufferView<const float>& x, Random& random)
+        {
+            detail::interleave(result, x, [&random](Int* r, const float* frames, size_t size) {
+                convert(r, frames, size, random);
+            });
+        }
+        template <typename Sample>
+        void deinterleave(const AudioBufferView<float>& result, const Sample* x)
+        {
+            if constexpr (std::is_same<Sample, float>::value)
+            {
+                float* channels[detail::maxInterleavedChannels];
+                detail::channels(channels, result);
+                arrayKernels().deinterleave(
+                    channels, x, result.channelCount(), result.channelSize());
+            }
+            else
+            {
+                constexpr size_t block = 512;
+                float frames[block];
+                const size_t channelCount = std::max(size_t(1), result.channelCount());
+                const size_t step         = block / channelCount;
+                for (size_t i = 0; i < result.channelSize(); i += step)
+                {
+                    const size_t count = std::min(step, result.channelSize() - i);
+                    detail::dequantize(frames, x + i * channelCount, count * channelCount);
+                    deinterleave(result.frames(i, count), frames);
+                }
+            }
+        }
+    }
+}
+
+#endif // DAP_FASTMATH_SAMPLE_CONVERSION_H
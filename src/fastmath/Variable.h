@@ -32,12 +32,12 @@ namespace dap
             using value_type = BaseType;
 
             Variable() = default;
-            template <typename T, DAP_REQUIRES(isArithmetic<T>())>
+            template <typename T, DAP_REQUIRES(isArithmeticOrPacked<T>())>
             DAP_NO_EXPLICIT_CTOR Variable(const T& value) noexcept
             : m_value(value)
             {
             }
-            template <typename T, DAP_REQUIRES(isArithmetic<T>())>
+            template <typename T, DAP_REQUIRES(isArithmeticOrPacked<T>())>
             DAP_NO_EXPLICIT_CTOR Variable(T&& value) noexcept  // NOLINT [misc-forwarding-reference-overload]
             : m_value(value)
             {
@@ -47,13 +47,13 @@ namespace dap
             : m_value(std::move(expr()))
             {
             }
-            template <typename T, DAP_REQUIRES(isArithmetic<T>())>
+            template <typename T, DAP_REQUIRES(isArithmeticOrPacked<T>())>
             Variable operator=(const T& value) noexcept // NOLINT intentionally return copy, not ref
             {
                 m_value = value;
                 return *this;
             }
-            template <typename T, DAP_REQUIRES(isArithmetic<T>())>
+            template <typename T, DAP_REQUIRES(isArithmeticOrPacked<T>())>
             Variable operator=(T&& value) noexcept // NOLINT, intentionally return copy, not ref
             {
                 m_value = std::forward<T>(value);
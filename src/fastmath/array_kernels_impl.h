@@ -0,0 +1,607 @@
+#ifndef DAP_ARRAY_KERNELS_IMPL_H
+#define DAP_ARRAY_KERNELS_IMPL_H
+
+#include "ArrayKernels.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <type_traits>
+#if defined(__SSE__)
+#include <xmmintrin.h>
+#endif
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#endif
+
+// Kernels of ArrayKernels.h over the vector type of an instruction set, to be instantiated by the
+// translation unit compiled for that instruction set only, its traits S being in an unnamed
+// namespace so that no code leaks to the other units. They call nothing but S, so S provides:
+//   V, mask_t and width, the vector and compare mask types and the floats of a vector
+//   load and store, unaligned, loadAligned and storeAligned, aligned to the size of a vector
+//   set1, add, sub, mul, min, max, abs, sqrt, floor and fmadd(a, b, c) = a * b + c
+//   lt, eq, nge and select(mask, a, b), a where mask is set and b elsewhere
+//   pow2(n), 2^n for integral n, and frexp(x, e), the mantissa m in [0.5, 1) of x = m 2^e
+//   hsum, hmin and hmax, the sum, min and max of the floats of a vector
+//   storeInt16 and storeInt32, unaligned, rounding to nearest floats within range, and
+//   loadInt16 and loadInt32, unaligned, of the integers of a vector
+// Interleaving and 24 bit packing shuffle 128-bit vectors whatever the width of S, being bound
+// by memory, and run scalar for S of width 1.
+
+namespace dap
+{
+    namespace fastmath
+    {
+        namespace detail
+        {
+            const ArrayKernels& sse41ArrayKernels();
+            const ArrayKernels& avx2ArrayKernels();
+            const ArrayKernels& avx512ArrayKernels();
+
+            namespace kernels
+            {
+                // the floats of x before the first one aligned to the vectors of S
+                template <typename S>
+                inline size_t head(const float* x, size_t size)
+                {
+                    const size_t bytes  = S::width * sizeof(float);
+                    const size_t offset = size_t(x) & (bytes - 1);
+                    return offset == 0 ? 0 : std::min(size, (bytes - offset) / sizeof(float));
+                }
+                // the first count floats of x, padded with pad
+                template <typename S>
+                inline typename S::V loadPartial(const float* x, size_t count, float pad = 0.0f)
+                {
+                    alignas(64) float a[S::width];
+                    for (size_t j = 0; j < S::width; ++j)
+                    {
+                        a[j] = j < count ? x[j] : pad;
+                    }
+                    return S::loadAligned(a);
+                }
+                template <typename S>
+                inline void storePartial(float* x, typename S::V a, size_t count)
+                {
+                    alignas(64) float b[S::width];
+                    S::storeAligned(b, a);
+                    for (size_t j = 0; j < count; ++j)
+                    {
+                        x[j] = b[j];
+                    }
+                }
+
+                // op of the coefficients of the arguments x: a padded vector up to the first
+                // aligned result, aligned stores of the body, with aligned loads when the
+                // arguments are aligned as the result, and a padded vector of the rest
+                template <typename S, typename Op, typename... X>
+                inline void map(float* result, size_t size, Op op, const X*... x)
+                {
+                    const size_t first = head<S>(result, size);
+                    const size_t last  = first + (size - first) / S::width * S::width;
+                    if (first > 0)
+                    {
+                        storePartial<S>(result, op(loadPartial<S>(x, first)...), first);
+                    }
+                    const auto body = [&](auto load) {
+                        for (size_t i = first; i < last; i += S::width)
+                        {
+                            S::storeAligned(result + i, op(load(x + i)...));
+                        }
+                    };
+                    const size_t bytes = S::width * sizeof(float);
+                    if (((((size_t(x) - size_t(result)) & (bytes - 1)) == 0) && ...))
+                    {
+                        body([](const float* a) { return S::loadAligned(a); });
+                    }
+                    else
+                    {
+                        body([](const float* a) { return S::load(a); });
+                    }
+                    if (last < size)
+                    {
+                        const size_t rest = size - last;
+                        storePartial<S>(result + last, op(loadPartial<S>(x + last, rest)...), rest);
+                    }
+                }
+                // step of the coefficients of x into four accumulators, then joined, the vectors
+                // before the first aligned one and after the last one padded with pad
+                template <typename S, typename Step, typename Join>
+                inline typename S::V
+                accumulate(const float* x, size_t size, float init, float pad, Step step, Join join)
+                {
+                    using V               = typename S::V;
+                    const V start         = S::set1(init);
+                    V acc[4]              = {start, start, start, start};
+                    size_t i              = head<S>(x, size);
+                    const size_t unrolled = 4 * S::width;
+                    if (i > 0)
+                    {
+                        acc[0] = step(acc[0], loadPartial<S>(x, i, pad));
+                    }
+                    for (; i + unrolled <= size; i += unrolled)
+                    {
+                        for (size_t k = 0; k < 4; ++k)
+                        {
+                            acc[k] = step(acc[k], S::loadAligned(x + i + k * S::width));
+                        }
+                    }
+                    for (; i + S::width <= size; i += S::width)
+                    {
+                        acc[0] = step(acc[0], S::loadAligned(x + i));
+                    }
+                    if (i < size)
+                    {
+                        acc[1] = step(acc[1], loadPartial<S>(x + i, size - i, pad));
+                    }
+                    return join(join(acc[0], acc[1]), join(acc[2], acc[3]));
+                }
+
+                // Cephes expf: x = n ln(2) + r with |r| <= ln(2) / 2, exp(r) being a polynomial
+                template <typename S>
+                inline typename S::V exp(typename S::V x)
+                {
+                    using V   = typename S::V;
+                    x         = S::min(S::max(x, S::set1(-87.3365448f)), S::set1(88.3762626f));
+                    const V n = S::floor(S::fmadd(x, S::set1(1.44269504f), S::set1(0.5f)));
+                    // ln(2) in two parts, n times the first one being exact
+                    V r = S::sub(x, S::mul(n, S::set1(0.693359375f)));
+                    r   = S::sub(r, S::mul(n, S::set1(-2.12194440e-4f)));
+                    V p = S::set1(1.9875691500e-4f);
+                    p   = S::fmadd(p, r, S::set1(1.3981999507e-3f));
+                    p   = S::fmadd(p, r, S::set1(8.3334519073e-3f));
+                    p   = S::fmadd(p, r, S::set1(4.1665795894e-2f));
+                    p   = S::fmadd(p, r, S::set1(1.6666665459e-1f));
+                    p   = S::fmadd(p, r, S::set1(5.0000001201e-1f));
+                    p   = S::fmadd(p, S::mul(r, r), S::add(r, S::set1(1.0f)));
+                    return S::mul(p, S::pow2(n));
+                }
+                // Cephes logf: x = m 2^e with sqrt(1/2) <= m < sqrt(2), log(m) being a polynomial
+                template <typename S>
+                inline typename S::V log(typename S::V x)
+                {
+                    using V     = typename S::V;
+                    const V one = S::set1(1.0f);
+                    V e;
+                    V m              = S::frexp(S::max(S::set1(FLT_MIN), x), e);
+                    const auto small = S::lt(m, S::set1(0.707106781f));
+                    e                = S::select(small, S::sub(e, one), e);
+                    m                = S::sub(S::select(small, S::add(m, m), m), one);
+                    const V z        = S::mul(m, m);
+                    V p              = S::set1(7.0376836292e-2f);
+                    p                = S::fmadd(p, m, S::set1(-1.1514610310e-1f));
+                    p                = S::fmadd(p, m, S::set1(1.1676998740e-1f));
+                    p                = S::fmadd(p, m, S::set1(-1.2420140846e-1f));
+                    p                = S::fmadd(p, m, S::set1(1.4249322787e-1f));
+                    p                = S::fmadd(p, m, S::set1(-1.6668057665e-1f));
+                    p                = S::fmadd(p, m, S::set1(2.0000714765e-1f));
+                    p                = S::fmadd(p, m, S::set1(-2.4999993993e-1f));
+                    p                = S::fmadd(p, m, S::set1(3.3333331174e-1f));
+                    p                = S::mul(S::mul(p, m), z);
+                    p                = S::fmadd(e, S::set1(-2.12194440e-4f), p);
+                    p                = S::sub(p, S::mul(z, S::set1(0.5f)));
+                    V y              = S::fmadd(e, S::set1(0.693359375f), S::add(m, p));
+                    y                = S::select(S::eq(x, S::set1(0.0f)), S::set1(-HUGE_VALF), y);
+                    y                = S::select(S::eq(x, S::set1(HUGE_VALF)), x, y);
+                    return S::select(S::nge(x, S::set1(0.0f)), S::set1(NAN), y);
+                }
+
+                template <typename S>
+                void add(float* result, const float* x, const float* y, size_t size)
+                {
+                    map<S>(result, size, [](auto a, auto b) { return S::add(a, b); }, x, y);
+                }
+                template <typename S>
+                void sub(float* result, const float* x, const float* y, size_t size)
+                {
+                    map<S>(result, size, [](auto a, auto b) { return S::sub(a, b); }, x, y);
+                }
+                template <typename S>
+                void mul(float* result, const float* x, const float* y, size_t size)
+                {
+                    map<S>(result, size, [](auto a, auto b) { return S::mul(a, b); }, x, y);
+                }
+                template <typename S>
+                void fma(float* result, const float* x, const float* y, const float* z, size_t size)
+                {
+                    const auto fmadd = [](auto a, auto b, auto c) { return S::fmadd(a, b, c); };
+                    map<S>(result, size, fmadd, x, y, z);
+                }
+                template <typename S>
+                void abs(float* result, const float* x, size_t size)
+                {
+                    map<S>(result, size, [](auto a) { return S::abs(a); }, x);
+                }
+                template <typename S>
+                void sqrt(float* result, const float* x, size_t size)
+                {
+                    map<S>(result, size, [](auto a) { return S::sqrt(a); }, x);
+                }
+                template <typename S>
+                void exp(float* result, const float* x, size_t size)
+                {
+                    map<S>(result, size, [](auto a) { return exp<S>(a); }, x);
+                }
+                template <typename S>
+                void log(float* result, const float* x, size_t size)
+                {
+                    map<S>(result, size, [](auto a) { return log<S>(a); }, x);
+                }
+                template <typename S>
+                float min(const float* x, size_t size)
+                {
+                    const auto min = [](auto a, auto b) { return S::min(a, b); };
+                    return S::hmin(accumulate<S>(x, size, x[0], x[0], min, min));
+                }
+                template <typename S>
+                float max(const float* x, size_t size)
+                {
+                    const auto max = [](auto a, auto b) { return S::max(a, b); };
+                    return S::hmax(accumulate<S>(x, size, x[0], x[0], max, max));
+                }
+                template <typename S>
+                float sum(const float* x, size_t size)
+                {
+                    const auto add = [](auto a, auto b) { return S::add(a, b); };
+                    return S::hsum(accumulate<S>(x, size, 0.0f, 0.0f, add, add));
+                }
+                template <typename S>
+                float squaredNorm(const float* x, size_t size)
+                {
+                    return S::hsum(accumulate<S>(x,
+                                                 size,
+                                                 0.0f,
+                                                 0.0f,
+                                                 [](auto a, auto b) { return S::fmadd(b, b, a); },
+                                                 [](auto a, auto b) { return S::add(a, b); }));
+                }
+
+                // x scaled to integers, plus dither in lsbs if not null, clipped to [low, high]
+                // and stored by store, a padded vector of the rest going through a copy
+                template <typename S, typename Int, typename Store>
+                inline void quantize(Int* result,
+                                     const float* x,
+                                     const float* dither,
+                                     size_t size,
+                                     float scale,
+                                     float high,
+                                     Store store)
+                {
+                    using V         = typename S::V;
+                    const V factor  = S::set1(scale);
+                    const V lower   = S::set1(-scale);
+                    const V upper   = S::set1(high);
+                    const auto body = [&](auto noise) {
+                        const auto sample = [&](V a, size_t i, size_t count) {
+                            const V b = S::fmadd(a, factor, noise(i, count));
+                            return S::min(S::max(b, lower), upper);
+                        };
+                        size_t i = 0;
+                        for (; i + S::width <= size; i += S::width)
+                        {
+                            store(result + i, sample(S::load(x + i), i, S::width));
+                        }
+                        if (i < size)
+                        {
+                            const size_t rest = size - i;
+                            Int b[S::width];
+                            store(b, sample(loadPartial<S>(x + i, rest), i, rest));
+                            std::copy_n(b, rest, result + i);
+                        }
+                    };
+                    if (dither != nullptr)
+                    {
+                        body([dither](size_t i, size_t count) {
+                            return count == S::width ? S::load(dither + i)
+                                                     : loadPartial<S>(dither + i, count);
+                        });
+                    }
+                    else
+                    {
+                        body([](size_t, size_t) { return S::set1(0.0f); });
+                    }
+                }
+                // x loaded as floats by load and scaled by 1 / scale
+                template <typename S, typename Int, typename Load>
+                inline void
+                dequantize(float* result, const Int* x, size_t size, float scale, Load load)
+                {
+                    const auto factor = S::set1(1.0f / scale);
+                    size_t i          = 0;
+                    for (; i + S::width <= size; i += S::width)
+                    {
+                        S::store(result + i, S::mul(load(x + i), factor));
+                    }
+                    if (i < size)
+                    {
+                        const size_t rest = size - i;
+                        Int a[S::width]   = {};
+                        std::copy_n(x + i, rest, a);
+                        storePartial<S>(result + i, S::mul(load(a), factor), rest);
+                    }
+                }
+
+                // the low 3 bytes of the integers of x, little endian
+                template <typename S>
+                inline void pack24(uint8_t* result, const int32_t* x, size_t size)
+                {
+                    size_t i = 0;
+#if defined(__SSSE3__)
+                    if constexpr (S::width > 1)
+                    {
+                        const __m128i bytes =
+                            _mm_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+                        // 16 bytes stored for 12, the last 4 rewritten by the next store
+                        for (; i + 6 <= size; i += 4)
+                        {
+                            const __m128i a =
+                                _mm_loadu_si128(reinterpret_cast<const __m128i*>(x + i));
+                            _mm_storeu_si128(reinterpret_cast<__m128i*>(result + 3 * i),
+                                             _mm_shuffle_epi8(a, bytes));
+                        }
+                    }
+#endif
+                    for (; i < size; ++i)
+                    {
+                        const auto a      = uint32_t(x[i]);
+                        result[3 * i]     = uint8_t(a);
+                        result[3 * i + 1] = uint8_t(a >> 8);
+                        result[3 * i + 2] = uint8_t(a >> 16);
+                    }
+                }
+                // the sign extended integers of the 3 little endian bytes of x
+                template <typename S>
+                inline void unpack24(int32_t* result, const uint8_t* x, size_t size)
+                {
+                    size_t i = 0;
+#if defined(__SSSE3__)
+                    if constexpr (S::width > 1)
+                    {
+                        // the bytes in the high 3 bytes of the integers, shifted back
+                        const __m128i bytes =
+                            _mm_setr_epi8(-1, 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11);
+                        for (; i + 6 <= size; i += 4)
+                        {
+                            const __m128i a =
+                                _mm_loadu_si128(reinterpret_cast<const __m128i*>(x + 3 * i));
+                            _mm_storeu_si128(reinterpret_cast<__m128i*>(result + i),
+                                             _mm_srai_epi32(_mm_shuffle_epi8(a, bytes), 8));
+                        }
+                    }
+#endif
+                    for (; i < size; ++i)
+                    {
+                        const uint32_t a = uint32_t(x[3 * i]) << 8 | uint32_t(x[3 * i + 1]) << 16 |
+                                           uint32_t(x[3 * i + 2]) << 24;
+                        result[i] = int32_t(a) >> 8;
+                    }
+                }
+
+                // f(std::integral_constant<size_t, C>) for channels == C in [1, 8]
+                template <size_t C = 1, typename F>
+                inline void withChannels(size_t channels, F f)
+                {
+                    if constexpr (C <= 8)
+                    {
+                        if (channels == C)
+                        {
+                            f(std::integral_constant<size_t, C>());
+                        }
+                        else
+                        {
+                            withChannels<C + 1>(channels, f);
+                        }
+                    }
+                }
+                // blocks of 4 frames of the channels x, stereo ones unpacked and the others
+                // transposed 4 channels at a time, the store of a frame spilling into the next
+                // frame, rewritten by its own store
+                template <typename S, size_t C>
+                inline void interleave(float* result, const float* const* channels, size_t frames)
+                {
+                    // copied so that the stores can't change them
+                    const float* x[C];
+                    std::copy_n(channels, C, x);
+                    size_t i = 0;
+                    if constexpr (C == 1)
+                    {
+                        std::copy_n(x[0], frames, result);
+                        return;
+                    }
+#if defined(__SSE__)
+                    if constexpr (S::width > 1 && C == 2)
+                    {
+                        for (; i + 4 <= frames; i += 4)
+                        {
+                            const __m128 l = _mm_loadu_ps(x[0] + i);
+                            const __m128 r = _mm_loadu_ps(x[1] + i);
+                            _mm_storeu_ps(result + 2 * i, _mm_unpacklo_ps(l, r));
+                            _mm_storeu_ps(result + 2 * i + 4, _mm_unpackhi_ps(l, r));
+                        }
+                    }
+                    else if constexpr (S::width > 1)
+                    {
+                        constexpr size_t groups = (C + 3) / 4;
+                        for (; (i + 3) * C + 4 * groups <= frames * C; i += 4)
+                        {
+                            __m128 a[groups][4];
+                            for (size_t g = 0; g < groups; ++g)
+                            {
+                                for (size_t k = 0; k < 4; ++k)
+                                {
+                                    a[g][k] = 4 * g + k < C ? _mm_loadu_ps(x[4 * g + k] + i)
+                                                            : _mm_setzero_ps();
+                                }
+                                _MM_TRANSPOSE4_PS(a[g][0], a[g][1], a[g][2], a[g][3]);
+                            }
+                            for (size_t f = 0; f < 4; ++f)
+                            {
+                                for (size_t g = 0; g < groups; ++g)
+                                {
+                                    _mm_storeu_ps(result + (i + f) * C + 4 * g, a[g][f]);
+                                }
+                            }
+                        }
+                    }
+#endif
+                    for (; i < frames; ++i)
+                    {
+                        for (size_t c = 0; c < C; ++c)
+                        {
+                            result[i * C + c] = x[c][i];
+                        }
+                    }
+                }
+                // blocks of 4 frames of x, the load of a frame reading into the next frame
+                template <typename S, size_t C>
+                inline void deinterleave(float* const* channels, const float* x, size_t frames)
+                {
+                    float* result[C];
+                    std::copy_n(channels, C, result);
+                    size_t i = 0;
+                    if constexpr (C == 1)
+                    {
+                        std::copy_n(x, frames, result[0]);
+                        return;
+                    }
+#if defined(__SSE__)
+                    if constexpr (S::width > 1 && C == 2)
+                    {
+                        for (; i + 4 <= frames; i += 4)
+                        {
+                            const __m128 a = _mm_loadu_ps(x + 2 * i);
+                            const __m128 b = _mm_loadu_ps(x + 2 * i + 4);
+                            const __m128 l = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+                            const __m128 r = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+                            _mm_storeu_ps(result[0] + i, l);
+                            _mm_storeu_ps(result[1] + i, r);
+                        }
+                    }
+                    else if constexpr (S::width > 1)
+                    {
+                        constexpr size_t groups = (C + 3) / 4;
+                        for (; (i + 3) * C + 4 * groups <= frames * C; i += 4)
+                        {
+                            __m128 a[groups][4];
+                            for (size_t g = 0; g < groups; ++g)
+                            {
+                                for (size_t f = 0; f < 4; ++f)
+                                {
+                                    a[g][f] = _mm_loadu_ps(x + (i + f) * C + 4 * g);
+                                }
+                                _MM_TRANSPOSE4_PS(a[g][0], a[g][1], a[g][2], a[g][3]);
+                                for (size_t k = 0; k < 4 && 4 * g + k < C; ++k)
+                                {
+                                    _mm_storeu_ps(result[4 * g + k] + i, a[g][k]);
+                                }
+                            }
+                        }
+                    }
+#endif
+                    for (; i < frames; ++i)
+                    {
+                        for (size_t c = 0; c < C; ++c)
+                        {
+                            result[c][i] = x[i * C + c];
+                        }
+                    }
+                }
+
+                template <typename S>
+                void toInt16(int16_t* result, const float* x, const float* dither, size_t size)
+                {
+                    const auto store = [](int16_t* r, auto a) { S::storeInt16(r, a); };
+                    quantize<S>(result, x, dither, size, 32768.0f, 32767.0f, store);
+                }
+                template <typename S>
+                void toInt32(int32_t* result, const float* x, const float* dither, size_t size)
+                {
+                    // the largest float below 2^31
+                    const auto store = [](int32_t* r, auto a) { S::storeInt32(r, a); };
+                    quantize<S>(result, x, dither, size, 2147483648.0f, 2147483520.0f, store);
+                }
+                template <typename S>
+                void toInt24(uint8_t* result, const float* x, const float* dither, size_t size)
+                {
+                    const auto store = [](int32_t* r, auto a) { S::storeInt32(r, a); };
+                    constexpr size_t block = 256;
+                    int32_t b[block];
+                    for (size_t i = 0; i < size; i += block)
+                    {
+                        const size_t count = std::min(block, size - i);
+                        const float* noise = dither != nullptr ? dither + i : nullptr;
+                        quantize<S>(b, x + i, noise, count, 8388608.0f, 8388607.0f, store);
+                        pack24<S>(result + 3 * i, b, count);
+                    }
+                }
+                template <typename S>
+                void fromInt16(float* result, const int16_t* x, size_t size)
+                {
+                    const auto load = [](const int16_t* a) { return S::loadInt16(a); };
+                    dequantize<S>(result, x, size, 32768.0f, load);
+                }
+                template <typename S>
+                void fromInt32(float* result, const int32_t* x, size_t size)
+                {
+                    const auto load = [](const int32_t* a) { return S::loadInt32(a); };
+                    dequantize<S>(result, x, size, 2147483648.0f, load);
+                }
+                template <typename S>
+                void fromInt24(float* result, const uint8_t* x, size_t size)
+                {
+                    const auto load = [](const int32_t* a) { return S::loadInt32(a); };
+                    constexpr size_t block = 256;
+                    int32_t b[block];
+                    for (size_t i = 0; i < size; i += block)
+                    {
+                        const size_t count = std::min(block, size - i);
+                        unpack24<S>(b, x + 3 * i, count);
+                        dequantize<S>(result + i, b, count, 8388608.0f, load);
+                    }
+                }
+                template <typename S>
+                void
+                interleave(float* result, const float* const* x, size_t channels, size_t frames)
+                {
+                    withChannels(channels, [&](auto c) {
+                        interleave<S, decltype(c)::value>(result, x, frames);
+                    });
+                }
+                template <typename S>
+                void
+                deinterleave(float* const* result, const float* x, size_t channels, size_t frames)
+                {
+                    withChannels(channels, [&](auto c) {
+                        deinterleave<S, decltype(c)::value>(result, x, frames);
+                    });
+                }
+
+                template <typename S>
+                constexpr ArrayKernels make(ArrayBackend backend)
+                {
+                    return {backend,
+                            &add<S>,
+                            &sub<S>,
+                            &mul<S>,
+                            &fma<S>,
+                            &abs<S>,
+                            &sqrt<S>,
+                            &exp<S>,
+                            &log<S>,
+                            &min<S>,
+                            &max<S>,
+                            &sum<S>,
+                            &squaredNorm<S>,
+                            &toInt16<S>,
+                            &toInt24<S>,
+                            &toInt32<S>,
+                            &fromInt16<S>,
+                            &fromInt24<S>,
+                            &fromInt32<S>,
+                            &interleave<S>,
+                            &deinterleave<S>};
+                }
+            }
+        }
+    }
+}
+
+#endif // DAP_ARRAY_KERNELS_IMPL_H
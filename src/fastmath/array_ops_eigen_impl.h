@@ -1,8 +1,10 @@
 #ifndef DAP_ARRAY_OPS_EIGEN_IMPL_H
 #define DAP_ARRAY_OPS_EIGEN_IMPL_H
 
+#include "ArrayKernels.h"
 #include "base/SystemAnnotations.h"
 #include <cassert>
+#include <cmath>
 #include <type_traits>
 #include <Eigen/Core>
 
@@ -19,28 +21,50 @@ namespace dap
         template <typename Lhs, typename Rhs, int NestingFlags>
         using CoeffBasedProduct = Eigen::Product<Lhs, Rhs, NestingFlags>;
 
+        namespace detail
+        {
+            // the float ops run the kernels of the backend of the cpu
+            template <typename T>
+            constexpr bool hasArrayKernels()
+            {
+                return std::is_same<T, float>::value;
+            }
+            template <size_t Alignment, typename... T>
+            void checkAlignment(const T*... ptrs)
+            {
+                (fastmath::checkAlignment<Alignment>(ptrs), ...);
+            }
+            // the Eigen option of maps of pointers aligned to alignment bytes
+            constexpr int eigenAlignment(size_t alignment)
+            {
+                return alignment >= 64   ? Eigen::Aligned64
+                       : alignment >= 32 ? Eigen::Aligned32
+                       : alignment >= 16 ? Eigen::Aligned16
+                                         : Eigen::Unaligned;
+            }
+        }
         namespace array
         {
             template <typename T>
             using ArrayType = Eigen::Array<T, Eigen::Dynamic, 1>;
 
-            template <typename T>
-            using MapType = Eigen::Map<ArrayType<T>, Eigen::Aligned>;
+            template <typename T, size_t Alignment = alignof(T)>
+            using MapType = Eigen::Map<ArrayType<T>, detail::eigenAlignment(Alignment)>;
 
-            template <typename T>
-            using ConstMapType = Eigen::Map<const ArrayType<T>, Eigen::Aligned>;
+            template <typename T, size_t Alignment = alignof(T)>
+            using ConstMapType = Eigen::Map<const ArrayType<T>, detail::eigenAlignment(Alignment)>;
 
-            template <typename T>
-            MapType<T> map(T* x, size_t size)
+            template <typename T, size_t Alignment = alignof(T)>
+            MapType<T, Alignment> map(T* x, size_t size)
             {
-                checkAlignment(x);
-                return MapType<T>(x, size);
+                checkAlignment<Alignment>(x);
+                return MapType<T, Alignment>(x, size);
             }
-            template <typename T>
-            ConstMapType<T> const_map(const T* x, size_t size)
+            template <typename T, size_t Alignment = alignof(T)>
+            ConstMapType<T, Alignment> const_map(const T* x, size_t size)
             {
-                checkAlignment(x);
-                return ConstMapType<T>(x, size);
+                checkAlignment<Alignment>(x);
+                return ConstMapType<T, Alignment>(x, size);
             }
         }
         namespace vector
@@ -48,23 +72,23 @@ namespace dap
             template <typename T>
             using VectorType = Eigen::Matrix<T, Eigen::Dynamic, 1>;
 
-            template <typename T>
-            using MapType = Eigen::Map<VectorType<T>, Eigen::Aligned>;
+            template <typename T, size_t Alignment = alignof(T)>
+            using MapType = Eigen::Map<VectorType<T>, detail::eigenAlignment(Alignment)>;
 
-            template <typename T>
-            using ConstMapType = Eigen::Map<const VectorType<T>, Eigen::Aligned>;
+            template <typename T, size_t Alignment = alignof(T)>
+            using ConstMapType = Eigen::Map<const VectorType<T>, detail::eigenAlignment(Alignment)>;
 
-            template <typename T>
-            MapType<T> map(T* x, size_t size)
+            template <typename T, size_t Alignment = alignof(T)>
+            MapType<T, Alignment> map(T* x, size_t size)
             {
-                checkAlignment(x);
-                return MapType<T>(x, size);
+                checkAlignment<Alignment>(x);
+                return MapType<T, Alignment>(x, size);
             }
-            template <typename T>
-            ConstMapType<T> const_map(const T* x, size_t size)
+            template <typename T, size_t Alignment = alignof(T)>
+            ConstMapType<T, Alignment> const_map(const T* x, size_t size)
             {
-                checkAlignment(x);
-                return ConstMapType<T>(x, size);
+                checkAlignment<Alignment>(x);
+                return ConstMapType<T, Alignment>(x, size);
             }
         }
         namespace matrix
@@ -76,240 +100,399 @@ namespace dap
             };
             // compile time size
             template <typename T, size_t Rows, size_t Cols, int Order = ColMajor>
-            using MatrixType                                          = Eigen::Matrix<T, Rows, Cols, Order>;
+            using MatrixType = Eigen::Matrix<T, Rows, Cols, Order>;
 
-            template <typename T, size_t Rows, size_t Cols, int Order = ColMajor>
-            using MapType                                             = Eigen::Map<MatrixType<T, Rows, Cols, Order>, Eigen::Aligned>;
+            template <typename T,
+                      size_t Rows,
+                      size_t Cols,
+                      int Order        = ColMajor,
+                      size_t Alignment = alignof(T)>
+            using MapType = Eigen::Map<MatrixType<T, Rows, Cols, Order>,
+                                       detail::eigenAlignment(Alignment)>;
 
-            template <typename T, size_t Rows, size_t Cols, int Order = ColMajor>
-            using ConstMapType                                        = Eigen::Map<const MatrixType<T, Rows, Cols, Order>, Eigen::Aligned>;
+            template <typename T,
+                      size_t Rows,
+                      size_t Cols,
+                      int Order        = ColMajor,
+                      size_t Alignment = alignof(T)>
+            using ConstMapType = Eigen::Map<const MatrixType<T, Rows, Cols, Order>,
+                                            detail::eigenAlignment(Alignment)>;
 
-            template <typename T, size_t Rows, size_t Cols, int Order = ColMajor>
-            MapType<T, Rows, Cols, Order> map(T* x, size_t DAP_ATTRIBUTE_UNUSED size)
+            template <typename T,
+                      size_t Rows,
+                      size_t Cols,
+                      int Order        = ColMajor,
+                      size_t Alignment = alignof(T)>
+            MapType<T, Rows, Cols, Order, Alignment> map(T* x, size_t DAP_ATTRIBUTE_UNUSED size)
             {
                 assert(size == Cols * Rows);
-                checkAlignment(x);
-                return MapType<T, Rows, Cols, Order>(x);
+                checkAlignment<Alignment>(x);
+                return MapType<T, Rows, Cols, Order, Alignment>(x);
             }
-            template <typename T, size_t Rows, size_t Cols, int Order = ColMajor>
-            ConstMapType<T, Rows, Cols, Order> const_map(const T* x, size_t DAP_ATTRIBUTE_UNUSED size)
+            template <typename T,
+                      size_t Rows,
+                      size_t Cols,
+                      int Order        = ColMajor,
+                      size_t Alignment = alignof(T)>
+            ConstMapType<T, Rows, Cols, Order, Alignment> const_map(const T* x,
+                                                                    size_t DAP_ATTRIBUTE_UNUSED
+                                                                        size)
             {
                 assert(size == Cols * Rows);
-                checkAlignment(x);
-                return ConstMapType<T, Rows, Cols, Order>(x);
+                checkAlignment<Alignment>(x);
+                return ConstMapType<T, Rows, Cols, Order, Alignment>(x);
             }
 
             // dynamic size
             template <typename T, int Order = ColMajor>
-            using MatrixTypeDynamic         = Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>;
+            using MatrixTypeDynamic = Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>;
 
-            template <typename T, int Order = ColMajor>
-            using MapTypeDynamic            = Eigen::Map<MatrixTypeDynamic<T, Order>, Eigen::Aligned>;
+            template <typename T, int Order = ColMajor, size_t Alignment = alignof(T)>
+            using MapTypeDynamic =
+                Eigen::Map<MatrixTypeDynamic<T, Order>, detail::eigenAlignment(Alignment)>;
 
-            template <typename T, int Order = ColMajor>
+            template <typename T, int Order = ColMajor, size_t Alignment = alignof(T)>
             using ConstMapTypeDynamic =
-                Eigen::Map<const MatrixTypeDynamic<T, Order>, Eigen::Aligned>;
+                Eigen::Map<const MatrixTypeDynamic<T, Order>, detail::eigenAlignment(Alignment)>;
 
-            template <typename T, int Order = ColMajor>
-            MapTypeDynamic<T, Order> map(T* x, size_t rows, size_t cols)
+            template <typename T, int Order = ColMajor, size_t Alignment = alignof(T)>
+            MapTypeDynamic<T, Order, Alignment> map(T* x, size_t rows, size_t cols)
             {
-                checkAlignment(x);
-                return MapTypeDynamic<T, Order>(x, rows, cols);
+                checkAlignment<Alignment>(x);
+                return MapTypeDynamic<T, Order, Alignment>(x, rows, cols);
             }
-            template <typename T, int Order = ColMajor>
-            ConstMapTypeDynamic<T, Order> const_map(const T* x, size_t rows, size_t cols)
+            template <typename T, int Order = ColMajor, size_t Alignment = alignof(T)>
+            ConstMapTypeDynamic<T, Order, Alignment> const_map(const T* x, size_t rows, size_t cols)
             {
-                checkAlignment(x);
-                return ConstMapTypeDynamic<T, Order>(x, rows, cols);
+                checkAlignment<Alignment>(x);
+                return ConstMapTypeDynamic<T, Order, Alignment>(x, rows, cols);
             }
         }
 
         // constant ops
-        template <typename T>
+        template <typename T, size_t Alignment>
         bool all(const T* x, size_t size)
         {
-            return array::const_map(x, size).all();
+            return array::const_map<T, Alignment>(x, size).all();
         }
-        template <typename T>
+        template <typename T, size_t Alignment>
         bool any(const T* x, size_t size)
         {
-            return array::const_map(x, size).any();
+            return array::const_map<T, Alignment>(x, size).any();
         }
-        template <typename T>
+        template <typename T, size_t Alignment>
         bool allFinite(const T* x, size_t size)
         {
             static_assert(!std::is_integral<T>::value, "Integral types are always finite.");
-            return array::const_map(x, size).allFinite();
+            return array::const_map<T, Alignment>(x, size).allFinite();
         }
-        template <typename T>
+        template <typename T, size_t Alignment>
         bool hasNaN(const T* x, size_t size)
         {
             static_assert(!std::is_integral<T>::value, "NaN is floating point only.");
-            return array::const_map(x, size).hasNaN();
+            return array::const_map<T, Alignment>(x, size).hasNaN();
         }
 
         // unary ops
-        template <typename T>
+        template <typename T, size_t Alignment>
         void abs(T* result, const T* x, size_t size)
         {
-            array::map(result, size) = array::const_map(x, size).abs();
+            if constexpr (detail::hasArrayKernels<T>())
+            {
+                detail::checkAlignment<Alignment>(result, x);
+                arrayKernels().abs(result, x, size);
+            }
+            else
+            {
+                array::map<T, Alignment>(result, size) =
+                    array::const_map<T, Alignment>(x, size).abs();
+            }
         }
-        template <typename T>
+        template <typename T, size_t Alignment>
         void abs2(T* result, const T* x, size_t size)
         {
-            array::map(result, size) = array::const_map(x, size).abs2();
+            array::map<T, Alignment>(result, size) = array::const_map<T, Alignment>(x, size).abs2();
         }
-        template <typename T>
+        template <typename T, size_t Alignment>
         void normalize(T* x, size_t size)
         {
-            vector::map(x, size).normalize();
+            vector::map<T, Alignment>(x, size).normalize();
         }
-        template <typename T>
+        template <typename T, size_t Alignment>
         void cos(T* result, const T* x, size_t size)
         {
             static_assert(!std::is_integral<T>::value, "cosine requires floating point.");
-            array::map(result, size) = array::const_map(x, size).cos();
+            array::map<T, Alignment>(result, size) = array::const_map<T, Alignment>(x, size).cos();
         }
-        template <typename T>
+        template <typename T, size_t Alignment>
         void sin(T* result, const T* x, size_t size)
         {
             static_assert(!std::is_integral<T>::value, "sine requires floating point.");
-            array::map(result, size) = array::const_map(x, size).sin();
+            array::map<T, Alignment>(result, size) = array::const_map<T, Alignment>(x, size).sin();
         }
-        template <typename T>
+        template <typename T, size_t Alignment>
         void tan(T* result, const T* x, size_t size)
         {
             static_assert(!std::is_integral<T>::value, "tangent requires floating point.");
-            array::map(result, size) = array::const_map(x, size).tan();
+            array::map<T, Alignment>(result, size) = array::const_map<T, Alignment>(x, size).tan();
         }
-        template <typename T>
+        template <typename T, size_t Alignment>
         void acos(T* result, const T* x, size_t size)
         {
             static_assert(!std::is_integral<T>::value, "arc cosine requires floating point.");
-            array::map(result, size) = array::const_map(x, size).acos();
+            array::map<T, Alignment>(result, size) = array::const_map<T, Alignment>(x, size).acos();
         }
-        template <typename T>
+        template <typename T, size_t Alignment>
         void asin(T* result, const T* x, size_t size)
         {
             static_assert(!std::is_integral<T>::value, "arc sine requires floating point.");
-            array::map(result, size) = array::const_map(x, size).asin();
+            array::map<T, Alignment>(result, size) = array::const_map<T, Alignment>(x, size).asin();
         }
-        template <typename T>
+        template <typename T, size_t Alignment>
         T max(const T* x, size_t size)
         {
-            return array::const_map(x, size).maxCoeff();
+            if constexpr (detail::hasArrayKernels<T>())
+            {
+                assert(size > 0);
+                detail::checkAlignment<Alignment>(x);
+                return arrayKernels().max(x, size);
+            }
+            else
+            {
+                return array::const_map<T, Alignment>(x, size).maxCoeff();
+            }
         }
-        template <typename T>
+        template <typename T, size_t Alignment>
         T min(const T* x, size_t size)
         {
-            return array::const_map(x, size).minCoeff();
+            if constexpr (detail::hasArrayKernels<T>())
+            {
+                assert(size > 0);
+                detail::checkAlignment<Alignment>(x);
+                return arrayKernels().min(x, size);
+            }
+            else
+            {
+                return array::const_map<T, Alignment>(x, size).minCoeff();
+            }
         }
-        template <typename T>
+        template <typename T, size_t Alignment>
         T sum(const T* x, size_t size)
         {
-            return array::const_map(x, size).sum();
+            if constexpr (detail::hasArrayKernels<T>())
+            {
+                detail::checkAlignment<Alignment>(x);
+                return arrayKernels().sum(x, size);
+            }
+            else
+            {
+                return array::const_map<T, Alignment>(x, size).sum();
+            }
         }
-        template <typename T>
+        template <typename T, size_t Alignment>
         T prod(const T* x, size_t size)
         {
-            return vector::const_map(x, size).prod();
+            return vector::const_map<T, Alignment>(x, size).prod();
         }
-        template <typename T>
+        template <typename T, size_t Alignment>
         void fill(const T& value, T* x, size_t size)
         {
-            return array::map(x, size).fill(value);
+            return array::map<T, Alignment>(x, size).fill(value);
         }
-        template <typename T>
+        template <typename T, size_t Alignment>
         void linspace(const T& low, const T& high, T* x, size_t size)
         {
-            array::map(x, size).setLinSpaced(low, high);
+            array::map<T, Alignment>(x, size).setLinSpaced(low, high);
         }
-        template <typename T>
+        template <typename T, size_t Alignment>
         T mean(const T* x, size_t size)
         {
-            return array::const_map(x, size).mean();
+            if constexpr (detail::hasArrayKernels<T>())
+            {
+                return sum<T, Alignment>(x, size) / T(size);
+            }
+            else
+            {
+                return array::const_map<T, Alignment>(x, size).mean();
+            }
         }
-        template <typename T, typename U>
-        T mean(U* result, const T* x, size_t size)
+        template <typename T, typename U, size_t Alignment>
+        void mean(U* result, const T* x, size_t size)
         {
-            *result = mean(x, size);
+            *result = mean<T, Alignment>(x, size);
         }
-        template <typename T>
+        template <typename T, size_t Alignment>
         T norm(const T* x, size_t size)
         {
-            return vector::const_map(x, size).norm();
+            if constexpr (detail::hasArrayKernels<T>())
+            {
+                return std::sqrt(squaredNorm<T, Alignment>(x, size));
+            }
+            else
+            {
+                return vector::const_map<T, Alignment>(x, size).norm();
+            }
         }
-        template <typename T, typename U>
+        template <typename T, typename U, size_t Alignment>
         void norm(U* result, const T* x, size_t size)
         {
-            *result = norm(x, size);
+            *result = norm<T, Alignment>(x, size);
         }
-        template <typename T>
+        template <typename T, size_t Alignment>
         T squaredNorm(const T* x, size_t size)
         {
-            return vector::const_map(x, size).squaredNorm();
+            if constexpr (detail::hasArrayKernels<T>())
+            {
+                detail::checkAlignment<Alignment>(x);
+                return arrayKernels().squaredNorm(x, size);
+            }
+            else
+            {
+                return vector::const_map<T, Alignment>(x, size).squaredNorm();
+            }
         }
-        template <typename T>
+        template <typename T, size_t Alignment>
         void square(T* result, const T* x, size_t size)
         {
-            array::map(result, size) = array::const_map(x, size).square();
+            array::map<T, Alignment>(result, size) =
+                array::const_map<T, Alignment>(x, size).square();
         }
-        template <typename T>
+        template <typename T, size_t Alignment>
         void cube(T* result, const T* x, size_t size)
         {
-            array::map(result, size) = array::const_map(x, size).cube();
+            array::map<T, Alignment>(result, size) = array::const_map<T, Alignment>(x, size).cube();
         }
-        template <typename T>
+        template <typename T, size_t Alignment>
         void pow(const T& value, T* result, const T* x, size_t size)
         {
-            array::map(result, size) = array::const_map(x, size).pow(value);
+            array::map<T, Alignment>(result, size) =
+                array::const_map<T, Alignment>(x, size).pow(value);
         }
-        template <typename T>
+        template <typename T, size_t Alignment>
         void sqrt(T* result, const T* x, size_t size)
         {
-            array::map(result, size) = array::const_map(x, size).sqrt();
+            if constexpr (detail::hasArrayKernels<T>())
+            {
+                detail::checkAlignment<Alignment>(result, x);
+                arrayKernels().sqrt(result, x, size);
+            }
+            else
+            {
+                array::map<T, Alignment>(result, size) =
+                    array::const_map<T, Alignment>(x, size).sqrt();
+            }
         }
-        template <typename T>
+        template <typename T, size_t Alignment>
         void exp(T* result, const T* x, size_t size)
         {
-            array::map(result, size) = array::const_map(x, size).exp();
+            if constexpr (detail::hasArrayKernels<T>())
+            {
+                detail::checkAlignment<Alignment>(result, x);
+                arrayKernels().exp(result, x, size);
+            }
+            else
+            {
+                array::map<T, Alignment>(result, size) =
+                    array::const_map<T, Alignment>(x, size).exp();
+            }
         }
-        template <typename T>
+        template <typename T, size_t Alignment>
         void log(T* result, const T* x, size_t size)
         {
-            array::map(result, size) = array::const_map(x, size).log();
+            if constexpr (detail::hasArrayKernels<T>())
+            {
+                detail::checkAlignment<Alignment>(result, x);
+                arrayKernels().log(result, x, size);
+            }
+            else
+            {
+                array::map<T, Alignment>(result, size) =
+                    array::const_map<T, Alignment>(x, size).log();
+            }
         }
-        template <typename T>
+        template <typename T, size_t Alignment>
         void inverse(T* result, const T* x, size_t size)
         {
-            array::map(result, size) = array::const_map(x, size).inverse();
+            array::map<T, Alignment>(result, size) =
+                array::const_map<T, Alignment>(x, size).inverse();
         }
-        template <typename T>
+        template <typename T, size_t Alignment>
         void conjugate(std::complex<T>* result, const std::complex<T>* x, size_t size)
         {
-            array::map(result, size) = array::const_map(x, size).conjugate();
+            using complex_t                                = std::complex<T>;
+            array::map<complex_t, Alignment>(result, size) =
+                array::const_map<complex_t, Alignment>(x, size).conjugate();
         }
 
         // binary ops
-        template <typename T>
+        template <typename T, size_t Alignment>
         void add(T* result, const T* x, const T* y, size_t size)
         {
-            array::map(result, size) = array::const_map(x, size) + array::const_map(y, size);
+            if constexpr (detail::hasArrayKernels<T>())
+            {
+                detail::checkAlignment<Alignment>(result, x, y);
+                arrayKernels().add(result, x, y, size);
+            }
+            else
+            {
+                array::map<T, Alignment>(result, size) =
+                    array::const_map<T, Alignment>(x, size) +
+                    array::const_map<T, Alignment>(y, size);
+            }
         }
-        template <typename T>
+        template <typename T, size_t Alignment>
         void sub(T* result, const T* x, const T* y, size_t size)
         {
-            array::map(result, size) = array::const_map(x, size) - array::const_map(y, size);
+            if constexpr (detail::hasArrayKernels<T>())
+            {
+                detail::checkAlignment<Alignment>(result, x, y);
+                arrayKernels().sub(result, x, y, size);
+            }
+            else
+            {
+                array::map<T, Alignment>(result, size) =
+                    array::const_map<T, Alignment>(x, size) -
+                    array::const_map<T, Alignment>(y, size);
+            }
         }
-        template <typename T>
+        template <typename T, size_t Alignment>
         void mul(T* result, const T* x, const T* y, size_t size)
         {
-            array::map(result, size) = array::const_map(x, size) * array::const_map(y, size);
+            if constexpr (detail::hasArrayKernels<T>())
+            {
+                detail::checkAlignment<Alignment>(result, x, y);
+                arrayKernels().mul(result, x, y, size);
+            }
+            else
+            {
+                array::map<T, Alignment>(result, size) =
+                    array::const_map<T, Alignment>(x, size) *
+                    array::const_map<T, Alignment>(y, size);
+            }
         }
-        template <typename T>
+        template <typename T, size_t Alignment>
         void div(T* result, const T* x, const T* y, size_t size)
         {
-            array::map(result, size) = array::const_map(x, size) / array::const_map(y, size);
+            array::map<T, Alignment>(result, size) =
+                array::const_map<T, Alignment>(x, size) / array::const_map<T, Alignment>(y, size);
+        }
+
+        // ternary ops
+        template <typename T, size_t Alignment>
+        void fma(T* result, const T* x, const T* y, const T* z, size_t size)
+        {
+            if constexpr (detail::hasArrayKernels<T>())
+            {
+                detail::checkAlignment<Alignment>(result, x, y, z);
+                arrayKernels().fma(result, x, y, z, size);
+            }
+            else
+            {
+                array::map<T, Alignment>(result, size) =
+                    array::const_map<T, Alignment>(x, size) *
+                        array::const_map<T, Alignment>(y, size) +
+                    array::const_map<T, Alignment>(z, size);
+            }
         }
 
     } // namespace fastmath
@@ -0,0 +1,432 @@
+#include <benchmark/benchmark.h>
+#include "fastmath/Approx.h"
+#include "fastmath/ArrayExpressions.h"
+#include "fastmath/ArrayKernels.h"
+#include "fastmath/SampleConversion.h"
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <vector>
+
+// Accuracy and speed of the approximations of fastmath/Approx.h against libm, the Exact tier.
+// Each benchmark maps a function over a block of float arguments spanning the range it is
+// documented for, the max_error counter being its maximum error over that block against the libm
+// result in double, relative for tan, exp and exp2 and absolute otherwise.
+
+namespace
+{
+    using dap::fastmath::approx::Accuracy;
+
+    constexpr size_t size = 1024;
+
+    struct Tan
+    {
+        static double exact(double x)
+        {
+            return std::tan(x);
+        }
+        static constexpr double from   = -1.5;
+        static constexpr double to     = 1.5;
+        static constexpr bool relative = true;
+        template <Accuracy A>
+        static void process(float* y, const float* x)
+        {
+            dap::fastmath::approx::tan<A>(y, x, size);
+        }
+    };
+    struct Exp
+    {
+        static double exact(double x)
+        {
+            return std::exp(x);
+        }
+        static constexpr double from   = -20.0;
+        static constexpr double to     = 20.0;
+        static constexpr bool relative = true;
+        template <Accuracy A>
+        static void process(float* y, const float* x)
+        {
+            dap::fastmath::approx::exp<A>(y, x, size);
+        }
+    };
+    struct Exp2
+    {
+        static double exact(double x)
+        {
+            return std::exp2(x);
+        }
+        static constexpr double from   = -20.0;
+        static constexpr double to     = 20.0;
+        static constexpr bool relative = true;
+        template <Accuracy A>
+        static void process(float* y, const float* x)
+        {
+            dap::fastmath::approx::exp2<A>(y, x, size);
+        }
+    };
+    struct Log2
+    {
+        static double exact(double x)
+        {
+            return std::log2(x);
+        }
+        static constexpr double from   = 1e-3;
+        static constexpr double to     = 1e3;
+        static constexpr bool relative = false;
+        template <Accuracy A>
+        static void process(float* y, const float* x)
+        {
+            dap::fastmath::approx::log2<A>(y, x, size);
+        }
+    };
+    struct Sin
+    {
+        static double exact(double x)
+        {
+            return std::sin(x);
+        }
+        static constexpr double from   = -10.0;
+        static constexpr double to     = 10.0;
+        static constexpr bool relative = false;
+        template <Accuracy A>
+        static void process(float* y, const float* x)
+        {
+            dap::fastmath::approx::sin<A>(y, x, size);
+        }
+    };
+    struct Tanh
+    {
+        static double exact(double x)
+        {
+            return std::tanh(x);
+        }
+        static constexpr double from   = -5.0;
+        static constexpr double to     = 5.0;
+        static constexpr bool relative = false;
+        template <Accuracy A>
+        static void process(float* y, const float* x)
+        {
+            dap::fastmath::approx::tanh<A>(y, x, size);
+        }
+    };
+
+    template <typename Function>
+    std::vector<float> arguments()
+    {
+        std::vector<float> x(size);
+        for (size_t i = 0; i < size; ++i)
+        {
+            x[i] = float(Function::from + (Function::to - Function::from) * double(i) / size);
+        }
+        return x;
+    }
+    template <typename Function>
+    double maxError(const std::vector<float>& x, const std::vector<float>& y)
+    {
+        double error = 0.0;
+        for (size_t i = 0; i < size; ++i)
+        {
+            const double exact = Function::exact(double(x[i]));
+            const double e     = std::abs(double(y[i]) - exact);
+            error              = std::max(error, Function::relative ? e / std::abs(exact) : e);
+        }
+        return error;
+    }
+}
+
+template <typename Function, Accuracy A>
+static void BM_Approx(benchmark::State& state)
+{
+    const auto x = arguments<Function>();
+    std::vector<float> y(size);
+    for (auto _ : state)
+    {
+        Function::template process<A>(y.data(), x.data());
+        benchmark::DoNotOptimize(y.data());
+        benchmark::ClobberMemory();
+    }
+    state.counters["max_error"] = maxError<Function>(x, y);
+    state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(size));
+}
+
+#define DAP_FASTMATH_APPROX_BENCHMARK(Function)                                                  \
+    BENCHMARK_TEMPLATE(BM_Approx, Function, Accuracy::Low);                                      \
+    BENCHMARK_TEMPLATE(BM_Approx, Function, Accuracy::Medium);                                   \
+    BENCHMARK_TEMPLATE(BM_Approx, Function, Accuracy::High);                                     \
+    BENCHMARK_TEMPLATE(BM_Approx, Function, Accuracy::Exact);
+
+DAP_FASTMATH_APPROX_BENCHMARK(Sin)
+DAP_FASTMATH_APPROX_BENCHMARK(Tan)
+DAP_FASTMATH_APPROX_BENCHMARK(Exp)
+DAP_FASTMATH_APPROX_BENCHMARK(Exp2)
+DAP_FASTMATH_APPROX_BENCHMARK(Log2)
+DAP_FASTMATH_APPROX_BENCHMARK(Tanh)
+
+#undef DAP_FASTMATH_APPROX_BENCHMARK
+
+// The float kernels of ArrayOps.h of each backend, the first argument, over arrays of the second
+// argument floats
+namespace
+{
+    using dap::fastmath::ArrayKernels;
+
+    struct Add
+    {
+        static void process(const ArrayKernels& k, float* y, const float* x, size_t n)
+        {
+            k.add(y, x, y, n);
+        }
+    };
+    struct Fma
+    {
+        static void process(const ArrayKernels& k, float* y, const float* x, size_t n)
+        {
+            k.fma(y, x, x, y, n);
+        }
+    };
+    struct Sqrt
+    {
+        static void process(const ArrayKernels& k, float* y, const float* x, size_t n)
+        {
+            k.sqrt(y, x, n);
+        }
+    };
+    struct ArrayExp
+    {
+        static void process(const ArrayKernels& k, float* y, const float* x, size_t n)
+        {
+            k.exp(y, x, n);
+        }
+    };
+    struct ArrayLog
+    {
+        static void process(const ArrayKernels& k, float* y, const float* x, size_t n)
+        {
+            k.log(y, x, n);
+        }
+    };
+    struct Max
+    {
+        static void process(const ArrayKernels& k, float* y, const float* x, size_t n)
+        {
+            y[0] = k.max(x, n);
+        }
+    };
+    struct Sum
+    {
+        static void process(const ArrayKernels& k, float* y, const float* x, size_t n)
+        {
+            y[0] = k.sum(x, n);
+        }
+    };
+    struct SquaredNorm
+    {
+        static void process(const ArrayKernels& k, float* y, const float* x, size_t n)
+        {
+            y[0] = k.squaredNorm(x, n);
+        }
+    };
+}
+
+template <typename Op>
+static void BM_ArrayKernels(benchmark::State& state)
+{
+    const auto backend = dap::fastmath::ArrayBackend(state.range(0));
+    const auto frames  = size_t(state.range(1));
+    if (!dap::fastmath::supported(backend))
+    {
+        state.SkipWithError("backend not supported");
+        return;
+    }
+    const auto previous = dap::fastmath::arrayBackend();
+    dap::fastmath::setArrayBackend(backend);
+    const auto& kernels = dap::fastmath::arrayKernels();
+    dap::fastmath::setArrayBackend(previous);
+    std::vector<float> x(frames);
+    for (size_t i = 0; i < frames; ++i)
+    {
+        x[i] = 1.0f + float(i % 100) / 100.0f;
+    }
+    std::vector<float> y(x);
+    for (auto _ : state)
+    {
+        Op::process(kernels, y.data(), x.data(), frames);
+        benchmark::DoNotOptimize(y.data());
+        benchmark::ClobberMemory();
+    }
+    std::ostringstream label;
+    label << backend;
+    state.SetLabel(label.str());
+    state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(frames));
+}
+
+#define DAP_FASTMATH_ARRAY_KERNELS_BENCHMARK(Op)                                                  \
+    BENCHMARK_TEMPLATE(BM_ArrayKernels, Op)->ArgsProduct({{0, 1, 2, 3}, {64, 1024, 16384}});
+
+DAP_FASTMATH_ARRAY_KERNELS_BENCHMARK(Add)
+DAP_FASTMATH_ARRAY_KERNELS_BENCHMARK(Fma)
+DAP_FASTMATH_ARRAY_KERNELS_BENCHMARK(Sqrt)
+DAP_FASTMATH_ARRAY_KERNELS_BENCHMARK(ArrayExp)
+DAP_FASTMATH_ARRAY_KERNELS_BENCHMARK(ArrayLog)
+DAP_FASTMATH_ARRAY_KERNELS_BENCHMARK(Max)
+DAP_FASTMATH_ARRAY_KERNELS_BENCHMARK(Sum)
+DAP_FASTMATH_ARRAY_KERNELS_BENCHMARK(SquaredNorm)
+
+#undef DAP_FASTMATH_ARRAY_KERNELS_BENCHMARK
+
+// gain * tanh(a + b * c) and sum(x * y) over arrays of the argument floats, fused into a single
+// loop by the expressions of ArrayExpressions.h or evaluated an op at a time, as the ops of
+// ArrayOps.h do
+namespace
+{
+    using dap::fastmath::Array;
+
+    Array<float> input(size_t frames, float offset)
+    {
+        Array<float> x(frames);
+        for (size_t i = 0; i < frames; ++i)
+        {
+            x[i] = offset + float(i % 100) / 100.0f;
+        }
+        return x;
+    }
+}
+
+static void BM_FusedChain(benchmark::State& state)
+{
+    const auto frames    = size_t(state.range(0));
+    const Array<float> a = input(frames, -0.5f);
+    const Array<float> b = input(frames, 0.5f);
+    const Array<float> c = input(frames, 0.25f);
+    Array<float> y(frames);
+    y.forbidAllocation(true);
+    for (auto _ : state)
+    {
+        y = 0.5f * tanh(a + b * c);
+        benchmark::DoNotOptimize(y.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(frames));
+}
+static void BM_UnfusedChain(benchmark::State& state)
+{
+    const auto frames    = size_t(state.range(0));
+    const Array<float> a = input(frames, -0.5f);
+    const Array<float> b = input(frames, 0.5f);
+    const Array<float> c = input(frames, 0.25f);
+    Array<float> y(frames);
+    y.forbidAllocation(true);
+    for (auto _ : state)
+    {
+        dap::fastmath::mul(y.data(), b.data(), c.data(), frames);
+        dap::fastmath::add(y.data(), a.data(), y.data(), frames);
+        y = tanh(y);
+        y = 0.5f * y;
+        benchmark::DoNotOptimize(y.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(frames));
+}
+static void BM_FusedDot(benchmark::State& state)
+{
+    const auto frames    = size_t(state.range(0));
+    const Array<float> x = input(frames, -0.5f);
+    const Array<float> y = input(frames, 0.5f);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(dap::fastmath::sum(x * y));
+    }
+    state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(frames));
+}
+static void BM_UnfusedDot(benchmark::State& state)
+{
+    const auto frames    = size_t(state.range(0));
+    const Array<float> x = input(frames, -0.5f);
+    const Array<float> y = input(frames, 0.5f);
+    Array<float> product(frames);
+    for (auto _ : state)
+    {
+        dap::fastmath::mul(product.data(), x.data(), y.data(), frames);
+        benchmark::DoNotOptimize(dap::fastmath::sum(product.data(), frames));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(frames));
+}
+BENCHMARK(BM_FusedChain)->RangeMultiplier(4)->Range(64, 65536);
+BENCHMARK(BM_UnfusedChain)->RangeMultiplier(4)->Range(64, 65536);
+BENCHMARK(BM_FusedDot)->RangeMultiplier(4)->Range(64, 65536);
+BENCHMARK(BM_UnfusedDot)->RangeMultiplier(4)->Range(64, 65536);
+
+// the planar float channels of an AudioBuffer to interleaved frames of floats or integers, by the
+// kernels of a backend or by a loop over the samples
+namespace
+{
+    dap::fastmath::AudioBuffer<float> channels(size_t channelCount, size_t frames)
+    {
+        dap::fastmath::AudioBuffer<float> buffer(channelCount, frames);
+        for (size_t ch = 0; ch < channelCount; ++ch)
+        {
+            for (size_t i = 0; i < frames; ++i)
+            {
+                buffer.channel(ch)[i] = float(i % 100) / 50.0f - 1.0f;
+            }
+        }
+        return buffer;
+    }
+}
+
+template <typename Sample>
+static void BM_Interleave(benchmark::State& state)
+{
+    const auto backend      = dap::fastmath::ArrayBackend(state.range(0));
+    const auto channelCount = size_t(state.range(1));
+    const size_t frames     = 1024;
+    if (!dap::fastmath::supported(backend))
+    {
+        state.SkipWithError("backend not supported");
+        return;
+    }
+    const auto buffer = channels(channelCount, frames);
+    std::vector<Sample> y(channelCount * frames);
+    const auto previous = dap::fastmath::arrayBackend();
+    dap::fastmath::setArrayBackend(backend);
+    for (auto _ : state)
+    {
+        dap::fastmath::interleave(y.data(), buffer);
+        benchmark::DoNotOptimize(y.data());
+        benchmark::ClobberMemory();
+    }
+    dap::fastmath::setArrayBackend(previous);
+    std::ostringstream label;
+    label << backend;
+    state.SetLabel(label.str());
+    state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(channelCount * frames));
+}
+static void BM_LoopInterleaveInt16(benchmark::State& state)
+{
+    const auto channelCount = size_t(state.range(0));
+    const size_t frames     = 1024;
+    const auto buffer       = channels(channelCount, frames);
+    std::vector<int16_t> y(channelCount * frames);
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < frames; ++i)
+        {
+            for (size_t ch = 0; ch < channelCount; ++ch)
+            {
+                const float x = std::min(std::max(buffer.channel(ch)[i] * 32768.0f, -32768.0f),
+                                         32767.0f);
+                y[i * channelCount + ch] = int16_t(std::lrint(x));
+            }
+        }
+        benchmark::DoNotOptimize(y.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(channelCount * frames));
+}
+BENCHMARK_TEMPLATE(BM_Interleave, float)->ArgsProduct({{0, 1, 2, 3}, {2, 8}});
+BENCHMARK_TEMPLATE(BM_Interleave, int16_t)->ArgsProduct({{0, 1, 2, 3}, {2, 8}});
+BENCHMARK_TEMPLATE(BM_Interleave, dap::fastmath::Int24)->ArgsProduct({{0, 1, 2, 3}, {2, 8}});
+BENCHMARK(BM_LoopInterleaveInt16)->Arg(2)->Arg(8);
+
+BENCHMARK_MAIN();
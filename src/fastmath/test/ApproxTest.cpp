@@ -0,0 +1,169 @@
+#include <gtest/gtest.h>
+#include <array>
+#include <cmath>
+
+#include "fastmath/Approx.h"
+#include "fastmath/Array.h"
+#include "fastmath/Pack.h"
+
+using namespace testing;
+using namespace dap;
+using namespace dap::fastmath;
+using approx::Accuracy;
+
+namespace
+{
+    template <Accuracy A>
+    double maxSineError()
+    {
+        double error = 0;
+        for (int i = -20000; i <= 20000; ++i)
+        {
+            const double x = 4.0 * M_PI * i / 20000.0;
+            error = std::max(error, std::abs(approx::sin<A>(x) - std::sin(x)));
+            error = std::max(error, std::abs(approx::cos<A>(x) - std::cos(x)));
+        }
+        return error;
+    }
+    // max error of approx against exact over [from, to], relative to exact if relative
+    template <typename Approx, typename Exact>
+    double maxError(Approx approx, Exact exact, double from, double to, bool relative)
+    {
+        double error = 0;
+        for (int i = 0; i <= 40000; ++i)
+        {
+            const double x = from + (to - from) * i / 40000.0;
+            const double e = std::abs(approx(x) - exact(x));
+            error          = std::max(error, relative ? e / std::abs(exact(x)) : e);
+        }
+        return error;
+    }
+    template <Accuracy A>
+    std::array<double, 5> maxErrors()
+    {
+        return {{maxError([](double x) { return approx::tan<A>(x); },
+                          [](double x) { return std::tan(x); },
+                          -1.5,
+                          1.5,
+                          true),
+                 maxError([](double x) { return approx::exp2<A>(x); },
+                          [](double x) { return std::exp2(x); },
+                          -20.0,
+                          20.0,
+                          true),
+                 maxError([](double x) { return approx::exp<A>(x); },
+                          [](double x) { return std::exp(x); },
+                          -20.0,
+                          20.0,
+                          true),
+                 maxError([](double x) { return approx::log2<A>(std::exp2(x)); },
+                          [](double x) { return x; },
+                          -20.0,
+                          20.0,
+                          false),
+                 maxError([](double x) { return approx::tanh<A>(x); },
+                          [](double x) { return std::tanh(x); },
+                          -10.0,
+                          10.0,
+                          false)}};
+    }
+    void assertMaxErrors(const std::array<double, 5>& errors, const std::array<double, 5>& bounds)
+    {
+        const char* names[] = {"tan", "exp2", "exp", "log2", "tanh"};
+        for (size_t i = 0; i < errors.size(); ++i)
+        {
+            ASSERT_LT(errors[i], bounds[i]) << names[i];
+        }
+    }
+}
+
+TEST(ApproxTest, sine_tiers_meet_their_max_error)
+{
+    ASSERT_LT(maxSineError<Accuracy::Low>(), 1.4e-4);
+    ASSERT_LT(maxSineError<Accuracy::Medium>(), 1.5e-6);
+    ASSERT_LT(maxSineError<Accuracy::High>(), 1.3e-8);
+    ASSERT_EQ(0.0, maxSineError<Accuracy::Exact>());
+}
+
+TEST(ApproxTest, float_sine)
+{
+    for (int i = 0; i < 1000; ++i)
+    {
+        const float x = float(i) * 0.01f - 2.0f;
+        ASSERT_NEAR(std::sin(x), approx::sin<Accuracy::High>(x), 3e-7f);
+        ASSERT_NEAR(std::cos(x), approx::cos<Accuracy::High>(x), 3e-7f);
+    }
+    ASSERT_EQ(0.0f, approx::sin<Accuracy::High>(0.0f));
+}
+
+TEST(ApproxTest, packs_and_arrays)
+{
+    const float4 x(0.1f, 1.0f, -2.0f, 3.0f);
+    const float4 y = approx::sin<Accuracy::Medium>(x);
+    for (size_t i = 0; i < float4::size(); ++i)
+    {
+        ASSERT_EQ(approx::sin<Accuracy::Medium>(x[i]), y[i]);
+    }
+
+    Array<float> a{0.1f, 1.0f, -2.0f, 3.0f, 4.0f};
+    Array<float> b(a.size());
+    approx::cos<Accuracy::High>(b, a);
+    for (size_t i = 0; i < a.size(); ++i)
+    {
+        ASSERT_EQ(approx::cos<Accuracy::High>(a[i]), b[i]);
+    }
+    Array<float> c(size_t(2));
+    ASSERT_THROW(approx::sin<Accuracy::High>(c, a), std::runtime_error);
+}
+
+TEST(ApproxTest, tiers_meet_their_max_error)
+{
+    assertMaxErrors(maxErrors<Accuracy::Low>(), {{1e-4, 1.1e-4, 1.1e-4, 1.1e-5, 7.1e-5}});
+    assertMaxErrors(maxErrors<Accuracy::Medium>(), {{2.3e-6, 3.8e-6, 3.8e-6, 6.1e-8, 1.8e-6}});
+    assertMaxErrors(maxErrors<Accuracy::High>(), {{1.2e-8, 2.7e-9, 2.7e-9, 4.3e-10, 1.3e-9}});
+    assertMaxErrors(maxErrors<Accuracy::Exact>(), {{1e-15, 1e-15, 1e-15, 1e-15, 1e-15}});
+}
+
+TEST(ApproxTest, float_functions)
+{
+    for (int i = 0; i < 1000; ++i)
+    {
+        const float x = float(i) * 0.01f - 5.0f;
+        ASSERT_NEAR(std::tanh(x), approx::tanh<Accuracy::High>(x), 3e-7f);
+        ASSERT_NEAR(1.0f, approx::exp<Accuracy::High>(x) / std::exp(x), 1e-6f);
+        ASSERT_NEAR(1.0f, approx::exp2<Accuracy::High>(x) / std::exp2(x), 3e-7f);
+        ASSERT_NEAR(x, approx::log2<Accuracy::High>(std::exp2(x)), 3e-7f);
+    }
+    ASSERT_EQ(0.0f, approx::tanh<Accuracy::High>(0.0f));
+    ASSERT_EQ(1.0f, approx::exp2<Accuracy::High>(0.0f));
+    ASSERT_EQ(0.0f, approx::log2<Accuracy::High>(1.0f));
+    ASSERT_EQ(1024.0f, approx::exp2<Accuracy::High>(10.0f));
+    // clamped to the range of normal exponents
+    ASSERT_LT(approx::exp<Accuracy::High>(-200.0f), 1e-37f);
+    ASSERT_TRUE(std::isfinite(approx::exp<Accuracy::High>(200.0f)));
+    ASSERT_NEAR(1.0f, approx::tanh<Accuracy::High>(200.0f), 1e-7f);
+}
+
+TEST(ApproxTest, packed_functions)
+{
+    const float4 x(0.1f, 1.0f, -2.0f, 3.0f);
+    const float4 tanh = approx::tanh<Accuracy::Medium>(x);
+    const float4 exp  = approx::exp<Accuracy::Medium>(x);
+    const float4 log2 = approx::log2<Accuracy::Medium>(exp);
+    const float4 tan  = approx::tan<Accuracy::Medium>(x);
+    for (size_t i = 0; i < float4::size(); ++i)
+    {
+        ASSERT_EQ(approx::tanh<Accuracy::Medium>(x[i]), tanh[i]);
+        ASSERT_EQ(approx::exp<Accuracy::Medium>(x[i]), exp[i]);
+        ASSERT_EQ(approx::log2<Accuracy::Medium>(exp[i]), log2[i]);
+        ASSERT_EQ(approx::tan<Accuracy::Medium>(x[i]), tan[i]);
+    }
+
+    Array<double> a{0.1, 1.0, -2.0, 3.0, 4.0};
+    Array<double> b(a.size());
+    approx::tanh<Accuracy::Low>(b, a);
+    for (size_t i = 0; i < a.size(); ++i)
+    {
+        ASSERT_EQ(approx::tanh<Accuracy::Low>(a[i]), b[i]);
+    }
+}
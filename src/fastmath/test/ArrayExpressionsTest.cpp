@@ -0,0 +1,89 @@
+#include "fastmath/ArrayExpressions.h"
+#include <gtest/gtest.h>
+#include <cmath>
+
+using namespace testing;
+using namespace dap;
+using dap::fastmath::Array;
+using dap::fastmath::VarArray;
+
+namespace
+{
+    Array<float> ramp(size_t size, float from, float step)
+    {
+        Array<float> x(size);
+        for (size_t i = 0; i < size; ++i)
+        {
+            x[i] = from + step * float(i);
+        }
+        return x;
+    }
+}
+
+TEST(ArrayExpressionsTest, fused_chain)
+{
+    const size_t size    = 67;
+    const Array<float> a = ramp(size, -1.0f, 0.03f);
+    const Array<float> b = ramp(size, 0.5f, 0.01f);
+    const Array<float> c = ramp(size, 2.0f, -0.05f);
+    const float gain     = 0.5f;
+
+    Array<float> result = gain * tanh(a + b * c);
+    ASSERT_EQ(size, result.size());
+    for (size_t i = 0; i < size; ++i)
+    {
+        ASSERT_NEAR(gain * std::tanh(a[i] + b[i] * c[i]), result[i], 1e-6f);
+    }
+    result = (a - 1) / 2 + sqrt(abs(c)) * -b;
+    for (size_t i = 0; i < size; ++i)
+    {
+        ASSERT_NEAR((a[i] - 1.0f) / 2.0f + std::sqrt(std::abs(c[i])) * -b[i], result[i], 1e-6f);
+    }
+    // in place, mixed with Eigen expressions
+    const float first = result[0];
+    result            = result * result + exp(a.map() * 0.5f);
+    ASSERT_NEAR(first * first + std::exp(-0.5f), result[0], 1e-6f);
+}
+
+TEST(ArrayExpressionsTest, forbidAllocation)
+{
+    const Array<float> a = ramp(8, 0.0f, 1.0f);
+    Array<float> result(a.size());
+    result.forbidAllocation(true);
+    const float* data = result.data();
+    result            = 2.0f * a + a * a;
+    ASSERT_EQ(data, result.data());
+    ASSERT_EQ(Array<float>({0, 3, 8, 15, 24, 35, 48, 63}), result);
+
+    Array<float> small(size_t(4));
+    small.forbidAllocation(true);
+    ASSERT_THROW(small = a + a, Array<float>::AllocationForbiddenException);
+}
+
+TEST(ArrayExpressionsTest, reductions)
+{
+    const Array<float> x = ramp(100, 1.0f, 1.0f);
+    const Array<float> y = ramp(100, 2.0f, 0.0f);
+    ASSERT_FLOAT_EQ(10100.0f, fastmath::sum(x * y));
+    ASSERT_FLOAT_EQ(50.5f, fastmath::mean(x));
+    ASSERT_FLOAT_EQ(200.0f, fastmath::max(x * y));
+    ASSERT_FLOAT_EQ(-200.0f, fastmath::min(-x * y));
+    ASSERT_FLOAT_EQ(338350.0f, fastmath::squaredNorm(x));
+    ASSERT_FLOAT_EQ(std::sqrt(4.0f * 338350.0f), fastmath::norm(x * y));
+}
+
+TEST(ArrayExpressionsTest, var_array)
+{
+    VarArray<fastmath::Variable<double>> a({1.0, 2.0, 3.0});
+    VarArray<fastmath::Variable<double>> b({4.0, 5.0, 6.0});
+    VarArray<fastmath::Variable<double>> result(a.size());
+    result.forbidAllocation(true);
+    result = a * b - 1;
+    ASSERT_EQ(3.0, result[0]);
+    ASSERT_EQ(9.0, result[1]);
+    ASSERT_EQ(17.0, result[2]);
+    ASSERT_EQ(32.0, fastmath::sum(a * b));
+    const Array<double> c({1.0, 1.0, 1.0});
+    result = a + c;
+    ASSERT_EQ(4.0, result[2]);
+}
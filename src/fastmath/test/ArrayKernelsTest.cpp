@@ -0,0 +1,250 @@
+#include "fastmath/ArrayKernels.h"
+#include "fastmath/ArrayOps.h"
+#include "fastmath/AlignedVector.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+using namespace testing;
+using namespace dap;
+using dap::fastmath::ArrayBackend;
+using dap::fastmath::ArrayKernels;
+
+namespace
+{
+    const ArrayBackend backends[] = {
+        ArrayBackend::Eigen, ArrayBackend::Sse41, ArrayBackend::Avx2, ArrayBackend::Avx512};
+
+    // floats in [from, to), with an extra float so that x.data() + 1 is never aligned
+    std::vector<float> signal(size_t size, float from, float to)
+    {
+        std::mt19937 engine(size);
+        std::uniform_real_distribution<float> distribution(from, to);
+        std::vector<float> x(size + 1);
+        for (auto& value : x)
+        {
+            value = distribution(engine);
+        }
+        return x;
+    }
+    double ulps(float value, double expected)
+    {
+        const float rounded = float(expected);
+        return std::abs(double(value) - expected) /
+               double(std::nextafter(std::abs(rounded), HUGE_VALF) - std::abs(rounded));
+    }
+
+    class ArrayKernelsTest : public Test
+    {
+        ArrayBackend m_backend{fastmath::arrayBackend()};
+
+    protected:
+        void TearDown() override
+        {
+            fastmath::setArrayBackend(m_backend);
+        }
+        // the kernels of every supported backend
+        template <typename Test>
+        void forEachBackend(Test test)
+        {
+            for (auto backend : backends)
+            {
+                if (fastmath::supported(backend))
+                {
+                    fastmath::setArrayBackend(backend);
+                    SCOPED_TRACE(testing::Message() << backend);
+                    test(fastmath::arrayKernels());
+                }
+            }
+        }
+    };
+}
+
+TEST_F(ArrayKernelsTest, backends)
+{
+    ASSERT_TRUE(fastmath::supported(ArrayBackend::Eigen));
+    ASSERT_TRUE(fastmath::supported(fastmath::arrayBackend()));
+    for (auto backend : backends)
+    {
+        if (fastmath::supported(backend))
+        {
+            fastmath::setArrayBackend(backend);
+            ASSERT_EQ(backend, fastmath::arrayBackend());
+            ASSERT_EQ(backend, fastmath::arrayKernels().backend);
+        }
+        else
+        {
+            ASSERT_THROW(fastmath::setArrayBackend(backend), std::invalid_argument);
+        }
+    }
+    std::ostringstream out;
+    out << ArrayBackend::Avx2;
+    ASSERT_EQ("AVX2", out.str());
+}
+
+TEST_F(ArrayKernelsTest, arithmetic)
+{
+    forEachBackend([](const ArrayKernels& kernels) {
+        for (size_t size : {0, 1, 3, 4, 7, 8, 15, 16, 17, 33, 64, 67})
+        {
+            const auto x = signal(size, -2.0f, 2.0f);
+            const auto y = signal(size + 1, -2.0f, 2.0f);
+            const auto z = signal(size + 2, -2.0f, 2.0f);
+            std::vector<float> result(size + 1);
+            kernels.add(result.data() + 1, x.data() + 1, y.data(), size);
+            for (size_t i = 0; i < size; ++i)
+            {
+                ASSERT_EQ(x[i + 1] + y[i], result[i + 1]) << size;
+            }
+            kernels.sub(result.data() + 1, x.data() + 1, y.data(), size);
+            for (size_t i = 0; i < size; ++i)
+            {
+                ASSERT_EQ(x[i + 1] - y[i], result[i + 1]) << size;
+            }
+            kernels.mul(result.data() + 1, x.data() + 1, y.data(), size);
+            for (size_t i = 0; i < size; ++i)
+            {
+                ASSERT_EQ(x[i + 1] * y[i], result[i + 1]) << size;
+            }
+            kernels.fma(result.data(), x.data(), y.data() + 1, z.data(), size);
+            for (size_t i = 0; i < size; ++i)
+            {
+                ASSERT_NEAR(double(x[i]) * y[i + 1] + z[i], result[i], 1e-6) << size;
+            }
+            kernels.abs(result.data() + 1, x.data(), size);
+            for (size_t i = 0; i < size; ++i)
+            {
+                ASSERT_EQ(std::abs(x[i]), result[i + 1]) << size;
+            }
+            kernels.abs(result.data(), x.data(), size);
+            kernels.sqrt(result.data(), result.data(), size);
+            for (size_t i = 0; i < size; ++i)
+            {
+                ASSERT_FLOAT_EQ(std::sqrt(std::abs(x[i])), result[i]) << size;
+            }
+        }
+    });
+}
+
+TEST_F(ArrayKernelsTest, reductions)
+{
+    forEachBackend([](const ArrayKernels& kernels) {
+        for (size_t size : {1, 3, 4, 7, 8, 15, 16, 17, 33, 64, 67, 1000})
+        {
+            const auto x   = signal(size, -2.0f, 2.0f);
+            double sum     = 0.0;
+            double squares = 0.0;
+            float min      = x[1];
+            float max      = x[1];
+            for (size_t i = 1; i <= size; ++i)
+            {
+                sum += x[i];
+                squares += double(x[i]) * x[i];
+                min = std::min(min, x[i]);
+                max = std::max(max, x[i]);
+            }
+            ASSERT_EQ(min, kernels.min(x.data() + 1, size)) << size;
+            ASSERT_EQ(max, kernels.max(x.data() + 1, size)) << size;
+            ASSERT_NEAR(sum, kernels.sum(x.data() + 1, size), 1e-6 * size) << size;
+            ASSERT_NEAR(squares, kernels.squaredNorm(x.data() + 1, size), 1e-6 * size) << size;
+        }
+        float none = 0.0f;
+        ASSERT_EQ(0.0f, kernels.sum(&none, 0));
+        ASSERT_EQ(0.0f, kernels.squaredNorm(&none, 0));
+    });
+}
+
+TEST_F(ArrayKernelsTest, exp_log)
+{
+    forEachBackend([](const ArrayKernels& kernels) {
+        const size_t size = 10001;
+        auto x            = signal(size, -87.0f, 88.0f);
+        std::vector<float> result(size + 1);
+        kernels.exp(result.data(), x.data() + 1, size);
+        for (size_t i = 0; i < size; ++i)
+        {
+            ASSERT_LE(ulps(result[i], std::exp(double(x[i + 1]))), 2.0) << x[i + 1];
+        }
+        x = signal(size, 1e-30f, 1e30f);
+        x[1] = 1.0f;
+        x[2] = std::numeric_limits<float>::min();
+        x[3] = std::numeric_limits<float>::max();
+        kernels.log(result.data(), x.data() + 1, size);
+        for (size_t i = 0; i < size; ++i)
+        {
+            ASSERT_LE(ulps(result[i], std::log(double(x[i + 1]))), 2.0) << x[i + 1];
+        }
+        const float special[] = {0.0f, -1.0f, HUGE_VALF, NAN, -HUGE_VALF};
+        kernels.log(result.data(), special, 5);
+        ASSERT_EQ(-HUGE_VALF, result[0]);
+        ASSERT_TRUE(std::isnan(result[1]));
+        ASSERT_EQ(HUGE_VALF, result[2]);
+        ASSERT_TRUE(std::isnan(result[3]));
+        ASSERT_TRUE(std::isnan(result[4]));
+        for (size_t i = 1; i < 16; ++i)
+        {
+            const float e = std::exp(float(i) / 4.0f);
+            kernels.log(result.data(), &e, 1);
+            ASSERT_NEAR(float(i) / 4.0f, result[0], 1e-6);
+        }
+    });
+}
+
+TEST_F(ArrayKernelsTest, array_ops)
+{
+    forEachBackend([](const ArrayKernels&) {
+        fastmath::AlignedVector<float> x({1.0f, 2.0f, 3.0f, 4.0f, 5.0f});
+        fastmath::AlignedVector<float> y({2.0f, 2.0f, 2.0f, 2.0f, 2.0f});
+        fastmath::AlignedVector<float> result(5);
+        fastmath::fma(result.data(), x.data(), y.data(), x.data(), x.size());
+        ASSERT_EQ(fastmath::AlignedVector<float>({3.0f, 6.0f, 9.0f, 12.0f, 15.0f}), result);
+        ASSERT_EQ(3.0f, fastmath::mean(x.data(), x.size()));
+        ASSERT_FLOAT_EQ(std::sqrt(55.0f), fastmath::norm(x.data(), x.size()));
+        fastmath::add(result.data() + 1, x.data(), y.data() + 1, 4);
+        ASSERT_EQ(fastmath::AlignedVector<float>({3.0f, 3.0f, 4.0f, 5.0f, 6.0f}), result);
+        ASSERT_EQ(9.0f, fastmath::sum(result.data() + 2, 2));
+        fastmath::add<float, 64>(result.data(), x.data(), y.data(), 5);
+        ASSERT_THROW((fastmath::add<float, 64>(result.data() + 1, x.data(), y.data(), 4)),
+                     std::runtime_error);
+        ASSERT_THROW((fastmath::sum<float, 16>(x.data() + 2, 3)), std::runtime_error);
+    });
+}
+
+TEST_F(ArrayKernelsTest, any_offsets)
+{
+    // heads, aligned bodies and tails of every length, the arguments aligned or not as the result
+    forEachBackend([](const ArrayKernels& kernels) {
+        const auto x = signal(100, -2.0f, 2.0f);
+        const auto y = signal(101, -2.0f, 2.0f);
+        const fastmath::AlignedVector<float> x64(x.begin(), x.end());
+        fastmath::AlignedVector<float> result(x.size());
+        const float* unaligned = x.data() + 3;
+        for (size_t offset = 0; offset < 16; ++offset)
+        {
+            for (size_t size : {size_t(0), size_t(1), size_t(5), size_t(17), size_t(80)})
+            {
+                for (const float* input : {x64.data() + offset, unaligned})
+                {
+                    float* out = result.data() + offset;
+                    kernels.mul(out, input, y.data() + offset, size);
+                    double sum = 0.0;
+                    for (size_t i = 0; i < size; ++i)
+                    {
+                        ASSERT_EQ(input[i] * y[offset + i], out[i]) << offset << " " << size;
+                        sum += input[i];
+                    }
+                    ASSERT_NEAR(sum, kernels.sum(input, size), 1e-5 * (size + 1)) << offset;
+                    if (size > 0)
+                    {
+                        ASSERT_EQ(*std::max_element(input, input + size), kernels.max(input, size));
+                    }
+                }
+            }
+        }
+    });
+}
@@ -356,6 +356,16 @@ void test_div()
     aligned_vector<T> expected({T(5), T(4), T(5)});
     assert_near(expected, x, 1e-6);
 }
+template <typename T>
+void test_fma()
+{
+    aligned_vector<T> x({T(1), T(2), T(3)});
+    aligned_vector<T> y({T(4), T(5), T(6)});
+    aligned_vector<T> z({T(7), T(8), T(9)});
+    fastmath::fma(x.data(), x.data(), y.data(), z.data(), x.size());
+    aligned_vector<T> expected({T(11), T(18), T(27)});
+    assert_near(expected, x, 1e-6);
+}
 
 TEST(ArrayOpsTest, all)
 {
@@ -563,3 +573,9 @@ TEST(ArrayOpsTest, div)
     test_div<float>();
     test_div<double>();
 }
+TEST(ArrayOpsTest, fma)
+{
+    test_fma<int>();
+    test_fma<float>();
+    test_fma<double>();
+}
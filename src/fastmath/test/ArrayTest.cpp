@@ -230,6 +230,25 @@ TEST(ArrayTest, ref2)
     ASSERT_EQ(a[1], c[0]);
     ASSERT_EQ(42, a[1]);
 }
+TEST(ArrayTest, views_at_any_offset)
+{
+    Array<float> a(size_t(67));
+    a.linspace(1.0f, 67.0f);
+    for (size_t start = 0; start < 16; ++start)
+    {
+        Array<float> b(a.data(), start, a.size(), false);
+        Array<float> c(b.size());
+        fastmath::add(c.data(), b.data(), b.data(), b.size());
+        for (size_t i = 0; i < b.size(); ++i)
+        {
+            ASSERT_EQ(2.0f * a[start + i], c[i]);
+        }
+        const float sum = (a.size() * (a.size() + 1) - start * (start + 1)) / 2.0f;
+        ASSERT_EQ(sum, fastmath::sum(b.data(), b.size()));
+        ASSERT_EQ(sum, b.map().sum());
+        ASSERT_EQ(sum, b.accumulate());
+    }
+}
 TEST(ArrayTest, range_loop)
 {
     const auto list(std::initializer_list<int>{1, 2, 3, 4});
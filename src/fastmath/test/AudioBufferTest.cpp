@@ -186,3 +186,97 @@ TEST(AudioBufferTest, move)
         }
     }
 }
+TEST(AudioBufferTest, single_allocation)
+{
+    AudioBuffer<float> buf(3, 10, 1.0f);
+    ASSERT_EQ(16u, buf.channelStride());
+    for (size_t ch = 0; ch < buf.channelCount(); ++ch)
+    {
+        ASSERT_EQ(buf.data()[0] + ch * buf.channelStride(), buf.channel(ch).data());
+        ASSERT_EQ(0u, size_t(buf.data()[ch]) % fastmath::maxAlignment);
+        ASSERT_EQ(buf.data()[ch], buf.channelData()[ch]);
+    }
+    AudioBuffer<double> buf2(2, 16);
+    ASSERT_EQ(16u, buf2.channelStride());
+    AudioBuffer<float> mono({1, 2, 3});
+    ASSERT_EQ(1u, mono.channelCount());
+    assert_eq(Array<float>({1, 2, 3}), mono.channel(0));
+}
+TEST(AudioBufferTest, move_steals_samples)
+{
+    AudioBuffer<float> buf(2, 100, 3.0f);
+    float* const* channels = buf.data();
+    float* left            = buf.data()[0];
+    AudioBuffer<float> buf2(std::move(buf));
+    ASSERT_EQ(channels, buf2.data());
+    ASSERT_EQ(left, buf2.channel(0).data());
+    ASSERT_EQ(3.0f, buf2.channel(1)[99]);
+    ASSERT_EQ(0u, buf.channelCount()); // NOLINT
+    ASSERT_EQ(0u, buf.channelSize());  // NOLINT
+
+    AudioBuffer<float> buf3(1, 4);
+    buf3 = std::move(buf2);
+    ASSERT_EQ(left, buf3.data()[0]);
+    ASSERT_EQ(2u, buf3.channelCount());
+    ASSERT_EQ(100u, buf3.channelSize());
+}
+TEST(AudioBufferTest, views)
+{
+    AudioBuffer<int> buf(4, 8);
+    for (size_t ch = 0; ch < buf.channelCount(); ++ch)
+    {
+        for (size_t i = 0; i < buf.channelSize(); ++i)
+        {
+            buf.channel(ch)[i] = int(10 * ch + i);
+        }
+    }
+    const auto view = buf.view(1, 2, 3, 4);
+    ASSERT_EQ(2u, view.channelCount());
+    ASSERT_EQ(4u, view.channelSize());
+    ASSERT_EQ(13, view(0, 0));
+    ASSERT_EQ(26, view(1, 3));
+    ASSERT_EQ(buf.channel(2).data() + 3, view.channel(1));
+
+    view.frames(1, 2).fill(-1);
+    ASSERT_EQ(13, buf.channel(1)[3]);
+    ASSERT_EQ(-1, buf.channel(1)[4]);
+    ASSERT_EQ(-1, buf.channel(2)[5]);
+    ASSERT_EQ(26, buf.channel(2)[6]);
+    ASSERT_EQ(0, buf.channel(0)[0]);
+    ASSERT_EQ(34, buf.channel(3)[4]);
+
+    const AudioBuffer<int>& constBuf = buf;
+    fastmath::AudioBufferView<const int> constView = constBuf.view().channels(3, 1);
+    ASSERT_EQ(37, constView(0, 7));
+    fastmath::AudioBufferView<const int> fromMutable = view;
+    ASSERT_EQ(view.channel(0), fromMutable.channel(0));
+}
+TEST(AudioBufferTest, device_pointers)
+{
+    // the float** of an audio device, processed and filled in place
+    std::vector<float> left(6, 1.0f);
+    std::vector<float> right(6, 2.0f);
+    float* outputs[] = {left.data(), right.data()};
+    fastmath::AudioBufferView<float> device(outputs, 2, 6);
+    for (size_t ch = 0; ch < device.channelCount(); ++ch)
+    {
+        for (size_t i = 0; i < device.channelSize(); ++i)
+        {
+            device(ch, i) *= 3.0f;
+        }
+    }
+    ASSERT_EQ(3.0f, left[5]);
+    ASSERT_EQ(6.0f, right[0]);
+
+    AudioBuffer<float> buf(2, 6);
+    buf.fill(5.0f);
+    device.frames(2, 4).copy(buf.view());
+    ASSERT_EQ(3.0f, left[1]);
+    ASSERT_EQ(5.0f, left[2]);
+    ASSERT_EQ(5.0f, right[5]);
+
+    const AudioBuffer<float> copy(device);
+    ASSERT_EQ(6.0f, copy.channel(1)[1]);
+    ASSERT_EQ(5.0f, copy.channel(1)[2]);
+    ASSERT_NE(right.data(), copy.channel(1).data());
+}
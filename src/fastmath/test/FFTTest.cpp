@@ -0,0 +1,76 @@
+#include "fastmath/FFT.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace testing;
+using namespace dap;
+using dap::fastmath::FFT;
+
+namespace
+{
+    std::vector<double> signal(size_t size)
+    {
+        std::mt19937 engine(size);
+        std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+        std::vector<double> x(size);
+        for (auto& value : x)
+        {
+            value = distribution(engine);
+        }
+        return x;
+    }
+}
+
+TEST(FFTTest, invalid_size)
+{
+    ASSERT_THROW(FFT<float>(4), std::invalid_argument);
+    ASSERT_THROW(FFT<float>(48), std::invalid_argument);
+}
+
+TEST(FFTTest, forward_matches_dft)
+{
+    for (size_t size : {8, 16, 64, 512})
+    {
+        const auto x = signal(size);
+        FFT<double> fft(size);
+        ASSERT_EQ(size / 2 + 1, fft.bins());
+        std::vector<double> re(fft.bins());
+        std::vector<double> im(fft.bins());
+        fft.forward(x.data(), re.data(), im.data());
+        for (size_t k = 0; k < fft.bins(); ++k)
+        {
+            double dftRe = 0.0;
+            double dftIm = 0.0;
+            for (size_t n = 0; n < size; ++n)
+            {
+                const double w = -2.0 * M_PI * double(k * n) / double(size);
+                dftRe += x[n] * std::cos(w);
+                dftIm += x[n] * std::sin(w);
+            }
+            ASSERT_NEAR(dftRe, re[k], 1e-9) << size << " " << k;
+            ASSERT_NEAR(dftIm, im[k], 1e-9) << size << " " << k;
+        }
+    }
+}
+
+TEST(FFTTest, inverse_roundtrip)
+{
+    for (size_t size : {8, 32, 1024})
+    {
+        const auto x = signal(size);
+        std::vector<float> in(x.begin(), x.end());
+        FFT<float> fft(size);
+        std::vector<float> re(fft.bins());
+        std::vector<float> im(fft.bins());
+        std::vector<float> out(size);
+        fft.forward(in.data(), re.data(), im.data());
+        fft.inverse(re.data(), im.data(), out.data());
+        for (size_t n = 0; n < size; ++n)
+        {
+            ASSERT_NEAR(in[n], out[n] / float(size), 1e-5f) << size << " " << n;
+        }
+    }
+}
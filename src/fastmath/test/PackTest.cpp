@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+#include <cmath>
+
+#include "fastmath/Pack.h"
+#include "fastmath/Variable.h"
+
+using namespace testing;
+using namespace dap;
+using namespace dap::fastmath;
+
+static_assert(isPacked<float4>(), "float4 is a packed type");
+static_assert(!isPacked<float>(), "float is not a packed type");
+static_assert(isArithmeticOrComplex<float4>(), "packs of arithmetic types are arithmetic");
+static_assert(isSame<float, lane_scalar_t<float8>>(), "float8 lanes are floats");
+
+TEST(PackTest, arithmetic_is_lane_wise)
+{
+    const float4 a(1.0f, 2.0f, 3.0f, 4.0f);
+    const float4 b(4.0f, 3.0f, 2.0f, 1.0f);
+    const float4 sum     = a + b;
+    const float4 diff    = a - b;
+    const float4 prod    = a * b;
+    const float4 quot    = a / b;
+    const float4 scaled  = 2.0f * a + 1;
+    const float4 negated = -a;
+    for (size_t i = 0; i < float4::size(); ++i)
+    {
+        ASSERT_FLOAT_EQ(a[i] + b[i], sum[i]);
+        ASSERT_FLOAT_EQ(a[i] - b[i], diff[i]);
+        ASSERT_FLOAT_EQ(a[i] * b[i], prod[i]);
+        ASSERT_FLOAT_EQ(a[i] / b[i], quot[i]);
+        ASSERT_FLOAT_EQ(2.0f * a[i] + 1.0f, scaled[i]);
+        ASSERT_FLOAT_EQ(-a[i], negated[i]);
+    }
+}
+TEST(PackTest, select_picks_lanes)
+{
+    const float8 x(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f);
+    const auto mask   = x < 4.0f;
+    const float8 clip = select(mask, x, float8(4.0f));
+    ASSERT_TRUE(mask.any());
+    ASSERT_FALSE(mask.all());
+    for (size_t i = 0; i < float8::size(); ++i)
+    {
+        ASSERT_EQ(i < 4, mask[i]);
+        ASSERT_FLOAT_EQ(std::min(float(i), 4.0f), clip[i]);
+    }
+    ASSERT_FLOAT_EQ(2.0f, select(false, 1.0f, 2.0f));
+}
+TEST(PackTest, functions_match_scalar)
+{
+    const float4 x(-1.5f, -0.25f, 0.5f, 2.75f);
+    const auto s = sin(x);
+    const auto t = tanh(x);
+    const auto f = floor(x);
+    const auto m = max(x, float4(0.0f));
+    const auto c = clip(x, float4(-1.0f), float4(1.0f));
+    for (size_t i = 0; i < float4::size(); ++i)
+    {
+        ASSERT_FLOAT_EQ(std::sin(x[i]), s[i]);
+        ASSERT_FLOAT_EQ(std::tanh(x[i]), t[i]);
+        ASSERT_FLOAT_EQ(std::floor(x[i]), f[i]);
+        ASSERT_FLOAT_EQ(std::max(x[i], 0.0f), m[i]);
+        ASSERT_FLOAT_EQ(std::min(std::max(x[i], -1.0f), 1.0f), c[i]);
+    }
+}
+TEST(PackTest, variable_of_pack)
+{
+    Variable<float4> v = float4(1.0f, 2.0f, 3.0f, 4.0f);
+    v *= 2.0f;
+    const float4 x = v();
+    for (size_t i = 0; i < float4::size(); ++i)
+    {
+        ASSERT_FLOAT_EQ(2.0f * float(i + 1), x[i]);
+    }
+}
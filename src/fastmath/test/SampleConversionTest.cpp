@@ -0,0 +1,269 @@
+#include "fastmath/SampleConversion.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace testing;
+using namespace dap;
+using dap::fastmath::ArrayBackend;
+using dap::fastmath::AudioBuffer;
+using dap::fastmath::Int24;
+
+namespace
+{
+    const ArrayBackend backends[] = {
+        ArrayBackend::Eigen, ArrayBackend::Sse41, ArrayBackend::Avx2, ArrayBackend::Avx512};
+
+    std::vector<float> signal(size_t size, float from, float to)
+    {
+        std::mt19937 engine(size);
+        std::uniform_real_distribution<float> distribution(from, to);
+        std::vector<float> x(size);
+        for (auto& value : x)
+        {
+            value = distribution(engine);
+        }
+        return x;
+    }
+    // uniform floats in [-1, 1), as dsp::UniformDistribution
+    class Random
+    {
+        std::mt19937 m_engine{42};
+        std::uniform_real_distribution<float> m_distribution{-1.0f, 1.0f};
+
+    public:
+        void fill(float* x, size_t size)
+        {
+            for (size_t i = 0; i < size; ++i)
+            {
+                x[i] = m_distribution(m_engine);
+            }
+        }
+    };
+    // x scaled, clipped and rounded to nearest
+    template <typename Int>
+    Int quantized(float x, float scale, float high)
+    {
+        return Int(std::nearbyint(std::min(std::max(x * scale, -scale), high)));
+    }
+    int32_t value(const Int24& x)
+    {
+        return int32_t(uint32_t(x.bytes[0]) << 8 | uint32_t(x.bytes[1]) << 16 |
+                       uint32_t(x.bytes[2]) << 24) >>
+               8;
+    }
+
+    class SampleConversionTest : public Test
+    {
+        ArrayBackend m_backend{fastmath::arrayBackend()};
+
+    protected:
+        void TearDown() override
+        {
+            fastmath::setArrayBackend(m_backend);
+        }
+        template <typename Test>
+        void forEachBackend(Test test)
+        {
+            for (auto backend : backends)
+            {
+                if (fastmath::supported(backend))
+                {
+                    fastmath::setArrayBackend(backend);
+                    SCOPED_TRACE(testing::Message() << backend);
+                    test();
+                }
+            }
+        }
+    };
+}
+
+TEST_F(SampleConversionTest, integers)
+{
+    forEachBackend([] {
+        for (size_t size : {0, 1, 3, 8, 15, 16, 17, 67, 1000})
+        {
+            auto x = signal(size + 1, -1.2f, 1.2f);
+            std::vector<int16_t> x16(size);
+            std::vector<Int24> x24(size);
+            std::vector<int32_t> x32(size);
+            std::vector<float> y(size);
+            fastmath::convert(x16.data(), x.data() + 1, size);
+            fastmath::convert(x24.data(), x.data() + 1, size);
+            fastmath::convert(x32.data(), x.data() + 1, size);
+            for (size_t i = 0; i < size; ++i)
+            {
+                const float a = x[i + 1];
+                ASSERT_EQ(quantized<int16_t>(a, 32768.0f, 32767.0f), x16[i]) << size;
+                ASSERT_EQ(quantized<int32_t>(a, 8388608.0f, 8388607.0f), value(x24[i])) << size;
+                ASSERT_EQ(quantized<int32_t>(a, 2147483648.0f, 2147483520.0f), x32[i]) << size;
+            }
+            fastmath::convert(y.data(), x16.data(), size);
+            for (size_t i = 0; i < size; ++i)
+            {
+                ASSERT_EQ(float(x16[i]) / 32768.0f, y[i]) << size;
+            }
+            fastmath::convert(y.data(), x24.data(), size);
+            for (size_t i = 0; i < size; ++i)
+            {
+                ASSERT_EQ(float(value(x24[i])) / 8388608.0f, y[i]) << size;
+            }
+            fastmath::convert(y.data(), x32.data(), size);
+            for (size_t i = 0; i < size; ++i)
+            {
+                ASSERT_EQ(float(x32[i]) / 2147483648.0f, y[i]) << size;
+            }
+        }
+    });
+}
+
+TEST_F(SampleConversionTest, clipping)
+{
+    forEachBackend([] {
+        const float x[] = {-2.0f, -1.0f, 0.5f, 1.0f, 2.0f, NAN};
+        int16_t x16[6];
+        Int24 x24[6];
+        int32_t x32[6];
+        fastmath::convert(x16, x, 6);
+        fastmath::convert(x24, x, 6);
+        fastmath::convert(x32, x, 6);
+        ASSERT_EQ(std::vector<int16_t>({-32768, -32768, 16384, 32767, 32767, -32768}),
+                  std::vector<int16_t>(x16, x16 + 6));
+        ASSERT_EQ(INT32_MIN, x32[0]);
+        ASSERT_EQ(INT32_MIN, x32[1]);
+        ASSERT_EQ(1 << 30, x32[2]);
+        ASSERT_EQ(2147483520, x32[3]);
+        ASSERT_EQ(2147483520, x32[4]);
+        // little endian
+        ASSERT_EQ(0x00, x24[1].bytes[0]);
+        ASSERT_EQ(0x00, x24[1].bytes[1]);
+        ASSERT_EQ(0x80, x24[1].bytes[2]);
+        ASSERT_EQ(0x400000, value(x24[2]));
+        ASSERT_EQ(0xff, x24[3].bytes[0]);
+        ASSERT_EQ(0xff, x24[3].bytes[1]);
+        ASSERT_EQ(0x7f, x24[3].bytes[2]);
+    });
+}
+
+TEST_F(SampleConversionTest, dither)
+{
+    forEachBackend([] {
+        // a quarter of an lsb, rounded to 0 without dither, its mean kept with it
+        const size_t size = 10000;
+        std::vector<float> x(size, 0.25f / 32768.0f);
+        x[0] = 1.0f;
+        x[1] = -1.0f;
+        std::vector<int16_t> result(size);
+        Random random;
+        fastmath::convert(result.data(), x.data(), size, random);
+        ASSERT_EQ(32767, result[0]);
+        ASSERT_EQ(-32768, result[1]);
+        double sum = 0.0;
+        for (size_t i = 2; i < size; ++i)
+        {
+            ASSERT_GE(result[i], -1);
+            ASSERT_LE(result[i], 1);
+            sum += result[i];
+        }
+        ASSERT_NEAR(0.25, sum / (size - 2), 0.02);
+    });
+}
+
+TEST_F(SampleConversionTest, interleave)
+{
+    forEachBackend([] {
+        for (size_t channels = 1; channels <= 8; ++channels)
+        {
+            for (size_t frames : {0, 1, 3, 4, 5, 7, 8, 17, 67})
+            {
+                AudioBuffer<float> buffer(channels, frames + 1);
+                for (size_t ch = 0; ch < channels; ++ch)
+                {
+                    for (size_t i = 0; i <= frames; ++i)
+                    {
+                        buffer.channel(ch)[i] = float(ch * 1000 + i);
+                    }
+                }
+                // frames from the second one, a sentinel after them
+                std::vector<float> x(channels * frames + 1, -1.0f);
+                fastmath::interleave(x.data(), buffer.view(0, channels, 1, frames));
+                for (size_t i = 0; i < frames; ++i)
+                {
+                    for (size_t ch = 0; ch < channels; ++ch)
+                    {
+                        ASSERT_EQ(float(ch * 1000 + i + 1), x[i * channels + ch])
+                            << channels << " " << frames;
+                    }
+                }
+                ASSERT_EQ(-1.0f, x.back());
+
+                AudioBuffer<float> result(channels, frames + 1, -1.0f);
+                fastmath::deinterleave(result.view(0, channels, 1, frames), x.data());
+                for (size_t ch = 0; ch < channels; ++ch)
+                {
+                    ASSERT_EQ(-1.0f, result.channel(ch)[0]);
+                    for (size_t i = 1; i <= frames; ++i)
+                    {
+                        ASSERT_EQ(buffer.channel(ch)[i], result.channel(ch)[i])
+                            << channels << " " << frames;
+                    }
+                }
+            }
+        }
+        AudioBuffer<float> buffer(9, 4);
+        std::vector<float> x(36);
+        ASSERT_THROW(fastmath::interleave(x.data(), buffer), std::invalid_argument);
+        ASSERT_THROW(fastmath::deinterleave(buffer, x.data()), std::invalid_argument);
+    });
+}
+
+TEST_F(SampleConversionTest, interleave_integers)
+{
+    forEachBackend([] {
+        // more frames than a block
+        const size_t channels = 3;
+        const size_t frames   = 1000;
+        AudioBuffer<float> buffer(channels, frames);
+        for (size_t ch = 0; ch < channels; ++ch)
+        {
+            const auto x = signal(frames + ch, -1.0f, 1.0f);
+            std::copy_n(x.begin(), frames, buffer.channel(ch).data());
+        }
+        std::vector<int16_t> x16(channels * frames);
+        std::vector<Int24> x24(channels * frames);
+        fastmath::interleave(x16.data(), buffer);
+        fastmath::interleave(x24.data(), buffer);
+        for (size_t i = 0; i < frames; ++i)
+        {
+            for (size_t ch = 0; ch < channels; ++ch)
+            {
+                const float a = buffer.channel(ch)[i];
+                ASSERT_EQ(quantized<int16_t>(a, 32768.0f, 32767.0f), x16[i * channels + ch]);
+                ASSERT_EQ(quantized<int32_t>(a, 8388608.0f, 8388607.0f),
+                          value(x24[i * channels + ch]));
+            }
+        }
+        AudioBuffer<float> result(channels, frames);
+        fastmath::deinterleave(result, x24.data());
+        for (size_t ch = 0; ch < channels; ++ch)
+        {
+            for (size_t i = 0; i < frames; ++i)
+            {
+                ASSERT_NEAR(buffer.channel(ch)[i], result.channel(ch)[i], 0.5f / 8388608.0f);
+            }
+        }
+        Random random;
+        std::vector<int32_t> x32(channels * frames);
+        fastmath::interleave(x32.data(), buffer, random);
+        fastmath::deinterleave(result, x32.data());
+        for (size_t ch = 0; ch < channels; ++ch)
+        {
+            for (size_t i = 0; i < frames; ++i)
+            {
+                ASSERT_NEAR(buffer.channel(ch)[i], result.channel(ch)[i], 1e-7f);
+            }
+        }
+    });
+}
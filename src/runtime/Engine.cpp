@@ -0,0 +1,113 @@
+#include "Engine.h"
+#include <algorithm>
+
+using dap::runtime::Engine;
+using dap::runtime::Graph;
+
+Engine::Engine(size_t crossfade)
+: m_crossfade(crossfade)
+, m_reclaimer(&Engine::reclaim, this)
+{
+}
+
+Engine::~Engine()
+{
+    m_running.store(false, std::memory_order_release);
+    m_wake.signal();
+    m_reclaimer.join();
+    delete m_retired.load();
+    delete m_pending.load();
+    delete m_previous;
+    delete m_current;
+}
+
+void Engine::reclaim()
+{
+    while (m_running.load(std::memory_order_acquire))
+    {
+        m_wake.wait();
+        delete m_retired.exchange(nullptr, std::memory_order_acq_rel);
+    }
+}
+
+Graph& Engine::swap(std::unique_ptr<Graph> graph)
+{
+    if (!graph->isCompiled())
+    {
+        graph->compile();
+    }
+    Graph& published = *graph;
+    // a graph still pending was never played, so it can be deleted right here
+    delete m_pending.exchange(graph.release(), std::memory_order_acq_rel);
+    return published;
+}
+
+// hands the previous graph to the reclaimer, retried at the next block if it is still busy
+void Engine::retire()
+{
+    Graph* expected = nullptr;
+    if (m_previous == nullptr ||
+        m_retired.compare_exchange_strong(expected, m_previous, std::memory_order_acq_rel))
+    {
+        if (m_previous != nullptr)
+        {
+            m_wake.signal();
+        }
+        m_previous = nullptr;
+        m_fading   = false;
+    }
+}
+
+void Engine::processBlock(float* out, size_t frames)
+{
+    if (!m_fading)
+    {
+        if (Graph* next = m_pending.exchange(nullptr, std::memory_order_acq_rel))
+        {
+            m_previous = m_current;
+            m_current  = next;
+            m_fading   = m_crossfade > 0 || m_previous != nullptr;
+            m_fade     = 0;
+        }
+    }
+    if (m_current == nullptr)
+    {
+        std::fill(out, out + frames, 0.0f);
+        return;
+    }
+    m_current->process(out, frames);
+    if (m_fading)
+    {
+        if (m_fade < m_crossfade)
+        {
+            // the first graph fades in from silence
+            if (m_previous != nullptr)
+            {
+                m_previous->process(m_block.data(), frames);
+            }
+            else
+            {
+                std::fill(m_block.begin(), m_block.begin() + frames, 0.0f);
+            }
+            const float step = 1.0f / float(m_crossfade);
+            for (size_t n = 0; n < frames; ++n)
+            {
+                const float gain = std::min(float(m_fade + n + 1) * step, 1.0f);
+                out[n]           = m_block[n] + gain * (out[n] - m_block[n]);
+            }
+            m_fade += frames;
+        }
+        if (m_fade >= m_crossfade)
+        {
+            retire();
+        }
+    }
+}
+
+void Engine::process(float* out, size_t frames)
+{
+    for (size_t offset = 0; offset < frames; offset += max_block_size_t::value)
+    {
+        processBlock(out + offset, std::min(frames - offset, max_block_size_t::value));
+    }
+}
@@ -0,0 +1,75 @@
+#ifndef DAP_RUNTIME_ENGINE_H
+#define DAP_RUNTIME_ENGINE_H
+
+#include "Graph.h"
+#include "base/Semaphore.h"
+#include <array>
+#include <atomic>
+#include <memory>
+#include <thread>
+
+namespace dap
+{
+    namespace runtime
+    {
+        class Engine;
+    }
+}
+
+// Plays runtime graphs on the audio thread while new ones are built elsewhere. swap() publishes a
+// graph which process() picks up at the next block boundary, fading from the playing graph to the
+// new one over a few frames. The old graph keeps being rendered during the crossfade and is then
+// handed to a reclaimer thread which deletes it, so the audio thread never frees memory. Graphs
+// published faster than the audio thread picks them up replace each other, only the latest one
+// is played.
+class dap::runtime::Engine final
+{
+    using block_t = std::array<float, max_block_size_t::value>;
+
+    // shared with other threads
+    std::atomic<Graph*> m_pending{nullptr};
+    std::atomic<Graph*> m_retired{nullptr};
+    std::atomic<bool> m_running{true};
+    Semaphore m_wake;
+
+    // owned by the audio thread
+    Graph* m_current{nullptr};
+    Graph* m_previous{nullptr};
+    bool m_fading{false};
+    size_t m_fade{0};
+    const size_t m_crossfade;
+    block_t m_block{};
+
+    std::thread m_reclaimer;
+
+    void reclaim();
+    void retire();
+    void processBlock(float* out, size_t frames);
+
+public:
+    // crossfade is the length, in frames, of the transition between two graphs
+    explicit Engine(size_t crossfade = 256);
+    Engine(const Engine&) = delete;
+    Engine(Engine&&)      = delete;
+    ~Engine();
+    Engine& operator=(const Engine&) = delete;
+    Engine& operator=(Engine&&) = delete;
+
+    // publishes graph, compiling it first if needed. The returned graph can be used to set its
+    // parameters until a later graph has replaced it.
+    Graph& swap(std::unique_ptr<Graph> graph);
+    // true while fading between two graphs, audio thread only
+    bool isFading() const
+    {
+        return m_fading;
+    }
+    // the graph being played, audio thread only
+    const Graph* current() const
+    {
+        return m_current;
+    }
+    // renders frames samples into out, silence until a graph has been published
+    void process(float* out, size_t frames);
+};
+
+#endif // DAP_RUNTIME_ENGINE_H
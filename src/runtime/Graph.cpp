@@ -0,0 +1,262 @@
+#include "Graph.h"
+#include <algorithm>
+#include <cassert>
+#include <stdexcept>
+
+using dap::runtime::Graph;
+
+Graph::Node& Graph::node(NodeId id)
+{
+    if (id >= m_nodes.size())
+    {
+        throw std::out_of_range("no node " + std::to_string(id) + " in graph");
+    }
+    return m_nodes[id];
+}
+
+const Graph::Node& Graph::node(NodeId id) const
+{
+    if (id >= m_nodes.size())
+    {
+        throw std::out_of_range("no node " + std::to_string(id) + " in graph");
+    }
+    return m_nodes[id];
+}
+
+Graph::NodeId Graph::add(ProcessorPtr processor)
+{
+    if (!processor)
+    {
+        throw std::invalid_argument("null processor added to graph");
+    }
+    const size_t inputs = processor->inputCount();
+    Node n{std::move(processor),
+           std::vector<NodeId>(inputs, none),
+           std::make_unique<std::atomic<float>[]>(inputs)};
+    for (size_t i = 0; i < inputs; ++i)
+    {
+        n.values[i].store(0.0f, std::memory_order_relaxed);
+    }
+    m_nodes.push_back(std::move(n));
+    m_compiled = false;
+    return m_nodes.size() - 1;
+}
+
+Graph::NodeId Graph::add(const std::string& name)
+{
+    return add(createProcessor(name));
+}
+
+Graph::NodeId Graph::add(const std::string& name, size_t inputs)
+{
+    return add(createProcessor(name, inputs));
+}
+
+void Graph::connect(NodeId source, NodeId destination, size_t input)
+{
+    node(source);
+    auto& sources = node(destination).sources;
+    if (input >= sources.size())
+    {
+        throw std::out_of_range("no input " + std::to_string(input) + " in node " +
+                                std::to_string(destination));
+    }
+    sources[input] = source;
+    m_compiled     = false;
+}
+
+void Graph::connect(NodeId source, NodeId destination, const std::string& input)
+{
+    connect(source, destination, inputIndex(destination, input));
+}
+
+void Graph::setOutput(NodeId output)
+{
+    node(output);
+    m_output   = output;
+    m_compiled = false;
+}
+
+void Graph::set(NodeId id, size_t input, float value)
+{
+    auto& n = node(id);
+    if (input >= n.sources.size())
+    {
+        throw std::out_of_range("no input " + std::to_string(input) + " in node " +
+                                std::to_string(id));
+    }
+    n.values[input].store(value, std::memory_order_relaxed);
+}
+
+void Graph::set(NodeId id, const std::string& input, float value)
+{
+    set(id, inputIndex(id, input), value);
+}
+
+size_t Graph::inputIndex(NodeId id, const std::string& input) const
+{
+    const auto& processor = *node(id).processor;
+    for (size_t i = 0; i < processor.inputCount(); ++i)
+    {
+        if (input == processor.inputName(i))
+        {
+            return i;
+        }
+    }
+    throw std::out_of_range("no input " + input + " in node " + std::to_string(id));
+}
+
+dap::runtime::Processor& Graph::processor(NodeId id)
+{
+    return *node(id).processor;
+}
+
+void Graph::compile()
+{
+    if (m_output == none)
+    {
+        throw std::logic_error("graph has no output");
+    }
+
+    // depth first post order from the output, i.e. inputs come first
+    enum class Mark
+    {
+        None,
+        Visiting,
+        Done
+    };
+    std::vector<Mark> marks(m_nodes.size(), Mark::None);
+    std::vector<NodeId> order;
+    auto visit = [&](NodeId id, auto& self) -> void {
+        if (marks[id] == Mark::Done)
+        {
+            return;
+        }
+        if (marks[id] == Mark::Visiting)
+        {
+            throw std::logic_error("graph has a cycle through node " + std::to_string(id));
+        }
+        marks[id] = Mark::Visiting;
+        for (auto source : m_nodes[id].sources)
+        {
+            if (source != none)
+            {
+                self(source, self);
+            }
+        }
+        marks[id] = Mark::Done;
+        order.push_back(id);
+    };
+    visit(m_output, visit);
+
+    // the step after which each output is not read anymore
+    std::vector<size_t> lastUse(m_nodes.size(), 0);
+    size_t inputCount     = 0;
+    size_t parameterCount = 0;
+    for (size_t k = 0; k < order.size(); ++k)
+    {
+        for (auto source : m_nodes[order[k]].sources)
+        {
+            if (source != none)
+            {
+                lastUse[source] = k;
+            }
+            else
+            {
+                ++parameterCount;
+            }
+            ++inputCount;
+        }
+    }
+
+    // outputs take the first free buffer, parameters have their own. The output node renders
+    // straight into the buffer given to process.
+    std::vector<size_t> bufferOf(m_nodes.size(), none);
+    std::vector<size_t> available;
+    size_t buffers = 0;
+    for (size_t k = 0; k + 1 < order.size(); ++k)
+    {
+        if (available.empty())
+        {
+            available.push_back(buffers++);
+        }
+        bufferOf[order[k]] = available.back();
+        available.pop_back();
+        for (auto source : m_nodes[order[k]].sources)
+        {
+            if (source != none && lastUse[source] == k &&
+                std::find(available.begin(), available.end(), bufferOf[source]) ==
+                    available.end())
+            {
+                available.push_back(bufferOf[source]);
+            }
+        }
+    }
+
+    m_buffers.assign(buffers + parameterCount, Block{});
+    m_inputs.assign(inputCount, nullptr);
+    m_steps.clear();
+    m_parameters.clear();
+    size_t input     = 0;
+    size_t parameter = buffers;
+    for (auto id : order)
+    {
+        auto& n = m_nodes[id];
+        m_steps.push_back({n.processor.get(),
+                           bufferOf[id] == none ? nullptr : m_buffers[bufferOf[id]].samples.data(),
+                           m_inputs.data() + input});
+        for (size_t i = 0; i < n.sources.size(); ++i, ++input)
+        {
+            if (n.sources[i] != none)
+            {
+                m_inputs[input] = m_buffers[bufferOf[n.sources[i]]].samples.data();
+            }
+            else
+            {
+                float* block    = m_buffers[parameter++].samples.data();
+                m_inputs[input] = block;
+                // the current value is not a number, so the block is filled at the first process
+                m_parameters.push_back(
+                    {&n.values[i], block, std::numeric_limits<float>::quiet_NaN()});
+            }
+        }
+    }
+    m_compiled = true;
+}
+
+void Graph::reset()
+{
+    for (auto& n : m_nodes)
+    {
+        n.processor->reset();
+    }
+}
+
+void Graph::processBlock(float* out, size_t frames)
+{
+    for (auto& parameter : m_parameters)
+    {
+        const float value = parameter.value->load(std::memory_order_relaxed);
+        if (value != parameter.current)
+        {
+            std::fill(parameter.block, parameter.block + max_block_size_t::value, value);
+            parameter.current = value;
+        }
+    }
+    const size_t last = m_steps.size() - 1;
+    for (size_t k = 0; k < last; ++k)
+    {
+        const auto& step = m_steps[k];
+        step.processor->process(step.out, frames, step.inputs);
+    }
+    m_steps[last].processor->process(out, frames, m_steps[last].inputs);
+}
+
+void Graph::process(float* out, size_t frames)
+{
+    assert(m_compiled);
+    for (size_t offset = 0; offset < frames; offset += max_block_size_t::value)
+    {
+        processBlock(out + offset, std::min(frames - offset, max_block_size_t::value));
+    }
+}
@@ -0,0 +1,119 @@
+#ifndef DAP_RUNTIME_GRAPH_H
+#define DAP_RUNTIME_GRAPH_H
+
+#include "Processor.h"
+#include "base/Constants.h"
+#include <array>
+#include <atomic>
+#include <limits>
+#include <vector>
+
+namespace dap
+{
+    namespace runtime
+    {
+        class Graph;
+    }
+}
+
+// Processors connected by index, the graph is built and compiled off the audio thread. compile()
+// orders the nodes reachable from the output so that inputs come first and assigns each of their
+// outputs a block buffer, a buffer is reused by later nodes once its last reader ran. process()
+// then renders blocks of max_block_size_t frames walking that order, it neither allocates nor
+// locks. An output may feed any number of inputs.
+//
+// Unconnected inputs are parameters, set() may be called from any thread while processing, a new
+// value is picked up at the next block.
+class dap::runtime::Graph final
+{
+public:
+    using NodeId                 = size_t;
+    static constexpr NodeId none = std::numeric_limits<NodeId>::max();
+
+private:
+    struct alignas(CACHE_LINE_SIZE) Block
+    {
+        std::array<float, max_block_size_t::value> samples;
+    };
+    struct Node
+    {
+        ProcessorPtr processor;
+        std::vector<NodeId> sources;
+        std::unique_ptr<std::atomic<float>[]> values;
+    };
+    struct Step
+    {
+        Processor* processor;
+        float* out;
+        const float* const* inputs;
+    };
+    struct Parameter
+    {
+        const std::atomic<float>* value;
+        float* block;
+        float current;
+    };
+
+    std::vector<Node> m_nodes;
+    NodeId m_output{none};
+    bool m_compiled{false};
+
+    // compiled state
+    std::vector<Step> m_steps;
+    std::vector<Parameter> m_parameters;
+    std::vector<const float*> m_inputs;
+    std::vector<Block> m_buffers;
+
+    Node& node(NodeId id);
+    const Node& node(NodeId id) const;
+    void processBlock(float* out, size_t frames);
+
+public:
+    Graph()             = default;
+    Graph(const Graph&) = delete;
+    Graph(Graph&&)      = delete;
+    ~Graph()            = default;
+    Graph& operator=(const Graph&) = delete;
+    Graph& operator=(Graph&&) = delete;
+
+    NodeId add(ProcessorPtr processor);
+    // adds a processor registered by name, see createProcessor
+    NodeId add(const std::string& name);
+    NodeId add(const std::string& name, size_t inputs);
+    // feeds the output of source into the given input of destination
+    void connect(NodeId source, NodeId destination, size_t input);
+    void connect(NodeId source, NodeId destination, const std::string& input);
+    void setOutput(NodeId output);
+    // sets the value of an unconnected input
+    void set(NodeId id, size_t input, float value);
+    void set(NodeId id, const std::string& input, float value);
+    size_t inputIndex(NodeId id, const std::string& input) const;
+    Processor& processor(NodeId id);
+
+    // schedules the nodes the output depends on, throws std::logic_error if there is no output
+    // or the graph has a cycle. Must be called again once connections change.
+    void compile();
+    bool isCompiled() const
+    {
+        return m_compiled;
+    }
+    size_t size() const
+    {
+        return m_nodes.size();
+    }
+    size_t stepCount() const
+    {
+        return m_steps.size();
+    }
+    size_t bufferCount() const
+    {
+        return m_buffers.size();
+    }
+
+    // resets every processor, e.g. before reusing the graph for a new note
+    void reset();
+    // renders frames samples of the output node into out, the graph must be compiled
+    void process(float* out, size_t frames);
+};
+
+#endif // DAP_RUNTIME_GRAPH_H
@@ -0,0 +1,60 @@
+#ifndef DAP_RUNTIME_PROCESSOR_H
+#define DAP_RUNTIME_PROCESSOR_H
+
+#include "base/AbstractFactory.h"
+#include <cstddef>
+#include <memory>
+#include <ostream>
+#include <string>
+
+namespace dap
+{
+    namespace runtime
+    {
+        class Processor;
+
+        template <typename ProductType, typename... ConstructorArgs>
+        class ProcessorRegistrar;
+
+        using ProcessorPtr = std::unique_ptr<Processor>;
+
+        // maximum number of frames given to Processor::process at once
+        using max_block_size_t = std::integral_constant<size_t, 64>;
+
+        // creates a processor registered by name, throws ProductNotFoundInFactory if there is none
+        ProcessorPtr createProcessor(const std::string& name);
+        // creates a processor taking a variable number of inputs, e.g. a mixer
+        ProcessorPtr createProcessor(const std::string& name, size_t inputs);
+
+        // dumps registered processor names and their constructor arguments
+        std::ostream& dumpProcessors(std::ostream& out);
+    }
+}
+
+// Type erased block processor, the unit a runtime graph is built from. Processors are created by
+// name through the AbstractFactory, see Processors.h for the ones wrapping dsp processors.
+class dap::runtime::Processor
+{
+public:
+    Processor()                 = default;
+    Processor(const Processor&) = delete;
+    Processor(Processor&&)      = delete;
+    virtual ~Processor()        = default;
+    Processor& operator=(const Processor&) = delete;
+    Processor& operator=(Processor&&) = delete;
+
+    virtual size_t inputCount() const             = 0;
+    virtual const char* inputName(size_t i) const = 0;
+    // renders frames (at most max_block_size_t) samples into out, inputs[i] points to frames
+    // samples of the i-th input. Called from the audio thread, must not allocate nor lock.
+    virtual void process(float* out, size_t frames, const float* const* inputs) = 0;
+    // clears the state, e.g. filter memories or oscillator phases
+    virtual void reset() = 0;
+};
+
+template <typename ProductType, typename... ConstructorArgs>
+class dap::runtime::ProcessorRegistrar : public Registrar<Processor, ProductType, ConstructorArgs...>
+{
+};
+
+#endif // DAP_RUNTIME_PROCESSOR_H
@@ -0,0 +1,51 @@
+#include "Processors.h"
+
+using namespace dap;
+using namespace dap::runtime;
+
+#define DAP_RUNTIME_REGISTER(ProductType)                                   \
+    template <>                                                             \
+    const volatile bool Registrar<Processor, ProductType>::value =          \
+        AbstractFactory<Processor>::register_(ProductType::getName(),       \
+                                              &Registrar<Processor, ProductType>::create)
+
+#define DAP_RUNTIME_REGISTER_WITH_ARGS(ProductType, ...)                              \
+    template <>                                                                       \
+    const volatile bool Registrar<Processor, ProductType, __VA_ARGS__>::value =       \
+        AbstractFactory<Processor, __VA_ARGS__>::register_(                           \
+            ProductType::getName(), &Registrar<Processor, ProductType, __VA_ARGS__>::create)
+
+// registrations live in the same translation unit as createProcessor, so linking the latter
+// always brings them along
+DAP_RUNTIME_REGISTER(processors::Add);
+DAP_RUNTIME_REGISTER(processors::AllPass);
+DAP_RUNTIME_REGISTER(processors::Bus);
+DAP_RUNTIME_REGISTER(processors::Control);
+DAP_RUNTIME_REGISTER(processors::DelayLine);
+DAP_RUNTIME_REGISTER(processors::FeedbackCombFilter);
+DAP_RUNTIME_REGISTER(processors::FeedbackLine);
+DAP_RUNTIME_REGISTER(processors::FeedforwardCombFilter);
+DAP_RUNTIME_REGISTER(processors::LadderFilter);
+DAP_RUNTIME_REGISTER(processors::Multiply);
+DAP_RUNTIME_REGISTER(processors::NoiseGenerator);
+DAP_RUNTIME_REGISTER(processors::Oscillator);
+DAP_RUNTIME_REGISTER(processors::Phaser);
+DAP_RUNTIME_REGISTER(processors::Phasor);
+DAP_RUNTIME_REGISTER(processors::Pwm);
+DAP_RUNTIME_REGISTER(processors::Smoother);
+DAP_RUNTIME_REGISTER_WITH_ARGS(processors::Mixer, size_t&&);
+
+ProcessorPtr dap::runtime::createProcessor(const std::string& name)
+{
+    return createProduct<Processor>(name);
+}
+
+ProcessorPtr dap::runtime::createProcessor(const std::string& name, size_t inputs)
+{
+    return createProduct<Processor>(name, std::move(inputs));
+}
+
+std::ostream& dap::runtime::dumpProcessors(std::ostream& out)
+{
+    return out << AbstractFactory<Processor>() << AbstractFactory<Processor, size_t&&>();
+}
@@ -0,0 +1,489 @@
+#ifndef DAP_RUNTIME_PROCESSORS_H
+#define DAP_RUNTIME_PROCESSORS_H
+
+#include "Processor.h"
+#include "dsp/AllPass.h"
+#include "dsp/CombFilter.h"
+#include "dsp/DelayLine.h"
+#include "dsp/FeedbackLine.h"
+#include "dsp/LadderFilter.h"
+#include "dsp/Mixer.h"
+#include "dsp/NoiseGenerator.h"
+#include "dsp/Oscillator.h"
+#include "dsp/Phaser.h"
+#include "dsp/Phasor.h"
+#include "dsp/Pwm.h"
+#include "dsp/Smoother.h"
+#include "dsp/UniformDistribution.h"
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+namespace dap
+{
+    namespace runtime
+    {
+        template <typename DspProcessor, typename... Args>
+        class ProcessorAdapter;
+
+        // maximum delay, in samples, of the delay based processors
+        using max_delay_t = std::integral_constant<size_t, 512 * 64>;
+
+        namespace detail
+        {
+            // samples carry every input, enumerations included
+            template <typename T>
+            inline T fromSample(float x)
+            {
+                if constexpr (std::is_enum<T>::value)
+                {
+                    return static_cast<T>(static_cast<std::underlying_type_t<T>>(x));
+                }
+                else
+                {
+                    return static_cast<T>(x);
+                }
+            }
+
+            template <typename T, typename = void>
+            struct HasReset : std::false_type
+            {
+            };
+            template <typename T>
+            struct HasReset<T, std::void_t<decltype(std::declval<T&>().reset())>> : std::true_type
+            {
+            };
+
+            struct Add
+            {
+                inline auto operator()(float x, float y)
+                {
+                    return x + y;
+                }
+            };
+            struct Multiply
+            {
+                inline auto operator()(float x, float y)
+                {
+                    return x * y;
+                }
+            };
+        }
+
+        namespace processors
+        {
+            class Add;
+            class AllPass;
+            class Bus;
+            class Control;
+            class DelayLine;
+            class FeedbackCombFilter;
+            class FeedbackLine;
+            class FeedforwardCombFilter;
+            class LadderFilter;
+            class Mixer;
+            class Multiply;
+            class NoiseGenerator;
+            class Oscillator;
+            class Phaser;
+            class Phasor;
+            class Pwm;
+            class Smoother;
+        }
+    }
+}
+
+// Wraps a dsp processor whose operator() takes Args, the processor is evaluated once per frame
+// with the n-th sample of each input
+template <typename DspProcessor, typename... Args>
+class dap::runtime::ProcessorAdapter : public Processor
+{
+    using names_t = std::array<const char*, sizeof...(Args)>;
+
+    DspProcessor m_processor{};
+    const names_t m_names;
+
+    template <size_t... Is>
+    inline void process(float* out,
+                        size_t frames,
+                        const float* const* inputs,
+                        const std::index_sequence<Is...>&)
+    {
+        const std::array<const float*, sizeof...(Args)> in{{inputs[Is]...}};
+        for (size_t n = 0; n < frames; ++n)
+        {
+            out[n] = static_cast<float>(m_processor(detail::fromSample<Args>(in[Is][n])...));
+        }
+    }
+
+protected:
+    template <typename... Names>
+    explicit ProcessorAdapter(Names... names)
+    : m_names{{names...}}
+    {
+        static_assert(sizeof...(Names) == sizeof...(Args), "one name per input is required");
+    }
+
+public:
+    size_t inputCount() const override
+    {
+        return sizeof...(Args);
+    }
+    const char* inputName(size_t i) const override
+    {
+        return m_names[i];
+    }
+    void process(float* out, size_t frames, const float* const* inputs) override
+    {
+        process(out, frames, inputs, std::index_sequence_for<Args...>{});
+    }
+    void reset() override
+    {
+        if constexpr (detail::HasReset<DspProcessor>::value)
+        {
+            m_processor.reset();
+        }
+    }
+};
+
+class dap::runtime::processors::Oscillator final
+: public ProcessorAdapter<dsp::Oscillator<float>,
+                          float,
+                          float,
+                          float,
+                          float,
+                          dsp::OscillatorFunctions::Shape>,
+  public ProcessorRegistrar<Oscillator>
+{
+public:
+    constexpr static const char* getName() noexcept
+    {
+        return "Oscillator";
+    }
+    Oscillator()
+    : ProcessorAdapter("gain", "frequency", "phase", "samplerate", "shape")
+    {
+    }
+};
+
+class dap::runtime::processors::Pwm final
+: public ProcessorAdapter<dsp::Pwm<float>, float, float, float, float, float>,
+  public ProcessorRegistrar<Pwm>
+{
+public:
+    constexpr static const char* getName() noexcept
+    {
+        return "Pwm";
+    }
+    Pwm()
+    : ProcessorAdapter("gain", "frequency", "phase", "samplerate", "dutycycle")
+    {
+    }
+};
+
+class dap::runtime::processors::Phasor final
+: public ProcessorAdapter<dsp::Phasor<float>, float, float>,
+  public ProcessorRegistrar<Phasor>
+{
+public:
+    constexpr static const char* getName() noexcept
+    {
+        return "Phasor";
+    }
+    Phasor()
+    : ProcessorAdapter("frequency", "samplerate")
+    {
+    }
+};
+
+class dap::runtime::processors::NoiseGenerator final
+: public ProcessorAdapter<dsp::NoiseGenerator<dsp::UniformDistribution>,
+                          float,
+                          dsp::NoiseGenerator<dsp::UniformDistribution>::Color>,
+  public ProcessorRegistrar<NoiseGenerator>
+{
+public:
+    constexpr static const char* getName() noexcept
+    {
+        return "NoiseGenerator";
+    }
+    NoiseGenerator()
+    : ProcessorAdapter("gain", "color")
+    {
+    }
+};
+
+class dap::runtime::processors::LadderFilter final
+: public ProcessorAdapter<dsp::LadderFilter<float>, float, float, float, float>,
+  public ProcessorRegistrar<LadderFilter>
+{
+public:
+    constexpr static const char* getName() noexcept
+    {
+        return "LadderFilter";
+    }
+    LadderFilter()
+    : ProcessorAdapter("signal", "frequency", "resonance", "samplerate")
+    {
+    }
+};
+
+class dap::runtime::processors::AllPass final
+: public ProcessorAdapter<dsp::AllPass<float>, float, float, float>,
+  public ProcessorRegistrar<AllPass>
+{
+public:
+    constexpr static const char* getName() noexcept
+    {
+        return "AllPass";
+    }
+    AllPass()
+    : ProcessorAdapter("signal", "frequency", "samplerate")
+    {
+    }
+};
+
+class dap::runtime::processors::Phaser final
+: public ProcessorAdapter<dsp::Phaser<float>, float, float, float, float, float, float>,
+  public ProcessorRegistrar<Phaser>
+{
+public:
+    constexpr static const char* getName() noexcept
+    {
+        return "Phaser";
+    }
+    Phaser()
+    : ProcessorAdapter("signal", "frequency", "depth", "feedback", "wet", "samplerate")
+    {
+    }
+};
+
+class dap::runtime::processors::DelayLine final
+: public ProcessorAdapter<dsp::DelayLine<float, max_delay_t::value>, float, float>,
+  public ProcessorRegistrar<DelayLine>
+{
+public:
+    constexpr static const char* getName() noexcept
+    {
+        return "DelayLine";
+    }
+    DelayLine()
+    : ProcessorAdapter("signal", "delay")
+    {
+    }
+};
+
+class dap::runtime::processors::FeedforwardCombFilter final
+: public ProcessorAdapter<dsp::FeedforwardCombFilter<float, max_delay_t::value>, float, float, float>,
+  public ProcessorRegistrar<FeedforwardCombFilter>
+{
+public:
+    constexpr static const char* getName() noexcept
+    {
+        return "FeedforwardCombFilter";
+    }
+    FeedforwardCombFilter()
+    : ProcessorAdapter("signal", "delay", "gain")
+    {
+    }
+};
+
+class dap::runtime::processors::FeedbackCombFilter final
+: public ProcessorAdapter<dsp::FeedbackCombFilter<float, max_delay_t::value>, float, float, float>,
+  public ProcessorRegistrar<FeedbackCombFilter>
+{
+public:
+    constexpr static const char* getName() noexcept
+    {
+        return "FeedbackCombFilter";
+    }
+    FeedbackCombFilter()
+    : ProcessorAdapter("signal", "delay", "feedback")
+    {
+    }
+};
+
+class dap::runtime::processors::FeedbackLine final
+: public ProcessorAdapter<dsp::FeedbackLine<float, max_delay_t::value>, float, float, float>,
+  public ProcessorRegistrar<FeedbackLine>
+{
+public:
+    constexpr static const char* getName() noexcept
+    {
+        return "FeedbackLine";
+    }
+    FeedbackLine()
+    : ProcessorAdapter("signal", "delay", "feedback")
+    {
+    }
+};
+
+class dap::runtime::processors::Smoother final
+: public ProcessorAdapter<dsp::Smoother<float>, float, size_t>,
+  public ProcessorRegistrar<Smoother>
+{
+public:
+    constexpr static const char* getName() noexcept
+    {
+        return "Smoother";
+    }
+    Smoother()
+    : ProcessorAdapter("value", "duration")
+    {
+    }
+};
+
+class dap::runtime::processors::Bus final
+: public ProcessorAdapter<dsp::Mixer::Bus, float, float>,
+  public ProcessorRegistrar<Bus>
+{
+public:
+    constexpr static const char* getName() noexcept
+    {
+        return "Bus";
+    }
+    Bus()
+    : ProcessorAdapter("gain", "signal")
+    {
+    }
+};
+
+class dap::runtime::processors::Add final
+: public ProcessorAdapter<detail::Add, float, float>,
+  public ProcessorRegistrar<Add>
+{
+public:
+    constexpr static const char* getName() noexcept
+    {
+        return "Add";
+    }
+    Add()
+    : ProcessorAdapter("x", "y")
+    {
+    }
+};
+
+class dap::runtime::processors::Multiply final
+: public ProcessorAdapter<detail::Multiply, float, float>,
+  public ProcessorRegistrar<Multiply>
+{
+public:
+    constexpr static const char* getName() noexcept
+    {
+        return "Multiply";
+    }
+    Multiply()
+    : ProcessorAdapter("x", "y")
+    {
+    }
+};
+
+// smoothed control evaluated once every divisor frames and linearly interpolated in between, as
+// crtp::control_rate over a dsp::FixedSmoother does
+class dap::runtime::processors::Control final
+: public Processor,
+  public ProcessorRegistrar<Control>
+{
+public:
+    using divisor_t           = std::integral_constant<size_t, 16>;
+    using smoothing_samples_t = std::integral_constant<size_t, 512>;
+
+private:
+    dsp::FixedSmoother<float, smoothing_samples_t::value / divisor_t::value> m_smoother;
+    float m_value{0};
+    float m_step{0};
+    size_t m_counter{0};
+
+public:
+    constexpr static const char* getName() noexcept
+    {
+        return "Control";
+    }
+    size_t inputCount() const override
+    {
+        return 1;
+    }
+    const char* inputName(size_t) const override
+    {
+        return "value";
+    }
+    void process(float* out, size_t frames, const float* const* inputs) override
+    {
+        size_t n = 0;
+        while (n < frames)
+        {
+            if (m_counter == 0)
+            {
+                m_step = (m_smoother(inputs[0][n]) - m_value) / float(divisor_t::value);
+            }
+            const size_t run = std::min(frames - n, divisor_t::value - m_counter);
+            for (size_t i = 0; i < run; ++i)
+            {
+                m_value += m_step;
+                out[n + i] = m_value;
+            }
+            n += run;
+            m_counter = (m_counter + run) % divisor_t::value;
+        }
+    }
+    void reset() override
+    {
+        m_smoother.reset();
+        m_value   = 0;
+        m_step    = 0;
+        m_counter = 0;
+    }
+};
+
+// sums its inputs normalized by the square root of their count, as dsp::Mixer does
+class dap::runtime::processors::Mixer final
+: public Processor,
+  public ProcessorRegistrar<Mixer, size_t>
+{
+    const size_t m_inputs;
+    const double m_norm;
+
+public:
+    constexpr static const char* getName() noexcept
+    {
+        return "Mixer";
+    }
+    explicit Mixer(size_t inputs)
+    : m_inputs(inputs)
+    , m_norm(std::sqrt(double(inputs)) + std::numeric_limits<float>::epsilon())
+    {
+        assert(inputs > 0);
+    }
+    size_t inputCount() const override
+    {
+        return m_inputs;
+    }
+    const char* inputName(size_t) const override
+    {
+        return "signal";
+    }
+    void process(float* out, size_t frames, const float* const* inputs) override
+    {
+        std::copy(inputs[0], inputs[0] + frames, out);
+        for (size_t i = 1; i < m_inputs; ++i)
+        {
+            const float* in = inputs[i];
+            for (size_t n = 0; n < frames; ++n)
+            {
+                out[n] += in[n];
+            }
+        }
+        for (size_t n = 0; n < frames; ++n)
+        {
+            out[n] = static_cast<float>(out[n] / m_norm);
+        }
+    }
+    void reset() override
+    {
+    }
+};
+
+#endif // DAP_RUNTIME_PROCESSORS_H
@@ -0,0 +1,156 @@
+#include "runtime/Engine.h"
+#include <gtest/gtest.h>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace testing;
+using namespace dap::runtime;
+
+namespace
+{
+    // outputs its value and flags its destruction
+    class Constant final : public Processor
+    {
+        const float m_value;
+        std::atomic<bool>& m_deleted;
+
+    public:
+        Constant(float value, std::atomic<bool>& deleted)
+        : m_value(value)
+        , m_deleted(deleted)
+        {
+        }
+        ~Constant() override
+        {
+            m_deleted = true;
+        }
+        size_t inputCount() const override
+        {
+            return 0;
+        }
+        const char* inputName(size_t) const override
+        {
+            return "";
+        }
+        void process(float* out, size_t frames, const float* const*) override
+        {
+            std::fill(out, out + frames, m_value);
+        }
+        void reset() override
+        {
+        }
+    };
+
+    std::unique_ptr<Graph> constant(float value, std::atomic<bool>& deleted)
+    {
+        auto graph = std::make_unique<Graph>();
+        graph->setOutput(graph->add(std::make_unique<Constant>(value, deleted)));
+        return graph;
+    }
+
+    bool waitFor(const std::atomic<bool>& flag)
+    {
+        for (int i = 0; i < 1000 && !flag; ++i)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return flag;
+    }
+}
+
+TEST(EngineTest, silent_without_graph)
+{
+    Engine engine;
+    std::vector<float> out(100, 1.0f);
+    engine.process(out.data(), out.size());
+    for (auto x : out)
+    {
+        ASSERT_EQ(0.0f, x);
+    }
+}
+
+TEST(EngineTest, crossfades_at_block_boundaries)
+{
+    std::atomic<bool> deleted1{false};
+    std::atomic<bool> deleted2{false};
+    Engine engine(128);
+    engine.swap(constant(1.0f, deleted1));
+
+    // the first graph fades in from silence
+    std::vector<float> out(256);
+    engine.process(out.data(), out.size());
+    for (size_t n = 0; n < 128; ++n)
+    {
+        ASSERT_FLOAT_EQ(float(n + 1) / 128.0f, out[n]);
+    }
+    ASSERT_EQ(1.0f, out.back());
+    ASSERT_FALSE(engine.isFading());
+
+    // the graph is picked up at the next block, i.e. at the next call here
+    engine.process(out.data(), 10);
+    engine.swap(constant(-1.0f, deleted2));
+    engine.process(out.data() + 10, out.size() - 10);
+    for (size_t n = 0; n < 10; ++n)
+    {
+        ASSERT_EQ(1.0f, out[n]);
+    }
+    for (size_t n = 0; n < 128; ++n)
+    {
+        ASSERT_FLOAT_EQ(1.0f - 2.0f * float(n + 1) / 128.0f, out[10 + n]);
+    }
+    ASSERT_EQ(-1.0f, out.back());
+
+    // the old graph is deleted off the audio thread
+    ASSERT_FALSE(engine.isFading());
+    ASSERT_TRUE(waitFor(deleted1));
+    ASSERT_FALSE(deleted2);
+}
+
+TEST(EngineTest, plays_the_latest_graph)
+{
+    std::atomic<bool> deleted1{false};
+    std::atomic<bool> deleted2{false};
+    std::atomic<bool> deleted3{false};
+    Engine engine(0);
+    engine.swap(constant(1.0f, deleted1));
+    std::vector<float> out(64);
+    engine.process(out.data(), out.size());
+    ASSERT_EQ(1.0f, out.front());
+
+    // a graph never played is replaced right away
+    engine.swap(constant(2.0f, deleted2));
+    engine.swap(constant(3.0f, deleted3));
+    ASSERT_TRUE(deleted2);
+    engine.process(out.data(), out.size());
+    ASSERT_EQ(3.0f, out.front());
+    ASSERT_EQ(3.0f, out.back());
+    ASSERT_TRUE(waitFor(deleted1));
+    ASSERT_FALSE(deleted3);
+}
+
+TEST(EngineTest, swaps_while_processing)
+{
+    Engine engine(64);
+    std::atomic<bool> running{true};
+    std::atomic<bool> deleted{false};
+    std::thread audio([&] {
+        std::vector<float> out(128);
+        while (running)
+        {
+            engine.process(out.data(), out.size());
+            for (auto x : out)
+            {
+                ASSERT_GE(x, 0.0f);
+                ASSERT_LE(x, 100.0f);
+            }
+        }
+    });
+    for (int i = 0; i < 100; ++i)
+    {
+        engine.swap(constant(float(i), deleted));
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+    running = false;
+    audio.join();
+}
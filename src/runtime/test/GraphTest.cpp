@@ -0,0 +1,191 @@
+#include "crtp/nodes/Node.h"
+#include "runtime/Graph.h"
+#include "runtime/Processors.h"
+#include <gtest/gtest.h>
+#include <vector>
+
+using namespace testing;
+using namespace dap;
+using namespace dap::runtime;
+
+namespace
+{
+    using shape_t   = dsp::OscillatorFunctions::Shape;
+    using control_t = crtp::ControlRateNode<crtp::ProcessorNode<dsp::FixedSmoother<float, 32>,
+                                                                crtp::Node::Inputs<float>,
+                                                                NODE_INPUT_NAMES("value"_s)>,
+                                            16,
+                                            crtp::ControlInterpolation::Linear>;
+    using osc_t     = crtp::ProcessorNode<dsp::Oscillator<float>,
+                                      crtp::Node::Inputs<control_t, control_t, float, float, shape_t>,
+                                      NODE_INPUT_NAMES(
+                                          "gain"_s, "frequency"_s, "phase"_s, "samplerate"_s, "shape"_s)>;
+    using filter_t  = crtp::ProcessorNode<dsp::LadderFilter<float>,
+                                         crtp::Node::Inputs<osc_t, control_t, float, float>,
+                                         NODE_INPUT_NAMES(
+                                             "signal"_s, "frequency"_s, "resonance"_s, "samplerate"_s)>;
+
+    float toSample(shape_t shape)
+    {
+        return static_cast<float>(static_cast<int>(shape));
+    }
+
+    // filtered oscillator, returns the filter
+    Graph::NodeId build(Graph& graph, float gain, float frequency, float cutoff)
+    {
+        auto control = [&graph](float value) {
+            const auto id = graph.add("Control");
+            graph.set(id, "value", value);
+            return id;
+        };
+        const auto osc = graph.add("Oscillator");
+        graph.connect(control(gain), osc, "gain");
+        graph.connect(control(frequency), osc, "frequency");
+        graph.set(osc, "samplerate", 44100.0f);
+        graph.set(osc, "shape", toSample(shape_t::Saw));
+        const auto filter = graph.add("LadderFilter");
+        graph.connect(osc, filter, "signal");
+        graph.connect(control(cutoff), filter, "frequency");
+        graph.set(filter, "resonance", 1.2f);
+        graph.set(filter, "samplerate", 44100.0f);
+        return filter;
+    }
+}
+
+TEST(GraphTest, creates_registered_processors)
+{
+    auto osc = createProcessor("Oscillator");
+    ASSERT_EQ(5u, osc->inputCount());
+    ASSERT_STREQ("frequency", osc->inputName(1));
+    ASSERT_EQ(3u, createProcessor("Mixer", 3)->inputCount());
+    ASSERT_THROW(createProcessor("nil"), AbstractFactory<Processor>::ProductNotFoundInFactory);
+}
+
+TEST(GraphTest, matches_crtp_graph)
+{
+    filter_t expected;
+    auto& osc                                         = expected.input("signal"_s);
+    osc.input("gain"_s).input("value"_s)              = 0.5f;
+    osc.input("frequency"_s).input("value"_s)         = 440.0f;
+    osc.input("phase"_s)                              = 0.0f;
+    osc.input("samplerate"_s)                         = 44100.0f;
+    osc.input("shape"_s)                              = shape_t::Saw;
+    expected.input("frequency"_s).input("value"_s)    = 2000.0f;
+    expected.input("resonance"_s)                     = 1.2f;
+    expected.input("samplerate"_s)                    = 44100.0f;
+
+    Graph graph;
+    graph.setOutput(build(graph, 0.5f, 440.0f, 2000.0f));
+    graph.compile();
+    ASSERT_EQ(5u, graph.stepCount());
+
+    std::vector<float> x(1000);
+    std::vector<float> y(x.size());
+    for (auto frames : {size_t{1000}, size_t{37}, size_t{64}, size_t{500}})
+    {
+        expected.process(x.data(), frames);
+        graph.process(y.data(), frames);
+        for (size_t n = 0; n < frames; ++n)
+        {
+            ASSERT_FLOAT_EQ(x[n], y[n]);
+        }
+    }
+}
+
+TEST(GraphTest, reuses_buffers)
+{
+    // two filtered oscillators mixed
+    Graph graph;
+    const auto mixer = graph.add("Mixer", 2);
+    graph.connect(build(graph, 0.5f, 440.0f, 2000.0f), mixer, 0);
+    graph.connect(build(graph, 0.5f, 220.0f, 1000.0f), mixer, 1);
+    graph.setOutput(mixer);
+    graph.compile();
+    ASSERT_EQ(11u, graph.stepCount());
+    // three buffers render a branch and a fourth one holds the first filter output while the
+    // second branch renders, each control, oscillator and filter parameter has its own one
+    ASSERT_EQ(4u + 6u + 6u + 4u, graph.bufferCount());
+
+    // an output feeding several inputs
+    Graph fanOut;
+    const auto osc = fanOut.add("Oscillator");
+    fanOut.set(osc, "gain", 1.0f);
+    fanOut.set(osc, "frequency", 100.0f);
+    fanOut.set(osc, "samplerate", 44100.0f);
+    const auto add = fanOut.add("Add");
+    fanOut.connect(osc, add, "x");
+    fanOut.connect(osc, add, "y");
+    fanOut.setOutput(add);
+    fanOut.compile();
+
+    auto reference = createProcessor("Oscillator");
+    std::vector<float> x(300);
+    std::vector<float> y(x.size());
+    const std::vector<float> gain(64, 1.0f);
+    const std::vector<float> frequency(64, 100.0f);
+    const std::vector<float> zero(64, 0.0f);
+    const std::vector<float> samplerate(64, 44100.0f);
+    const float* inputs[] = {gain.data(), frequency.data(), zero.data(), samplerate.data(), zero.data()};
+    for (size_t offset = 0; offset < x.size(); offset += 64)
+    {
+        reference->process(x.data() + offset, std::min<size_t>(64, x.size() - offset), inputs);
+    }
+    fanOut.process(y.data(), y.size());
+    for (size_t n = 0; n < x.size(); ++n)
+    {
+        ASSERT_FLOAT_EQ(2.0f * x[n], y[n]);
+    }
+}
+
+TEST(GraphTest, parameters)
+{
+    Graph graph;
+    const auto add = graph.add("Add");
+    graph.set(add, "x", 1.0f);
+    graph.set(add, 1, 2.0f);
+    graph.setOutput(add);
+    graph.compile();
+
+    std::vector<float> out(100);
+    graph.process(out.data(), out.size());
+    ASSERT_EQ(3.0f, out.front());
+    ASSERT_EQ(3.0f, out.back());
+
+    graph.set(add, "y", -1.0f);
+    graph.process(out.data(), out.size());
+    ASSERT_EQ(0.0f, out.front());
+    ASSERT_EQ(0.0f, out.back());
+}
+
+TEST(GraphTest, reset)
+{
+    Graph graph;
+    graph.setOutput(build(graph, 0.5f, 440.0f, 2000.0f));
+    graph.compile();
+
+    std::vector<float> expected(300);
+    std::vector<float> out(expected.size());
+    graph.process(expected.data(), expected.size());
+    graph.reset();
+    graph.process(out.data(), out.size());
+    for (size_t n = 0; n < out.size(); ++n)
+    {
+        ASSERT_EQ(expected[n], out[n]);
+    }
+}
+
+TEST(GraphTest, errors)
+{
+    Graph graph;
+    ASSERT_THROW(graph.compile(), std::logic_error);
+    const auto x = graph.add("Add");
+    const auto y = graph.add("Add");
+    ASSERT_THROW(graph.connect(x, y, "z"), std::out_of_range);
+    ASSERT_THROW(graph.connect(x, 2, 0), std::out_of_range);
+    ASSERT_THROW(graph.set(x, 2, 0.0f), std::out_of_range);
+    graph.connect(x, y, "x");
+    graph.connect(y, x, "x");
+    graph.setOutput(y);
+    ASSERT_THROW(graph.compile(), std::logic_error);
+    ASSERT_FALSE(graph.isCompiled());
+}
@@ -0,0 +1,196 @@
+#ifndef DAP_THREADSAFE_WORKER_POOL_H
+#define DAP_THREADSAFE_WORKER_POOL_H
+
+#include "base/Semaphore.h"
+#include "base/SystemCommon.h"
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace dap
+{
+    namespace threadsafe
+    {
+        class WorkerPool;
+    }
+}
+
+// Fixed set of worker threads running batches of tasks on behalf of a realtime thread.
+// WorkerPool::run publishes a batch, works on it from the calling thread as well and spins until
+// every task is done, it does not allocate, lock nor block, so it can be called from the audio
+// callback. Idle workers spin for a while waiting for the next batch and then park on a semaphore,
+// the calling thread only signals the semaphore if some worker is parked.
+class dap::threadsafe::WorkerPool final
+{
+public:
+    struct Task
+    {
+        void (*function)(void*);
+        void* context;
+    };
+    static constexpr size_t max_tasks = 0xffff;
+
+private:
+    // batch state packed in one word so a task index is never claimed against a stale batch:
+    // epoch (32 bits) | task count (16 bits) | next task to claim (16 bits)
+    static constexpr uint64_t epochOf(uint64_t state)
+    {
+        return state >> 32u;
+    }
+    static constexpr uint64_t countOf(uint64_t state)
+    {
+        return (state >> 16u) & max_tasks;
+    }
+    static constexpr uint64_t nextOf(uint64_t state)
+    {
+        return state & max_tasks;
+    }
+
+    std::atomic<uint64_t> m_state{0};
+    std::atomic<size_t> m_remaining{0};
+    std::atomic<uint32_t> m_sleepers{0};
+    std::atomic<bool> m_running{true};
+    const Task* m_tasks{nullptr};
+    uint32_t m_epoch{0};
+    const size_t m_spinCount;
+    Semaphore m_wake;
+    std::vector<std::thread> m_workers;
+#ifndef NDEBUG
+    std::thread::id m_caller;
+    bool m_runningBatch{false};
+#endif
+
+    // runs tasks of the given batch until none is left to claim
+    void execute(uint64_t epoch)
+    {
+        uint64_t state = m_state.load(std::memory_order_acquire);
+        while (epochOf(state) == epoch && nextOf(state) < countOf(state))
+        {
+            if (m_state.compare_exchange_weak(state, state + 1, std::memory_order_acq_rel))
+            {
+                const Task& task = m_tasks[nextOf(state)];
+                task.function(task.context);
+                m_remaining.fetch_sub(1, std::memory_order_release);
+                state = m_state.load(std::memory_order_acquire);
+            }
+        }
+    }
+    uint64_t waitForBatch(uint64_t epoch)
+    {
+        while (true)
+        {
+            for (size_t i = 0; i < m_spinCount; ++i)
+            {
+                const uint64_t state = m_state.load(std::memory_order_acquire);
+                if (epochOf(state) != epoch)
+                {
+                    return state;
+                }
+                spinPause();
+            }
+            // announce before the last check, run() either sees the sleeper or we see the batch
+            m_sleepers.fetch_add(1);
+            const uint64_t state = m_state.load();
+            if (epochOf(state) != epoch)
+            {
+                return state;
+            }
+            m_wake.wait();
+        }
+    }
+    void work()
+    {
+        flushDenormalsToZero();
+
+        uint64_t epoch = 0;
+        while (true)
+        {
+            epoch = epochOf(waitForBatch(epoch));
+            if (!m_running.load(std::memory_order_acquire))
+            {
+                return;
+            }
+            execute(epoch);
+        }
+    }
+    void publish(const Task* tasks, size_t count)
+    {
+        m_tasks = tasks;
+        m_remaining.store(count, std::memory_order_relaxed);
+        m_state.store((uint64_t(++m_epoch) << 32u) | (uint64_t(count) << 16u));
+        if (m_sleepers.load() > 0)
+        {
+            m_wake.signal(m_sleepers.exchange(0));
+        }
+    }
+
+public:
+    // worker i is pinned to core i + 1, leaving core 0 to the thread calling run()
+    explicit WorkerPool(size_t workerCount, bool pinned = true, size_t spinCount = 1u << 14u)
+    : m_spinCount(spinCount)
+    {
+        m_workers.reserve(workerCount);
+        const size_t cores = std::max(concurrent_threads(), 1);
+        for (size_t i = 0; i < workerCount; ++i)
+        {
+            m_workers.emplace_back(&WorkerPool::work, this);
+            if (pinned)
+            {
+                setThreadAffinity(&m_workers.back(), (i + 1) % cores);
+            }
+            setRealtimePriority(&m_workers.back());
+        }
+    }
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool(WorkerPool&&)      = delete;
+    ~WorkerPool()
+    {
+        m_running.store(false, std::memory_order_release);
+        publish(nullptr, 0);
+        m_wake.signal(static_cast<uint32_t>(m_workers.size()));
+        for (auto& worker : m_workers)
+        {
+            worker.join();
+        }
+    }
+    WorkerPool& operator=(const WorkerPool&) = delete;
+    WorkerPool& operator=(WorkerPool&&) = delete;
+
+    size_t workerCount() const
+    {
+        return m_workers.size();
+    }
+    // runs count tasks concurrently and returns once all of them are done. Must always be called
+    // from the same thread and not from a task, tasks must stay alive until run returns. Debug
+    // builds assert both.
+    void run(const Task* tasks, size_t count)
+    {
+        assert(count <= max_tasks);
+#ifndef NDEBUG
+        if (m_caller == std::thread::id())
+        {
+            m_caller = std::this_thread::get_id();
+        }
+        assert(m_caller == std::this_thread::get_id() && "run called from another thread");
+        assert(!m_runningBatch && "run called from a task");
+        m_runningBatch = true;
+#endif
+        if (count != 0)
+        {
+            publish(tasks, count);
+            execute(m_epoch);
+            while (m_remaining.load(std::memory_order_acquire) != 0)
+            {
+                spinPause();
+            }
+        }
+#ifndef NDEBUG
+        m_runningBatch = false;
+#endif
+    }
+};
+
+#endif // DAP_THREADSAFE_WORKER_POOL_H
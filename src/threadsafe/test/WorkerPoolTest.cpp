@@ -0,0 +1,76 @@
+#include "threadsafe/WorkerPool.h"
+#include <array>
+#include <chrono>
+#include <gtest/gtest.h>
+
+using namespace testing;
+using namespace dap::threadsafe;
+
+namespace
+{
+    struct Counter
+    {
+        std::atomic<size_t> count{0};
+
+        static void increment(void* context)
+        {
+            static_cast<Counter*>(context)->count.fetch_add(1);
+        }
+    };
+    template <size_t N>
+    auto makeTasks(std::array<Counter, N>& counters)
+    {
+        std::array<WorkerPool::Task, N> tasks;
+        for (size_t i = 0; i < N; ++i)
+        {
+            tasks[i] = {&Counter::increment, &counters[i]};
+        }
+        return tasks;
+    }
+}
+
+TEST(WorkerPoolTest, runs_every_task_once_per_batch)
+{
+    WorkerPool pool(3, false);
+    std::array<Counter, 7> counters;
+    const auto tasks = makeTasks(counters);
+
+    for (size_t batch = 1; batch <= 1000; ++batch)
+    {
+        pool.run(tasks.data(), tasks.size());
+        for (const auto& counter : counters)
+        {
+            ASSERT_EQ(batch, counter.count.load());
+        }
+    }
+}
+TEST(WorkerPoolTest, without_workers_runs_on_calling_thread)
+{
+    WorkerPool pool(0);
+    std::array<Counter, 3> counters;
+    const auto tasks = makeTasks(counters);
+
+    pool.run(tasks.data(), tasks.size());
+    ASSERT_EQ(0u, pool.workerCount());
+    for (const auto& counter : counters)
+    {
+        ASSERT_EQ(1u, counter.count.load());
+    }
+}
+TEST(WorkerPoolTest, parked_workers_are_woken_up)
+{
+    WorkerPool pool(2, false, 1);
+    std::array<Counter, 4> counters;
+    const auto tasks = makeTasks(counters);
+
+    for (size_t batch = 1; batch <= 10; ++batch)
+    {
+        // gives workers time to park
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        pool.run(tasks.data(), tasks.size());
+        for (const auto& counter : counters)
+        {
+            ASSERT_EQ(batch, counter.count.load());
+        }
+    }
+}